@@ -10,6 +10,7 @@
 #include <shogun/lib/config.h>
 #include <shogun/lib/memory.h>
 
+#include <algorithm>
 #include <thread>
 
 #if defined(LINUX)
@@ -25,6 +26,9 @@
 
 using namespace shogun;
 
+/* thread budget of the calling thread, 0 if unlimited */
+static thread_local int32_t thread_budget=0;
+
 Parallel::Parallel()
 {
 	num_threads=get_num_cpus();
@@ -86,5 +90,19 @@ void Parallel::set_num_threads(int32_t n)
 
 int32_t Parallel::get_num_threads() const
 {
+	if (thread_budget>0 && thread_budget<num_threads)
+		return thread_budget;
+
 	return num_threads;
 }
+
+Parallel::ThreadBudget::ThreadBudget(int32_t n) : m_previous(thread_budget)
+{
+	/* nested budgets can only narrow the enclosing one */
+	thread_budget=m_previous>0 ? std::min(m_previous, n) : n;
+}
+
+Parallel::ThreadBudget::~ThreadBudget()
+{
+	thread_budget=m_previous;
+}
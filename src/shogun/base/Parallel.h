@@ -43,10 +43,35 @@ public:
 	void set_num_threads(int32_t n);
 
 	/** get number of threads
-	 * @return number of threads
+	 * @return number of threads, at most the budget of the calling thread
 	 */
 	int32_t get_num_threads() const;
 
+	/** @brief Limits the number of threads get_num_threads() returns on the
+	 * calling thread while it exists, so that computations running
+	 * concurrently can split the threads between them without changing the
+	 * global setting. A budget nested in another one is at most the
+	 * enclosing budget. The previous budget is restored on destruction.
+	 */
+	class ThreadBudget
+	{
+	public:
+		/** constructor
+		 * @param n number of threads of the calling thread
+		 */
+		explicit ThreadBudget(int32_t n);
+
+		/** destructor */
+		~ThreadBudget();
+
+		ThreadBudget(const ThreadBudget&) = delete;
+		ThreadBudget& operator=(const ThreadBudget&) = delete;
+
+	private:
+		/** budget before this one */
+		int32_t m_previous;
+	};
+
 	// FIXME: Should be dropped, but needed to be wrappable by some
 	int32_t ref() { return 1; }
 	int32_t ref_count() const { return 1; }
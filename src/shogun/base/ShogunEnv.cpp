@@ -11,6 +11,7 @@
 
 #include <shogun/io/SGIO.h>
 #include <shogun/lib/Signal.h>
+#include <shogun/lib/Tracer.h>
 #include <shogun/mathematics/linalg/SGLinalg.h>
 
 #include <rxcpp/rx-lite.hpp>
@@ -99,6 +100,16 @@ void ShogunEnv::init_from_env()
 			    env_thread_val);
 		}
 	}
+
+	char* env_trace_val = NULL;
+	env_trace_val = getenv("SHOGUN_TRACE");
+	if (env_trace_val)
+	{
+		if (strncmp(env_trace_val, "events", 6) == 0)
+			Tracer::enable(true);
+		else if (strncmp(env_trace_val, "on", 2) == 0)
+			Tracer::enable();
+	}
 }
 
 io::SGIO* ShogunEnv::io()
@@ -131,6 +142,15 @@ Signal* ShogunEnv::signal()
 	return sg_signal.get();
 }
 
+std::shared_ptr<Tracer> ShogunEnv::tracer()
+{
+	/* created on first use, as SGObjects cannot be constructed while the
+	 * environment is */
+	std::call_once(
+	    sg_tracer_flag, [this]() { sg_tracer = std::make_shared<Tracer>(); });
+	return sg_tracer;
+}
+
 SGLinalg* ShogunEnv::linalg()
 {
 	return sg_linalg.get();
@@ -15,6 +15,7 @@
 #include <shogun/io/fs/FileSystemRegistry.h>
 
 #include <memory>
+#include <mutex>
 
 namespace shogun
 {
@@ -24,6 +25,7 @@ namespace shogun
 	}
 	class SGLinalg;
 	class Signal;
+	class Tracer;
 
 	class ShogunEnv : public io::FileSystemRegistry, public Parallel, public Version
 	{
@@ -79,6 +81,13 @@ namespace shogun
 		 * @return linalg object
 		 */
 		Signal* signal();
+
+		/** get the global tracer, which collects the time spent in traced
+		 * code sections
+		 *
+		 * @return tracer object
+		 */
+		std::shared_ptr<Tracer> tracer();
 #endif
 
 	private:
@@ -93,6 +102,8 @@ namespace shogun
 		std::unique_ptr<io::SGIO> sg_io;
 		std::unique_ptr<Signal> sg_signal;
 		std::unique_ptr<SGLinalg> sg_linalg;
+		std::shared_ptr<Tracer> sg_tracer;
+		std::once_flag sg_tracer_flag;
 		float64_t sg_fequals_epsilon;
 		bool sg_fequals_tolerant;
 	};
@@ -36,10 +36,18 @@
 #ifndef __SG_PROGRESS_H__
 #define __SG_PROGRESS_H__
 
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
 #include <functional>
 #include <iterator>
 #include <memory>
+#include <mutex>
 #include <string>
+#include <thread>
+#include <vector>
 
 #include <shogun/base/range.h>
 #include <shogun/io/SGIO.h>
@@ -71,8 +79,61 @@ namespace shogun
 		UTF8
 	};
 
+	class ProgressPrinter;
+
+	/**
+	 * @class Background thread that prints all progress bars at a fixed
+	 * rate, so that loops only need to increment a counter. The thread runs
+	 * while there are progress bars to print.
+	 */
+	class ProgressReporter
+	{
+	public:
+		/** @return the reporter shared by all progress bars */
+		static ProgressReporter& instance()
+		{
+			// never destroyed, so that progress bars and the thread can
+			// outlive static destruction
+			static ProgressReporter* reporter = new ProgressReporter();
+			return *reporter;
+		}
+
+		/** Starts printing a progress bar.
+		 * @param printer the progress bar
+		 */
+		void attach(const ProgressPrinter* printer);
+
+		/** Stops printing a progress bar.
+		 * @param printer the progress bar
+		 */
+		void detach(const ProgressPrinter* printer);
+
+	private:
+		ProgressReporter() : m_running(false)
+		{
+		}
+
+		/** Prints the attached progress bars until there are none. */
+		void run();
+
+		/** Time between two prints */
+		static constexpr std::chrono::milliseconds m_interval{100};
+		/** Attached progress bars */
+		std::vector<const ProgressPrinter*> m_printers;
+		/** Lock of m_printers and m_running */
+		std::mutex m_mutex;
+		/** Wakes the thread when progress bars are detached */
+		std::condition_variable m_wake;
+		/** Whether the thread is running */
+		bool m_running;
+	};
+
 	/**
 	 * @class Printer class that displays the progress bar.
+	 *
+	 * Progress is counted with relaxed atomic increments of per-thread
+	 * counters and printed by the @ref ProgressReporter, so that counting
+	 * costs no locks in loops.
 	 */
 	class ProgressPrinter
 	{
@@ -91,39 +152,53 @@ namespace shogun
 		      m_prefix(prefix), m_mode(mode), m_columns_num(0), m_rows_num(0),
 		      m_last_progress(0), m_last_progress_time(0),
 		      m_progress_start_time(Time::get_curtime()),
-		      m_current_value(min_value)
+		      m_base_value(min_value), m_attached(false)
 		{
+			if (env()->io()->get_show_progress() && m_max_value > m_min_value)
+			{
+				m_attached = true;
+				ProgressReporter::instance().attach(this);
+			}
 		}
 		~ProgressPrinter()
 		{
+			finish();
 		}
 
 		/**
-		 * Increment and print the progress bar.
-		 * Everything is locked to prevent race conditions
-		 * or characters overlapping (especially within
-		 * multi threaded environments).
+		 * Increment the progress. This only increments a counter of
+		 * the calling thread, the progress bar is printed by the
+		 * @ref ProgressReporter.
 		 */
-		void print_progress() const
+		SG_FORCED_INLINE void print_progress() const
+		{
+			increment();
+		}
+
+		/**
+		 * Print the progress bar as it is now. Called by the
+		 * @ref ProgressReporter.
+		 */
+		void report() const
 		{
 			lock.lock();
-			if (m_current_value.load() - m_min_value >
-			    m_max_value - m_min_value)
-			{
-				increment();
-				lock.unlock();
-				return;
-			}
 			print_progress_impl();
-			if (m_current_value.load() - m_min_value ==
-			    m_max_value - m_min_value)
-			{
-				print_end();
-				increment();
-				lock.unlock();
+			lock.unlock();
+		}
+
+		/**
+		 * Stop reporting and print the final progress bar, once.
+		 */
+		void finish() const
+		{
+			if (!m_attached.exchange(false))
 				return;
-			}
-			increment();
+
+			ProgressReporter::instance().detach(this);
+			lock.lock();
+			m_last_progress_time = 0;
+			print_progress_impl();
+			print_end();
 			lock.unlock();
 		}
 
@@ -153,14 +228,15 @@ namespace shogun
 		 */
 		void premature_end()
 		{
-			if (m_current_value.load() < m_max_value - 1)
-				m_current_value.store(m_max_value);
+			auto current_value = get_current_value();
+			if (current_value < m_max_value - 1)
+				m_base_value.fetch_add(m_max_value - current_value);
 		}
 
 		/** @return last progress as a percentage. */
 		inline float64_t get_current_progress() const
 		{
-			return m_current_value.load();
+			return get_current_value();
 		}
 
 	private:
@@ -177,6 +253,8 @@ namespace shogun
 			if (m_max_value <= m_min_value)
 				return;
 
+			auto current_value = get_current_value();
+
 			// Check for terminal dimension. This is for provide
 			// a minimal resize functionality.
 			set_screen_size();
@@ -200,8 +278,9 @@ namespace shogun
 			float64_t runtime = Time::get_curtime();
 
 			if (difference > 0.0)
-				v = 100 * (m_current_value.load() - m_min_value) /
-				    (m_max_value - m_min_value);
+				v = 100 *
+				    std::min<float64_t>(current_value - m_min_value, difference) /
+				    difference;
 
 			// Set up chunk size
 			size_chunk = difference / (float64_t)progress_bar_space;
@@ -230,7 +309,7 @@ namespace shogun
 			io::print("{} |", m_prefix.c_str());
 			for (index_t i = 1; i < progress_bar_space; i++)
 			{
-				if (m_current_value.load() - m_min_value > i * size_chunk)
+				if (current_value - m_min_value > i * size_chunk)
 				{
 					io::print("{}", get_pb_char().c_str());
 				}
@@ -268,7 +347,7 @@ namespace shogun
 			if (!env()->io()->get_show_progress())
 				return;
 
-			m_current_value.store(current_val);
+			m_base_value.fetch_add(current_val - get_current_value());
 
 			if (max_value <= min_value)
 				return;
@@ -325,7 +404,7 @@ namespace shogun
 			io::print("{} |", m_prefix.c_str());
 			for (index_t i = 1; i < progress_bar_space; i++)
 			{
-				if (m_current_value.load() - min_value > i * size_chunk)
+				if (get_current_value() - min_value > i * size_chunk)
 				{
 					io::print("{}", get_pb_char().c_str());
 				}
@@ -399,12 +478,41 @@ namespace shogun
 #endif
 		}
 
-		/* Increment the current value (atomically) */
-		void increment() const
+		/** Number of counters threads are spread over */
+		static constexpr int32_t m_num_counters = 16;
+
+		/** @return index of the counter of the calling thread */
+		static int32_t counter_index()
 		{
-			m_current_value++;
+			static std::atomic<int32_t> next_index{0};
+			thread_local int32_t index =
+			    next_index.fetch_add(1, std::memory_order_relaxed) %
+			    m_num_counters;
+			return index;
 		}
 
+		/* Increment the counter of the calling thread (atomically) */
+		SG_FORCED_INLINE void increment() const
+		{
+			m_counters[counter_index()].value.fetch_add(
+			    1, std::memory_order_relaxed);
+		}
+
+		/** @return current value, sum of all counters */
+		int64_t get_current_value() const
+		{
+			auto value = m_base_value.load(std::memory_order_relaxed);
+			for (const auto& counter : m_counters)
+				value += counter.value.load(std::memory_order_relaxed);
+			return value;
+		}
+
+		/** Counter on its own cache line */
+		struct alignas(CPU_CACHE_LINE_SIZE_BYTES) Counter
+		{
+			std::atomic<int64_t> value{0};
+		};
+
 		/** Maxmimum value */
 		float64_t m_max_value;
 		/** Minimum value */
@@ -427,12 +535,49 @@ namespace shogun
 		mutable float64_t m_last_progress_time;
 		/** Progress start time */
 		mutable float64_t m_progress_start_time;
-		/** Current value */
-		mutable std::atomic<int64_t> m_current_value;
-		/** Lock for multithreaded operations **/
+		/** Current value besides the counters */
+		mutable std::atomic<int64_t> m_base_value;
+		/** Increments of the threads */
+		mutable std::array<Counter, m_num_counters> m_counters;
+		/** Whether the progress bar is attached to the reporter */
+		mutable std::atomic<bool> m_attached;
+		/** Lock for printing **/
 		mutable Lock lock;
 	};
 
+	inline void ProgressReporter::attach(const ProgressPrinter* printer)
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		m_printers.push_back(printer);
+		if (!m_running)
+		{
+			m_running = true;
+			std::thread(&ProgressReporter::run, this).detach();
+		}
+	}
+
+	inline void ProgressReporter::detach(const ProgressPrinter* printer)
+	{
+		std::lock_guard<std::mutex> guard(m_mutex);
+		m_printers.erase(
+		    std::remove(m_printers.begin(), m_printers.end(), printer),
+		    m_printers.end());
+		if (m_printers.empty())
+			m_wake.notify_all();
+	}
+
+	inline void ProgressReporter::run()
+	{
+		std::unique_lock<std::mutex> guard(m_mutex);
+		while (!m_printers.empty())
+		{
+			m_wake.wait_for(guard, m_interval);
+			for (auto printer : m_printers)
+				printer->report();
+		}
+		m_running = false;
+	}
+
 	/** @class Helper class to show a progress bar given a range.
 	 *
 	 * @code
@@ -518,10 +663,10 @@ namespace shogun
 				{
 					m_printer->premature_end();
 					m_printer->print_progress();
+					m_printer->finish();
 					return false;
 				}
-				bool result = evaluate_condition();
-				return (this->m_value != other.m_value) && result;
+				return evaluate_condition();
 			}
 
 		private:
@@ -531,12 +676,14 @@ namespace shogun
 			 */
 			bool evaluate_condition()
 			{
-				if (!m_condition())
+				bool result = m_condition();
+				if (!result)
 				{
 					m_printer->premature_end();
 					m_printer->print_progress();
+					m_printer->finish();
 				}
-				return m_condition();
+				return result;
 			}
 
 			/* The wrapped range */
@@ -645,6 +792,7 @@ namespace shogun
 		{
 			m_printer->premature_end();
 			m_printer->print_progress();
+			m_printer->finish();
 		}
 
 		/**
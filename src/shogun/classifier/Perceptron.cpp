@@ -57,6 +57,18 @@ void Perceptron::init_model(std::shared_ptr<Features> data)
 	}
 }
 
+bool Perceptron::init_warm_start(std::shared_ptr<Features> data)
+{
+	if (data)
+	{
+		if (!data->has_property(FP_DOT))
+			error("Specified features are not of type CDotFeatures");
+		set_features(std::static_pointer_cast<DotFeatures>(data));
+	}
+
+	return get_w().vlen == features->get_dim_feature_space();
+}
+
 void Perceptron::iteration()
 {
 	bool converged = true;
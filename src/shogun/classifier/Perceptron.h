@@ -60,6 +60,7 @@ class Perceptron : public IterativeMachine<LinearMachine>
 
 	protected:
 		virtual void init_model(std::shared_ptr<Features> data);
+		virtual bool init_warm_start(std::shared_ptr<Features> data);
 		virtual void iteration();
 
 	protected:
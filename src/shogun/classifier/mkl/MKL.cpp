@@ -10,6 +10,7 @@
 #include <shogun/classifier/mkl/MKL.h>
 #include <shogun/classifier/svm/LibSVM.h>
 #include <shogun/kernel/CombinedKernel.h>
+#include <shogun/kernel/normalizer/IdentityKernelNormalizer.h>
 #include <shogun/lib/Signal.h>
 #include <utility>
 
@@ -742,20 +743,11 @@ float64_t MKL::compute_elasticnet_dual_objective()
 
 		int32_t k=0;
 		auto combined_kernel = std::static_pointer_cast<CombinedKernel>(kernel);
+		auto sums = combined_kernel->compute_subkernel_quadratic_forms(
+		    get_support_vectors(), get_alphas());
 		for (index_t k_idx=0; k_idx<combined_kernel->get_num_kernels(); k_idx++)
 		{
-			auto kn = combined_kernel->get_kernel(k_idx);
-			float64_t sum=0;
-			for (int32_t i=0; i<n; i++)
-			{
-				int32_t ii=get_support_vector(i);
-
-				for (int32_t j=0; j<n; j++)
-				{
-					int32_t jj=get_support_vector(j);
-					sum+=get_alpha(i)*get_alpha(j)*kn->kernel(ii,jj);
-				}
-			}
+			float64_t sum=sums[k_idx];
 			nm[k]= Math::pow(sum, 0.5);
 			del = Math::max(del, nm[k]);
 
@@ -1637,6 +1629,29 @@ void MKL::compute_sum_beta(float64_t* sumw)
 		sumw[i]=0;
 	}
 
+	/* all sub-kernels in one pass, unless the combined kernel normalizes
+	 * the weighted sum */
+	auto combined_kernel = std::dynamic_pointer_cast<CombinedKernel>(kernel);
+	if (combined_kernel && !combined_kernel->get_append_subkernel_weights() &&
+	    std::dynamic_pointer_cast<IdentityKernelNormalizer>(
+	        kernel->get_normalizer()))
+	{
+		SGVector<int32_t> idx(nsv);
+		SGVector<float64_t> alphas(nsv);
+		for (int32_t i=0; i<nsv; i++)
+		{
+			idx[i]=svm->get_support_vector(i);
+			alphas[i]=svm->get_alpha(i);
+		}
+
+		auto sums = combined_kernel->compute_subkernel_quadratic_forms(idx, alphas);
+		for (int32_t n=0; n<num_kernels; n++)
+			sumw[n]=0.5*sums[n];
+
+		mkl_iterations++;
+		return;
+	}
+
 	for (int32_t n=0; n<num_kernels; n++)
 	{
 		beta.vector[n]=1.0;
@@ -1677,20 +1692,11 @@ float64_t MKL::compute_mkl_dual_objective()
 	if (m_labels && kernel && kernel->get_kernel_type() == K_COMBINED)
 	{
 		auto combined_kernel = std::static_pointer_cast<CombinedKernel>(kernel);
+		auto sums = combined_kernel->compute_subkernel_quadratic_forms(
+		    get_support_vectors(), get_alphas());
 		for (index_t k_idx=0; k_idx<combined_kernel->get_num_kernels(); k_idx++)
 		{
-			auto kn = combined_kernel->get_kernel(k_idx);
-			float64_t sum=0;
-			for (int32_t i=0; i<n; i++)
-			{
-				int32_t ii=get_support_vector(i);
-
-				for (int32_t j=0; j<n; j++)
-				{
-					int32_t jj=get_support_vector(j);
-					sum+=get_alpha(i)*get_alpha(j)*kn->kernel(ii,jj);
-				}
-			}
+			float64_t sum=sums[k_idx];
 
 			if (mkl_norm==1.0)
 				mkl_obj = Math::max(mkl_obj, sum);
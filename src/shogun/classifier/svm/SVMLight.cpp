@@ -28,6 +28,7 @@
 #include <shogun/io/SGIO.h>
 #include <shogun/lib/Signal.h>
 #include <shogun/lib/Time.h>
+#include <shogun/lib/Tracer.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/lapack.h>
 
@@ -655,6 +656,7 @@ int32_t SVMLight::optimize_to_convergence(int32_t* docs, int32_t* label, int32_t
   {
 #endif
 	  COMPUTATION_CONTROLLERS
+	  SG_TRACE_SCOPE("svmlight::iteration");
 	  if(use_kernel_cache)
 		  kernel->set_time(iteration);  /* for lru cache */
 
@@ -765,6 +767,7 @@ int32_t SVMLight::optimize_to_convergence(int32_t* docs, int32_t* label, int32_t
 
 	  if (use_kernel_cache)
 	  {
+		  SG_TRACE_SCOPE("svmlight::cache_kernel_rows");
 		  // in case of MKL w/o linadd cache each kernel independently
 		  // else if linadd is disabled cache single kernel
 		  if ( callback &&
@@ -786,14 +789,18 @@ int32_t SVMLight::optimize_to_convergence(int32_t* docs, int32_t* label, int32_t
 	  if(verbosity>=2) t2=get_runtime();
 
 	  if(retrain != 2) {
+		  SG_TRACE_SCOPE("svmlight::optimize_svm");
 		  optimize_svm(docs,label,inconsistent,0.0,chosen,active2dnum,
 					   totdoc,working2dnum,choosenum,a,lin,c,
 					   aicache,&qp,&epsilon_crit_org);
 	  }
 
 	  if(verbosity>=2) t3=get_runtime();
-	  update_linear_component(docs,label,active2dnum,a,a_old,working2dnum,totdoc,
-							  lin,aicache,c);
+	  {
+		  SG_TRACE_SCOPE("svmlight::update_linear_component");
+		  update_linear_component(docs,label,active2dnum,a,a_old,working2dnum,totdoc,
+								  lin,aicache,c);
+	  }
 
 	  if(verbosity>=2) t4=get_runtime();
 	  supvecnum=calculate_svm_model(docs,label,lin,a,a_old,c,working2dnum,active2dnum);
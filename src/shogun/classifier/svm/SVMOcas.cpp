@@ -10,6 +10,7 @@
 #include <shogun/mathematics/Math.h>
 #include <shogun/lib/Time.h>
 #include <shogun/base/Parallel.h>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/machine/LinearMachine.h>
 #include <shogun/features/DotFeatures.h>
 #include <shogun/labels/Labels.h>
@@ -201,23 +202,25 @@ int SVMOcas::add_new_cut(
 	float64_t* new_a = o->tmp_a_buf;
 	memset(new_a, 0, sizeof(float64_t)*nDim);
 
-	for(i=0; i < cut_length; i++)
-	{
-		f->add_to_dense_vec(y[new_cut[i]], new_cut[i], new_a, nDim);
+	f->add_to_dense_vec_subset((int32_t*) new_cut, cut_length, y, new_a, nDim);
 
-		if (o->use_bias)
+	if (o->use_bias)
+	{
+		for(i=0; i < cut_length; i++)
 			c_bias[nSel]+=y[new_cut[i]];
 	}
 
 	/* compute new_a'*new_a and count number of non-zerou dimensions */
 	nz_dims = 0;
-	sq_norm_a = Math::sq(c_bias[nSel]);
+	sq_norm_a = 0;
+#pragma omp parallel for reduction(+:nz_dims,sq_norm_a) num_threads(env()->get_num_threads())
 	for(j=0; j < nDim; j++ ) {
 		if(new_a[j] != 0) {
 			nz_dims++;
 			sq_norm_a += new_a[j]*new_a[j];
 		}
 	}
+	sq_norm_a += Math::sq(c_bias[nSel]);
 
 	/* sparsify new_a and insert it to the last column of sparse_A */
 	c_nzd[nSel] = nz_dims;
@@ -242,13 +245,14 @@ int SVMOcas::add_new_cut(
 
 	new_col_H[nSel] = sq_norm_a;
 
-	for(i=0; i < nSel; i++)
+#pragma omp parallel for schedule(dynamic, 16) num_threads(env()->get_num_threads())
+	for(uint32_t k=0; k < nSel; k++)
 	{
-		float64_t tmp = c_bias[nSel]*c_bias[i];
-		for(j=0; j < c_nzd[i]; j++)
-			tmp += new_a[c_idx[i][j]]*c_val[i][j];
+		float64_t tmp = c_bias[nSel]*c_bias[k];
+		for(uint32_t l=0; l < c_nzd[k]; l++)
+			tmp += new_a[c_idx[k][l]]*c_val[k][l];
 
-		new_col_H[i] = tmp;
+		new_col_H[k] = tmp;
 	}
 	//Math::display_vector(new_col_H, nSel+1, "new_col_H");
 	//Math::display_vector((int32_t*) c_idx[nSel], (int32_t) nz_dims, "c_idx");
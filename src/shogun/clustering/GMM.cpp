@@ -7,6 +7,7 @@
  */
 #include <shogun/lib/config.h>
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/base/progress.h>
 #include <shogun/clustering/GMM.h>
 #include <shogun/clustering/KMeans.h>
@@ -16,6 +17,7 @@
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/NormalDistribution.h>
 #include <shogun/mathematics/RandomNamespace.h>
+#include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/multiclass/KNN.h>
 #include <utility>
@@ -23,6 +25,121 @@
 
 using namespace shogun;
 using namespace std;
+using namespace Eigen;
+
+namespace
+{
+	/** number of vectors processed at once in the E- and M-step */
+	constexpr index_t BLOCK_SIZE = 256;
+
+	/** Covariance of a component factored once per E-step */
+	struct ComponentFactor
+	{
+		ECovType cov_type;
+		VectorXd mean;
+		/** lower Cholesky factor of a full covariance, or its whitening
+		 * matrix if the factorization fails
+		 */
+		MatrixXd factor;
+		bool triangular;
+		/** inverse variances of a diagonal or spherical covariance */
+		VectorXd inv_var;
+		/** log of the coefficient and of the normalization constant */
+		float64_t log_norm;
+	};
+
+	ComponentFactor
+	factorize(const std::shared_ptr<Gaussian>& component, float64_t coef)
+	{
+		ComponentFactor f;
+		f.cov_type = component->get_cov_type();
+		auto mean = component->get_mean();
+		auto d = component->get_d();
+		auto num_dim = mean.vlen;
+		f.mean = Map<VectorXd>(mean.vector, num_dim);
+		f.triangular = false;
+
+		// same constant as Gaussian::init()
+		float64_t log_det = 0;
+		switch (f.cov_type)
+		{
+		case FULL:
+		{
+			auto u = component->get_u();
+			Map<MatrixXd> eigenvectors(u.matrix, num_dim, num_dim);
+			Map<VectorXd> eigenvalues(d.vector, num_dim);
+			LLT<MatrixXd> llt(
+			    eigenvectors * eigenvalues.asDiagonal() *
+			    eigenvectors.transpose());
+			if (llt.info() == Success)
+			{
+				f.factor = llt.matrixL();
+				f.triangular = true;
+			}
+			else
+				f.factor = eigenvalues.cwiseSqrt().cwiseInverse().asDiagonal() *
+				           eigenvectors.transpose();
+			log_det = eigenvalues.array().log().sum();
+			break;
+		}
+		case DIAG:
+			f.inv_var = Map<VectorXd>(d.vector, num_dim).cwiseInverse();
+			log_det = -f.inv_var.array().log().sum();
+			break;
+		case SPHERICAL:
+			f.inv_var = VectorXd::Constant(1, 1.0 / d[0]);
+			log_det = num_dim * std::log(d[0]);
+			break;
+		}
+		f.log_norm =
+		    std::log(coef) - 0.5 * (std::log(2 * M_PI) * num_dim + log_det);
+		return f;
+	}
+
+	/** Copies vectors begin to end - 1 into the columns of block. */
+	void gather(
+	    const std::shared_ptr<DotFeatures>& features, index_t begin,
+	    index_t end, MatrixXd& block)
+	{
+		block.setZero(features->get_dim_feature_space(), end - begin);
+		for (index_t i = begin; i < end; ++i)
+			features->add_to_dense_vec(
+			    1.0, i, block.col(i - begin).data(), block.rows());
+	}
+
+	/** Computes the log joint probabilities of a block of vectors, one row
+	 * per component.
+	 */
+	void log_joint_block(
+	    const std::vector<ComponentFactor>& factors, const MatrixXd& block,
+	    Ref<MatrixXd> log_joint)
+	{
+		for (size_t j = 0; j < factors.size(); ++j)
+		{
+			const auto& f = factors[j];
+			MatrixXd centered = block.colwise() - f.mean;
+			RowVectorXd mahalanobis;
+			switch (f.cov_type)
+			{
+			case FULL:
+				if (f.triangular)
+					f.factor.triangularView<Lower>().solveInPlace(centered);
+				else
+					centered = f.factor * centered;
+				mahalanobis = centered.colwise().squaredNorm();
+				break;
+			case DIAG:
+				mahalanobis = f.inv_var.transpose() * centered.cwiseAbs2();
+				break;
+			case SPHERICAL:
+				mahalanobis = centered.colwise().squaredNorm() * f.inv_var[0];
+				break;
+			}
+			log_joint.row(j) =
+			    (f.log_norm - 0.5 * mahalanobis.array()).matrix();
+		}
+	}
+} // namespace
 
 GMM::GMM() : RandomMixin<Distribution>(), m_components(), m_coefficients()
 {
@@ -146,38 +263,14 @@ float64_t GMM::train_em(float64_t min_cov, int32_t max_iter, float64_t min_chang
 	int32_t iter=0;
 	float64_t log_likelihood_prev=0;
 	float64_t log_likelihood_cur=0;
-	SGVector<float64_t> logPxy(num_vectors * m_components.size());
+	SGMatrix<float64_t> logPxy(int32_t(m_components.size()), num_vectors);
 	SGVector<float64_t> logPx(num_vectors);
-	//float64_t* logPost=SG_MALLOC(float64_t, num_vectors*m_components.vlen);
 	auto pb = SG_PROGRESS(range(max_iter));
 	while (iter<max_iter)
 	{
 		log_likelihood_prev=log_likelihood_cur;
-		log_likelihood_cur=0;
-
-		for (int32_t i=0; i<num_vectors; i++)
-		{
-			logPx[i]=0;
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(i);
-			for (int32_t j=0; j<int32_t(m_components.size()); j++)
-			{
-				logPxy[index_t(i * m_components.size() + j)] =
-				    m_components[j]->compute_log_PDF(v) +
-				    std::log(m_coefficients[j]);
-				logPx[i] +=
-				    std::exp(logPxy[index_t(i * m_components.size() + j)]);
-			}
-
-			logPx[i] = std::log(logPx[i]);
-			log_likelihood_cur+=logPx[i];
-
-			for (int32_t j=0; j<int32_t(m_components.size()); j++)
-			{
-				//logPost[i*m_components.vlen+j]=logPxy[i*m_components.vlen+j]-logPx[i];
-				alpha.matrix[i * m_components.size() + j] = std::exp(
-				    logPxy[index_t(i * m_components.size() + j)] - logPx[i]);
-			}
-		}
+		log_likelihood_cur =
+		    expectation(m_components, m_coefficients, logPxy, logPx, alpha);
 
 		if (iter>0 && log_likelihood_cur-log_likelihood_prev<min_change)
 			break;
@@ -210,7 +303,7 @@ float64_t GMM::train_smem(int32_t max_iter, int32_t max_cand, float64_t min_cov,
 	float64_t cur_likelihood=train_em(min_cov, max_em_iter, min_change);
 
 	int32_t iter=0;
-	SGVector<float64_t> logPxy(num_vectors * m_components.size());
+	SGMatrix<float64_t> logPxy(int32_t(m_components.size()), num_vectors);
 	SGVector<float64_t> logPx(num_vectors);
 	SGVector<float64_t> logPost(num_vectors * m_components.size());
 	SGVector<float64_t> logPostSum(m_components.size());
@@ -227,24 +320,13 @@ float64_t GMM::train_smem(int32_t max_iter, int32_t max_cand, float64_t min_cov,
 	auto pb = SG_PROGRESS(range(max_iter));
 	while (iter<max_iter)
 	{
+		expectation(m_components, m_coefficients, logPxy, logPx);
+
 		linalg::zero(logPostSum);
 		linalg::zero(logPostSum2);
 		linalg::zero(logPostSumSum);
 		for (int32_t i=0; i<num_vectors; i++)
 		{
-			logPx[i]=0;
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(i);
-			for (int32_t j=0; j<int32_t(m_components.size()); j++)
-			{
-				logPxy[index_t(i * m_components.size() + j)] =
-				    m_components[j]->compute_log_PDF(v) +
-				    std::log(m_coefficients[j]);
-				logPx[i] +=
-				    std::exp(logPxy[index_t(i * m_components.size() + j)]);
-			}
-
-			logPx[i] = std::log(logPx[i]);
-
 			for (int32_t j=0; j<int32_t(m_components.size()); j++)
 			{
 				logPost[index_t(i * m_components.size() + j)] =
@@ -354,42 +436,25 @@ void GMM::partial_em(int32_t comp1, int32_t comp2, int32_t comp3, float64_t min_
 	auto dotdata=features->as<DotFeatures>();
 	int32_t num_vectors=dotdata->get_num_vectors();
 
-	SGVector<float64_t> init_logPxy(num_vectors * m_components.size());
+	SGMatrix<float64_t> init_logPxy(int32_t(m_components.size()), num_vectors);
 	SGVector<float64_t> init_logPx(num_vectors);
 	SGVector<float64_t> init_logPx_fix(num_vectors);
 	SGVector<float64_t> post_add(num_vectors);
 
+	expectation(m_components, m_coefficients, init_logPxy, init_logPx);
 	for (int32_t i=0; i<num_vectors; i++)
 	{
-		init_logPx[i]=0;
 		init_logPx_fix[i]=0;
-
-		SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(i);
 		for (int32_t j=0; j<int32_t(m_components.size()); j++)
 		{
-			init_logPxy[index_t(i * m_components.size() + j)] =
-			    m_components[j]->compute_log_PDF(v) +
-			    std::log(m_coefficients[j]);
-			init_logPx[i] +=
-			    std::exp(init_logPxy[index_t(i * m_components.size() + j)]);
 			if (j!=comp1 && j!=comp2 && j!=comp3)
-			{
-				init_logPx_fix[i] +=
-				    std::exp(init_logPxy[index_t(i * m_components.size() + j)]);
-			}
+				init_logPx_fix[i] += std::exp(init_logPxy(j, i));
 		}
 
-		init_logPx[i] = std::log(init_logPx[i]);
 		post_add[i] = std::log(
-		    std::exp(
-		        init_logPxy[index_t(i * m_components.size() + comp1)] -
-		        init_logPx[i]) +
-		    std::exp(
-		        init_logPxy[index_t(i * m_components.size() + comp2)] -
-		        init_logPx[i]) +
-		    std::exp(
-		        init_logPxy[index_t(i * m_components.size() + comp3)] -
-		        init_logPx[i]));
+		    std::exp(init_logPxy(comp1, i) - init_logPx[i]) +
+		    std::exp(init_logPxy(comp2, i) - init_logPx[i]) +
+		    std::exp(init_logPxy(comp3, i) - init_logPx[i]));
 	}
 
 	vector<shared_ptr<Gaussian>> components(3);
@@ -498,34 +563,24 @@ void GMM::partial_em(int32_t comp1, int32_t comp2, int32_t comp3, float64_t min_
 	float64_t log_likelihood_cur=0;
 	int32_t iter=0;
 	SGMatrix<float64_t> alpha(num_vectors, 3);
-	SGVector<float64_t> logPxy(num_vectors * 3);
+	SGMatrix<float64_t> logPxy(3, num_vectors);
 	SGVector<float64_t> logPx(num_vectors);
-	//float64_t* logPost=SG_MALLOC(float64_t, num_vectors*m_components.vlen);
 
 	while (iter<max_em_iter)
 	{
 		log_likelihood_prev=log_likelihood_cur;
 		log_likelihood_cur=0;
 
+		expectation(components, coefficients, logPxy, logPx);
 		for (int32_t i=0; i<num_vectors; i++)
 		{
-			logPx[i]=0;
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(i);
-			for (int32_t j=0; j<3; j++)
-			{
-				logPxy[i * 3 + j] = components[j]->compute_log_PDF(v) +
-				                    std::log(coefficients[j]);
-				logPx[i] += std::exp(logPxy[i * 3 + j]);
-			}
-
-			logPx[i] = std::log(logPx[i] + init_logPx_fix[i]);
+			logPx[i] = std::log(std::exp(logPx[i]) + init_logPx_fix[i]);
 			log_likelihood_cur+=logPx[i];
 
 			for (int32_t j=0; j<3; j++)
 			{
-				//logPost[i*m_components.vlen+j]=logPxy[i*m_components.vlen+j]-logPx[i];
 				alpha.matrix[i * 3 + j] =
-				    std::exp(logPxy[i * 3 + j] - logPx[i] + post_add[i]);
+				    std::exp(logPxy(j, i) - logPx[i] + post_add[i]);
 			}
 		}
 
@@ -546,126 +601,208 @@ void GMM::partial_em(int32_t comp1, int32_t comp2, int32_t comp3, float64_t min_
 	partial_candidate.reset();
 }
 
-void GMM::max_likelihood(SGMatrix<float64_t> alpha, float64_t min_cov)
+float64_t GMM::expectation(
+    const std::vector<std::shared_ptr<Gaussian>>& components,
+    const SGVector<float64_t>& coefficients, SGMatrix<float64_t>& log_joint,
+    SGVector<float64_t>& log_px, SGMatrix<float64_t> alpha) const
 {
-	auto dotdata=features->as<DotFeatures>();
-	int32_t num_dim=dotdata->get_dim_feature_space();
-
-	float64_t alpha_sum;
-	float64_t alpha_sum_sum=0;
-
-	for (int32_t i=0; i<alpha.num_cols; i++)
+	auto dotdata = features->as<DotFeatures>();
+	index_t num_vectors = dotdata->get_num_vectors();
+	index_t num_components = components.size();
+
+	std::vector<ComponentFactor> factors;
+	for (auto j : range(num_components))
+		factors.push_back(factorize(components[j], coefficients[j]));
+
+	if (log_joint.num_rows != num_components ||
+	    log_joint.num_cols != num_vectors)
+		log_joint = SGMatrix<float64_t>(num_components, num_vectors);
+	if (log_px.vlen != num_vectors)
+		log_px = SGVector<float64_t>(num_vectors);
+	if (alpha.matrix)
+		ASSERT(int64_t(alpha.num_rows) * alpha.num_cols ==
+		       int64_t(num_vectors) * num_components)
+
+	Map<MatrixXd> log_pxy(log_joint.matrix, num_components, num_vectors);
+	int64_t num_blocks = (num_vectors + BLOCK_SIZE - 1) / BLOCK_SIZE;
+#pragma omp parallel for num_threads(env()->get_num_threads())
+	for (int64_t b = 0; b < num_blocks; ++b)
 	{
-		alpha_sum=0;
-		SGVector<float64_t> mean_sum(num_dim);
-		linalg::zero(mean_sum);
-
-		for (int32_t j=0; j<alpha.num_rows; j++)
+		index_t begin = b * BLOCK_SIZE;
+		index_t end = std::min(begin + BLOCK_SIZE, num_vectors);
+		MatrixXd block;
+		gather(dotdata, begin, end, block);
+		log_joint_block(factors, block, log_pxy.middleCols(begin, end - begin));
+
+		// log-sum-exp over the components
+		for (index_t i = begin; i < end; ++i)
 		{
-			alpha_sum+=alpha.matrix[j*alpha.num_cols+i];
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(j);
-			linalg::add(
-			    v, mean_sum, mean_sum, alpha.matrix[j * alpha.num_cols + i],
-			    1.0);
+			float64_t peak = log_pxy.col(i).maxCoeff();
+			log_px[i] = std::isinf(peak)
+			                ? peak
+			                : peak + std::log(
+			                             (log_pxy.col(i).array() - peak)
+			                                 .exp()
+			                                 .sum());
+			if (alpha.matrix)
+				Map<VectorXd>(
+				    alpha.matrix + int64_t(i) * num_components,
+				    num_components) =
+				    (log_pxy.col(i).array() - log_px[i]).exp();
 		}
+	}
 
-		linalg::scale(mean_sum, mean_sum, 1.0 / alpha_sum);
-
-		m_components[i]->set_mean(mean_sum);
-
-		SGMatrix<float64_t> cov_sum;
+	return Map<VectorXd>(log_px.vector, num_vectors).sum();
+}
 
-		ECovType cov_type = m_components[i]->get_cov_type();
-		if (cov_type==FULL)
-		{
-			cov_sum = SGMatrix<float64_t>(num_dim, num_dim);
-			linalg::zero(cov_sum);
-		}
-		else if(cov_type==DIAG)
+void GMM::max_likelihood(SGMatrix<float64_t> alpha, float64_t min_cov)
+{
+	auto dotdata=features->as<DotFeatures>();
+	int32_t num_dim=dotdata->get_dim_feature_space();
+	index_t num_vectors = alpha.num_rows;
+	index_t num_components = alpha.num_cols;
+
+	// one column of assignments per vector
+	Map<MatrixXd> resp(alpha.matrix, num_components, num_vectors);
+
+	// partial t reduces blocks t, t + num_partial, ... into its own
+	// statistics, which are summed in order afterwards
+	int64_t num_blocks = (num_vectors + BLOCK_SIZE - 1) / BLOCK_SIZE;
+	int64_t num_partial =
+	    std::max<int64_t>(std::min<int64_t>(env()->get_num_threads(), num_blocks), 1);
+	auto reduce_blocks = [&](auto&& add_block) {
+#pragma omp parallel for num_threads(num_partial)
+		for (int64_t t = 0; t < num_partial; ++t)
 		{
-			cov_sum = SGMatrix<float64_t>(1, num_dim);
-			linalg::zero(cov_sum);
+			MatrixXd block;
+			for (int64_t b = t; b < num_blocks; b += num_partial)
+			{
+				index_t begin = b * BLOCK_SIZE;
+				index_t end = std::min(begin + BLOCK_SIZE, num_vectors);
+				gather(dotdata, begin, end, block);
+				add_block(
+				    t, block, resp.middleCols(begin, end - begin));
+			}
 		}
-		else if(cov_type==SPHERICAL)
+	};
+
+	std::vector<VectorXd> alpha_sums(num_partial, VectorXd::Zero(num_components));
+	std::vector<MatrixXd> mean_sums(
+	    num_partial, MatrixXd::Zero(num_dim, num_components));
+	reduce_blocks([&](int64_t t, const MatrixXd& block, const auto& weights) {
+		alpha_sums[t] += weights.rowwise().sum();
+		mean_sums[t].noalias() += block * weights.transpose();
+	});
+	for (int64_t t = 1; t < num_partial; ++t)
+	{
+		alpha_sums[0] += alpha_sums[t];
+		mean_sums[0] += mean_sums[t];
+	}
+	const VectorXd& alpha_sum = alpha_sums[0];
+	MatrixXd means = mean_sums[0] * alpha_sum.cwiseInverse().asDiagonal();
+
+	// weighted scatter around the new means, a full matrix, its diagonal or
+	// its trace depending on the covariance type
+	std::vector<std::vector<MatrixXd>> cov_sums(num_partial);
+	for (auto& cov_sum : cov_sums)
+	{
+		for (auto i : range(num_components))
 		{
-			cov_sum = SGMatrix<float64_t>(1, 1);
-			linalg::zero(cov_sum);
+			switch (m_components[i]->get_cov_type())
+			{
+			case FULL:
+				cov_sum.push_back(MatrixXd::Zero(num_dim, num_dim));
+				break;
+			case DIAG:
+				cov_sum.push_back(MatrixXd::Zero(num_dim, 1));
+				break;
+			case SPHERICAL:
+				cov_sum.push_back(MatrixXd::Zero(1, 1));
+				break;
+			}
 		}
-
-		for (int32_t j=0; j<alpha.num_rows; j++)
+	}
+	reduce_blocks([&](int64_t t, const MatrixXd& block, const auto& weights) {
+		for (auto i : range(num_components))
 		{
-			SGVector<float64_t> v=dotdata->get_computed_dot_feature_vector(j);
-
-			linalg::add(v, mean_sum, v, 1.0, -1.0);
-			switch (cov_type)
+			MatrixXd centered = block.colwise() - means.col(i);
+			auto& cov_sum = cov_sums[t][i];
+			switch (m_components[i]->get_cov_type())
 			{
-				case FULL:
-				    linalg::rank_update(
-				        cov_sum, v, alpha.matrix[j * alpha.num_cols + i]);
-				    break;
-			    case DIAG:
-			    {
-				    auto temp_matrix = SGMatrix<float64_t>(v.vector, 1, v.vlen);
-				    auto temp_result = linalg::matrix_prod(
-				        temp_matrix, temp_matrix, true, false);
-				    cov_sum = temp_result.get_diagonal_vector().clone();
-				    linalg::scale(
-				        cov_sum, cov_sum, alpha.matrix[j * alpha.num_cols + i]);
-			    }
-
-			    break;
-			    case SPHERICAL:
-				    float64_t temp = 0;
-
-				    temp = linalg::dot(v, v);
-
-				    cov_sum(0, 0) +=
-				        temp * alpha.matrix[j * alpha.num_cols + i];
-				    break;
+			case FULL:
+				cov_sum.noalias() += centered *
+				                     weights.row(i).asDiagonal() *
+				                     centered.transpose();
+				break;
+			case DIAG:
+				cov_sum.noalias() +=
+				    centered.cwiseAbs2() * weights.row(i).transpose();
+				break;
+			case SPHERICAL:
+				cov_sum(0, 0) +=
+				    centered.colwise().squaredNorm().dot(weights.row(i));
+				break;
 			}
 		}
+	});
+	for (int64_t t = 1; t < num_partial; ++t)
+	{
+		for (auto i : range(num_components))
+			cov_sums[0][i] += cov_sums[t][i];
+	}
+
+	for (auto i : range(num_components))
+	{
+		SGVector<float64_t> mean(num_dim);
+		Map<VectorXd>(mean.vector, num_dim) = means.col(i);
+		m_components[i]->set_mean(mean);
 
-		switch (cov_type)
+		const auto& cov_sum = cov_sums[0][i];
+		switch (m_components[i]->get_cov_type())
 		{
 			case FULL:
-		    {
-			    linalg::scale(cov_sum, cov_sum, 1.0 / alpha_sum);
+			{
+				SGMatrix<float64_t> cov(num_dim, num_dim);
+				Map<MatrixXd>(cov.matrix, num_dim, num_dim) =
+				    cov_sum / alpha_sum[i];
 
-			    SGVector<float64_t> d0(num_dim);
-			    linalg::eigen_solver_symmetric(cov_sum, d0, cov_sum);
+				SGVector<float64_t> d0(num_dim);
+				linalg::eigen_solver_symmetric(cov, d0, cov);
 
-			    for (auto& v: d0)
-				    v = Math::max(min_cov, v);
+				for (auto& v: d0)
+					v = Math::max(min_cov, v);
 
-			    m_components[i]->set_d(d0);
-			    m_components[i]->set_u(cov_sum);
+				m_components[i]->set_d(d0);
+				m_components[i]->set_u(cov);
 
-			    break;
-		    }
-		    case DIAG:
-			    for (int32_t j = 0; j < num_dim; j++)
-			    {
-				    cov_sum(0, j) /= alpha_sum;
-				    cov_sum(0, j) = Math::max(min_cov, cov_sum(0, j));
-			    }
+				break;
+			}
+			case DIAG:
+			{
+				SGVector<float64_t> d0(num_dim);
+				for (int32_t j = 0; j < num_dim; j++)
+					d0[j] = Math::max(min_cov, cov_sum(j, 0) / alpha_sum[i]);
 
-			    m_components[i]->set_d(cov_sum.get_row_vector(0));
+				m_components[i]->set_d(d0);
 
-			    break;
-		    case SPHERICAL:
-			    cov_sum[0] /= alpha_sum * num_dim;
-			    cov_sum[0] = Math::max(min_cov, cov_sum[0]);
+				break;
+			}
+			case SPHERICAL:
+			{
+				SGVector<float64_t> d0(1);
+				d0[0] = Math::max(
+				    min_cov, cov_sum(0, 0) / (alpha_sum[i] * num_dim));
 
-			    m_components[i]->set_d(cov_sum.get_row_vector(0));
+				m_components[i]->set_d(d0);
 
-			    break;
+				break;
+			}
 		}
 
-		m_coefficients.vector[i]=alpha_sum;
-		alpha_sum_sum+=alpha_sum;
+		m_coefficients.vector[i] = alpha_sum[i];
 	}
 
-	linalg::scale(m_coefficients, m_coefficients, 1.0 / alpha_sum_sum);
+	linalg::scale(m_coefficients, m_coefficients, 1.0 / alpha_sum.sum());
 }
 
 int32_t GMM::get_num_model_parameters()
@@ -698,8 +835,22 @@ float64_t GMM::get_log_derivative(int32_t num_param, int32_t num_example)
 
 float64_t GMM::get_log_likelihood_example(int32_t num_example)
 {
-	not_implemented(SOURCE_LOCATION);
-	return 1;
+	ASSERT(features);
+
+	auto point =
+	    features->as<DotFeatures>()->get_computed_dot_feature_vector(
+	        num_example);
+	return cluster(point)[m_components.size()];
+}
+
+SGVector<float64_t> GMM::get_log_likelihood()
+{
+	ASSERT(features);
+
+	SGMatrix<float64_t> log_joint;
+	SGVector<float64_t> log_px;
+	expectation(m_components, m_coefficients, log_joint, log_px);
+	return log_px;
 }
 
 float64_t GMM::get_likelihood_example(int32_t num_example)
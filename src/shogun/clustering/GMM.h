@@ -135,6 +135,13 @@ class GMM : public RandomMixin<Distribution>
 		 */
 		virtual float64_t get_log_likelihood_example(int32_t num_example);
 
+		/** compute log likelihood for all examples, in parallel blocks of
+		 * examples
+		 *
+		 * @return log likelihood of every example
+		 */
+		virtual SGVector<float64_t> get_log_likelihood();
+
 		/** compute likelihood for example
 		 *
 		 * abstract base method
@@ -238,6 +245,25 @@ class GMM : public RandomMixin<Distribution>
 		void partial_em(int32_t comp1, int32_t comp2, int32_t comp3,
 				float64_t min_cov, int32_t max_em_iter, float64_t min_change);
 
+		/** E-step: computes the log joint probability of every training
+		 * vector and component, in parallel blocks of vectors against the
+		 * Cholesky factors of the component covariances
+		 *
+		 * @param components mixture components
+		 * @param coefficients mixture coefficients
+		 * @param log_joint filled with the log joint probabilities, one
+		 * column per vector and one row per component
+		 * @param log_px filled with the log likelihood of every vector
+		 * @param alpha if not empty, filled with the point assignment in the
+		 * layout of max_likelihood()
+		 * @return log likelihood of the training data
+		 */
+		float64_t expectation(
+				const std::vector<std::shared_ptr<Gaussian>>& components,
+				const SGVector<float64_t>& coefficients,
+				SGMatrix<float64_t>& log_joint, SGVector<float64_t>& log_px,
+				SGMatrix<float64_t> alpha=SGMatrix<float64_t>()) const;
+
 	protected:
 		/** Mixture components */
 		std::vector<std::shared_ptr<Gaussian>> m_components;
@@ -22,6 +22,7 @@
 #include <shogun/features/Features.h>
 
 #include <string.h>
+#include <type_traits>
 #ifndef _WIN32
 #include <unistd.h>
 #endif
@@ -283,6 +284,20 @@ SGMatrix<T> Distance::get_distance_matrix()
 
 	SG_DEBUG("returning distance matrix of size {}x{}", m, n)
 
+	SGMatrix<float64_t> full=compute_distance_matrix();
+	if (full.matrix)
+	{
+		if constexpr (std::is_same<T, float64_t>::value)
+			return full;
+		else
+		{
+			SGMatrix<T> converted(m, n);
+			for (int64_t i=0; i<total_num; i++)
+				converted.matrix[i]=(T) full.matrix[i];
+			return converted;
+		}
+	}
+
 	result=SG_MALLOC(T, total_num);
 
 	PRange<int64_t> pb = PRange<int64_t>(
@@ -369,6 +369,18 @@ class Distance : public SGObject
 		/// matrix precomputation
 		void do_precompute_matrix();
 
+		/** compute the whole distance matrix at once, distances that can
+		 * do this faster than pair by pair override this, called by
+		 * get_distance_matrix() after init()
+		 *
+		 * @return distance matrix of size num_lhs x num_rhs, or an empty
+		 * matrix to compute it pair by pair
+		 */
+		virtual SGMatrix<float64_t> compute_distance_matrix()
+		{
+			return SGMatrix<float64_t>();
+		}
+
 		/**
 		 * Checks the compatibility between two supplied features
 		 *
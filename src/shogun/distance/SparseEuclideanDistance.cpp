@@ -4,6 +4,7 @@
  * Authors: Chiyuan Zhang
  */
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/lib/common.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/distance/SparseEuclideanDistance.h>
@@ -70,6 +71,25 @@ float64_t SparseEuclideanDistance::compute(int32_t idx_a, int32_t idx_b)
 	return std::sqrt(result);
 }
 
+SGMatrix<float64_t> SparseEuclideanDistance::compute_distance_matrix()
+{
+	SGMatrix<float64_t> result=
+		(std::static_pointer_cast<SparseFeatures<float64_t>>(lhs))->sparse_dot_matrix(
+		std::static_pointer_cast<SparseFeatures<float64_t>>(rhs));
+
+#pragma omp parallel for num_threads(env()->get_num_threads())
+	for (int32_t j=0; j<result.num_cols; j++)
+	{
+		for (int32_t i=0; i<result.num_rows; i++)
+		{
+			float64_t sq=sq_lhs[i]+sq_rhs[j]-2*result(i, j);
+			result(i, j)=std::sqrt(Math::abs(sq));
+		}
+	}
+
+	return result;
+}
+
 void SparseEuclideanDistance::init()
 {
 	sq_lhs=NULL;
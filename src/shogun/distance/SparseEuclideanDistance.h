@@ -68,6 +68,10 @@ class SparseEuclideanDistance: public SparseDistance<float64_t>
 		virtual float64_t compute(int32_t idx_a, int32_t idx_b);
 		/*    compute_kernel*/
 
+		/// compute all distances from one sparse matrix product of
+		/// lhs and rhs and the squared norms
+		virtual SGMatrix<float64_t> compute_distance_matrix();
+
 	private:
 		void init();
 
@@ -0,0 +1,340 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#include <shogun/evaluation/BinaryClassAccumulator.h>
+#include <shogun/mathematics/Math.h>
+
+#include <algorithm>
+#include <numeric>
+#include <vector>
+
+using namespace shogun;
+
+BinaryClassAccumulator::BinaryClassAccumulator() : SGObject()
+{
+	init();
+}
+
+BinaryClassAccumulator::BinaryClassAccumulator(
+    float64_t min_score, float64_t max_score, int32_t num_bins)
+    : SGObject()
+{
+	init();
+	require(num_bins > 0, "Number of bins ({}) must be positive.", num_bins);
+	require(
+	    min_score < max_score,
+	    "Lower end of the score range ({}) must be smaller than the upper "
+	    "end ({}).",
+	    min_score, max_score);
+
+	m_min_score = min_score;
+	m_max_score = max_score;
+	m_num_bins = num_bins;
+	reset();
+}
+
+BinaryClassAccumulator::~BinaryClassAccumulator()
+{
+}
+
+void BinaryClassAccumulator::init()
+{
+	m_min_score = 0;
+	m_max_score = 0;
+	m_num_bins = 0;
+
+	SG_ADD(&m_min_score, "min_score", "Lower end of the score range");
+	SG_ADD(&m_max_score, "max_score", "Upper end of the score range");
+	SG_ADD(&m_num_bins, "num_bins", "Number of bins, 0 in exact mode");
+	SG_ADD(&m_scores, "scores", "Distinct scores or lower ends of bins");
+	SG_ADD(&m_positives, "positives", "Positive examples of every score");
+	SG_ADD(&m_negatives, "negatives", "Negative examples of every score");
+}
+
+void BinaryClassAccumulator::reset()
+{
+	if (!is_binned())
+	{
+		m_scores = SGVector<float64_t>();
+		m_positives = SGVector<int64_t>();
+		m_negatives = SGVector<int64_t>();
+		return;
+	}
+
+	auto width = (m_max_score - m_min_score) / m_num_bins;
+	m_scores = SGVector<float64_t>(m_num_bins);
+	for (index_t i = 0; i < m_num_bins; ++i)
+		m_scores[i] = m_min_score + (m_num_bins - 1 - i) * width;
+	m_positives = SGVector<int64_t>(m_num_bins);
+	m_negatives = SGVector<int64_t>(m_num_bins);
+	m_positives.zero();
+	m_negatives.zero();
+}
+
+index_t BinaryClassAccumulator::bin(float64_t score) const
+{
+	auto b = std::floor(
+	    (score - m_min_score) / (m_max_score - m_min_score) * m_num_bins);
+	/* clamped before the cast, scores far out of range overflow index_t */
+	return m_num_bins - 1 -
+	       (index_t)Math::clamp<float64_t>(b, 0, m_num_bins - 1);
+}
+
+namespace
+{
+	/** merges two lists of scores in decreasing order with their counts */
+	void merge_sorted(
+	    const SGVector<float64_t>& scores_a, const SGVector<int64_t>& pos_a,
+	    const SGVector<int64_t>& neg_a, const SGVector<float64_t>& scores_b,
+	    const SGVector<int64_t>& pos_b, const SGVector<int64_t>& neg_b,
+	    SGVector<float64_t>& scores, SGVector<int64_t>& pos,
+	    SGVector<int64_t>& neg)
+	{
+		std::vector<float64_t> merged_scores;
+		std::vector<int64_t> merged_pos, merged_neg;
+		merged_scores.reserve(scores_a.vlen + scores_b.vlen);
+		merged_pos.reserve(scores_a.vlen + scores_b.vlen);
+		merged_neg.reserve(scores_a.vlen + scores_b.vlen);
+
+		index_t i = 0, j = 0;
+		while (i < scores_a.vlen || j < scores_b.vlen)
+		{
+			if (j == scores_b.vlen ||
+			    (i < scores_a.vlen && scores_a[i] > scores_b[j]))
+			{
+				merged_scores.push_back(scores_a[i]);
+				merged_pos.push_back(pos_a[i]);
+				merged_neg.push_back(neg_a[i]);
+				i++;
+			}
+			else if (
+			    i == scores_a.vlen || scores_b[j] > scores_a[i])
+			{
+				merged_scores.push_back(scores_b[j]);
+				merged_pos.push_back(pos_b[j]);
+				merged_neg.push_back(neg_b[j]);
+				j++;
+			}
+			else
+			{
+				merged_scores.push_back(scores_a[i]);
+				merged_pos.push_back(pos_a[i] + pos_b[j]);
+				merged_neg.push_back(neg_a[i] + neg_b[j]);
+				i++;
+				j++;
+			}
+		}
+
+		scores = SGVector<float64_t>(merged_scores.begin(), merged_scores.end());
+		pos = SGVector<int64_t>(merged_pos.begin(), merged_pos.end());
+		neg = SGVector<int64_t>(merged_neg.begin(), merged_neg.end());
+	}
+} // namespace
+
+void BinaryClassAccumulator::update(
+    const SGVector<float64_t>& scores, const SGVector<float64_t>& labels)
+{
+	require(
+	    scores.vlen == labels.vlen,
+	    "Number of scores ({}) must be equal to the number of labels ({}).",
+	    scores.vlen, labels.vlen);
+
+	if (is_binned())
+	{
+		for (index_t i = 0; i < scores.vlen; ++i)
+		{
+			require(
+			    !std::isnan(scores[i]), "Score {} is not a number.", i);
+			if (labels[i] > 0)
+				m_positives[bin(scores[i])]++;
+			else
+				m_negatives[bin(scores[i])]++;
+		}
+		return;
+	}
+
+	std::vector<index_t> idxs(scores.vlen);
+	std::iota(idxs.begin(), idxs.end(), 0);
+	std::sort(idxs.begin(), idxs.end(), [&scores](index_t a, index_t b) {
+		return scores[a] > scores[b];
+	});
+
+	std::vector<float64_t> chunk_scores;
+	std::vector<int64_t> chunk_pos, chunk_neg;
+	for (auto i : idxs)
+	{
+		require(!std::isnan(scores[i]), "Score {} is not a number.", i);
+		if (chunk_scores.empty() || chunk_scores.back() != scores[i])
+		{
+			chunk_scores.push_back(scores[i]);
+			chunk_pos.push_back(0);
+			chunk_neg.push_back(0);
+		}
+		if (labels[i] > 0)
+			chunk_pos.back()++;
+		else
+			chunk_neg.back()++;
+	}
+
+	merge_sorted(
+	    m_scores, m_positives, m_negatives,
+	    SGVector<float64_t>(chunk_scores.begin(), chunk_scores.end()),
+	    SGVector<int64_t>(chunk_pos.begin(), chunk_pos.end()),
+	    SGVector<int64_t>(chunk_neg.begin(), chunk_neg.end()), m_scores,
+	    m_positives, m_negatives);
+}
+
+void BinaryClassAccumulator::update(
+    const std::shared_ptr<BinaryLabels>& predicted,
+    const std::shared_ptr<BinaryLabels>& ground_truth)
+{
+	require(predicted, "No predicted labels provided.");
+	require(ground_truth, "No ground truth labels provided.");
+	require(
+	    predicted->get_num_labels() == ground_truth->get_num_labels(),
+	    "Number of predicted labels ({}) must be equal to the number of "
+	    "ground truth labels ({}).",
+	    predicted->get_num_labels(), ground_truth->get_num_labels());
+	ground_truth->ensure_valid();
+
+	update(predicted->get_values(), ground_truth->get_labels());
+}
+
+void BinaryClassAccumulator::merge(
+    const std::shared_ptr<BinaryClassAccumulator>& other)
+{
+	require(other, "No accumulator provided.");
+	require(
+	    is_binned() == other->is_binned(),
+	    "Cannot merge accumulators of exact and binned mode.");
+
+	if (is_binned())
+	{
+		require(
+		    m_num_bins == other->m_num_bins &&
+		        m_min_score == other->m_min_score &&
+		        m_max_score == other->m_max_score,
+		    "Cannot merge accumulators of different bins.");
+		for (index_t i = 0; i < m_num_bins; ++i)
+		{
+			m_positives[i] += other->m_positives[i];
+			m_negatives[i] += other->m_negatives[i];
+		}
+		return;
+	}
+
+	merge_sorted(
+	    m_scores, m_positives, m_negatives, other->m_scores,
+	    other->m_positives, other->m_negatives, m_scores, m_positives,
+	    m_negatives);
+}
+
+int64_t BinaryClassAccumulator::get_num_positives() const
+{
+	return std::accumulate(
+	    m_positives.begin(), m_positives.end(), (int64_t)0);
+}
+
+int64_t BinaryClassAccumulator::get_num_negatives() const
+{
+	return std::accumulate(
+	    m_negatives.begin(), m_negatives.end(), (int64_t)0);
+}
+
+void BinaryClassAccumulator::require_both_classes() const
+{
+	require(
+	    get_num_positives() > 0,
+	    "{}: Number of positive labels is zero, curves fail!", get_name());
+	require(
+	    get_num_negatives() > 0,
+	    "{}: Number of negative labels is zero, curves fail!", get_name());
+}
+
+SGMatrix<float64_t> BinaryClassAccumulator::get_ROC() const
+{
+	require_both_classes();
+	float64_t pos_count = get_num_positives();
+	float64_t neg_count = get_num_negatives();
+
+	std::vector<float64_t> graph{0.0, 0.0};
+	float64_t tp = 0, fp = 0;
+	for (index_t i = 0; i < m_scores.vlen; ++i)
+	{
+		if (!m_positives[i] && !m_negatives[i])
+			continue;
+
+		tp += m_positives[i];
+		fp += m_negatives[i];
+		graph.push_back(fp / neg_count);
+		graph.push_back(tp / pos_count);
+	}
+
+	SGMatrix<float64_t> roc(2, graph.size() / 2);
+	std::copy(graph.begin(), graph.end(), roc.matrix);
+	return roc;
+}
+
+float64_t BinaryClassAccumulator::get_auROC() const
+{
+	auto roc = get_ROC();
+	return Math::area_under_curve(roc.matrix, roc.num_cols, false);
+}
+
+float64_t BinaryClassAccumulator::get_auROC_error_bound() const
+{
+	if (!is_binned())
+		return 0.0;
+
+	require_both_classes();
+	/* pairs of a positive and a negative example in the same bin count half
+	 * instead of zero or one */
+	float64_t tied = 0;
+	for (index_t i = 0; i < m_num_bins; ++i)
+		tied += float64_t(m_positives[i]) * m_negatives[i];
+
+	return 0.5 * tied /
+	       (float64_t(get_num_positives()) * get_num_negatives());
+}
+
+SGMatrix<float64_t> BinaryClassAccumulator::get_PRC() const
+{
+	require_both_classes();
+	float64_t pos_count = get_num_positives();
+
+	std::vector<float64_t> graph;
+	float64_t tp = 0, count = 0;
+	for (index_t i = 0; i < m_scores.vlen; ++i)
+	{
+		if (!m_positives[i] && !m_negatives[i])
+			continue;
+
+		tp += m_positives[i];
+		count += m_positives[i] + m_negatives[i];
+		graph.push_back(tp / count);
+		graph.push_back(tp / pos_count);
+	}
+
+	SGMatrix<float64_t> prc(2, graph.size() / 2);
+	std::copy(graph.begin(), graph.end(), prc.matrix);
+	return prc;
+}
+
+float64_t BinaryClassAccumulator::get_auPRC() const
+{
+	auto prc = get_PRC();
+	return Math::area_under_curve(prc.matrix, prc.num_cols, true);
+}
+
+SGVector<float64_t> BinaryClassAccumulator::get_thresholds() const
+{
+	std::vector<float64_t> thresholds;
+	for (index_t i = 0; i < m_scores.vlen; ++i)
+	{
+		if (m_positives[i] || m_negatives[i])
+			thresholds.push_back(m_scores[i]);
+	}
+	return SGVector<float64_t>(thresholds.begin(), thresholds.end());
+}
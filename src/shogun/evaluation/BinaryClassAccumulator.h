@@ -0,0 +1,154 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#ifndef BINARYCLASSACCUMULATOR_H_
+#define BINARYCLASSACCUMULATOR_H_
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/SGObject.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+
+namespace shogun
+{
+
+/** @brief Accumulates scores and labels of binary predictions chunk by
+ * chunk to compute the ROC and PRC curves and the areas under them, without
+ * keeping the predictions in memory.
+ *
+ * The accumulator stores the number of positive and negative examples per
+ * score. In exact mode every distinct score is kept, and the curves are the
+ * ones of ROCEvaluation and, for distinct scores, PRCEvaluation. In binned
+ * mode scores are counted in a fixed number of equally wide bins over a
+ * given range, scores outside the range in the first or last bin. Memory
+ * is then bounded by the number of bins and the auROC is off by at most
+ * get_auROC_error_bound().
+ *
+ * Chunks can be accumulated in parallel by giving every thread its own
+ * accumulator and merging them afterwards.
+ */
+class BinaryClassAccumulator : public SGObject
+{
+public:
+	/** constructor, exact mode */
+	BinaryClassAccumulator();
+
+	/** constructor, binned mode
+	 *
+	 * @param min_score lower end of the score range
+	 * @param max_score upper end of the score range
+	 * @param num_bins number of bins
+	 */
+	BinaryClassAccumulator(
+	    float64_t min_score, float64_t max_score, int32_t num_bins);
+
+	/** destructor */
+	virtual ~BinaryClassAccumulator();
+
+	/** Adds a chunk of predictions.
+	 *
+	 * @param scores predicted scores
+	 * @param labels ground truth labels, positive if greater than zero
+	 */
+	void update(
+	    const SGVector<float64_t>& scores, const SGVector<float64_t>& labels);
+
+	/** Adds a chunk of predictions.
+	 *
+	 * @param predicted predicted labels with values
+	 * @param ground_truth labels assumed to be correct
+	 */
+	void update(
+	    const std::shared_ptr<BinaryLabels>& predicted,
+	    const std::shared_ptr<BinaryLabels>& ground_truth);
+
+	/** Adds the predictions of another accumulator of the same mode, and of
+	 * the same bins in binned mode.
+	 *
+	 * @param other accumulator to merge
+	 */
+	void merge(const std::shared_ptr<BinaryClassAccumulator>& other);
+
+	/** Removes all predictions. */
+	void reset();
+
+	/** @return whether scores are binned */
+	bool is_binned() const
+	{
+		return m_num_bins > 0;
+	}
+
+	/** @return number of positive examples */
+	int64_t get_num_positives() const;
+
+	/** @return number of negative examples */
+	int64_t get_num_negatives() const;
+
+	/** @return area under the ROC curve */
+	float64_t get_auROC() const;
+
+	/** @return upper bound of the difference between get_auROC() and the
+	 * auROC of the exact scores, 0 in exact mode
+	 */
+	float64_t get_auROC_error_bound() const;
+
+	/** @return ROC curve, with false positive rate in row 0 and true
+	 * positive rate in row 1
+	 */
+	SGMatrix<float64_t> get_ROC() const;
+
+	/** @return area under the PRC curve */
+	float64_t get_auPRC() const;
+
+	/** @return PRC curve, with precision in row 0 and recall in row 1 */
+	SGMatrix<float64_t> get_PRC() const;
+
+	/** @return thresholds of the points of the curves after the first ROC
+	 * point, that are the distinct scores or the lower ends of the bins in
+	 * decreasing order
+	 */
+	SGVector<float64_t> get_thresholds() const;
+
+	/** @return object name */
+	virtual const char* get_name() const
+	{
+		return "BinaryClassAccumulator";
+	}
+
+private:
+	void init();
+
+	/** @return index of the bin of a score in m_scores */
+	index_t bin(float64_t score) const;
+
+	/** Requires examples of both classes. */
+	void require_both_classes() const;
+
+protected:
+	/** lower end of the score range in binned mode */
+	float64_t m_min_score;
+
+	/** upper end of the score range in binned mode */
+	float64_t m_max_score;
+
+	/** number of bins, 0 in exact mode */
+	int32_t m_num_bins;
+
+	/** distinct scores in exact mode or lower ends of the bins in binned
+	 * mode, in decreasing order
+	 */
+	SGVector<float64_t> m_scores;
+
+	/** number of positive examples of every score */
+	SGVector<int64_t> m_positives;
+
+	/** number of negative examples of every score */
+	SGVector<int64_t> m_negatives;
+};
+} // namespace shogun
+
+#endif /* BINARYCLASSACCUMULATOR_H_ */
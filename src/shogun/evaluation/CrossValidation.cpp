@@ -6,17 +6,23 @@
  *          Leon Kuchenbecker
  */
 
+#include <shogun/base/Parallel.h>
 #include <shogun/base/progress.h>
 #include <shogun/evaluation/CrossValidation.h>
 #include <shogun/evaluation/CrossValidationStorage.h>
 #include <shogun/evaluation/Evaluation.h>
 #include <shogun/evaluation/SplittingStrategy.h>
+#include <shogun/features/IndexFeatures.h>
+#include <shogun/kernel/CustomKernel.h>
 #include <shogun/lib/observers/ObservedValueTemplated.h>
+#include <shogun/machine/KernelMachine.h>
 #include <shogun/machine/Machine.h>
 #include <shogun/mathematics/Statistics.h>
 #include <shogun/lib/View.h>
 
+#include <algorithm>
 #include <utility>
+#include <vector>
 
 using namespace shogun;
 
@@ -50,19 +56,126 @@ CrossValidation::~CrossValidation()
 void CrossValidation::init()
 {
 	m_num_runs = 1;
+	m_precompute_kernel = false;
+	m_num_fold_threads = 0;
 
 	SG_ADD(&m_num_runs, "num_runs", "Number of repetitions");
+	SG_ADD(
+	    &m_precompute_kernel, "precompute_kernel",
+	    "Compute the kernel matrix once and share it between all folds",
+	    ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_num_fold_threads, "num_fold_threads",
+	    "Number of folds evaluated concurrently (0 for all threads)",
+	    ParameterProperties::SETTING);
 }
 
 std::shared_ptr<EvaluationResult> CrossValidation::evaluate_impl() const
+{
+	return evaluate_folds(nullptr);
+}
+
+std::shared_ptr<EvaluationResult> CrossValidation::evaluate_warm_start(
+    std::vector<std::shared_ptr<Machine>>& fold_machines) const
+{
+	require(
+	    m_machine, "{}::evaluate_warm_start() is only possible if a machine "
+	               "is attached",
+	    get_name());
+	require(
+	    m_features, "{}::evaluate_warm_start() is only possible if features "
+	                "are attached",
+	    get_name());
+	require(
+	    m_labels, "{}::evaluate_warm_start() is only possible if labels are "
+	              "attached",
+	    get_name());
+
+	return evaluate_folds(&fold_machines);
+}
+
+std::shared_ptr<EvaluationResult> CrossValidation::evaluate_folds(
+    std::vector<std::shared_ptr<Machine>>* fold_machines) const
 {
 	SGVector<float64_t> results(m_num_runs);
+	index_t num_subsets = m_splitting_strategy->get_num_subsets();
+	index_t num_folds = m_num_runs * num_subsets;
+
+	/* build the index sets of all runs upfront, so that folds of different
+	 * runs can be evaluated concurrently */
+	SG_DEBUG("building index sets for {} runs of {}-fold cross-validation",
+		m_num_runs, num_subsets);
+	std::vector<SGVector<index_t>> train_indices(num_folds);
+	std::vector<SGVector<index_t>> test_indices(num_folds);
+	for (auto run : range(m_num_runs))
+	{
+		m_splitting_strategy->build_subsets();
+		for (auto i : range(num_subsets))
+		{
+			train_indices[run * num_subsets + i] =
+			    m_splitting_strategy->generate_subset_inverse(i);
+			test_indices[run * num_subsets + i] =
+			    m_splitting_strategy->generate_subset_indices(i);
+		}
+	}
+
+	std::shared_ptr<CustomKernel> kernel_matrix;
+	auto machine = m_machine;
+	if (m_precompute_kernel)
+	{
+		kernel_matrix = precompute_kernel();
+		if (kernel_matrix)
+		{
+			/* every fold gets its own view on the kernel matrix, so the
+			 * machine is cloned without its kernel (and its features) */
+			auto kernel_machine = m_machine->as<KernelMachine>();
+			auto kernel = kernel_machine->get_kernel();
+			kernel_machine->set_kernel(nullptr);
+			machine = make_clone(
+			    m_machine,
+			    ParameterProperties::HYPER | ParameterProperties::SETTING);
+			kernel_machine->set_kernel(kernel);
+		}
+	}
+
+	if (fold_machines && (index_t)fold_machines->size() != num_folds)
+		fold_machines->assign(num_folds, nullptr);
+
+	/* split the thread budget between concurrently evaluated folds and the
+	 * machines trained inside every fold */
+	int32_t num_threads = env()->get_num_threads();
+	int32_t num_fold_threads = m_num_fold_threads > 0
+	                               ? std::min(m_num_fold_threads, num_threads)
+	                               : num_threads;
+	num_fold_threads = std::max(std::min(num_fold_threads, num_folds), 1);
+	int32_t num_machine_threads = std::max(num_threads / num_fold_threads, 1);
+
+	SG_DEBUG("evaluating {} folds using {} threads, {} threads per fold",
+		num_folds, num_fold_threads, num_machine_threads);
+
+	SGVector<float64_t> fold_results(num_folds);
+	auto pb = SG_PROGRESS(range(num_folds));
+	#pragma omp parallel for num_threads(num_fold_threads)
+	for (index_t i = 0; i < num_folds; ++i)
+	{
+		/* limits the machines of this fold only */
+		Parallel::ThreadBudget budget(num_machine_threads);
+		fold_results[i] = evaluate_fold(
+		    machine, train_indices[i], test_indices[i], kernel_matrix,
+		    fold_machines ? &(*fold_machines)[i] : nullptr);
+		io::info("Result of cross-validation fold {}/{} of run {}/{} is {}",
+			i % num_subsets + 1, num_subsets, i / num_subsets + 1, m_num_runs,
+			fold_results[i]);
+		pb.print_progress();
+	}
+	pb.complete();
 
-	/* perform all the x-val runs */
-	SG_DEBUG("starting {} runs of cross-validation", m_num_runs);
-	for (auto i : SG_PROGRESS(range(m_num_runs)))
+	/* build arithmetic mean of the folds of every run */
+	for (auto i : range(m_num_runs))
 	{
-		results[i] = evaluate_one_run(i);
+		SGVector<float64_t> run_results(
+		    fold_results.vector + i * num_subsets, num_subsets, false);
+		results[i] = Statistics::mean(run_results);
 		io::info("Result of cross-validation run {}/{} is {}", i+1, m_num_runs, results[i]);
 	}
 
@@ -85,49 +198,96 @@ void CrossValidation::set_num_runs(int32_t num_runs)
 	m_num_runs = num_runs;
 }
 
-float64_t CrossValidation::evaluate_one_run(int64_t index) const
+void CrossValidation::set_precompute_kernel(bool precompute_kernel)
 {
-	SG_TRACE("entering {}::evaluate_one_run()", get_name());
-	index_t num_subsets = m_splitting_strategy->get_num_subsets();
+	m_precompute_kernel = precompute_kernel;
+}
 
-	SG_DEBUG("building index sets for {}-fold cross-validation", num_subsets)
-	m_splitting_strategy->build_subsets();
+void CrossValidation::set_num_fold_threads(int32_t num_fold_threads)
+{
+	require(num_fold_threads >= 0,
+		"Number of fold threads ({}) must be non-negative", num_fold_threads);
 
-	SGVector<float64_t> results(num_subsets);
+	m_num_fold_threads = num_fold_threads;
+}
 
-	#pragma omp parallel for shared(results)
-	for (auto i = 0; i<num_subsets; ++i)
+std::shared_ptr<CustomKernel> CrossValidation::precompute_kernel() const
+{
+	auto kernel_machine = std::dynamic_pointer_cast<KernelMachine>(m_machine);
+	if (!kernel_machine || !kernel_machine->get_kernel())
 	{
-		// only need to clone hyperparameters and settings of machine
-		// model parameters are inferred/learned during training
-		auto machine = make_clone(m_machine,
-				ParameterProperties::HYPER | ParameterProperties::SETTING);
+		io::warn("{}::precompute_kernel(): {} is not a kernel machine, "
+			"kernel matrix is not precomputed", get_name(), m_machine->get_name());
+		return nullptr;
+	}
 
-		SGVector<index_t> idx_train =
-			m_splitting_strategy->generate_subset_inverse(i);
+	auto kernel = kernel_machine->get_kernel();
+	if (kernel->get_kernel_type() == K_CUSTOM)
+	{
+		SG_DEBUG("kernel of {} is already precomputed", m_machine->get_name());
+		return kernel->as<CustomKernel>();
+	}
 
-		SGVector<index_t> idx_test =
-			m_splitting_strategy->generate_subset_indices(i);
+	/* do not touch the features the kernel of the machine was initialised
+	 * with */
+	auto gram_kernel = make_clone(
+	    kernel, ParameterProperties::HYPER | ParameterProperties::SETTING);
+	gram_kernel->init(m_features, m_features);
 
-		auto features_train = view(m_features, idx_train);
-		auto labels_train = view(m_labels, idx_train);
-		auto features_test = view(m_features, idx_test);
-		auto labels_test = view(m_labels, idx_test);
+	SG_DEBUG("precomputing {} kernel matrix of size {}x{}",
+		gram_kernel->get_name(), gram_kernel->get_num_vec_lhs(),
+		gram_kernel->get_num_vec_rhs());
+	return std::make_shared<CustomKernel>(
+	    gram_kernel->get_kernel_matrix<float32_t>());
+}
 
-		auto evaluation_criterion = make_clone(m_evaluation_criterion);
+float64_t CrossValidation::evaluate_fold(
+    const std::shared_ptr<Machine>& prototype,
+    const SGVector<index_t>& idx_train, const SGVector<index_t>& idx_test,
+    const std::shared_ptr<CustomKernel>& kernel_matrix,
+    std::shared_ptr<Machine>* fold_machine) const
+{
+	// only need to clone hyperparameters and settings of machine
+	// model parameters are inferred/learned during training
+	auto machine = fold_machine ? *fold_machine : nullptr;
+	if (!machine)
+		machine = make_clone(prototype,
+				ParameterProperties::HYPER | ParameterProperties::SETTING);
 
-		machine->set_labels(labels_train);
-		machine->train(features_train);
+	std::shared_ptr<Features> features_train;
+	std::shared_ptr<Features> features_test;
+	if (kernel_matrix)
+	{
+		/* index features select rows and columns of the shared matrix,
+		 * index features given by the user are mapped through */
+		machine->as<KernelMachine>()->set_kernel(kernel_matrix->shallow_copy());
+		if (m_features && m_features->get_feature_class() == C_INDEX)
+		{
+			features_train = view(m_features, idx_train);
+			features_test = view(m_features, idx_test);
+		}
+		else
+		{
+			features_train = std::make_shared<IndexFeatures>(idx_train);
+			features_test = std::make_shared<IndexFeatures>(idx_test);
+		}
+	}
+	else
+	{
+		features_train = view(m_features, idx_train);
+		features_test = view(m_features, idx_test);
+	}
+	auto labels_train = view(m_labels, idx_train);
+	auto labels_test = view(m_labels, idx_test);
 
-		auto result_labels = machine->apply(features_test);
+	auto evaluation_criterion = make_clone(m_evaluation_criterion);
 
-		results[i] = evaluation_criterion->evaluate(result_labels, labels_test);
-		io::info("Result of cross-validation fold {}/{} is {}", i+1, num_subsets, results[i]);
-	}
+	machine->set_labels(labels_train);
+	machine->train(features_train);
 
-	/* build arithmetic mean of results */
-	float64_t mean = Statistics::mean(results);
+	auto result_labels = machine->apply(features_test);
+	if (fold_machine)
+		*fold_machine = machine;
 
-	SG_TRACE("leaving {}::evaluate_one_run()", get_name());
-	return mean;
+	return evaluation_criterion->evaluate(result_labels, labels_test);
 }
@@ -15,12 +15,15 @@
 #include <shogun/evaluation/MachineEvaluation.h>
 #include <shogun/mathematics/Seedable.h>
 
+#include <vector>
+
 namespace shogun
 {
 
 	class MachineEvaluation;
 	class CrossValidationOutput;
 	class CrossValidationStorage;
+	class CustomKernel;
 	class List;
 
 	/** @brief type to encapsulate the results of an evaluation run.
@@ -114,7 +117,13 @@ namespace shogun
 	 * sub-classes
 	 * may average results of each cross validation fold differently by
 	 * overwriting
-	 * the evaluate_one_run method.
+	 * the evaluate_impl method.
+	 *
+	 * Folds of all runs are evaluated concurrently. The thread budget
+	 * (env()->get_num_threads()) is split between the folds and the machines
+	 * trained inside them, see set_num_fold_threads(). For kernel machines,
+	 * the kernel matrix of all features can be computed once and shared by
+	 * all folds (in single precision), see set_precompute_kernel().
 	 *
 	 * See [Forman, G. and Scholz, M. (2009). Apples-to-apples in
 	 * cross-validation
@@ -159,6 +168,39 @@ namespace shogun
 		/** setter for the number of runs to use for evaluation */
 		void set_num_runs(int32_t num_runs);
 
+		/** If enabled and the machine is a kernel machine, the kernel matrix
+		 * of all features is computed once (as float32) and every fold
+		 * trains and applies a CustomKernel on the rows and columns of its
+		 * vectors, instead of recomputing kernel values in every fold.
+		 * Memory is O(n^2) in the number of features.
+		 *
+		 * @param precompute_kernel whether to precompute the kernel matrix
+		 */
+		void set_precompute_kernel(bool precompute_kernel);
+
+		/** Sets the number of folds that are evaluated concurrently. The
+		 * machines trained in the folds use the remaining threads, i.e.
+		 * env()->get_num_threads()/num_fold_threads each.
+		 *
+		 * @param num_fold_threads number of concurrent folds, 0 to use all
+		 * threads for folds
+		 */
+		void set_num_fold_threads(int32_t num_fold_threads);
+
+		/** Evaluates like evaluate(), but trains the given machines in the
+		 * folds instead of clones of the machine. Learners that support it
+		 * (see IterativeMachine::set_warm_start()) then start from their
+		 * previous solution. Hyperparameters of the given machines have to
+		 * be updated by the caller.
+		 *
+		 * @param fold_machines machines of the folds, resized to the number
+		 * of folds, missing machines are cloned from the machine. Set to
+		 * the trained machines.
+		 * @return evaluation result
+		 */
+		std::shared_ptr<EvaluationResult> evaluate_warm_start(
+		    std::vector<std::shared_ptr<Machine>>& fold_machines) const;
+
 		/** @return name of the SGSerializable */
 		virtual const char* get_name() const
 		{
@@ -175,19 +217,52 @@ namespace shogun
 		 */
 		virtual std::shared_ptr<EvaluationResult> evaluate_impl() const override;
 
-		/** Evaluates one single cross-validation run.
-		 * Current implementation evaluates each fold separately and then
-		 * calculates
-		 * arithmetic mean. Suitable for accuracy and AUC for example. NOT for
-		 * F1-measure. Has to be overridden by sub-classes if results have to be
-		 * merged differently
+		/** Evaluates all folds.
+		 *
+		 * @param fold_machines machines trained in the folds, see
+		 * evaluate_warm_start(), nullptr to train clones of the machine
+		 * @return the cross-validation result
+		 */
+		std::shared_ptr<EvaluationResult> evaluate_folds(
+		    std::vector<std::shared_ptr<Machine>>* fold_machines) const;
+
+		/** Computes the kernel matrix of the features with the kernel of
+		 * the machine, or returns the kernel of the machine if it is a
+		 * CustomKernel already.
 		 *
-		 * @return evaluation result of one cross-validation run
+		 * @return precomputed kernel, or nullptr if the machine is not a
+		 * kernel machine
 		 */
-		float64_t evaluate_one_run(int64_t index) const;
+		std::shared_ptr<CustomKernel> precompute_kernel() const;
+
+		/** Trains a clone of the machine on one fold and evaluates it on
+		 * the held out vectors.
+		 *
+		 * @param prototype machine to clone
+		 * @param idx_train indices of training vectors
+		 * @param idx_test indices of test vectors
+		 * @param kernel_matrix precomputed kernel, nullptr to use the
+		 * features
+		 * @param fold_machine machine of the fold, trained instead of a
+		 * clone of the prototype if set, and set to the trained machine.
+		 * nullptr to train a clone only.
+		 * @return evaluation result of the fold
+		 */
+		float64_t evaluate_fold(
+		    const std::shared_ptr<Machine>& prototype,
+		    const SGVector<index_t>& idx_train,
+		    const SGVector<index_t>& idx_test,
+		    const std::shared_ptr<CustomKernel>& kernel_matrix,
+		    std::shared_ptr<Machine>* fold_machine) const;
 
 		/** number of evaluation runs for one fold */
 		int32_t m_num_runs;
+
+		/** whether the kernel matrix is shared between folds */
+		bool m_precompute_kernel;
+
+		/** number of folds evaluated concurrently */
+		int32_t m_num_fold_threads;
 	};
 }
 
@@ -0,0 +1,730 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#include <shogun/base/Parallel.h>
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/base/progress.h>
+#include <shogun/evaluation/CrossValidation.h>
+#include <shogun/evaluation/Evaluation.h>
+#include <shogun/evaluation/HyperparameterSearch.h>
+#include <shogun/evaluation/SplittingStrategy.h>
+#include <shogun/features/IndexFeatures.h>
+#include <shogun/kernel/CustomKernel.h>
+#include <shogun/labels/Labels.h>
+#include <shogun/lib/View.h>
+#include <shogun/machine/KernelMachine.h>
+#include <shogun/machine/Machine.h>
+#include <shogun/mathematics/RandomNamespace.h>
+#include <shogun/mathematics/UniformIntDistribution.h>
+#include <shogun/mathematics/UniformRealDistribution.h>
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <map>
+#include <utility>
+
+using namespace shogun;
+
+HyperparameterSearch::HyperparameterSearch() : RandomMixin<SGObject>()
+{
+	init();
+}
+
+HyperparameterSearch::HyperparameterSearch(
+    std::shared_ptr<Machine> machine, std::shared_ptr<Features> features,
+    std::shared_ptr<Labels> labels,
+    std::shared_ptr<SplittingStrategy> splitting_strategy,
+    std::shared_ptr<Evaluation> evaluation_criterion)
+    : RandomMixin<SGObject>()
+{
+	init();
+
+	m_machine = std::move(machine);
+	m_features = std::move(features);
+	m_labels = std::move(labels);
+	m_splitting_strategy = std::move(splitting_strategy);
+	m_evaluation_criterion = std::move(evaluation_criterion);
+}
+
+HyperparameterSearch::~HyperparameterSearch()
+{
+}
+
+void HyperparameterSearch::init()
+{
+	m_strategy = SEARCH_GRID;
+	m_num_candidates = 10;
+	m_eta = 3;
+	m_min_resource = 1.0 / 9;
+	m_num_concurrent_candidates = 0;
+	m_cache_kernel_matrices = true;
+	m_kernel_matrix_cache_size = 1024;
+	m_warm_start = false;
+	m_best = -1;
+
+	SG_ADD(&m_machine, "machine", "Machine whose hyperparameters are searched");
+	SG_ADD(&m_features, "features", "Features");
+	SG_ADD(&m_labels, "labels", "Labels");
+	SG_ADD(
+	    &m_splitting_strategy, "splitting_strategy",
+	    "Splitting strategy of the cross-validation");
+	SG_ADD(
+	    &m_evaluation_criterion, "evaluation_criterion",
+	    "Evaluation criterion");
+	SG_ADD_OPTIONS(
+	    (machine_int_t*)&m_strategy, "strategy", "Search strategy",
+	    ParameterProperties::SETTING,
+	    SG_OPTIONS(
+	        SEARCH_GRID, SEARCH_RANDOM, SEARCH_SUCCESSIVE_HALVING,
+	        SEARCH_HYPERBAND));
+	SG_ADD(
+	    &m_num_candidates, "num_candidates", "Number of sampled candidates",
+	    ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_eta, "eta", "Reduction factor of successive halving",
+	    ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_min_resource, "min_resource",
+	    "Fraction of vectors of the first round of successive halving",
+	    ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_num_concurrent_candidates, "num_concurrent_candidates",
+	    "Number of candidates evaluated concurrently (0 for all threads)",
+	    ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_cache_kernel_matrices, "cache_kernel_matrices",
+	    "Share kernel matrices between candidates",
+	    ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_kernel_matrix_cache_size, "kernel_matrix_cache_size",
+	    "Memory of the shared kernel matrices in MB",
+	    ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_warm_start, "warm_start",
+	    "Start learners from the solution of the previous candidate",
+	    ParameterProperties::SETTING);
+	SG_ADD(
+	    &m_candidates, "candidates", "Evaluated candidates",
+	    ParameterProperties::MODEL);
+	SG_ADD(
+	    &m_scores, "scores", "Scores of the candidates",
+	    ParameterProperties::MODEL);
+	SG_ADD(
+	    &m_num_vectors, "num_vectors",
+	    "Number of vectors the candidates were evaluated on",
+	    ParameterProperties::MODEL);
+}
+
+void HyperparameterSearch::add_values(
+    const std::string& name, SGVector<float64_t> values)
+{
+	require(values.vlen > 0, "No values given for parameter {}", name);
+
+	m_parameter_names.push_back(name);
+	m_parameter_values.push_back(values);
+	m_parameter_ranges.push_back(SGVector<float64_t>());
+}
+
+void HyperparameterSearch::add_range(
+    const std::string& name, float64_t min, float64_t max, bool log_scale)
+{
+	require(
+	    min < max, "Range [{}, {}] of parameter {} is empty", min, max, name);
+	require(
+	    !log_scale || min > 0,
+	    "Range [{}, {}] of parameter {} has to be positive for a log scale",
+	    min, max, name);
+
+	m_parameter_names.push_back(name);
+	m_parameter_values.push_back(SGVector<float64_t>());
+	m_parameter_ranges.push_back(
+	    SGVector<float64_t>({min, max, log_scale ? 1.0 : 0.0}));
+}
+
+void HyperparameterSearch::set_strategy(ESearchStrategy strategy)
+{
+	m_strategy = strategy;
+}
+
+void HyperparameterSearch::set_num_candidates(int32_t num_candidates)
+{
+	require(
+	    num_candidates > 0, "Number of candidates ({}) must be positive",
+	    num_candidates);
+
+	m_num_candidates = num_candidates;
+}
+
+void HyperparameterSearch::set_eta(int32_t eta)
+{
+	require(eta > 1, "Reduction factor ({}) must be larger than 1", eta);
+
+	m_eta = eta;
+}
+
+void HyperparameterSearch::set_min_resource(float64_t min_resource)
+{
+	require(
+	    min_resource > 0 && min_resource <= 1,
+	    "Minimum resource ({}) must be in (0, 1]", min_resource);
+
+	m_min_resource = min_resource;
+}
+
+void HyperparameterSearch::set_num_concurrent_candidates(
+    int32_t num_concurrent_candidates)
+{
+	require(
+	    num_concurrent_candidates >= 0,
+	    "Number of concurrent candidates ({}) must be non-negative",
+	    num_concurrent_candidates);
+
+	m_num_concurrent_candidates = num_concurrent_candidates;
+}
+
+void HyperparameterSearch::set_cache_kernel_matrices(bool cache_kernel_matrices)
+{
+	m_cache_kernel_matrices = cache_kernel_matrices;
+}
+
+void HyperparameterSearch::set_kernel_matrix_cache_size(int32_t size)
+{
+	require(
+	    size >= 0, "Kernel matrix cache size ({}) must be non-negative",
+	    size);
+
+	m_kernel_matrix_cache_size = size;
+}
+
+void HyperparameterSearch::set_warm_start(bool warm_start)
+{
+	m_warm_start = warm_start;
+}
+
+SGMatrix<float64_t> HyperparameterSearch::get_candidates() const
+{
+	return m_candidates;
+}
+
+SGVector<float64_t> HyperparameterSearch::get_scores() const
+{
+	return m_scores;
+}
+
+SGVector<int32_t> HyperparameterSearch::get_num_vectors() const
+{
+	return m_num_vectors;
+}
+
+std::map<std::string, float64_t>
+HyperparameterSearch::get_best_parameters() const
+{
+	require(m_best >= 0, "{}::search() has not been run", get_name());
+
+	std::map<std::string, float64_t> parameters;
+	for (auto i : range(m_parameter_names.size()))
+		parameters[m_parameter_names[i]] = m_candidates(i, m_best);
+
+	return parameters;
+}
+
+float64_t HyperparameterSearch::get_best_score() const
+{
+	require(m_best >= 0, "{}::search() has not been run", get_name());
+
+	return m_scores[m_best];
+}
+
+void HyperparameterSearch::put_parameter(
+    const std::shared_ptr<SGObject>& machine, const std::string& name,
+    float64_t value)
+{
+	auto object = machine;
+	auto leaf = name;
+	for (auto pos = leaf.find("::"); pos != std::string::npos;
+	     pos = leaf.find("::"))
+	{
+		object = object->get(leaf.substr(0, pos));
+		require(object, "Parameter {} does not exist", name);
+		leaf = leaf.substr(pos + 2);
+	}
+
+	if (object->has<float64_t>(leaf))
+		object->put(leaf, value);
+	else if (object->has<float32_t>(leaf))
+		object->put(leaf, (float32_t)value);
+	else if (object->has<int32_t>(leaf))
+		object->put(leaf, (int32_t)std::lround(value));
+	else if (object->has<int64_t>(leaf))
+		object->put(leaf, (int64_t)std::llround(value));
+	else
+		error(
+		    "{} has no numeric parameter {} (of {})", object->get_name(),
+		    leaf, name);
+}
+
+std::shared_ptr<Machine> HyperparameterSearch::search()
+{
+	require(m_machine, "{}::search() requires a machine", get_name());
+	require(m_features, "{}::search() requires features", get_name());
+	require(m_labels, "{}::search() requires labels", get_name());
+	require(
+	    m_splitting_strategy, "{}::search() requires a splitting strategy",
+	    get_name());
+	require(
+	    m_evaluation_criterion, "{}::search() requires an evaluation criterion",
+	    get_name());
+	require(
+	    !m_parameter_names.empty(), "{}::search() requires parameters",
+	    get_name());
+
+	index_t num_vectors = m_labels->get_num_labels();
+	m_permutation = SGVector<index_t>(num_vectors);
+	m_permutation.range_fill();
+	random::shuffle(m_permutation, m_prng);
+
+	m_workers.clear();
+	m_fold_machines.clear();
+	m_kernel_matrices.clear();
+
+	std::vector<index_t> candidates;
+	switch (m_strategy)
+	{
+	case SEARCH_GRID:
+	case SEARCH_RANDOM:
+	{
+		m_candidates = m_strategy == SEARCH_GRID
+		                   ? grid_candidates()
+		                   : sample_candidates(m_num_candidates);
+		for (auto i : range(m_candidates.num_cols))
+			candidates.push_back(i);
+
+		m_scores = SGVector<float64_t>(m_candidates.num_cols);
+		m_num_vectors = SGVector<int32_t>(m_candidates.num_cols);
+		evaluate_candidates(candidates, num_vectors);
+		break;
+	}
+	case SEARCH_SUCCESSIVE_HALVING:
+	{
+		m_candidates = sample_candidates(m_num_candidates);
+		for (auto i : range(m_candidates.num_cols))
+			candidates.push_back(i);
+
+		m_scores = SGVector<float64_t>(m_candidates.num_cols);
+		m_num_vectors = SGVector<int32_t>(m_candidates.num_cols);
+		successive_halving(
+		    candidates, std::ceil(m_min_resource * num_vectors));
+		break;
+	}
+	case SEARCH_HYPERBAND:
+	{
+		/* bracket s starts with ceil((s_max+1)/(s+1)*eta^s) candidates on
+		 * eta^-s of the vectors */
+		auto s_max = (int32_t)std::floor(
+		    std::log(1.0 / m_min_resource) / std::log(m_eta) + 1e-10);
+		std::vector<index_t> bracket_sizes;
+		index_t num_candidates = 0;
+		for (int32_t s = s_max; s >= 0; --s)
+		{
+			bracket_sizes.push_back(std::ceil(
+			    (s_max + 1.0) / (s + 1.0) * std::pow(m_eta, s)));
+			num_candidates += bracket_sizes.back();
+		}
+
+		m_candidates = sample_candidates(num_candidates);
+		m_scores = SGVector<float64_t>(num_candidates);
+		m_num_vectors = SGVector<int32_t>(num_candidates);
+
+		index_t first = 0;
+		for (auto i : range(bracket_sizes.size()))
+		{
+			int32_t s = s_max - i;
+			candidates.clear();
+			for (auto j : range(bracket_sizes[i]))
+				candidates.push_back(first + j);
+			first += bracket_sizes[i];
+
+			io::info("Hyperband bracket {}/{}: {} candidates", i + 1,
+				bracket_sizes.size(), candidates.size());
+			successive_halving(
+			    candidates, std::ceil(num_vectors * std::pow(m_eta, -s)));
+		}
+		break;
+	}
+	}
+
+	/* the best candidate of the ones that used all vectors */
+	m_best = -1;
+	for (auto i : range(m_candidates.num_cols))
+	{
+		if (m_num_vectors[i] != num_vectors)
+			continue;
+		if (m_best < 0 || is_better(m_scores[i], m_scores[m_best]))
+			m_best = i;
+	}
+	require(
+	    m_best >= 0, "{}::search(): no candidate was evaluated on all {} "
+	                 "vectors",
+	    get_name(), num_vectors);
+	io::info("Best candidate {} with score {}", m_best, m_scores[m_best]);
+
+	m_workers.clear();
+	m_fold_machines.clear();
+	m_kernel_matrices.clear();
+
+	auto best = make_clone(
+	    m_machine, ParameterProperties::HYPER | ParameterProperties::SETTING);
+	put_candidate(best, m_best, false);
+	best->set_labels(m_labels);
+	best->train(m_features);
+
+	return best;
+}
+
+SGMatrix<float64_t> HyperparameterSearch::grid_candidates() const
+{
+	index_t num_parameters = m_parameter_names.size();
+	index_t num_candidates = 1;
+	for (auto i : range(num_parameters))
+	{
+		require(
+		    m_parameter_values[i].vlen > 0,
+		    "Grid search requires values of parameter {}, not a range",
+		    m_parameter_names[i]);
+		num_candidates *= m_parameter_values[i].vlen;
+	}
+
+	/* the first parameter varies fastest, so neighbouring candidates only
+	 * differ in one value, which suits warm starts */
+	SGMatrix<float64_t> candidates(num_parameters, num_candidates);
+	for (auto j : range(num_candidates))
+	{
+		index_t rest = j;
+		for (auto i : range(num_parameters))
+		{
+			const auto& values = m_parameter_values[i];
+			candidates(i, j) = values[rest % values.vlen];
+			rest /= values.vlen;
+		}
+	}
+
+	return candidates;
+}
+
+SGMatrix<float64_t>
+HyperparameterSearch::sample_candidates(index_t num_candidates) const
+{
+	index_t num_parameters = m_parameter_names.size();
+	SGMatrix<float64_t> candidates(num_parameters, num_candidates);
+	for (auto j : range(num_candidates))
+	{
+		for (auto i : range(num_parameters))
+		{
+			const auto& values = m_parameter_values[i];
+			if (values.vlen > 0)
+			{
+				UniformIntDistribution<index_t> uniform_int_dist(
+				    0, values.vlen - 1);
+				candidates(i, j) = values[uniform_int_dist(m_prng)];
+				continue;
+			}
+
+			const auto& bounds = m_parameter_ranges[i];
+			if (bounds[2] != 0)
+			{
+				UniformRealDistribution<float64_t> uniform_real_dist(
+				    std::log(bounds[0]), std::log(bounds[1]));
+				candidates(i, j) = std::exp(uniform_real_dist(m_prng));
+			}
+			else
+			{
+				UniformRealDistribution<float64_t> uniform_real_dist(
+				    bounds[0], bounds[1]);
+				candidates(i, j) = uniform_real_dist(m_prng);
+			}
+		}
+	}
+
+	return candidates;
+}
+
+void HyperparameterSearch::successive_halving(
+    std::vector<index_t> candidates, index_t num_vectors)
+{
+	index_t num_all = m_labels->get_num_labels();
+	/* every fold needs training and test vectors */
+	num_vectors = std::max(
+	    num_vectors,
+	    (index_t)(2 * m_splitting_strategy->get_num_subsets()));
+	num_vectors = std::min(num_vectors, num_all);
+
+	while (true)
+	{
+		io::info("Successive halving: {} candidates on {} vectors",
+			candidates.size(), num_vectors);
+		evaluate_candidates(candidates, num_vectors);
+		if (num_vectors == num_all)
+			break;
+
+		/* keep the best 1/eta of the candidates for eta times the vectors */
+		std::stable_sort(
+		    candidates.begin(), candidates.end(), [&](index_t a, index_t b) {
+			    return is_better(m_scores[a], m_scores[b]);
+		    });
+		candidates.resize(std::max(candidates.size() / m_eta, (size_t)1));
+		num_vectors = std::min(num_vectors * m_eta, num_all);
+	}
+}
+
+void HyperparameterSearch::evaluate_candidates(
+    const std::vector<index_t>& candidates, index_t num_vectors)
+{
+	index_t num_candidates = candidates.size();
+
+	auto kernel_machine = std::dynamic_pointer_cast<KernelMachine>(m_machine);
+	bool use_kernel_matrices = m_cache_kernel_matrices && kernel_machine &&
+	                           kernel_machine->get_kernel() &&
+	                           kernel_machine->get_kernel()->get_kernel_type() !=
+	                               K_CUSTOM;
+	if (use_kernel_matrices)
+		cache_kernel_matrices(candidates);
+
+	/* the first vectors of the permutation, in order for locality */
+	SGVector<index_t> idx(num_vectors);
+	std::copy_n(m_permutation.vector, num_vectors, idx.vector);
+	std::sort(idx.begin(), idx.end());
+
+	auto labels = view(m_labels, idx);
+	std::shared_ptr<Features> features;
+	if (use_kernel_matrices)
+		features = std::make_shared<IndexFeatures>(idx);
+	else
+		features = view(m_features, idx);
+
+	/* all candidates use the same splits */
+	auto splitting_strategy = make_clone(m_splitting_strategy);
+	splitting_strategy->put("labels", labels);
+	seed(splitting_strategy);
+
+	/* candidates with a cached kernel matrix are cloned without the kernel */
+	auto prototype = m_machine;
+	if (use_kernel_matrices)
+	{
+		auto kernel = kernel_machine->get_kernel();
+		kernel_machine->set_kernel(nullptr);
+		prototype = make_clone(
+		    m_machine,
+		    ParameterProperties::HYPER | ParameterProperties::SETTING);
+		kernel_machine->set_kernel(kernel);
+	}
+
+	/* candidates with the same kernel parameters are evaluated in a row,
+	 * in batches whose kernel matrices fit into the cache */
+	std::vector<std::vector<index_t>> batches;
+	if (use_kernel_matrices)
+	{
+		std::vector<index_t> order(candidates);
+		std::stable_sort(
+		    order.begin(), order.end(), [this](index_t a, index_t b) {
+			    return kernel_key(a) < kernel_key(b);
+		    });
+
+		index_t max_matrices = max_kernel_matrices();
+		index_t num_matrices = 0;
+		for (auto i : range(num_candidates))
+		{
+			bool new_key = i == 0 ||
+			               kernel_key(order[i]) != kernel_key(order[i - 1]);
+			if (new_key && (batches.empty() || ++num_matrices > max_matrices))
+			{
+				batches.emplace_back();
+				num_matrices = 1;
+			}
+			batches.back().push_back(order[i]);
+		}
+	}
+	else
+		batches.push_back(candidates);
+
+	auto pb = SG_PROGRESS(range(num_candidates));
+	for (const auto& batch : batches)
+	{
+		if (use_kernel_matrices)
+			cache_kernel_matrices(batch);
+
+		/* split the thread budget between concurrent candidates and their
+		 * cross-validations */
+		index_t batch_size = batch.size();
+		int32_t num_threads = env()->get_num_threads();
+		int32_t num_workers =
+		    m_num_concurrent_candidates > 0
+		        ? std::min(m_num_concurrent_candidates, num_threads)
+		        : num_threads;
+		num_workers = std::max(std::min(num_workers, (int32_t)batch_size), 1);
+		while ((int32_t)m_workers.size() < num_workers)
+			m_workers.push_back(std::make_shared<CrossValidation>());
+		m_fold_machines.resize(m_workers.size());
+		int32_t num_candidate_threads = std::max(num_threads / num_workers, 1);
+
+		SG_DEBUG("evaluating {} candidates using {} threads, {} threads per "
+			"candidate", batch_size, num_workers, num_candidate_threads);
+
+		/* every worker evaluates a contiguous chunk of the candidates in
+		 * order, so that warm starts continue from similar candidates */
+		#pragma omp parallel for schedule(static) num_threads(num_workers)
+		for (int32_t w = 0; w < num_workers; ++w)
+		{
+			/* limits the cross-validations of this worker only */
+			Parallel::ThreadBudget budget(num_candidate_threads);
+			const auto& cv = m_workers[w];
+			auto& fold_machines = m_fold_machines[w];
+			for (index_t j = (int64_t)w * batch_size / num_workers;
+			     j < (int64_t)(w + 1) * batch_size / num_workers; ++j)
+			{
+				auto candidate = batch[j];
+				std::shared_ptr<CustomKernel> kernel_matrix;
+				if (use_kernel_matrices)
+					kernel_matrix = m_kernel_matrices.at(kernel_key(candidate));
+
+				auto machine = make_clone(
+				    prototype,
+				    ParameterProperties::HYPER | ParameterProperties::SETTING);
+				if (kernel_matrix)
+					machine->as<KernelMachine>()->set_kernel(kernel_matrix);
+				put_candidate(machine, candidate, use_kernel_matrices);
+				if (m_warm_start)
+				{
+					if (machine->has<bool>("warm_start"))
+						machine->put("warm_start", true);
+					for (const auto& fold_machine : fold_machines)
+					{
+						if (fold_machine)
+							put_candidate(
+							    fold_machine, candidate, use_kernel_matrices);
+					}
+				}
+
+				cv->put("machine", machine);
+				cv->put("features", features);
+				cv->put("labels", labels);
+				cv->put(
+				    "splitting_strategy", make_clone(splitting_strategy));
+				cv->put("evaluation_criterion", m_evaluation_criterion);
+				cv->set_precompute_kernel(use_kernel_matrices);
+				cv->set_num_fold_threads(num_workers > 1 ? 1 : 0);
+
+				auto result =
+				    (m_warm_start ? cv->evaluate_warm_start(fold_machines)
+				                  : cv->evaluate())
+				        ->as<CrossValidationResult>();
+				m_scores[candidate] = result->get_mean();
+				m_num_vectors[candidate] = num_vectors;
+				SG_DEBUG("candidate {} on {} vectors: {}", candidate,
+					num_vectors, m_scores[candidate]);
+				pb.print_progress();
+			}
+		}
+	}
+	pb.complete();
+}
+
+void HyperparameterSearch::cache_kernel_matrices(
+    const std::vector<index_t>& candidates)
+{
+	/* a candidate for every kernel matrix */
+	std::map<std::vector<float64_t>, index_t> keys;
+	for (auto candidate : candidates)
+		keys.emplace(kernel_key(candidate), candidate);
+
+	/* drop matrices of other candidates until the missing ones fit */
+	index_t num_missing = 0;
+	for (const auto& key : keys)
+		num_missing += !m_kernel_matrices.count(key.first);
+	index_t max_matrices = max_kernel_matrices();
+	for (auto it = m_kernel_matrices.begin(); it != m_kernel_matrices.end() &&
+	     (index_t)m_kernel_matrices.size() + num_missing > max_matrices;)
+	{
+		if (keys.count(it->first))
+			++it;
+		else
+			it = m_kernel_matrices.erase(it);
+	}
+
+	auto kernel = m_machine->as<KernelMachine>()->get_kernel();
+	for (const auto& key : keys)
+	{
+		if (m_kernel_matrices.count(key.first))
+			continue;
+
+		/* the kernel of all vectors, subsets select rows and columns */
+		auto gram_kernel = make_clone(
+		    kernel, ParameterProperties::HYPER | ParameterProperties::SETTING);
+		for (auto i : range(m_parameter_names.size()))
+		{
+			if (is_kernel_parameter(i))
+				put_parameter(
+				    gram_kernel, m_parameter_names[i].substr(8),
+				    m_candidates(i, key.second));
+		}
+		gram_kernel->init(m_features, m_features);
+
+		SG_DEBUG("caching {} kernel matrix of size {}x{}",
+			gram_kernel->get_name(), gram_kernel->get_num_vec_lhs(),
+			gram_kernel->get_num_vec_rhs());
+		m_kernel_matrices[key.first] = std::make_shared<CustomKernel>(
+		    gram_kernel->get_kernel_matrix<float32_t>());
+	}
+}
+
+index_t HyperparameterSearch::max_kernel_matrices() const
+{
+	float64_t num_all = m_features->get_num_vectors();
+	float64_t matrix_size = num_all * num_all * sizeof(float32_t);
+	float64_t num_matrices =
+	    std::floor(m_kernel_matrix_cache_size * 1024.0 * 1024.0 / matrix_size);
+
+	/* at least the matrix of a single candidate is cached */
+	return (index_t)std::min(
+	    std::max(num_matrices, 1.0),
+	    (float64_t)std::numeric_limits<index_t>::max());
+}
+
+std::vector<float64_t> HyperparameterSearch::kernel_key(index_t candidate) const
+{
+	std::vector<float64_t> key;
+	for (auto i : range(m_parameter_names.size()))
+	{
+		if (is_kernel_parameter(i))
+			key.push_back(m_candidates(i, candidate));
+	}
+
+	return key;
+}
+
+bool HyperparameterSearch::is_kernel_parameter(index_t parameter) const
+{
+	return m_parameter_names[parameter].rfind("kernel::", 0) == 0;
+}
+
+void HyperparameterSearch::put_candidate(
+    const std::shared_ptr<Machine>& machine, index_t candidate,
+    bool skip_kernel) const
+{
+	for (auto i : range(m_parameter_names.size()))
+	{
+		if (skip_kernel && is_kernel_parameter(i))
+			continue;
+		put_parameter(machine, m_parameter_names[i], m_candidates(i, candidate));
+	}
+}
+
+bool HyperparameterSearch::is_better(float64_t a, float64_t b) const
+{
+	if (m_evaluation_criterion->get_evaluation_direction() == ED_MAXIMIZE)
+		return a > b;
+
+	return a < b;
+}
@@ -0,0 +1,333 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#ifndef __HYPERPARAMETERSEARCH_H_
+#define __HYPERPARAMETERSEARCH_H_
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/SGObject.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/mathematics/RandomMixin.h>
+
+#include <map>
+#include <string>
+#include <vector>
+
+namespace shogun
+{
+	class Machine;
+	class Features;
+	class Labels;
+	class SplittingStrategy;
+	class Evaluation;
+	class CrossValidation;
+	class CustomKernel;
+
+	/** strategy to generate and select candidates of a hyperparameter search */
+	enum ESearchStrategy
+	{
+		/** all combinations of the given values */
+		SEARCH_GRID = 0,
+		/** randomly sampled candidates */
+		SEARCH_RANDOM = 1,
+		/** randomly sampled candidates, successively halved on growing
+		 * subsets of the data */
+		SEARCH_SUCCESSIVE_HALVING = 2,
+		/** successive halving with different trade-offs between number of
+		 * candidates and data used for them */
+		SEARCH_HYPERBAND = 3
+	};
+
+	/** @brief Searches hyperparameters of a machine by cross-validation.
+	 *
+	 * Parameters are addressed by name, parameters of nested objects by
+	 * their path, e.g. "kernel::width" for the width of the kernel of a
+	 * kernel machine. Every candidate is a clone of the machine with its
+	 * values put on these parameters, and is evaluated with
+	 * CrossValidation.
+	 *
+	 * Candidates are either all combinations of given values (grid search)
+	 * or sampled from given values and ranges (random search). Successive
+	 * halving evaluates the sampled candidates on a random subset of the
+	 * vectors and keeps the best 1/eta of them for a subset eta times as
+	 * large, until all vectors are used. Hyperband runs successive halving
+	 * with several initial subset sizes, see
+	 *
+	 * Li, L., Jamieson, K., DeSalvo, G., Rostamizadeh, A. and Talwalkar, A.
+	 * (2017). Hyperband: A novel bandit-based approach to hyperparameter
+	 * optimization. JMLR, 18(1), 6765-6816.
+	 *
+	 * Candidates are evaluated concurrently, see
+	 * set_num_concurrent_candidates(). For kernel machines, the kernel
+	 * matrix is computed once for all candidates with the same kernel
+	 * parameters (e.g. that only differ in C), see
+	 * set_cache_kernel_matrices(). Candidates with the same kernel
+	 * parameters are evaluated in a row, so that only the matrices that fit
+	 * into set_kernel_matrix_cache_size() are kept. With warm start, every concurrent worker
+	 * keeps the machines trained on the folds of its previous candidate
+	 * and IterativeMachine learners start from their solution.
+	 */
+	class HyperparameterSearch : public RandomMixin<SGObject>
+	{
+	public:
+		/** constructor */
+		HyperparameterSearch();
+
+		/** constructor
+		 * @param machine learning machine whose hyperparameters are searched
+		 * @param features features to use for cross-validation
+		 * @param labels labels that correspond to the features
+		 * @param splitting_strategy splitting strategy to use
+		 * @param evaluation_criterion evaluation criterion to use
+		 */
+		HyperparameterSearch(
+		    std::shared_ptr<Machine> machine,
+		    std::shared_ptr<Features> features,
+		    std::shared_ptr<Labels> labels,
+		    std::shared_ptr<SplittingStrategy> splitting_strategy,
+		    std::shared_ptr<Evaluation> evaluation_criterion);
+
+		/** destructor */
+		virtual ~HyperparameterSearch();
+
+		/** Adds values of a parameter to search. Integer parameters are
+		 * rounded.
+		 *
+		 * @param name name or path of the parameter
+		 * @param values values of the parameter
+		 */
+		void add_values(const std::string& name, SGVector<float64_t> values);
+
+		/** Adds a range of a parameter to sample from (random search,
+		 * successive halving and Hyperband only).
+		 *
+		 * @param name name or path of the parameter
+		 * @param min lower bound of the range
+		 * @param max upper bound of the range
+		 * @param log_scale whether to sample uniformly on a log scale
+		 */
+		void add_range(
+		    const std::string& name, float64_t min, float64_t max,
+		    bool log_scale = false);
+
+		/** @param strategy how candidates are generated and selected */
+		void set_strategy(ESearchStrategy strategy);
+
+		/** @param num_candidates number of sampled candidates (of every
+		 * bracket for Hyperband)
+		 */
+		void set_num_candidates(int32_t num_candidates);
+
+		/** @param eta reduction factor of successive halving */
+		void set_eta(int32_t eta);
+
+		/** @param min_resource fraction of vectors the first round of
+		 * successive halving uses, in (0, 1]
+		 */
+		void set_min_resource(float64_t min_resource);
+
+		/** Sets the number of candidates evaluated concurrently. Every
+		 * candidate uses env()->get_num_threads()/num_concurrent_candidates
+		 * threads.
+		 *
+		 * @param num_concurrent_candidates number of concurrent candidates,
+		 * 0 to use all threads for candidates
+		 */
+		void set_num_concurrent_candidates(int32_t num_concurrent_candidates);
+
+		/** @param cache_kernel_matrices whether kernel matrices are shared
+		 * between candidates with the same kernel parameters
+		 */
+		void set_cache_kernel_matrices(bool cache_kernel_matrices);
+
+		/** @param size memory of the shared kernel matrices in MB, the
+		 * matrix of a single candidate is kept in any case
+		 */
+		void set_kernel_matrix_cache_size(int32_t size);
+
+		/** @param warm_start whether learners start from the solution of
+		 * the previous candidate, see
+		 * CrossValidation::evaluate_warm_start()
+		 */
+		void set_warm_start(bool warm_start);
+
+		/** Runs the search and trains the best candidate on all vectors.
+		 *
+		 * @return best machine, trained
+		 */
+		std::shared_ptr<Machine> search();
+
+		/** @return values of the evaluated candidates, one column per
+		 * candidate and one row per parameter in the order they were added
+		 */
+		SGMatrix<float64_t> get_candidates() const;
+
+		/** @return evaluation result of every candidate on the largest
+		 * subset of vectors it was evaluated on
+		 */
+		SGVector<float64_t> get_scores() const;
+
+		/** @return number of vectors every candidate was last evaluated on */
+		SGVector<int32_t> get_num_vectors() const;
+
+		/** @return parameter values of the best candidate */
+		std::map<std::string, float64_t> get_best_parameters() const;
+
+		/** @return evaluation result of the best candidate */
+		float64_t get_best_score() const;
+
+		/** Puts a value on a parameter, given by name or path, of a
+		 * machine.
+		 *
+		 * @param machine machine to modify
+		 * @param name name or path of the parameter
+		 * @param value value of the parameter, rounded for integer
+		 * parameters
+		 */
+		static void put_parameter(
+		    const std::shared_ptr<SGObject>& machine, const std::string& name,
+		    float64_t value);
+
+		/** @return name of the SGSerializable */
+		virtual const char* get_name() const
+		{
+			return "HyperparameterSearch";
+		}
+
+	private:
+		void init();
+
+		/** @return all combinations of the values of the parameters */
+		SGMatrix<float64_t> grid_candidates() const;
+
+		/** @return num_candidates randomly sampled candidates */
+		SGMatrix<float64_t> sample_candidates(index_t num_candidates) const;
+
+		/** Runs successive halving.
+		 *
+		 * @param candidates indices of the candidates of the first round
+		 * @param num_vectors number of vectors of the first round
+		 */
+		void successive_halving(
+		    std::vector<index_t> candidates, index_t num_vectors);
+
+		/** Evaluates candidates on the first vectors of the permutation
+		 * concurrently and stores their scores.
+		 *
+		 * @param candidates indices of the candidates
+		 * @param num_vectors number of vectors to use
+		 */
+		void evaluate_candidates(
+		    const std::vector<index_t>& candidates, index_t num_vectors);
+
+		/** Computes the kernel matrices for the kernel parameters of the
+		 * candidates that are not cached yet, dropping matrices of other
+		 * candidates as long as the cache is full.
+		 *
+		 * @param candidates indices of the candidates
+		 */
+		void cache_kernel_matrices(const std::vector<index_t>& candidates);
+
+		/** @return number of kernel matrices that fit into the cache */
+		index_t max_kernel_matrices() const;
+
+		/** @return key of the kernel matrix of a candidate in the cache */
+		std::vector<float64_t> kernel_key(index_t candidate) const;
+
+		/** @return whether the parameter is one of the kernel */
+		bool is_kernel_parameter(index_t parameter) const;
+
+		/** Puts the values of a candidate on a machine.
+		 *
+		 * @param machine machine to modify
+		 * @param candidate index of the candidate
+		 * @param skip_kernel whether to skip parameters of the kernel
+		 */
+		void put_candidate(
+		    const std::shared_ptr<Machine>& machine, index_t candidate,
+		    bool skip_kernel) const;
+
+		/** @return whether score a is better than score b */
+		bool is_better(float64_t a, float64_t b) const;
+
+	protected:
+		/** machine whose hyperparameters are searched */
+		std::shared_ptr<Machine> m_machine;
+
+		/** features */
+		std::shared_ptr<Features> m_features;
+
+		/** labels */
+		std::shared_ptr<Labels> m_labels;
+
+		/** splitting strategy of the cross-validation */
+		std::shared_ptr<SplittingStrategy> m_splitting_strategy;
+
+		/** criterion for evaluation */
+		std::shared_ptr<Evaluation> m_evaluation_criterion;
+
+		/** strategy */
+		ESearchStrategy m_strategy;
+
+		/** number of sampled candidates */
+		int32_t m_num_candidates;
+
+		/** reduction factor of successive halving */
+		int32_t m_eta;
+
+		/** fraction of vectors of the first round of successive halving */
+		float64_t m_min_resource;
+
+		/** number of candidates evaluated concurrently */
+		int32_t m_num_concurrent_candidates;
+
+		/** whether kernel matrices are shared between candidates */
+		bool m_cache_kernel_matrices;
+
+		/** memory of the shared kernel matrices in MB */
+		int32_t m_kernel_matrix_cache_size;
+
+		/** whether learners start from the previous solution */
+		bool m_warm_start;
+
+		/** names or paths of the searched parameters */
+		std::vector<std::string> m_parameter_names;
+
+		/** values of the searched parameters, empty for ranges */
+		std::vector<SGVector<float64_t>> m_parameter_values;
+
+		/** ranges of the searched parameters (min, max, log scale) */
+		std::vector<SGVector<float64_t>> m_parameter_ranges;
+
+		/** evaluated candidates */
+		SGMatrix<float64_t> m_candidates;
+
+		/** scores of the candidates */
+		SGVector<float64_t> m_scores;
+
+		/** number of vectors of the scores */
+		SGVector<int32_t> m_num_vectors;
+
+		/** index of the best candidate */
+		index_t m_best;
+
+		/** random order of the vectors for subsets */
+		SGVector<index_t> m_permutation;
+
+		/** cross-validations of the concurrent workers */
+		std::vector<std::shared_ptr<CrossValidation>> m_workers;
+
+		/** machines trained in the folds of every worker, for warm starts */
+		std::vector<std::vector<std::shared_ptr<Machine>>> m_fold_machines;
+
+		/** kernel matrices by values of the kernel parameters */
+		std::map<std::vector<float64_t>, std::shared_ptr<CustomKernel>>
+		    m_kernel_matrices;
+	};
+} // namespace shogun
+
+#endif /* __HYPERPARAMETERSEARCH_H_ */
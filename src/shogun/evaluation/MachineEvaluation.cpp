@@ -58,8 +58,7 @@ void MachineEvaluation::init()
 	m_labels = NULL;
 	m_splitting_strategy = NULL;
 	m_evaluation_criterion = NULL;
-	m_cancel_computation = false;
-	m_pause_computation_flag = false;
+	reset_computation_variables();
 
 	SG_ADD(&m_machine, "machine", "Used learning machine");
 	SG_ADD(&m_features, "features", "Used features");
@@ -0,0 +1,129 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#include <shogun/evaluation/RegressionAccumulator.h>
+#include <shogun/mathematics/Math.h>
+
+using namespace shogun;
+
+RegressionAccumulator::RegressionAccumulator() : SGObject()
+{
+	init();
+}
+
+RegressionAccumulator::~RegressionAccumulator()
+{
+}
+
+void RegressionAccumulator::init()
+{
+	reset();
+
+	SG_ADD(&m_num_values, "num_values", "Number of predictions");
+	SG_ADD(
+	    &m_mean_squared_error, "mean_squared_error",
+	    "Mean of the squared errors");
+	SG_ADD(
+	    &m_mean_absolute_error, "mean_absolute_error",
+	    "Mean of the absolute errors");
+	SG_ADD(&m_mean_truth, "mean_truth", "Mean of the ground truth");
+	SG_ADD(
+	    &m_squared_deviations, "squared_deviations",
+	    "Sum of squared deviations of the ground truth");
+}
+
+void RegressionAccumulator::reset()
+{
+	m_num_values = 0;
+	m_mean_squared_error = 0;
+	m_mean_absolute_error = 0;
+	m_mean_truth = 0;
+	m_squared_deviations = 0;
+}
+
+void RegressionAccumulator::update(
+    const SGVector<float64_t>& predicted,
+    const SGVector<float64_t>& ground_truth)
+{
+	require(
+	    predicted.vlen == ground_truth.vlen,
+	    "Number of predicted values ({}) must be equal to the number of "
+	    "ground truth values ({}).",
+	    predicted.vlen, ground_truth.vlen);
+
+	for (index_t i = 0; i < predicted.vlen; ++i)
+	{
+		m_num_values++;
+		auto diff = predicted[i] - ground_truth[i];
+		m_mean_squared_error +=
+		    (diff * diff - m_mean_squared_error) / m_num_values;
+		m_mean_absolute_error +=
+		    (std::abs(diff) - m_mean_absolute_error) / m_num_values;
+
+		auto delta = ground_truth[i] - m_mean_truth;
+		m_mean_truth += delta / m_num_values;
+		m_squared_deviations += delta * (ground_truth[i] - m_mean_truth);
+	}
+}
+
+void RegressionAccumulator::update(
+    const std::shared_ptr<RegressionLabels>& predicted,
+    const std::shared_ptr<RegressionLabels>& ground_truth)
+{
+	require(predicted, "Predicted labels must be not null.");
+	require(ground_truth, "Ground truth labels must be not null.");
+
+	update(predicted->get_labels(), ground_truth->get_labels());
+}
+
+void RegressionAccumulator::merge(
+    const std::shared_ptr<RegressionAccumulator>& other)
+{
+	require(other, "No accumulator provided.");
+	if (!other->m_num_values)
+		return;
+
+	float64_t n_a = m_num_values;
+	float64_t n_b = other->m_num_values;
+	float64_t n = n_a + n_b;
+
+	m_mean_squared_error +=
+	    (other->m_mean_squared_error - m_mean_squared_error) * n_b / n;
+	m_mean_absolute_error +=
+	    (other->m_mean_absolute_error - m_mean_absolute_error) * n_b / n;
+
+	auto delta = other->m_mean_truth - m_mean_truth;
+	m_mean_truth += delta * n_b / n;
+	m_squared_deviations +=
+	    other->m_squared_deviations + delta * delta * n_a * n_b / n;
+	m_num_values += other->m_num_values;
+}
+
+float64_t RegressionAccumulator::get_mean_squared_error() const
+{
+	require(m_num_values > 0, "No predictions accumulated.");
+	return m_mean_squared_error;
+}
+
+float64_t RegressionAccumulator::get_root_mean_squared_error() const
+{
+	return std::sqrt(get_mean_squared_error());
+}
+
+float64_t RegressionAccumulator::get_mean_absolute_error() const
+{
+	require(m_num_values > 0, "No predictions accumulated.");
+	return m_mean_absolute_error;
+}
+
+float64_t RegressionAccumulator::get_r2() const
+{
+	require(m_num_values > 0, "No predictions accumulated.");
+	require(
+	    m_squared_deviations > 0,
+	    "Ground truth is constant, coefficient of determination is "
+	    "undefined.");
+	return 1.0 - m_mean_squared_error * m_num_values / m_squared_deviations;
+}
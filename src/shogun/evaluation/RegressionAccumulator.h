@@ -0,0 +1,108 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#ifndef REGRESSIONACCUMULATOR_H_
+#define REGRESSIONACCUMULATOR_H_
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/SGObject.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/lib/SGVector.h>
+
+namespace shogun
+{
+
+/** @brief Accumulates regression predictions chunk by chunk to compute the
+ * mean squared error, the mean absolute error and the coefficient of
+ * determination without keeping the predictions in memory.
+ *
+ * Means are updated with Welford's method and accumulators are merged with
+ * the pairwise formula of Chan et al., so chunks can be accumulated in
+ * parallel by giving every thread its own accumulator and merging them
+ * afterwards.
+ */
+class RegressionAccumulator : public SGObject
+{
+public:
+	/** constructor */
+	RegressionAccumulator();
+
+	/** destructor */
+	virtual ~RegressionAccumulator();
+
+	/** Adds a chunk of predictions.
+	 *
+	 * @param predicted predicted values
+	 * @param ground_truth values assumed to be correct
+	 */
+	void update(
+	    const SGVector<float64_t>& predicted,
+	    const SGVector<float64_t>& ground_truth);
+
+	/** Adds a chunk of predictions.
+	 *
+	 * @param predicted predicted labels
+	 * @param ground_truth labels assumed to be correct
+	 */
+	void update(
+	    const std::shared_ptr<RegressionLabels>& predicted,
+	    const std::shared_ptr<RegressionLabels>& ground_truth);
+
+	/** Adds the predictions of another accumulator.
+	 *
+	 * @param other accumulator to merge
+	 */
+	void merge(const std::shared_ptr<RegressionAccumulator>& other);
+
+	/** Removes all predictions. */
+	void reset();
+
+	/** @return number of predictions */
+	int64_t get_num_values() const
+	{
+		return m_num_values;
+	}
+
+	/** @return mean squared error */
+	float64_t get_mean_squared_error() const;
+
+	/** @return root of the mean squared error */
+	float64_t get_root_mean_squared_error() const;
+
+	/** @return mean absolute error */
+	float64_t get_mean_absolute_error() const;
+
+	/** @return coefficient of determination \f$R^2\f$ */
+	float64_t get_r2() const;
+
+	/** @return object name */
+	virtual const char* get_name() const
+	{
+		return "RegressionAccumulator";
+	}
+
+private:
+	void init();
+
+protected:
+	/** number of predictions */
+	int64_t m_num_values;
+
+	/** mean of the squared errors */
+	float64_t m_mean_squared_error;
+
+	/** mean of the absolute errors */
+	float64_t m_mean_absolute_error;
+
+	/** mean of the ground truth */
+	float64_t m_mean_truth;
+
+	/** sum of squared deviations of the ground truth from its mean */
+	float64_t m_squared_deviations;
+};
+} // namespace shogun
+
+#endif /* REGRESSIONACCUMULATOR_H_ */
@@ -557,6 +557,8 @@ protected:
 
 	/** feature cache */
 	std::shared_ptr<Cache<ST>> feature_cache;
+
+	template <class> friend class DenseIndexViewFeatures;
 };
 }
 #endif // _DENSEFEATURES__H__
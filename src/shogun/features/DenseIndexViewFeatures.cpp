@@ -0,0 +1,302 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/features/DenseIndexViewFeatures.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/eigen3.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
+
+#include <typeinfo>
+#include <vector>
+
+using namespace shogun;
+using namespace Eigen;
+
+/** number of vectors gathered into one block */
+static constexpr int32_t GATHER_BLOCK_SIZE = 64;
+
+template <class ST>
+DenseIndexViewFeatures<ST>::DenseIndexViewFeatures() : DenseFeatures<ST>()
+{
+	init();
+}
+
+template <class ST>
+DenseIndexViewFeatures<ST>::DenseIndexViewFeatures(
+    const std::shared_ptr<DenseFeatures<ST>>& features,
+    const SGVector<index_t>& indices)
+    : DenseFeatures<ST>(features->feature_matrix)
+{
+	init();
+	require(
+	    features->feature_matrix.matrix,
+	    "Only features with a feature matrix can be viewed.");
+
+	auto num_vectors = features->get_num_vectors();
+	SGVector<index_t> real_indices(indices.vlen);
+	for (index_t i = 0; i < indices.vlen; ++i)
+	{
+		require(
+		    indices[i] >= 0 && indices[i] < num_vectors,
+		    "Index {} ({}) is out of bounds [0, {}).", i, indices[i],
+		    num_vectors);
+		real_indices[i] =
+		    features->m_subset_stack->subset_idx_conversion(indices[i]);
+	}
+	this->add_subset(real_indices);
+}
+
+template <class ST>
+DenseIndexViewFeatures<ST>::DenseIndexViewFeatures(
+    const DenseIndexViewFeatures& orig)
+    : DenseFeatures<ST>(orig), m_indices(orig.m_indices)
+{
+	init();
+}
+
+template <class ST>
+DenseIndexViewFeatures<ST>::~DenseIndexViewFeatures()
+{
+}
+
+template <class ST>
+std::shared_ptr<Features> DenseIndexViewFeatures<ST>::duplicate() const
+{
+	return std::make_shared<DenseIndexViewFeatures>(*this);
+}
+
+template <class ST>
+void DenseIndexViewFeatures<ST>::init()
+{
+	SG_ADD(&m_indices, "indices", "Indices of the viewed vectors.");
+}
+
+template <class ST>
+void DenseIndexViewFeatures<ST>::subset_changed_post()
+{
+	DenseFeatures<ST>::subset_changed_post();
+
+	auto subset = this->m_subset_stack->get_last_subset();
+	m_indices = subset ? subset->get_subset_idx() : SGVector<index_t>();
+}
+
+template <class ST>
+float64_t DenseIndexViewFeatures<ST>::dot(
+    int32_t vec_idx1, const SGVector<float64_t>& vec2) const
+{
+	ASSERT(vec2.vlen == this->num_features)
+	const ST* vec1 = vector_at(vec_idx1);
+
+	float64_t result = 0;
+	for (int32_t i = 0; i < this->num_features; ++i)
+		result += vec1[i] * vec2[i];
+
+	return result;
+}
+
+template <>
+float64_t DenseIndexViewFeatures<float64_t>::dot(
+    int32_t vec_idx1, const SGVector<float64_t>& vec2) const
+{
+	ASSERT(vec2.vlen == this->num_features)
+	Map<const VectorXd> vec1(vector_at(vec_idx1), this->num_features);
+	return vec1.dot(Map<const VectorXd>(vec2.vector, vec2.vlen));
+}
+
+template <class ST>
+float64_t DenseIndexViewFeatures<ST>::dot(
+    int32_t vec_idx1, std::shared_ptr<DotFeatures> df, int32_t vec_idx2) const
+{
+	ASSERT(df)
+	ASSERT(df->get_feature_type() == this->get_feature_type())
+	ASSERT(df->get_feature_class() == this->get_feature_class())
+	auto sf = std::static_pointer_cast<DenseFeatures<ST>>(df);
+
+	int32_t len2;
+	bool free2;
+	ST* vec2 = sf->get_feature_vector(vec_idx2, len2, free2);
+	ASSERT(len2 == this->num_features)
+
+	SGVector<ST> sg_vec1(
+	    const_cast<ST*>(vector_at(vec_idx1)), this->num_features, false);
+	SGVector<ST> sg_vec2(vec2, len2, false);
+	float64_t result = linalg::dot(sg_vec1, sg_vec2);
+
+	sf->free_feature_vector(vec2, vec_idx2, free2);
+	return result;
+}
+
+template <class ST>
+void DenseIndexViewFeatures<ST>::add_to_dense_vec(
+    float64_t alpha, int32_t vec_idx1, float64_t* vec2, int32_t vec2_len,
+    bool abs_val) const
+{
+	ASSERT(vec2_len == this->num_features)
+	const ST* vec1 = vector_at(vec_idx1);
+
+	if (abs_val)
+	{
+		for (int32_t i = 0; i < vec2_len; i++)
+			vec2[i] += alpha * Math::abs(vec1[i]);
+	}
+	else
+	{
+		for (int32_t i = 0; i < vec2_len; i++)
+			vec2[i] += alpha * vec1[i];
+	}
+}
+
+template <class ST>
+template <typename IndexFunction>
+void DenseIndexViewFeatures<ST>::dense_dot_gather(
+    int32_t num, const IndexFunction& index, float64_t* output,
+    const float64_t* alphas, const float64_t* vec, int32_t dim,
+    float64_t b) const
+{
+	ASSERT(output)
+	ASSERT(dim == this->num_features)
+
+	const index_t* real_indices = m_indices.vector;
+	const ST* matrix = this->feature_matrix.matrix;
+	Map<const VectorXd> w(vec, dim);
+
+	int32_t num_blocks = (num + GATHER_BLOCK_SIZE - 1) / GATHER_BLOCK_SIZE;
+#pragma omp parallel num_threads(env()->get_num_threads())
+	{
+		MatrixXd block(dim, GATHER_BLOCK_SIZE);
+#pragma omp for schedule(static)
+		for (int32_t k = 0; k < num_blocks; ++k)
+		{
+			int32_t begin = k * GATHER_BLOCK_SIZE;
+			int32_t size = std::min(GATHER_BLOCK_SIZE, num - begin);
+			for (int32_t j = 0; j < size; ++j)
+			{
+				auto idx = index(begin + j);
+				if (real_indices)
+					idx = real_indices[idx];
+				const ST* x = matrix + int64_t(idx) * dim;
+				for (int32_t i = 0; i < dim; ++i)
+					block(i, j) = x[i];
+			}
+
+			VectorXd dots = block.leftCols(size).transpose() * w;
+			for (int32_t j = 0; j < size; ++j)
+			{
+				output[begin + j] =
+				    (alphas ? alphas[begin + j] * dots[j] : dots[j]) + b;
+			}
+		}
+	}
+}
+
+template <class ST>
+void DenseIndexViewFeatures<ST>::dense_dot_range(
+    float64_t* output, int32_t start, int32_t stop, float64_t* alphas,
+    float64_t* vec, int32_t dim, float64_t b) const
+{
+	ASSERT(start >= 0)
+	ASSERT(start < stop)
+	ASSERT(stop <= this->get_num_vectors())
+
+	dense_dot_gather(
+	    stop - start, [start](int32_t i) { return start + i; }, output,
+	    alphas, vec, dim, b);
+}
+
+template <class ST>
+void DenseIndexViewFeatures<ST>::dense_dot_range_subset(
+    int32_t* sub_index, int32_t num, float64_t* output, float64_t* alphas,
+    float64_t* vec, int32_t dim, float64_t b) const
+{
+	ASSERT(sub_index)
+	ASSERT(num > 0)
+
+	/* alphas are indexed by the vectors of the subset */
+	std::vector<float64_t> sub_alphas;
+	if (alphas)
+	{
+		sub_alphas.resize(num);
+		for (int32_t i = 0; i < num; ++i)
+			sub_alphas[i] = alphas[sub_index[i]];
+	}
+
+	dense_dot_gather(
+	    num, [sub_index](int32_t i) { return sub_index[i]; }, output,
+	    alphas ? sub_alphas.data() : nullptr, vec, dim, b);
+}
+
+namespace
+{
+	template <class ST>
+	std::shared_ptr<Features> dense_index_view_typed(
+	    const std::shared_ptr<Features>& features,
+	    const SGVector<index_t>& indices)
+	{
+		auto& features_ref = *features;
+		if (typeid(features_ref) != typeid(DenseFeatures<ST>) &&
+		    typeid(features_ref) != typeid(DenseIndexViewFeatures<ST>))
+			return nullptr;
+
+		auto dense = std::static_pointer_cast<DenseFeatures<ST>>(features);
+		int32_t num_feat, num_vec;
+		if (!dense->get_feature_matrix(num_feat, num_vec))
+			return nullptr;
+
+		return std::make_shared<DenseIndexViewFeatures<ST>>(dense, indices);
+	}
+} // namespace
+
+std::shared_ptr<Features> shogun::dense_index_view(
+    const std::shared_ptr<Features>& features,
+    const SGVector<index_t>& indices)
+{
+	if (!features || features->get_feature_class() != C_DENSE)
+		return nullptr;
+
+	switch (features->get_feature_type())
+	{
+	case F_BOOL:
+		return dense_index_view_typed<bool>(features, indices);
+	case F_CHAR:
+		return dense_index_view_typed<char>(features, indices);
+	case F_BYTE:
+		return dense_index_view_typed<uint8_t>(features, indices);
+	case F_SHORT:
+		return dense_index_view_typed<int16_t>(features, indices);
+	case F_WORD:
+		return dense_index_view_typed<uint16_t>(features, indices);
+	case F_INT:
+		return dense_index_view_typed<int32_t>(features, indices);
+	case F_UINT:
+		return dense_index_view_typed<uint32_t>(features, indices);
+	case F_LONG:
+		return dense_index_view_typed<int64_t>(features, indices);
+	case F_ULONG:
+		return dense_index_view_typed<uint64_t>(features, indices);
+	case F_SHORTREAL:
+		return dense_index_view_typed<float32_t>(features, indices);
+	case F_DREAL:
+		return dense_index_view_typed<float64_t>(features, indices);
+	case F_LONGREAL:
+		return dense_index_view_typed<floatmax_t>(features, indices);
+	default:
+		return nullptr;
+	}
+}
+
+template class shogun::DenseIndexViewFeatures<bool>;
+template class shogun::DenseIndexViewFeatures<char>;
+template class shogun::DenseIndexViewFeatures<int8_t>;
+template class shogun::DenseIndexViewFeatures<uint8_t>;
+template class shogun::DenseIndexViewFeatures<int16_t>;
+template class shogun::DenseIndexViewFeatures<uint16_t>;
+template class shogun::DenseIndexViewFeatures<int32_t>;
+template class shogun::DenseIndexViewFeatures<uint32_t>;
+template class shogun::DenseIndexViewFeatures<int64_t>;
+template class shogun::DenseIndexViewFeatures<uint64_t>;
+template class shogun::DenseIndexViewFeatures<float32_t>;
+template class shogun::DenseIndexViewFeatures<float64_t>;
+template class shogun::DenseIndexViewFeatures<floatmax_t>;
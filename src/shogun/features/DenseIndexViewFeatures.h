@@ -0,0 +1,171 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#ifndef _DENSEINDEXVIEWFEATURES__H__
+#define _DENSEINDEXVIEWFEATURES__H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/features/DenseFeatures.h>
+
+namespace shogun
+{
+
+/** @brief Dense features that are a view of a subset of the vectors of
+ * other dense features, sharing their feature matrix.
+ *
+ * Creating a view neither duplicates the viewed features nor copies their
+ * subset stack, it only composes the given indices with the active subset
+ * of the viewed features. The dot products of the view index the shared
+ * matrix through these composed indices directly: dense_dot_range() and
+ * dense_dot_range_subset() gather blocks of vectors into a buffer and
+ * compute their dot products with one matrix-vector product, in parallel
+ * over the blocks.
+ *
+ * The composed indices are also the one subset on the subset stack of the
+ * view, since the accessors of DenseFeatures such as get_feature_vector()
+ * and get_feature_matrix() are not virtual and index through that stack.
+ * Subsets added to the view are composed with it as usual.
+ *
+ * Only features that store their feature matrix can be viewed.
+ */
+template <class ST>
+class DenseIndexViewFeatures : public DenseFeatures<ST>
+{
+public:
+	/** default constructor */
+	DenseIndexViewFeatures();
+
+	/** constructor
+	 *
+	 * @param features features to view, with a feature matrix
+	 * @param indices indices of the viewed vectors of features, with
+	 * respect to its active subset
+	 */
+	DenseIndexViewFeatures(
+	    const std::shared_ptr<DenseFeatures<ST>>& features,
+	    const SGVector<index_t>& indices);
+
+	/** copy constructor */
+	DenseIndexViewFeatures(const DenseIndexViewFeatures& orig);
+
+	virtual ~DenseIndexViewFeatures();
+
+	/** duplicate feature object
+	 *
+	 * @return feature object
+	 */
+	virtual std::shared_ptr<Features> duplicate() const;
+
+	/** compute dot product between vector1 and a dense vector
+	 *
+	 * @param vec_idx1 index of first vector
+	 * @param vec2 dense vector
+	 */
+	virtual float64_t
+	dot(int32_t vec_idx1, const SGVector<float64_t>& vec2) const;
+
+	/** compute dot product between vector1 and vector2 of other dense
+	 * features of the same type
+	 *
+	 * @param vec_idx1 index of first vector
+	 * @param df DotFeatures (of same kind) to compute dot product with
+	 * @param vec_idx2 index of second vector
+	 */
+	virtual float64_t
+	dot(int32_t vec_idx1, std::shared_ptr<DotFeatures> df,
+	    int32_t vec_idx2) const;
+
+	/** add vector 1 multiplied with alpha to dense vector2
+	 *
+	 * @param alpha scalar alpha
+	 * @param vec_idx1 index of first vector
+	 * @param vec2 pointer to real valued vector
+	 * @param vec2_len length of real valued vector
+	 * @param abs_val if true add the absolute value
+	 */
+	virtual void add_to_dense_vec(
+	    float64_t alpha, int32_t vec_idx1, float64_t* vec2, int32_t vec2_len,
+	    bool abs_val = false) const;
+
+	/** Compute the dot product for a range of vectors
+	 *
+	 * @param output result for the given vector range
+	 * @param start start vector range from this idx
+	 * @param stop stop vector range at this idx
+	 * @param alphas scalars to multiply with, may be NULL
+	 * @param vec dense vector to compute dot product with
+	 * @param dim length of the dense vector
+	 * @param b bias
+	 */
+	virtual void dense_dot_range(
+	    float64_t* output, int32_t start, int32_t stop, float64_t* alphas,
+	    float64_t* vec, int32_t dim, float64_t b) const;
+
+	/** Compute the dot product for a subset of vectors
+	 *
+	 * @param sub_index index for which to compute outputs
+	 * @param num length of index
+	 * @param output result for the given vector range
+	 * @param alphas scalars to multiply with, may be NULL
+	 * @param vec dense vector to compute dot product with
+	 * @param dim length of the dense vector
+	 * @param b bias
+	 */
+	virtual void dense_dot_range_subset(
+	    int32_t* sub_index, int32_t num, float64_t* output, float64_t* alphas,
+	    float64_t* vec, int32_t dim, float64_t b) const;
+
+	/** @return object name */
+	virtual const char* get_name() const
+	{
+		return "DenseIndexViewFeatures";
+	}
+
+	/** updates the indices of the viewed vectors to the active subset */
+	virtual void subset_changed_post();
+
+private:
+	/** registers parameters */
+	void init();
+
+	/** @return pointer to a vector in the feature matrix
+	 *
+	 * @param idx index of the vector in the view
+	 */
+	inline const ST* vector_at(index_t idx) const
+	{
+		return this->feature_matrix.matrix +
+		       int64_t(m_indices.vector ? m_indices.vector[idx] : idx) *
+		           this->num_features;
+	}
+
+	/** Computes output[i]=alphas[i]*<x_j, vec>+b for the vectors x_j with
+	 * j=index(i), i=0..num-1, in blocks gathered into a buffer.
+	 */
+	template <typename IndexFunction>
+	void dense_dot_gather(
+	    int32_t num, const IndexFunction& index, float64_t* output,
+	    const float64_t* alphas, const float64_t* vec, int32_t dim,
+	    float64_t b) const;
+
+	/** indices of the viewed vectors in the feature matrix, empty if all
+	 * vectors are viewed */
+	SGVector<index_t> m_indices;
+};
+
+/** Creates a DenseIndexViewFeatures of features, if these are dense
+ * features with a feature matrix.
+ *
+ * @param features features to view
+ * @param indices indices of the viewed vectors
+ * @return view, or nullptr if features cannot be viewed this way
+ */
+std::shared_ptr<Features> dense_index_view(
+    const std::shared_ptr<Features>& features,
+    const SGVector<index_t>& indices);
+} // namespace shogun
+
+#endif // _DENSEINDEXVIEWFEATURES__H__
@@ -7,11 +7,13 @@
  */
 
 #include <shogun/base/Parallel.h>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/base/progress.h>
 #include <shogun/features/DotFeatures.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/lib/Signal.h>
 #include <shogun/lib/Time.h>
+#include <shogun/lib/Tracer.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 
@@ -46,6 +48,7 @@ DotFeatures::DotFeatures(std::shared_ptr<File> loader)
 
 void DotFeatures::dense_dot_range(float64_t* output, int32_t start, int32_t stop, float64_t* alphas, float64_t* vec, int32_t dim, float64_t b) const
 {
+	SG_TRACE_SCOPE("dot_features::dense_dot_range");
 	ASSERT(output)
 	ASSERT(start>=0)
 	ASSERT(start<stop)
@@ -76,6 +79,7 @@ void DotFeatures::dense_dot_range(float64_t* output, int32_t start, int32_t stop
 
 		int32_t t_start=thread_num*step;
 		int32_t t_stop=(thread_num==num_threads) ? num_vectors : (thread_num+1)*step;
+		SG_TRACE_SCOPE("dot_features::dense_dot_range_block");
 
 #ifdef WIN32
 		for (int32_t i=t_start; i<t_stop; i++)
@@ -143,6 +147,53 @@ void DotFeatures::dense_dot_range_subset(int32_t* sub_index, int32_t num, float6
 	pb.complete();
 }
 
+void DotFeatures::add_to_dense_vec_subset(int32_t* sub_index, int32_t num,
+		float64_t* alphas, float64_t* vec, int32_t dim) const
+{
+	ASSERT(sub_index)
+	ASSERT(alphas)
+	ASSERT(vec)
+
+	if (num<=0)
+		return;
+
+	// a block is worth its partial vector only for enough vectors
+	const int32_t min_block_size=1024;
+	const int32_t num_blocks=Math::max(1, Math::min(
+		env()->get_num_threads(), num/min_block_size));
+
+	// the first block adds directly to vec
+	SGMatrix<float64_t> partial;
+	if (num_blocks>1)
+		partial=SGMatrix<float64_t>(dim, num_blocks-1);
+
+#pragma omp parallel for schedule(static, 1) num_threads(num_blocks)
+	for (int32_t t=0; t<num_blocks; t++)
+	{
+		float64_t* dst=vec;
+		if (t>0)
+		{
+			dst=partial.matrix+int64_t(t-1)*dim;
+			memset(dst, 0, sizeof(float64_t)*dim);
+		}
+
+		const int32_t t_start=int64_t(num)*t/num_blocks;
+		const int32_t t_stop=int64_t(num)*(t+1)/num_blocks;
+		for (int32_t i=t_start; i<t_stop; i++)
+			add_to_dense_vec(alphas[sub_index[i]], sub_index[i], dst, dim);
+	}
+
+	if (num_blocks>1)
+	{
+#pragma omp parallel for schedule(static) num_threads(env()->get_num_threads())
+		for (int32_t j=0; j<dim; j++)
+		{
+			for (int32_t t=0; t<num_blocks-1; t++)
+				vec[j]+=partial(j, t);
+		}
+	}
+}
+
 SGMatrix<float64_t> DotFeatures::get_computed_dot_feature_matrix() const
 {
 
@@ -124,6 +124,22 @@ class DotFeatures : public Features
 		virtual void dense_dot_range_subset(int32_t* sub_index, int32_t num,
 				float64_t* output, float64_t* alphas, float64_t* vec, int32_t dim, float64_t b) const;
 
+		/** Add a subset of vectors multiplied with their alphas to a dense
+		 * vector, vec += sum_i alphas[sub_index[i]] * x[sub_index[i]]
+		 *
+		 * The subset is split into blocks that are accumulated in parallel,
+		 * each into a partial vector of its own, and the partial vectors are
+		 * summed into vec afterwards.
+		 *
+		 * @param sub_index indices of the vectors to add
+		 * @param num length of index
+		 * @param alphas scalars to multiply with, indexed by vector index
+		 * @param vec dense vector to add to
+		 * @param dim length of the dense vector
+		 */
+		virtual void add_to_dense_vec_subset(int32_t* sub_index, int32_t num,
+				float64_t* alphas, float64_t* vec, int32_t dim) const;
+
 		/** get number of non-zero features in vector
 		 *
 		 * (in case accurate estimates are too expensive overestimating is OK)
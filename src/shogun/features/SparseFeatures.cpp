@@ -1,3 +1,4 @@
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/lib/common.h>
 #include <shogun/lib/memory.h>
 #include <shogun/features/SparseFeatures.h>
@@ -5,8 +6,10 @@
 #include <shogun/mathematics/Math.h>
 #include <shogun/io/SGIO.h>
 
+#include <numeric>
 #include <string.h>
 #include <stdlib.h>
+#include <vector>
 
 namespace shogun
 {
@@ -212,6 +215,161 @@ void SparseFeatures<complex128_t>::add_to_dense_vec(float64_t alpha,
 	not_implemented(SOURCE_LOCATION);;
 }
 
+template<class ST> void SparseFeatures<ST>::dense_dot_range(float64_t* output,
+	int32_t start, int32_t stop, float64_t* alphas, float64_t* vec,
+	int32_t dim, float64_t b) const
+{
+	require(output, "dense_dot_range: output must not be NULL");
+	require(start>=0 && start<stop && stop<=get_num_vectors(),
+		"dense_dot_range(start={},stop={}): range exceeds [0;{}]",
+		start, stop, get_num_vectors());
+	require(dim>=get_num_features(),
+		"dense_dot_range(dim={}): dim should contain number of features {}",
+		dim, get_num_features());
+
+#pragma omp parallel for schedule(static) num_threads(env()->get_num_threads())
+	for (int32_t i=start; i<stop; i++)
+	{
+		SGSparseVector<ST> sv=get_sparse_feature_vector(i);
+
+		float64_t result=0;
+		for (int32_t k=0; k<sv.num_feat_entries; k++)
+			result+=vec[sv.features[k].feat_index]*sv.features[k].entry;
+
+		free_sparse_feature_vector(i);
+
+		if (alphas)
+			output[i-start]=alphas[i-start]*result+b;
+		else
+			output[i-start]=result+b;
+	}
+}
+
+template<>
+void SparseFeatures<complex128_t>::dense_dot_range(float64_t* output,
+	int32_t start, int32_t stop, float64_t* alphas, float64_t* vec,
+	int32_t dim, float64_t b) const
+{
+	not_implemented(SOURCE_LOCATION);;
+}
+
+template<class ST> SGMatrix<float64_t> SparseFeatures<ST>::dense_dot_matrix(
+	const SGMatrix<float64_t>& w) const
+{
+	require(w.num_rows>=get_num_features(),
+		"dense_dot_matrix(w={}x{}): rows should contain number of features {}",
+		w.num_rows, w.num_cols, get_num_features());
+
+	const int32_t num_vec=get_num_vectors();
+	SGMatrix<float64_t> result(num_vec, w.num_cols);
+
+#pragma omp parallel for schedule(static) num_threads(env()->get_num_threads())
+	for (int32_t i=0; i<num_vec; i++)
+	{
+		SGSparseVector<ST> sv=get_sparse_feature_vector(i);
+
+		for (index_t c=0; c<w.num_cols; c++)
+		{
+			const float64_t* w_col=w.matrix+int64_t(c)*w.num_rows;
+
+			float64_t dot=0;
+			for (int32_t k=0; k<sv.num_feat_entries; k++)
+				dot+=w_col[sv.features[k].feat_index]*sv.features[k].entry;
+
+			result(i, c)=dot;
+		}
+
+		free_sparse_feature_vector(i);
+	}
+
+	return result;
+}
+
+template<>
+SGMatrix<float64_t> SparseFeatures<complex128_t>::dense_dot_matrix(
+	const SGMatrix<float64_t>& w) const
+{
+	not_implemented(SOURCE_LOCATION);;
+	return SGMatrix<float64_t>();
+}
+
+template<class ST> SGMatrix<float64_t> SparseFeatures<ST>::sparse_dot_matrix(
+	const std::shared_ptr<SparseFeatures<ST>>& rhs) const
+{
+	require(rhs, "sparse_dot_matrix: rhs must not be NULL");
+
+	const int32_t num_feat=get_num_features();
+	const int32_t num_lhs=get_num_vectors();
+	const int32_t num_rhs=rhs->get_num_vectors();
+
+	// feature-major copy of the (subset) vectors, entries of one feature
+	// are ordered by vector index
+	std::vector<int64_t> offsets(num_feat+1, 0);
+	for (int32_t i=0; i<num_lhs; i++)
+	{
+		SGSparseVector<ST> sv=get_sparse_feature_vector(i);
+		for (int32_t k=0; k<sv.num_feat_entries; k++)
+		{
+			if (sv.features[k].feat_index<num_feat)
+				offsets[sv.features[k].feat_index+1]++;
+		}
+		free_sparse_feature_vector(i);
+	}
+	std::partial_sum(offsets.begin(), offsets.end(), offsets.begin());
+
+	std::vector<index_t> vec_index(offsets[num_feat]);
+	std::vector<float64_t> entries(offsets[num_feat]);
+	std::vector<int64_t> next(offsets.begin(), offsets.end()-1);
+	for (int32_t i=0; i<num_lhs; i++)
+	{
+		SGSparseVector<ST> sv=get_sparse_feature_vector(i);
+		for (int32_t k=0; k<sv.num_feat_entries; k++)
+		{
+			const int32_t f=sv.features[k].feat_index;
+			if (f<num_feat)
+			{
+				vec_index[next[f]]=i;
+				entries[next[f]]=sv.features[k].entry;
+				next[f]++;
+			}
+		}
+		free_sparse_feature_vector(i);
+	}
+
+	SGMatrix<float64_t> result(num_lhs, num_rhs);
+	result.zero();
+
+#pragma omp parallel for schedule(dynamic, 64) num_threads(env()->get_num_threads())
+	for (int32_t j=0; j<num_rhs; j++)
+	{
+		SGSparseVector<ST> sv=rhs->get_sparse_feature_vector(j);
+		float64_t* col=result.matrix+int64_t(j)*num_lhs;
+
+		for (int32_t k=0; k<sv.num_feat_entries; k++)
+		{
+			const int32_t f=sv.features[k].feat_index;
+			if (f>=num_feat)
+				continue;
+
+			const float64_t value=sv.features[k].entry;
+			for (int64_t p=offsets[f]; p<offsets[f+1]; p++)
+				col[vec_index[p]]+=entries[p]*value;
+		}
+
+		rhs->free_sparse_feature_vector(j);
+	}
+
+	return result;
+}
+
+template<>
+SGMatrix<float64_t> SparseFeatures<complex128_t>::sparse_dot_matrix(
+	const std::shared_ptr<SparseFeatures<complex128_t>>& rhs) const
+{
+	not_implemented(SOURCE_LOCATION);;
+	return SGMatrix<float64_t>();
+}
+
 template<class ST> void SparseFeatures<ST>::free_sparse_feature_vector(int32_t num) const
 {
 	if (feature_cache)
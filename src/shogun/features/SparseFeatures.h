@@ -166,6 +166,50 @@ template <class ST> class SparseFeatures : public DotFeatures
 		void add_to_dense_vec(float64_t alpha, int32_t num,
 				float64_t* vec, int32_t dim, bool abs_val=false) const;
 
+		/** compute alphas[i] * sparse[i]^T * w + b for a range of vectors,
+		 * row by row of the sparse matrix in parallel
+		 *
+		 * possible with subset
+		 *
+		 * @param output result for the given vector range
+		 * @param start start vector range from this idx
+		 * @param stop stop vector range at this idx
+		 * @param alphas scalars to multiply with, may be NULL
+		 * @param vec dense vector to compute dot product with
+		 * @param dim length of the dense vector
+		 * @param b bias
+		 */
+		virtual void dense_dot_range(float64_t* output, int32_t start,
+				int32_t stop, float64_t* alphas, float64_t* vec, int32_t dim,
+				float64_t b) const;
+
+		/** compute the dot products of all feature vectors with the
+		 * columns of a dense matrix, i.e. X*W with the feature vectors as
+		 * rows of X
+		 *
+		 * possible with subset
+		 *
+		 * @param w dense matrix with (at least) num_features rows
+		 * @return matrix of size num_vectors x w.num_cols
+		 */
+		SGMatrix<float64_t> dense_dot_matrix(const SGMatrix<float64_t>& w) const;
+
+		/** compute the dot products between all feature vectors of these
+		 * and of other sparse features, i.e. X*Y^T with the feature vectors
+		 * as rows
+		 *
+		 * A feature-major copy of these features is built, each column of
+		 * the result is then accumulated from the non-zero features of one
+		 * vector of rhs, in parallel over the vectors of rhs.
+		 *
+		 * possible with subsets on both sides
+		 *
+		 * @param rhs sparse features of the same type
+		 * @return matrix of size num_vectors x rhs->get_num_vectors()
+		 */
+		SGMatrix<float64_t> sparse_dot_matrix(
+				const std::shared_ptr<SparseFeatures<ST>>& rhs) const;
+
 		/** free sparse feature vector
 		 *
 		 * possible with subset
@@ -10,6 +10,7 @@
 #include <shogun/preprocessor/StringPreprocessor.h>
 #include <shogun/mathematics/RandomNamespace.h>
 
+#include <limits>
 #include <sys/types.h>
 #include <sys/stat.h>
 #include <stdio.h>
@@ -99,6 +100,9 @@ template<class ST> void StringFeatures<ST>::cleanup()
 	*/
 
 	features.clear();
+	contiguous_buffers.clear();
+	packed_strings=SGVector<uint64_t>();
+	packed_offsets=SGVector<int64_t>();
 	symbol_mask_table = SGVector<ST>();
 
 	/* start with a fresh alphabet, but instead of emptying the histogram
@@ -202,8 +206,14 @@ template<class ST> ST* StringFeatures<ST>::get_feature_vector(int32_t num, int32
 
 	if (!preprocess_on_get)
 	{
-		dofree=false;
 		len=features[real_num].vlen;
+		if (is_packed_string(real_num))
+		{
+			dofree=true;
+			return unpack_string(real_num);
+		}
+
+		dofree=false;
 		return features[real_num].vector;
 	}
 	else
@@ -316,6 +326,9 @@ template<class ST> int32_t StringFeatures<ST>::get_vector_length(int32_t vec_num
 {
 	ASSERT(vec_num<get_num_vectors())
 
+	if (!preprocess_on_get)
+		return features[m_subset_stack->subset_idx_conversion(vec_num)].vlen;
+
 	int32_t len;
 	bool free_vec;
 	ST* vec=get_feature_vector(vec_num, len, free_vec);
@@ -634,7 +647,21 @@ template<class ST> bool StringFeatures<ST>::load_fastq_file(const char* fname,
 		str=SG_MALLOC(ST, len);
 	}
 	else
-		strings.resize(num);
+	{
+		// store all reads in contiguous buffers, which needs their lengths
+		SGVector<index_t> lengths(num);
+		lengths.zero();
+		for (i=0; i<num; i++)
+		{
+			if (!f.get_line(len, offs) || !f.get_line(len, offs))
+				break;
+			lengths[i]=len;
+			if (!f.get_line(len, offs) || !f.get_line(len, offs))
+				break;
+		}
+		offs=0;
+		allocate_contiguous(lengths);
+	}
 
 	for (i=0;i<num; i++)
 	{
@@ -656,8 +683,7 @@ template<class ST> bool StringFeatures<ST>::load_fastq_file(const char* fname,
 		}
 		else
 		{
-			strings[i] = SGVector<ST>(len);
-			str=strings[i].vector;
+			str=features[i].vector;
 
 			if (ignore_invalid)
 			{
@@ -686,9 +712,10 @@ template<class ST> bool StringFeatures<ST>::load_fastq_file(const char* fname,
 	}
 
 	if (bitremap_in_single_string)
+	{
 		num=1;
-
-	features=std::move(strings);
+		features=std::move(strings);
+	}
 
 	return true;
 }
@@ -811,12 +838,11 @@ template<class ST> bool StringFeatures<ST>::append_features(std::shared_ptr<Stri
 	std::vector<SGVector<ST>> new_features;
 	new_features.reserve(sf->get_num_vectors());
 
+	// copies of the strings, unpacked if sf is packed
 	index_t sf_num_str=sf->get_num_vectors();
 	for (int32_t i=0; i<sf_num_str; i++)
-	{
-		int32_t real_i = sf->m_subset_stack->subset_idx_conversion(i);
-		new_features[i] = sf->features[real_i].clone();
-	}
+		new_features.push_back(sf->get_feature_vector(i));
+
 	return append_features(new_features);
 }
 
@@ -847,7 +873,7 @@ template<class ST> bool StringFeatures<ST>::append_features(const std::vector<SG
 		std::vector<SGVector<ST>> new_features;
 		new_features.reserve(num_vectors);
 
-		for (int32_t i=0; i<get_num_vectors(); i++)
+		for (int32_t i=0; i<num_vectors; i++)
 		{
 			if (i<old_num_vectors)
 				new_features.push_back(features[i]);
@@ -869,6 +895,10 @@ template<class ST> const std::vector<SGVector<ST>>& StringFeatures<ST>::get_stri
 	if (m_subset_stack->has_subsets())
 		error("get features() is not possible on subset");
 
+	// the strings of the list are accessed in place, packed ones have none
+	require(!is_packed(), "get_string_list() is not possible on packed strings, "
+		"call unpack() first");
+
 	return features;
 }
 
@@ -878,6 +908,198 @@ template<class ST> std::vector<SGVector<ST>>& StringFeatures<ST>::get_string_lis
 		std::as_const(*this).get_string_list());
 }
 
+template<class ST> bool StringFeatures<ST>::set_features(SGVector<ST> buffer, SGVector<index_t> offsets)
+{
+	require(offsets.vlen>0, "At least the end of the last string is required");
+
+	int32_t num_vectors=offsets.vlen-1;
+	std::vector<SGVector<ST>> strings;
+	strings.reserve(num_vectors);
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		require(offsets[i]>=0 && offsets[i]<=offsets[i+1] && offsets[i+1]<=buffer.vlen,
+			"String {} ({} to {}) is not in the buffer of length {}",
+			i, offsets[i], offsets[i+1], buffer.vlen);
+		strings.push_back(buffer.slice(offsets[i], offsets[i+1]));
+	}
+
+	if (!set_features(strings))
+		return false;
+
+	contiguous_buffers.push_back(buffer);
+	return true;
+}
+
+template<class ST> void StringFeatures<ST>::allocate_contiguous(const SGVector<index_t>& lengths)
+{
+	std::vector<SGVector<ST>> strings;
+	std::vector<SGVector<ST>> buffers;
+	strings.reserve(lengths.vlen);
+
+	// a buffer cannot be longer than index_t allows
+	const int64_t max_buffer_length=std::numeric_limits<index_t>::max();
+	for (int32_t first=0; first<lengths.vlen;)
+	{
+		int64_t buffer_length=0;
+		int32_t last=first;
+		while (last<lengths.vlen && buffer_length+lengths[last]<=max_buffer_length)
+			buffer_length+=lengths[last++];
+
+		SGVector<ST> buffer((index_t) buffer_length);
+		index_t offset=0;
+		for (int32_t i=first; i<last; i++)
+		{
+			strings.push_back(buffer.slice(offset, offset+lengths[i]));
+			offset+=lengths[i];
+		}
+		buffers.push_back(buffer);
+		first=last;
+	}
+
+	features=std::move(strings);
+	contiguous_buffers=std::move(buffers);
+}
+
+template<class ST> void StringFeatures<ST>::make_contiguous()
+{
+	if (m_subset_stack->has_subsets())
+		error("make_contiguous() is not possible on subset");
+
+	if (is_packed())
+	{
+		unpack();
+		return;
+	}
+
+	std::vector<SGVector<ST>> strings=std::move(features);
+	SGVector<index_t> lengths(strings.size());
+	for (index_t i=0; i<lengths.vlen; i++)
+		lengths[i]=strings[i].vlen;
+
+	// strings that were views of the old buffers are still kept alive here
+	auto buffers=std::move(contiguous_buffers);
+	allocate_contiguous(lengths);
+	for (index_t i=0; i<lengths.vlen; i++)
+		sg_memcpy(features[i].vector, strings[i].vector, lengths[i]*sizeof(ST));
+}
+
+/** @return symbol g of the packed symbols */
+static inline uint8_t get_packed_symbol(const uint64_t* packed, int64_t g)
+{
+	return (packed[g/32] >> (62-2*(g%32))) & 3;
+}
+
+/** @return the packed symbols p, ..., p+k-1 (k<=32) with the last symbol in
+ * the least significant bits
+ */
+static inline uint64_t get_packed_word(const uint64_t* packed, int64_t p, int32_t k)
+{
+	int64_t w=p/32;
+	int32_t shift=2*(p%32);
+	uint64_t word=packed[w] << shift;
+	if (shift>0 && shift+2*k>64)
+		word|=packed[w+1] >> (64-shift);
+	return word >> (64-2*k);
+}
+
+template<class ST> void StringFeatures<ST>::pack()
+{
+	if (m_subset_stack->has_subsets())
+		error("pack() is not possible on subset");
+	require(alphabet->get_alphabet()==DNA || alphabet->get_alphabet()==RNA,
+		"Only strings of DNA or RNA alphabet can be packed");
+
+	if (is_packed())
+		unpack();
+
+	int32_t num_vectors=features.size();
+	SGVector<int64_t> offsets(num_vectors+1);
+	offsets[0]=0;
+	for (int32_t i=0; i<num_vectors; i++)
+		offsets[i+1]=offsets[i]+features[i].vlen;
+
+	int64_t num_words=offsets[num_vectors]/32+1;
+	require(num_words<=std::numeric_limits<index_t>::max(),
+		"Too many symbols ({}) to pack", offsets[num_vectors]);
+	SGVector<uint64_t> packed((index_t) num_words);
+	packed.zero();
+
+	for (int32_t i=0; i<num_vectors; i++)
+	{
+		for (index_t j=0; j<features[i].vlen; j++)
+		{
+			uint8_t c=(uint8_t) features[i].vector[j];
+			require(alphabet->is_valid(c),
+				"Invalid symbol {} at position {} of string {}", (int32_t) c, j, i);
+
+			int64_t g=offsets[i]+j;
+			packed[g/32]|=((uint64_t) alphabet->remap_to_bin(c)) << (62-2*(g%32));
+		}
+		// keep the length for a string without data
+		features[i]=SGVector<ST>(NULL, features[i].vlen, false);
+	}
+
+	contiguous_buffers.clear();
+	packed_strings=packed;
+	packed_offsets=offsets;
+}
+
+template<class ST> void StringFeatures<ST>::unpack()
+{
+	if (m_subset_stack->has_subsets())
+		error("unpack() is not possible on subset");
+
+	if (!is_packed())
+		return;
+
+	// strings that were set after packing are copied too
+	std::vector<SGVector<ST>> strings=std::move(features);
+	auto buffers=std::move(contiguous_buffers);
+	SGVector<index_t> lengths(strings.size());
+	for (index_t i=0; i<lengths.vlen; i++)
+		lengths[i]=strings[i].vlen;
+
+	allocate_contiguous(lengths);
+	for (index_t i=0; i<lengths.vlen; i++)
+	{
+		if (strings[i].vector)
+		{
+			sg_memcpy(features[i].vector, strings[i].vector, lengths[i]*sizeof(ST));
+			continue;
+		}
+
+		for (index_t j=0; j<lengths[i]; j++)
+		{
+			features[i].vector[j]=(ST) alphabet->remap_to_char(
+				get_packed_symbol(packed_strings.vector, packed_offsets[i]+j));
+		}
+	}
+
+	packed_strings=SGVector<uint64_t>();
+	packed_offsets=SGVector<int64_t>();
+}
+
+template<class ST> bool StringFeatures<ST>::is_packed() const
+{
+	return packed_strings.vector!=NULL;
+}
+
+template<class ST> bool StringFeatures<ST>::is_packed_string(int32_t real_num) const
+{
+	return is_packed() && features[real_num].vector==NULL && features[real_num].vlen>0;
+}
+
+template<class ST> ST* StringFeatures<ST>::unpack_string(int32_t real_num) const
+{
+	index_t len=features[real_num].vlen;
+	int64_t offset=packed_offsets[real_num];
+	ST* str=SG_MALLOC(ST, len);
+	for (index_t j=0; j<len; j++)
+		str[j]=(ST) alphabet->remap_to_char(get_packed_symbol(packed_strings.vector, offset+j));
+
+	return str;
+}
+
 template<class ST> std::vector<SGVector<ST>> StringFeatures<ST>::copy_features()
 {
 	ASSERT(get_num_vectors()>0)
@@ -1059,6 +1281,7 @@ template<class ST> int32_t StringFeatures<ST>::obtain_by_sliding_window(int32_t
 {
 	if (m_subset_stack->has_subsets())
 		not_implemented(SOURCE_LOCATION);
+	require(!is_packed(), "Cannot use a sliding window on packed strings");
 
 	int32_t num_vectors = get_num_vectors();
 	int32_t max_string_length = get_max_vector_length();
@@ -1098,6 +1321,8 @@ template<class ST> int32_t StringFeatures<ST>::obtain_by_position_list(int32_t w
 	if (m_subset_stack->has_subsets())
 		not_implemented(SOURCE_LOCATION);
 
+	require(!is_packed(), "Cannot use a position list on packed strings");
+
 	int32_t num_vectors = get_num_vectors();
 	int32_t max_string_length = get_max_vector_length();
 
@@ -1179,6 +1404,7 @@ template<class ST> void StringFeatures<ST>::embed_features(int32_t p_order)
 {
 	if (m_subset_stack->has_subsets())
 		not_implemented(SOURCE_LOCATION);
+	require(!is_packed(), "Cannot embed packed strings");
 
 	ASSERT(alphabet->get_num_symbols_in_histogram() > 0)
 
@@ -1461,6 +1687,13 @@ template<class ST> std::shared_ptr<Features> StringFeatures<ST>::copy_subset(
 		index_t real_idx=m_subset_stack->subset_idx_conversion(indices.vector[i]);
 
 		/* copy string */
+		if (is_packed_string(real_idx))
+		{
+			list_copy[i]=SGVector<ST>(
+				unpack_string(real_idx), features[real_idx].vlen);
+			continue;
+		}
+
 		SGVector<ST> current_string=features[real_idx];
 		SGVector<ST> string_copy = current_string.clone();
 		list_copy[i]=string_copy;
@@ -1491,6 +1724,9 @@ template<class ST> ST* StringFeatures<ST>::compute_feature_vector(int32_t num, i
 	if (len<=0)
 		return NULL;
 
+	if (is_packed_string(real_num))
+		return unpack_string(real_num);
+
 	ST* target=SG_MALLOC(ST, len);
 	sg_memcpy(target, features[real_num].vector, len*sizeof(ST));
 	return target;
@@ -1516,6 +1752,8 @@ template<class ST> void StringFeatures<ST>::init()
 			"single_string",
 			"Created by sliding window.");*/
 	watch_param("single_string", &single_string);
+	watch_param("packed_strings", &packed_strings);
+	watch_param("packed_offsets", &packed_offsets);
 
 	SG_ADD(
 		&num_symbols, "num_symbols", "Number of used symbols.");
@@ -1786,6 +2024,7 @@ template<> void StringFeatures<sg_type>::save(std::shared_ptr<File> writer)		\
 {																			\
 	if (m_subset_stack->has_subsets())															\
 		error("save() is not possible on subset");						\
+	require(!is_packed(), "save() is not possible on packed strings");	\
 	SG_SET_LOCALE_C;													\
 	ASSERT(writer)															\
 	writer->f_write(features.data(), get_num_vectors());				\
@@ -1807,6 +2046,35 @@ SAVE(set_string_list, float64_t)
 SAVE(set_string_list, floatmax_t)
 #undef SAVE
 
+/** Computes the k-mers of a packed string like
+ * Alphabet::translate_from_single_order() (without gap) and drops the first
+ * start of them. Every k-mer is read from at most two words at once.
+ */
+template <class ST>
+static void translate_from_packed(
+	const uint64_t* packed, int64_t offset, int32_t len, int32_t start,
+	int32_t p_order, bool rev, ST* obs)
+{
+	for (int32_t i=start; i<len; i++)
+	{
+		// k-mers of the first positions are cut at the start of the string
+		int32_t k=Math::min(i+1, p_order);
+		uint64_t value=get_packed_word(packed, offset+i-k+1, k);
+
+		if (rev)
+		{
+			// reverse the order of the 2 bit symbols
+			value=((value >> 2) & 0x3333333333333333ULL) | ((value & 0x3333333333333333ULL) << 2);
+			value=((value >> 4) & 0x0F0F0F0F0F0F0F0FULL) | ((value & 0x0F0F0F0F0F0F0F0FULL) << 4);
+			value=((value >> 8) & 0x00FF00FF00FF00FFULL) | ((value & 0x00FF00FF00FF00FFULL) << 8);
+			value=((value >> 16) & 0x0000FFFF0000FFFFULL) | ((value & 0x0000FFFF0000FFFFULL) << 16);
+			value=(value >> 32) | (value << 32);
+			value>>=64-2*p_order;
+		}
+		obs[i-start]=(ST) value;
+	}
+}
+
 template <class ST> template <class CT>
 bool StringFeatures<ST>::obtain_from_char_features(std::shared_ptr<StringFeatures<CT>> sf, int32_t start,
 		int32_t p_order, int32_t gap, bool rev)
@@ -1822,23 +2090,14 @@ bool StringFeatures<ST>::obtain_from_char_features(std::shared_ptr<StringFeature
 
 	int32_t num_vectors=sf->get_num_vectors();
 	ASSERT(num_vectors>0)
-	features.reserve(num_vectors);
 
 	SG_DEBUG("{:1.0f} symbols in StringFeatures<*> {} symbols in histogram", sf->get_num_symbols(),
 			alpha->get_num_symbols_in_histogram());
 
+	SGVector<index_t> lengths(num_vectors);
 	for (int32_t i=0; i<num_vectors; i++)
-	{
-		int32_t len=-1;
-		bool vfree;
-		CT* c=sf->get_feature_vector(i, len, vfree);
-		ASSERT(!vfree) // won't work when preprocessors are attached
-
-		features.emplace_back(len);
-
-		for (int32_t j=0; j<len; j++)
-			features.back()[j]=(ST) alpha->remap_to_bin(c[j]);
-	}
+		lengths[i]=sf->get_vector_length(i);
+	allocate_contiguous(lengths);
 
 	original_num_symbols=alpha->get_num_symbols();
 	int32_t max_val=alpha->get_num_bits();
@@ -1858,15 +2117,29 @@ bool StringFeatures<ST>::obtain_from_char_features(std::shared_ptr<StringFeature
 	SG_DEBUG("translate: start={} order={} gap={}(size:{})", start, p_order, gap, sizeof(ST))
 	for (int32_t line=0; line<num_vectors; line++)
 	{
-		int32_t len=0;
-		bool vfree;
-		ST* fv=get_feature_vector(line, len, vfree);
-		ASSERT(!vfree) // won't work when preprocessors are attached
+		ST* fv=features[line].vector;
+		int32_t len=features[line].vlen;
+		int32_t real_line=sf->m_subset_stack->subset_idx_conversion(line);
 
-		if (rev)
-			Alphabet::translate_from_single_order_reversed(fv, len, start+gap, p_order+gap, max_val, gap);
+		if (gap==0 && sf->is_packed_string(real_line))
+		{
+			translate_from_packed(
+				sf->packed_strings.vector, sf->packed_offsets[real_line], len,
+				start, p_order, rev, fv);
+		}
 		else
-			Alphabet::translate_from_single_order(fv, len, start+gap, p_order+gap, max_val, gap);
+		{
+			bool vfree;
+			CT* c=sf->get_feature_vector(line, len, vfree);
+			for (int32_t j=0; j<len; j++)
+				fv[j]=(ST) alpha->remap_to_bin(c[j]);
+			sf->free_feature_vector(c, line, vfree);
+
+			if (rev)
+				Alphabet::translate_from_single_order_reversed(fv, len, start+gap, p_order+gap, max_val, gap);
+			else
+				Alphabet::translate_from_single_order(fv, len, start+gap, p_order+gap, max_val, gap);
+		}
 
 		/* fix the length of the string -- hacky */
 		features[line].vlen-=start+gap ;
@@ -391,6 +391,20 @@ template <class ST> class StringFeatures : public Features
 		 */
 		bool set_features(const SGVector<ST>* p_features, int32_t p_num_vectors);
 
+		/** set features from strings stored back to back in one buffer,
+		 * string i being buffer[offsets[i]], ..., buffer[offsets[i+1]-1]
+		 *
+		 * The strings are views of the buffer and no string is copied.
+		 *
+		 * not possible with subset
+		 *
+		 * @param buffer symbols of all strings
+		 * @param offsets start of every string in the buffer followed by the
+		 * end of the last string
+		 * @return if setting was successful
+		 */
+		bool set_features(SGVector<ST> buffer, SGVector<index_t> offsets);
+
 		/** append features
 		 * If the given string features have a subset, only this will be copied
 		 *
@@ -416,12 +430,18 @@ template <class ST> class StringFeatures : public Features
 		bool append_features(const std::vector<SGVector<ST>>& p_features);
 
 		/** returns a copy of the string_list vector (swig friendly)
+		 *
+		 * not possible with packed strings, see unpack()
+		 *
 		 * @return string_list
 		 */
 		const std::vector<SGVector<ST>>& get_string_list() const;
 
 #ifndef SWIG
 		/** get_string_list
+		 *
+		 * not possible with packed strings, see unpack()
+		 *
 		 * @return string_list
 		 */
 		std::vector<SGVector<ST>>& get_string_list();
@@ -437,6 +457,38 @@ template <class ST> class StringFeatures : public Features
 		 */
 		virtual std::vector<SGVector<ST>> copy_features();
 
+		/** Moves all strings into large contiguous buffers, which replaces
+		 * one allocation per string by a few allocations and keeps the
+		 * strings next to each other in memory. Packed strings are
+		 * unpacked.
+		 *
+		 * not possible with subset
+		 */
+		void make_contiguous();
+
+		/** Packs all strings of a DNA or RNA alphabet into 2 bits per
+		 * symbol, which needs a quarter of the memory of char strings.
+		 *
+		 * get_feature_vector() unpacks a packed string into a new vector
+		 * (of upper case symbols) that has to be freed with
+		 * free_feature_vector(). obtain_from_char() computes the k-mers
+		 * directly from the packed symbols. get_string_list() accesses
+		 * the strings in place and requires unpack() to be called first.
+		 * Setting or loading new strings drops the packed ones.
+		 *
+		 * not possible with subset
+		 */
+		void pack();
+
+		/** unpacks packed strings into contiguous buffers, see pack()
+		 *
+		 * not possible with subset
+		 */
+		void unpack();
+
+		/** @return whether the strings are packed, see pack() */
+		bool is_packed() const;
+
 		/** get_features  (swig compatible)
 		 *
 		 * possible with subset
@@ -636,9 +688,30 @@ template <class ST> class StringFeatures : public Features
 		 */
 		virtual ST* compute_feature_vector(int32_t num, int32_t& len);
 
+		/** @return whether a string is packed
+		 *
+		 * @param real_num index of the string, not respecting a subset
+		 */
+		bool is_packed_string(int32_t real_num) const;
+
+		/** unpacks a packed string
+		 *
+		 * @param real_num index of the string, not respecting a subset
+		 * @return unpacked string to be freed with SG_FREE
+		 */
+		ST* unpack_string(int32_t real_num) const;
+
+		/** replaces the strings by views of new contiguous buffers
+		 *
+		 * @param lengths lengths of the strings
+		 */
+		void allocate_contiguous(const SGVector<index_t>& lengths);
+
 	private:
 		void init();
 
+		template <class> friend class StringFeatures;
+
 	protected:
 		/** alphabet */
 		std::shared_ptr<Alphabet> alphabet;
@@ -649,6 +722,17 @@ template <class ST> class StringFeatures : public Features
 		/** true when single string / created by sliding window */
 		SGVector<ST> single_string;
 
+		/** buffers the strings are views of when stored contiguously */
+		std::vector<SGVector<ST>> contiguous_buffers;
+
+		/** symbols of the packed strings, 32 per word with the first
+		 * symbol in the most significant bits
+		 */
+		SGVector<uint64_t> packed_strings;
+
+		/** offset of the first symbol of every packed string */
+		SGVector<int64_t> packed_offsets;
+
 		/// number of used symbols
 		floatmax_t num_symbols;
 
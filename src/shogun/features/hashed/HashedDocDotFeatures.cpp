@@ -4,16 +4,94 @@
  * Authors: Sergey Lisitsyn
  */
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/features/hashed/HashedDocDotFeatures.h>
 #include <shogun/lib/DelimiterTokenizer.h>
 #include <shogun/lib/Hash.h>
 #include <shogun/mathematics/Math.h>
 
+#include <algorithm>
 #include <cmath>
 #include <utility>
+#include <vector>
 
 namespace shogun
 {
+namespace
+{
+	/** Tokenizes a document and calls f with the hashed index of every
+	 * token and combination of tokens, as HashedDocConverter::apply()
+	 * does.
+	 */
+	template <typename F>
+	void for_each_hashed_index(
+	    const SGVector<char>& sv, const std::shared_ptr<Tokenizer>& tzer,
+	    int32_t num_bits, int32_t ngrams, int32_t tokens_to_skip, F&& f)
+	{
+		/** this vector will maintain the current n+k active tokens
+		 * in a circular manner */
+		SGVector<uint32_t> hashes(ngrams+tokens_to_skip);
+		index_t hashes_start = 0;
+		index_t hashes_end = 0;
+		index_t len = hashes.vlen - 1;
+
+		/** the combinations generated from the current active tokens will be
+		 * stored here to avoid creating new objects */
+		SGVector<index_t> hashed_indices((ngrams-1)*(tokens_to_skip+1) + 1);
+
+		auto local_tzer = tzer->get_copy();
+
+		/** Reading n+k-1 tokens */
+		const int32_t seed = 0xdeadbeaf;
+		local_tzer->set_text(sv);
+		index_t start = 0;
+		while (hashes_end<ngrams-1+tokens_to_skip && local_tzer->has_next())
+		{
+			index_t end = local_tzer->next_token_idx(start);
+			uint32_t token_hash = Hash::MurmurHash3((uint8_t* ) &sv.vector[start], end-start, seed);
+			hashes[hashes_end++] = token_hash;
+		}
+
+		/** Reading token and storing indices to hashed_indices */
+		while (local_tzer->has_next())
+		{
+			index_t end = local_tzer->next_token_idx(start);
+			uint32_t token_hash = Hash::MurmurHash3((uint8_t* ) &sv.vector[start], end-start, seed);
+			hashes[hashes_end] = token_hash;
+
+			HashedDocConverter::generate_ngram_hashes(hashes, hashes_start, len, hashed_indices,
+					num_bits, ngrams, tokens_to_skip);
+
+			for (index_t i=0; i<hashed_indices.vlen; i++)
+				f(hashed_indices[i]);
+
+			hashes_start++;
+			hashes_end++;
+			if (hashes_end==hashes.vlen)
+				hashes_end = 0;
+			if (hashes_start==hashes.vlen)
+				hashes_start = 0;
+		}
+
+		if (ngrams>1)
+		{
+			while (hashes_start!=hashes_end)
+			{
+				len--;
+				index_t max_idx = HashedDocConverter::generate_ngram_hashes(hashes, hashes_start,
+						len, hashed_indices, num_bits, ngrams, tokens_to_skip);
+
+				for (index_t i=0; i<max_idx; i++)
+					f(hashed_indices[i]);
+
+				hashes_start++;
+				if (hashes_start==hashes.vlen)
+					hashes_start = 0;
+			}
+		}
+	}
+} // namespace
+
 HashedDocDotFeatures::HashedDocDotFeatures(int32_t hash_bits, std::shared_ptr<StringFeatures<char>> docs,
 	std::shared_ptr<Tokenizer> tzer, bool normalize, int32_t n_grams, int32_t skips, int32_t size) : DotFeatures(size)
 {
@@ -31,6 +109,10 @@ HashedDocDotFeatures::HashedDocDotFeatures(const HashedDocDotFeatures& orig)
 {
 	init(orig.num_bits, orig.doc_collection, orig.tokenizer, orig.should_normalize,
 			orig.ngrams, orig.tokens_to_skip);
+	m_index_offsets = orig.m_index_offsets;
+	m_index_features = orig.m_index_features;
+	m_index_counts = orig.m_index_counts;
+	m_index_scales = orig.m_index_scales;
 }
 
 HashedDocDotFeatures::HashedDocDotFeatures(const std::shared_ptr<File>& loader)
@@ -62,8 +144,9 @@ void HashedDocDotFeatures::init(int32_t hash_bits, std::shared_ptr<StringFeature
 	SG_ADD((std::shared_ptr<SGObject>*) &tokenizer, "tokenizer", "Document tokenizer");
 	SG_ADD(&should_normalize, "should_normalize", "Normalize or not the dot products");
 
-
-
+	for (auto name : {"num_bits", "ngrams", "tokens_to_skip", "doc_collection",
+			"tokenizer", "should_normalize"})
+		add_callback_function(name, [this]() { clear_index(); });
 }
 
 HashedDocDotFeatures::~HashedDocDotFeatures()
@@ -84,6 +167,28 @@ float64_t HashedDocDotFeatures::dot(int32_t vec_idx1, std::shared_ptr<DotFeature
 
 	auto hddf = std::static_pointer_cast<HashedDocDotFeatures>(df);
 
+	if (is_indexed(vec_idx1) && hddf->is_indexed(vec_idx2))
+	{
+		/** merge of the sorted indices of both documents */
+		int64_t i1 = m_index_offsets[vec_idx1];
+		int64_t i2 = hddf->m_index_offsets[vec_idx2];
+		const int64_t end1 = m_index_offsets[vec_idx1 + 1];
+		const int64_t end2 = hddf->m_index_offsets[vec_idx2 + 1];
+		float64_t result = 0;
+		while (i1 < end1 && i2 < end2)
+		{
+			uint32_t f1 = m_index_features[i1];
+			uint32_t f2 = hddf->m_index_features[i2];
+			if (f1 == f2)
+				result += (float64_t)m_index_counts[i1++] * hddf->m_index_counts[i2++];
+			else if (f1 < f2)
+				i1++;
+			else
+				i2++;
+		}
+		return result * m_index_scales[vec_idx1] * hddf->m_index_scales[vec_idx2];
+	}
+
 	SGVector<char> sv1 = doc_collection->get_feature_vector(vec_idx1);
 	SGVector<char> sv2 = hddf->doc_collection->get_feature_vector(vec_idx2);
 
@@ -105,70 +210,18 @@ float64_t HashedDocDotFeatures::dot(
 {
 	ASSERT(vec2.size() == std::pow(2,num_bits))
 
-	SGVector<char> sv = doc_collection->get_feature_vector(vec_idx1);
-
-	/** this vector will maintain the current n+k active tokens
-	 * in a circular manner */
-	SGVector<uint32_t> hashes(ngrams+tokens_to_skip);
-	index_t hashes_start = 0;
-	index_t hashes_end = 0;
-	int32_t len = hashes.vlen - 1;
-
-	/** the combinations generated from the current active tokens will be
-	 * stored here to avoid creating new objects */
-	SGVector<index_t> hashed_indices((ngrams-1)*(tokens_to_skip+1) + 1);
-
 	float64_t result = 0;
-	auto local_tzer = tokenizer->get_copy();
-
-	/** Reading n+k-1 tokens */
-	const int32_t seed = 0xdeadbeaf;
-	local_tzer->set_text(sv);
-	index_t start = 0;
-	while (hashes_end<ngrams-1+tokens_to_skip && local_tzer->has_next())
+	if (is_indexed(vec_idx1))
 	{
-		index_t end = local_tzer->next_token_idx(start);
-		uint32_t token_hash = Hash::MurmurHash3((uint8_t* ) &sv.vector[start], end-start, seed);
-		hashes[hashes_end++] = token_hash;
-	}
+		for (int64_t i = m_index_offsets[vec_idx1]; i < m_index_offsets[vec_idx1 + 1]; i++)
+			result += m_index_counts[i] * vec2[m_index_features[i]];
 
-	/** Reading token and storing indices to hashed_indices */
-	while (local_tzer->has_next())
-	{
-		index_t end = local_tzer->next_token_idx(start);
-		uint32_t token_hash = Hash::MurmurHash3((uint8_t* ) &sv.vector[start], end-start, seed);
-		hashes[hashes_end] = token_hash;
-
-		HashedDocConverter::generate_ngram_hashes(hashes, hashes_start, len, hashed_indices,
-				num_bits, ngrams, tokens_to_skip);
-
-		for (index_t i=0; i<hashed_indices.vlen; i++)
-			result += vec2[hashed_indices[i]];
-
-		hashes_start++;
-		hashes_end++;
-		if (hashes_end==hashes.vlen)
-			hashes_end = 0;
-		if (hashes_start==hashes.vlen)
-			hashes_start = 0;
+		return result * m_index_scales[vec_idx1];
 	}
 
-	if (ngrams>1)
-	{
-		while (hashes_start!=hashes_end)
-		{
-			len--;
-			index_t max_idx = HashedDocConverter::generate_ngram_hashes(hashes, hashes_start,
-					len, hashed_indices, num_bits, ngrams, tokens_to_skip);
-
-			for (index_t i=0; i<max_idx; i++)
-				result += vec2[hashed_indices[i]];
-
-			hashes_start++;
-			if (hashes_start==hashes.vlen)
-				hashes_start = 0;
-		}
-	}
+	SGVector<char> sv = doc_collection->get_feature_vector(vec_idx1);
+	for_each_hashed_index(sv, tokenizer, num_bits, ngrams, tokens_to_skip,
+			[&](index_t idx) { result += vec2[idx]; });
 	doc_collection->free_feature_vector(sv, vec_idx1);
 
 	return should_normalize ? result / std::sqrt((float64_t)sv.size()) : result;
@@ -182,73 +235,118 @@ void HashedDocDotFeatures::add_to_dense_vec(float64_t alpha, int32_t vec_idx1,
 	if (abs_val)
 		alpha = Math::abs(alpha);
 
+	if (is_indexed(vec_idx1))
+	{
+		const float64_t value = alpha * m_index_scales[vec_idx1];
+		for (int64_t i = m_index_offsets[vec_idx1]; i < m_index_offsets[vec_idx1 + 1]; i++)
+			vec2[m_index_features[i]] += m_index_counts[i] * value;
+
+		return;
+	}
+
 	SGVector<char> sv = doc_collection->get_feature_vector(vec_idx1);
 	const float64_t value =
 		should_normalize ? alpha / std::sqrt((float64_t)sv.size()) : alpha;
 
-	/** this vector will maintain the current n+k active tokens
-	 * in a circular manner */
-	SGVector<uint32_t> hashes(ngrams+tokens_to_skip);
-	index_t hashes_start = 0;
-	index_t hashes_end = 0;
-	index_t len = hashes.vlen - 1;
-
-	/** the combinations generated from the current active tokens will be
-	 * stored here to avoid creating new objects */
-	SGVector<index_t> hashed_indices((ngrams-1)*(tokens_to_skip+1) + 1);
+	for_each_hashed_index(sv, tokenizer, num_bits, ngrams, tokens_to_skip,
+			[&](index_t idx) { vec2[idx] += value; });
 
-	auto local_tzer = tokenizer->get_copy();
+	doc_collection->free_feature_vector(sv, vec_idx1);
 
-	/** Reading n+k-1 tokens */
-	const int32_t seed = 0xdeadbeaf;
-	local_tzer->set_text(sv);
-	index_t start = 0;
-	while (hashes_end<ngrams-1+tokens_to_skip && local_tzer->has_next())
-	{
-		index_t end = local_tzer->next_token_idx(start);
-		uint32_t token_hash = Hash::MurmurHash3((uint8_t* ) &sv.vector[start], end-start, seed);
-		hashes[hashes_end++] = token_hash;
-	}
+}
 
-	while (local_tzer->has_next())
+void HashedDocDotFeatures::build_index(int64_t max_bytes)
+{
+	require(doc_collection, "No document collection to index");
+	require(!doc_collection->get_subset_stack()->has_subsets(),
+		"Cannot index a document collection with a subset");
+	clear_index();
+
+	const int32_t num_docs = get_num_vectors();
+	const int32_t block_size = 1024;
+	const int64_t doc_bytes = sizeof(int64_t) + sizeof(float64_t);
+	const int64_t entry_bytes = 2 * sizeof(uint32_t);
+
+	std::vector<int64_t> offsets(1, 0);
+	std::vector<uint32_t> features;
+	std::vector<uint32_t> counts;
+	std::vector<float64_t> scales;
+	int64_t num_bytes = doc_bytes;
+
+	/** documents are hashed in parallel a block at a time and appended in
+	 * order until the budget is exhausted */
+	std::vector<std::vector<std::pair<uint32_t, uint32_t>>> block(block_size);
+	std::vector<float64_t> block_scales(block_size);
+	bool full = false;
+	for (int32_t begin = 0; begin < num_docs && !full; begin += block_size)
 	{
-		index_t end = local_tzer->next_token_idx(start);
-		uint32_t token_hash = Hash::MurmurHash3((uint8_t* ) &sv.vector[start], end-start, seed);
-		hashes[hashes_end] = token_hash;
-
-		HashedDocConverter::generate_ngram_hashes(hashes, hashes_start, len, hashed_indices,
-				num_bits, ngrams, tokens_to_skip);
-
-		for (index_t i=0; i<hashed_indices.vlen; i++)
-			vec2[hashed_indices[i]] += value;
-
-		hashes_start++;
-		hashes_end++;
-		if (hashes_end==hashes.vlen)
-			hashes_end = 0;
-		if (hashes_start==hashes.vlen)
-			hashes_start = 0;
-	}
+		const int32_t end = std::min(begin + block_size, num_docs);
 
-	if (ngrams>1)
-	{
-		while (hashes_start!=hashes_end)
+#pragma omp parallel for num_threads(env()->get_num_threads())
+		for (int32_t i = begin; i < end; i++)
 		{
-			len--;
-			index_t max_idx = HashedDocConverter::generate_ngram_hashes(hashes,
-					hashes_start, len, hashed_indices, num_bits, ngrams, tokens_to_skip);
-
-			for (index_t i=0; i<max_idx; i++)
-				vec2[hashed_indices[i]] += value;
+			SGVector<char> sv = doc_collection->get_feature_vector(i);
+			std::vector<uint32_t> hashed;
+			for_each_hashed_index(sv, tokenizer, num_bits, ngrams, tokens_to_skip,
+					[&hashed](index_t idx) { hashed.push_back(idx); });
+			block_scales[i - begin] = should_normalize ? 1.0 / std::sqrt((float64_t)sv.size()) : 1.0;
+			doc_collection->free_feature_vector(sv, i);
+
+			std::sort(hashed.begin(), hashed.end());
+			auto& entries = block[i - begin];
+			entries.clear();
+			for (auto idx : hashed)
+			{
+				if (!entries.empty() && entries.back().first == idx)
+					entries.back().second++;
+				else
+					entries.emplace_back(idx, 1);
+			}
+		}
 
-			hashes_start++;
-			if (hashes_start==hashes.vlen)
-				hashes_start = 0;
+		for (int32_t i = begin; i < end; i++)
+		{
+			const auto& entries = block[i - begin];
+			int64_t bytes = doc_bytes + entry_bytes * entries.size();
+			if (max_bytes > 0 && num_bytes + bytes > max_bytes)
+			{
+				full = true;
+				break;
+			}
+			num_bytes += bytes;
+
+			for (const auto& entry : entries)
+			{
+				features.push_back(entry.first);
+				counts.push_back(entry.second);
+			}
+			offsets.push_back(features.size());
+			scales.push_back(block_scales[i - begin]);
 		}
 	}
 
-	doc_collection->free_feature_vector(sv, vec_idx1);
+	m_index_offsets = SGVector<int64_t>(offsets.size());
+	std::copy(offsets.begin(), offsets.end(), m_index_offsets.begin());
+	m_index_features = SGVector<uint32_t>(features.size());
+	std::copy(features.begin(), features.end(), m_index_features.begin());
+	m_index_counts = SGVector<uint32_t>(counts.size());
+	std::copy(counts.begin(), counts.end(), m_index_counts.begin());
+	m_index_scales = SGVector<float64_t>(scales.size());
+	std::copy(scales.begin(), scales.end(), m_index_scales.begin());
+
+	if (m_index_scales.vlen < num_docs)
+		io::info(
+		    "Indexed {} of {} documents in {} bytes, the others are hashed "
+		    "on the fly",
+		    m_index_scales.vlen, num_docs, num_bytes);
+}
 
+void HashedDocDotFeatures::clear_index()
+{
+	m_index_offsets = SGVector<int64_t>();
+	m_index_features = SGVector<uint32_t>();
+	m_index_counts = SGVector<uint32_t>();
+	m_index_scales = SGVector<float64_t>();
 }
 
 uint32_t HashedDocDotFeatures::calculate_token_hash(char* token,
@@ -260,12 +358,15 @@ uint32_t HashedDocDotFeatures::calculate_token_hash(char* token,
 
 void HashedDocDotFeatures::set_doc_collection(std::shared_ptr<StringFeatures<char>> docs)
 {
-
+	clear_index();
 	doc_collection = std::move(docs);
 }
 
 int32_t HashedDocDotFeatures::get_nnz_features_for_vector(int32_t num) const
 {
+	if (is_indexed(num))
+		return m_index_offsets[num + 1] - m_index_offsets[num];
+
 	SGVector<char> sv = doc_collection->get_feature_vector(num);
 	int32_t num_nnz_features = sv.size();
 	doc_collection->free_feature_vector(sv, num);
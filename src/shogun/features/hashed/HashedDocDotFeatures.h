@@ -30,6 +30,11 @@ class Tokenizer;
  * The latter implements a k-skip n-grams approach, meaning that you can combine up to n tokens, while skipping up to k.
  * Eg. for the tokens ["a", "b", "c", "d"], with n_grams = 2 and skips = 2, one would get the following combinations :
  * ["a", "ab", "ac" (skipped 1), "ad" (skipped 2), "b", "bc", "bd" (skipped 1), "c", "cd", "d"].
+ *
+ * By default every dot product tokenizes and hashes the document again. When the collection
+ * is used for more than one pass, e.g. by a linear learner, build_index() hashes it once into
+ * a compressed sparse row index of hashed indices and counts, which dot products and
+ * add_to_dense_vec() then read directly.
  */
 class HashedDocDotFeatures: public DotFeatures
 {
@@ -144,6 +149,25 @@ public:
 	 */
 	void set_doc_collection(std::shared_ptr<StringFeatures<char>> docs);
 
+	/** Hashes the documents in parallel into an index of their hashed indices and counts.
+	 * Documents are indexed in order as long as the index fits into the memory budget,
+	 * the remaining ones are still hashed on every access. Changing the document
+	 * collection, the tokenizer or the hashing parameters removes the index, and it is
+	 * not used while the document collection has a subset.
+	 *
+	 * @param max_bytes memory budget of the index in bytes, 0 for no limit
+	 */
+	void build_index(int64_t max_bytes=0);
+
+	/** Removes the index, so documents are hashed on every access again */
+	void clear_index();
+
+	/** @return number of leading documents in the index */
+	inline int32_t get_num_indexed() const
+	{
+		return m_index_scales.vlen;
+	}
+
 	virtual const char* get_name() const;
 
 	/** duplicate feature object
@@ -182,6 +206,13 @@ public:
 			int32_t num_bits, uint32_t seed);
 
 private:
+	/** @return whether the document is in the index */
+	inline bool is_indexed(int32_t num) const
+	{
+		return num < m_index_scales.vlen &&
+			!doc_collection->get_subset_stack()->has_subsets();
+	}
+
 	void init(int32_t hash_bits, std::shared_ptr<StringFeatures<char>> docs, std::shared_ptr<Tokenizer> tzer,
 		bool normalize, int32_t n_grams, int32_t skips);
 
@@ -203,6 +234,18 @@ protected:
 
 	/** tokens to skip when combining tokens */
 	int32_t tokens_to_skip;
+
+	/** start of every indexed document in the index, followed by the end */
+	SGVector<int64_t> m_index_offsets;
+
+	/** sorted distinct hashed indices of the indexed documents */
+	SGVector<uint32_t> m_index_features;
+
+	/** number of occurrences of every hashed index */
+	SGVector<uint32_t> m_index_counts;
+
+	/** normalization factor of every indexed document */
+	SGVector<float64_t> m_index_scales;
 };
 }
 
@@ -14,6 +14,7 @@
 #include <shogun/io/SGIO.h>
 #include <shogun/io/streaming/StreamingFile.h>
 #include <shogun/io/streaming/ParseBuffer.h>
+#include <shogun/lib/Tracer.h>
 #include <condition_variable>
 #include <memory>
 #include <mutex>
@@ -517,15 +518,21 @@ template <class T> void* InputParser<T>::main_parse_loop(void* params)
 		}
 		lock.unlock();
 
-		current_example = examples_ring->get_free_example();
+		{
+			SG_TRACE_SCOPE("input_parser::wait_free_example");
+			current_example = examples_ring->get_free_example();
+		}
 		current_feature_vector = current_example->fv;
 		current_len = current_example->length;
 		current_label = current_example->label;
 
-		if (example_type == E_LABELLED)
-			get_vector_and_label(current_feature_vector, current_len, current_label);
-		else
-			get_vector_only(current_feature_vector,	current_len);
+		{
+			SG_TRACE_SCOPE("input_parser::parse_example");
+			if (example_type == E_LABELLED)
+				get_vector_and_label(current_feature_vector, current_len, current_label);
+			else
+				get_vector_only(current_feature_vector,	current_len);
+		}
 
 		if (current_len < 0)
 		{
@@ -605,6 +612,7 @@ template <class T> int32_t InputParser<T>::get_next_example(T* &fv,
             else
             {
                 /* Examples left, wait for one to become ready */
+				SG_TRACE_SCOPE("input_parser::wait_example");
 				examples_state_changed.wait(lock);
                 continue;
             }
@@ -10,6 +10,8 @@
 #include <shogun/io/SGIO.h>
 #include <shogun/lib/Signal.h>
 #include <shogun/base/Parallel.h>
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/base/progress.h>
 #include <shogun/kernel/Kernel.h>
 #include <shogun/kernel/CombinedKernel.h>
 #include <shogun/kernel/CustomKernel.h>
@@ -18,6 +20,9 @@
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/eigen3.h>
 
+#include <utility>
+#include <vector>
+
 using namespace shogun;
 using namespace Eigen;
 
@@ -69,6 +74,7 @@ bool CombinedKernel::init_with_extracted_subsets(
 	if (!l_combined || !r_combined)
 		error("Cast failed - unsupported features passed");
 
+	m_subkernel_matrices = SGVector<float32_t>();
 	Kernel::init(l, r);
 	ASSERT(l->get_feature_type() == F_UNKNOWN)
 	ASSERT(r->get_feature_type() == F_UNKNOWN)
@@ -171,6 +177,9 @@ bool CombinedKernel::init_with_extracted_subsets(
 		    "CombinedKernel: Number of features/kernels does not match - "
 		    "bailing out");
 
+	if (m_precompute_subkernel_matrices)
+		compute_subkernel_matrices();
+
 	init_normalizer();
 	initialized = true;
 	return true;
@@ -234,12 +243,13 @@ bool CombinedKernel::init(std::shared_ptr<Features> l, std::shared_ptr<Features>
 		 * subsets present!
 		 */
 		combined_l = std::make_shared<CombinedFeatures>();
-		combined_r = std::make_shared<CombinedFeatures>();
+		combined_r = l == r ? combined_l : std::make_shared<CombinedFeatures>();
 
 		for (index_t i = 0; i < get_num_subkernels(); ++i)
 		{
 			combined_l->append_feature_obj(l);
-			combined_r->append_feature_obj(r);
+			if (combined_r != combined_l)
+				combined_r->append_feature_obj(r);
 		}
 	}
 	else
@@ -254,6 +264,7 @@ bool CombinedKernel::init(std::shared_ptr<Features> l, std::shared_ptr<Features>
 
 void CombinedKernel::remove_lhs()
 {
+	m_subkernel_matrices = SGVector<float32_t>();
 	delete_optimization();
 
 	for (index_t k_idx=0; k_idx<get_num_kernels(); k_idx++)
@@ -271,6 +282,7 @@ void CombinedKernel::remove_lhs()
 
 void CombinedKernel::remove_rhs()
 {
+	m_subkernel_matrices = SGVector<float32_t>();
 	delete_optimization();
 
 	for (index_t k_idx=0; k_idx<get_num_kernels(); k_idx++)
@@ -288,6 +300,7 @@ void CombinedKernel::remove_rhs()
 
 void CombinedKernel::remove_lhs_and_rhs()
 {
+	m_subkernel_matrices = SGVector<float32_t>();
 	delete_optimization();
 
 	for (index_t k_idx=0; k_idx<get_num_kernels(); k_idx++)
@@ -307,6 +320,7 @@ void CombinedKernel::remove_lhs_and_rhs()
 
 void CombinedKernel::cleanup()
 {
+	m_subkernel_matrices = SGVector<float32_t>();
 	for (index_t k_idx=0; k_idx<get_num_kernels(); k_idx++)
 	{
 		auto k = get_kernel(k_idx);
@@ -338,6 +352,17 @@ void CombinedKernel::list_kernels()
 
 float64_t CombinedKernel::compute(int32_t x, int32_t y)
 {
+	if (has_subkernel_matrices())
+	{
+		auto num_kernels = m_subkernel_matrix_weights.vlen;
+		Map<const VectorXf> values(
+		    m_subkernel_matrices.vector + subkernel_matrices_offset(x, y),
+		    num_kernels);
+		Map<const VectorXd> weights(
+		    m_subkernel_matrix_weights.vector, num_kernels);
+		return values.cast<float64_t>().dot(weights);
+	}
+
 	float64_t result=0;
 	for (index_t k_idx=0; k_idx<get_num_kernels(); k_idx++)
 	{
@@ -432,6 +457,20 @@ void CombinedKernel::compute_batch(
 	ASSERT(vec_idx)
 	ASSERT(result)
 
+	if (has_subkernel_matrices())
+	{
+		#pragma omp parallel for
+		for (int32_t i=0; i<num_vec; i++)
+		{
+			float64_t sub_result=0;
+			for (int32_t j=0; j<num_suppvec; j++)
+				sub_result += weights[j] * compute(IDX[j], vec_idx[i]);
+
+			result[i] += factor*sub_result;
+		}
+		return;
+	}
+
 	//we have to do the optimization business ourselves but lets
 	//make sure we start cleanly
 	delete_optimization();
@@ -684,6 +723,9 @@ void CombinedKernel::set_subkernel_weights(SGVector<float64_t> weights)
 
 			i++ ;
 		}
+
+		if (has_subkernel_matrices())
+			update_subkernel_matrix_weights();
 	}
 }
 
@@ -721,6 +763,141 @@ bool CombinedKernel::precompute_subkernels()
 	return true;
 }
 
+void CombinedKernel::set_precompute_subkernel_matrices(bool precompute)
+{
+	m_precompute_subkernel_matrices = precompute;
+	if (!precompute)
+		m_subkernel_matrices = SGVector<float32_t>();
+	else if (initialized && !has_subkernel_matrices())
+		compute_subkernel_matrices();
+}
+
+void CombinedKernel::update_subkernel_matrix_weights()
+{
+	m_subkernel_matrix_weights = SGVector<float64_t>(get_num_kernels());
+	for (auto k_idx : range(get_num_kernels()))
+		m_subkernel_matrix_weights[k_idx] =
+		    get_kernel(k_idx)->get_combined_kernel_weight();
+}
+
+void CombinedKernel::compute_subkernel_matrices()
+{
+	m_subkernel_matrices = SGVector<float32_t>();
+	if (append_subkernel_weights)
+	{
+		io::warn("{}: sub-kernel matrices are not precomputed with appended "
+			"sub-kernel weights", get_name());
+		return;
+	}
+
+	int32_t num_kernels = get_num_kernels();
+	if (!num_kernels || !num_lhs || !num_rhs)
+		return;
+
+	// if lhs == rhs and sizes match assume k(i,j)=k(j,i)
+	m_subkernel_matrices_triangle = lhs && lhs == rhs && num_lhs == num_rhs;
+	int64_t num_pairs = m_subkernel_matrices_triangle
+	                        ? int64_t(num_lhs) * (num_lhs + 1) / 2
+	                        : int64_t(num_lhs) * num_rhs;
+	SG_DEBUG("precomputing {} sub-kernel matrices with {} entries each",
+		num_kernels, num_pairs);
+
+	update_subkernel_matrix_weights();
+	SGVector<float32_t> matrices(num_pairs * num_kernels);
+
+	/* square blocks of pairs, every block computes all sub-kernels so that
+	 * the interleaved values of a pair are written by one thread */
+	const int32_t block_size = 64;
+	std::vector<std::pair<int32_t, int32_t>> blocks;
+	for (int32_t y = 0; y < num_rhs; y += block_size)
+	{
+		int32_t x_end = m_subkernel_matrices_triangle ? y + 1 : num_lhs;
+		for (int32_t x = 0; x < x_end; x += block_size)
+			blocks.emplace_back(x, y);
+	}
+
+	int32_t num_threads = env()->get_num_threads();
+	auto pb = SG_PROGRESS(range(blocks.size()));
+	#pragma omp parallel for schedule(dynamic) num_threads(num_threads)
+	for (int64_t b = 0; b < (int64_t)blocks.size(); ++b)
+	{
+		auto [x_start, y_start] = blocks[b];
+		int32_t y_end = std::min(y_start + block_size, num_rhs);
+		int32_t x_end = std::min(x_start + block_size, num_lhs);
+		for (int32_t k_idx = 0; k_idx < num_kernels; ++k_idx)
+		{
+			const auto& k = kernel_array[k_idx];
+			for (int32_t y = y_start; y < y_end; ++y)
+			{
+				int32_t x_last = m_subkernel_matrices_triangle
+				                     ? std::min(x_end, y + 1)
+				                     : x_end;
+				for (int32_t x = x_start; x < x_last; ++x)
+					matrices[subkernel_matrices_offset(x, y) + k_idx] =
+					    k->kernel(x, y);
+			}
+		}
+		pb.print_progress();
+	}
+	pb.complete();
+
+	m_subkernel_matrices = matrices;
+}
+
+SGVector<float64_t> CombinedKernel::compute_subkernel_quadratic_forms(
+    const SGVector<int32_t>& idx, const SGVector<float64_t>& coef)
+{
+	require(
+	    idx.vlen == coef.vlen,
+	    "Number of indices ({}) and coefficients ({}) must match", idx.vlen,
+	    coef.vlen);
+
+	int32_t num_kernels = get_num_kernels();
+	SGVector<float64_t> result(num_kernels);
+	result.zero();
+	Map<VectorXd> eigen_result(result.vector, num_kernels);
+
+	int32_t num_threads = env()->get_num_threads();
+	if (has_subkernel_matrices())
+	{
+		/* one pass over the pairs for all sub-kernels */
+		#pragma omp parallel num_threads(num_threads)
+		{
+			VectorXd sums = VectorXd::Zero(num_kernels);
+			#pragma omp for schedule(dynamic)
+			for (index_t i = 0; i < idx.vlen; ++i)
+			{
+				for (index_t j = 0; j < idx.vlen; ++j)
+				{
+					Map<const VectorXf> values(
+					    m_subkernel_matrices.vector +
+					        subkernel_matrices_offset(idx[i], idx[j]),
+					    num_kernels);
+					sums += coef[i] * coef[j] * values.cast<float64_t>();
+				}
+			}
+			#pragma omp critical
+			eigen_result += sums;
+		}
+		return result;
+	}
+
+	for (auto k_idx : range(num_kernels))
+	{
+		auto k = get_kernel(k_idx);
+		float64_t sum = 0;
+		#pragma omp parallel for reduction(+:sum) num_threads(num_threads)
+		for (index_t i = 0; i < idx.vlen; ++i)
+		{
+			for (index_t j = 0; j < idx.vlen; ++j)
+				sum += coef[i] * coef[j] * k->kernel(idx[i], idx[j]);
+		}
+		result[k_idx] = sum;
+	}
+
+	return result;
+}
+
 void CombinedKernel::init()
 {
 	sv_count=0;
@@ -758,6 +935,12 @@ void CombinedKernel::init()
 	weight_update = false;
 	SG_ADD(&weight_update, "weight_update",
 	    "weight update");
+
+	m_precompute_subkernel_matrices = false;
+	m_subkernel_matrices_triangle = false;
+	SG_ADD(&m_precompute_subkernel_matrices, "precompute_subkernel_matrices",
+	    "Whether sub-kernel matrices are precomputed",
+	    ParameterProperties::SETTING);
 }
 
 void CombinedKernel::enable_subkernel_weight_learning()
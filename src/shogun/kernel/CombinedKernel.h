@@ -40,6 +40,10 @@ class ListElement;
  *     k_{combined}({\bf x}, {\bf x'}) = \sum_{m=1}^M \beta_m k_m({\bf x}, {\bf x'})
  * \f]
  *
+ * If the kernel matrices of the sub-kernels are precomputed (see
+ * set_precompute_subkernel_matrices()), kernel values are weighted sums of
+ * the stored sub-kernel values, which makes changing the weights (e.g. in
+ * MKL) cheap.
  */
 class CombinedKernel : public Kernel
 {
@@ -162,6 +166,7 @@ class CombinedKernel : public Kernel
 				unset_property(KP_LINADD);
 
 			kernel_array.insert(kernel_array.begin() + idx, k);
+			m_subkernel_matrices = SGVector<float32_t>();
 			return true;
 		}
 
@@ -206,6 +211,7 @@ class CombinedKernel : public Kernel
 
 			int n = get_num_kernels();
 			kernel_array.push_back(k);
+			m_subkernel_matrices = SGVector<float32_t>();
 
 			if(enable_subkernel_weight_opt && n+1==get_num_kernels())
 				enable_subkernel_weight_learning();
@@ -227,6 +233,7 @@ class CombinedKernel : public Kernel
 			    kernel_array.size());
 
 			kernel_array.erase(kernel_array.begin() + idx);
+			m_subkernel_matrices = SGVector<float32_t>();
 
 			if (get_num_kernels()==0)
 			{
@@ -395,6 +402,37 @@ class CombinedKernel : public Kernel
 		/** precompute all sub-kernels */
 		bool precompute_subkernels();
 
+		/** If enabled, init() computes the kernel matrices of all
+		 * sub-kernels once, blockwise in parallel and in single precision.
+		 * The values of all sub-kernels for one pair of vectors are stored
+		 * next to each other, and only the upper triangle is stored if lhs
+		 * and rhs are the same. Kernel values are then the weighted sum of
+		 * these values. Memory is O(n^2) in the number of vectors times the
+		 * number of sub-kernels. Not available with appended sub-kernel
+		 * weights.
+		 *
+		 * @param precompute whether to precompute the sub-kernel matrices
+		 */
+		void set_precompute_subkernel_matrices(bool precompute);
+
+		/** @return whether the sub-kernel matrices are precomputed */
+		bool has_subkernel_matrices() const
+		{
+			return m_subkernel_matrices.vlen > 0;
+		}
+
+		/** Computes \f$\sum_{i,j} c_i c_j k_m(x_{idx_i}, x_{idx_j})\f$ for
+		 * every sub-kernel \f$k_m\f$ (unweighted), e.g. the squared norms of
+		 * the MKL sub-kernel solutions. Uses one pass over the precomputed
+		 * sub-kernel matrices if available.
+		 *
+		 * @param idx vector indices
+		 * @param coef coefficients of the vectors
+		 * @return quadratic form of every sub-kernel
+		 */
+		SGVector<float64_t> compute_subkernel_quadratic_forms(
+		    const SGVector<int32_t>& idx, const SGVector<float64_t>& coef);
+
 		/** Returns a  casted version of the given kernel. Throws an error
 		 * if parameter is not of class CombinedKernel. SG_REF's the returned
 		 * kernel
@@ -497,6 +535,34 @@ class CombinedKernel : public Kernel
 
 	private:
 		void init();
+
+		/** computes the sub-kernel matrices, see
+		 * set_precompute_subkernel_matrices()
+		 */
+		void compute_subkernel_matrices();
+
+		/** copies the weights of the sub-kernels for the precomputed
+		 * matrices
+		 */
+		void update_subkernel_matrix_weights();
+
+		/** @return offset of the sub-kernel values of a pair of vectors in
+		 * the precomputed sub-kernel matrices
+		 */
+		inline int64_t subkernel_matrices_offset(int32_t x, int32_t y) const
+		{
+			int64_t pair;
+			if (m_subkernel_matrices_triangle)
+			{
+				if (x > y)
+					std::swap(x, y);
+				pair = int64_t(y) * (y + 1) / 2 + x;
+			}
+			else
+				pair = int64_t(y) * num_lhs + x;
+
+			return pair * m_subkernel_matrix_weights.vlen;
+		}
 		/**
 		 * The purpose of this function is to make customkernels aware of any
 		 * subsets present, regardless whether the features passed are of type
@@ -536,6 +602,15 @@ class CombinedKernel : public Kernel
 		bool enable_subkernel_weight_opt;
 		/** update the weight for subkernels */
 		bool weight_update;
+
+		/** whether init() precomputes the sub-kernel matrices */
+		bool m_precompute_subkernel_matrices;
+		/** precomputed sub-kernel values, interleaved per pair of vectors */
+		SGVector<float32_t> m_subkernel_matrices;
+		/** whether only the upper triangle is precomputed */
+		bool m_subkernel_matrices_triangle;
+		/** weights of the sub-kernels for the precomputed matrices */
+		SGVector<float64_t> m_subkernel_matrix_weights;
 };
 }
 #endif /* _COMBINEDKERNEL_H__ */
@@ -90,6 +90,29 @@ CustomKernel::~CustomKernel()
 	SG_TRACE("Leaving");
 }
 
+std::shared_ptr<CustomKernel> CustomKernel::shallow_copy() const
+{
+	auto copy=std::make_shared<CustomKernel>();
+	copy->kmatrix=kmatrix;
+	copy->upper_diagonal=upper_diagonal;
+	copy->m_is_symmetric=m_is_symmetric;
+	copy->m_free_km=false;
+	copy->m_row_subset_stack=std::make_shared<SubsetStack>(*m_row_subset_stack);
+	copy->m_col_subset_stack=std::make_shared<SubsetStack>(*m_col_subset_stack);
+
+	if (lhs && rhs)
+	{
+		/* features are only used for their size, so they can be shared */
+		copy->Kernel::init(lhs, rhs);
+		copy->lhs_equals_rhs=lhs_equals_rhs;
+		copy->num_lhs=num_lhs;
+		copy->num_rhs=num_rhs;
+		copy->set_normalizer(make_clone(normalizer));
+	}
+
+	return copy;
+}
+
 bool CustomKernel::dummy_init(int32_t rows, int32_t cols)
 {
 	return init(std::make_shared<DummyFeatures>(rows), std::make_shared<DummyFeatures>(cols));
@@ -130,6 +153,10 @@ bool CustomKernel::init(std::shared_ptr<Features> l, std::shared_ptr<Features> r
 		remove_all_col_subsets();
 		remove_all_row_subsets();
 
+		/* keep the index features as lhs and rhs, so that the kernel can be
+		 * re-initialised with other index features on one side only */
+		Kernel::init(l, r);
+
 		add_row_subset(l_idx->get_feature_index());
 		add_col_subset(r_idx->get_feature_index());
 
@@ -560,6 +560,16 @@ class CustomKernel: public Kernel
 			return kmatrix;
 		}
 
+		/** Creates a custom kernel that shares the kernel matrix of this one
+		 * (no copy) but has its own subset stacks, initialised with the
+		 * currently active row/col subsets. Adding or removing subsets on the
+		 * copy does not affect this kernel, so several copies can be used
+		 * concurrently on the same precomputed matrix.
+		 *
+		 * @return custom kernel sharing the kernel matrix
+		 */
+		std::shared_ptr<CustomKernel> shallow_copy() const;
+
 	protected:
 
 		/** compute kernel function
@@ -13,6 +13,7 @@
 #include <shogun/io/SGIO.h>
 #include <shogun/lib/Signal.h>
 #include <shogun/lib/Time.h>
+#include <shogun/lib/Tracer.h>
 #include <shogun/lib/common.h>
 #include <shogun/lib/config.h>
 
@@ -25,6 +26,7 @@
 #include <shogun/classifier/svm/SVM.h>
 
 #include <string.h>
+#include <type_traits>
 #ifndef _WIN32
 #include <unistd.h>
 #endif
@@ -295,6 +297,8 @@ void Kernel::cache_kernel_row(int32_t m)
 
 	if(!kernel_cache_check(m))   // not cached yet
 	{
+		SG_TRACE_COUNT("kernel_cache::misses", 1);
+		SG_TRACE_SCOPE("kernel_cache::compute_row");
 		cache = kernel_cache_clean_and_malloc(m);
 		if(cache) {
 			l=kernel_cache.totdoc2active[m];
@@ -319,6 +323,8 @@ void Kernel::cache_kernel_row(int32_t m)
 		else
 			perror("Error: Kernel cache full! => increase cache size");
 	}
+	else
+		SG_TRACE_COUNT("kernel_cache::hits", 1);
 }
 
 
@@ -389,7 +395,10 @@ void Kernel::cache_multiple_kernel_rows(int32_t* rows, int32_t num_rows)
 				idx=2*num_vec-1-idx;
 
 			if (kernel_cache_check(idx))
+			{
+				SG_TRACE_COUNT("kernel_cache::hits", 1);
 				continue;
+			}
 
 			needs_computation[idx]=1;
 			uncached_rows[num]=idx;
@@ -401,6 +410,8 @@ void Kernel::cache_multiple_kernel_rows(int32_t* rows, int32_t num_rows)
 			num++;
 		}
 
+		SG_TRACE_COUNT("kernel_cache::misses", num);
+		SG_TRACE_SCOPE("kernel_cache::compute_rows");
 		if (num>0)
 		{
 			step = num/nthreads;
@@ -735,6 +746,7 @@ void Kernel::list_kernel()
 		ENUM_CASE(K_GAUSSIANARDSPARSE)
 		ENUM_CASE(K_STREAMING)
 		ENUM_CASE(K_PERIODIC)
+		ENUM_CASE(K_NYSTROM)
 	}
 
 	switch (get_feature_class())
@@ -1306,6 +1318,7 @@ template <class T> void* Kernel::get_kernel_matrix_helper(void* p)
 template <class T>
 SGMatrix<T> Kernel::get_kernel_matrix()
 {
+	SG_TRACE_SCOPE("kernel::get_kernel_matrix");
 	T* result = NULL;
 
 	require(has_features(), "no features assigned to kernel");
@@ -1320,6 +1333,20 @@ SGMatrix<T> Kernel::get_kernel_matrix()
 
 	SG_DEBUG("returning kernel matrix of size {}x{}", m, n)
 
+	SGMatrix<float64_t> full=compute_kernel_matrix();
+	if (full.matrix)
+	{
+		if constexpr (std::is_same<T, float64_t>::value)
+			return full;
+		else
+		{
+			SGMatrix<T> converted(m, n);
+			for (int64_t i=0; i<total_num; i++)
+				converted.matrix[i]=(T) full.matrix[i];
+			return converted;
+		}
+	}
+
 	result=SG_MALLOC(T, total_num);
 
 	int32_t num_threads=env()->get_num_threads();
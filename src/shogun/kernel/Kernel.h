@@ -113,7 +113,8 @@ enum EKernelType
 	K_GAUSSIANARDSPARSE = 511,
 	K_STREAMING = 520,
 	K_PERIODIC = 530,
-	K_MATERN = 540
+	K_MATERN = 540,
+	K_NYSTROM = 550
 };
 
 /** kernel property */
@@ -875,6 +876,18 @@ class Kernel : public SGObject
 		 */
 		static std::shared_ptr<Kernel> obtain_from_generic(const std::shared_ptr<SGObject>& kernel);
 	protected:
+		/** compute the whole kernel matrix at once, kernels that can do
+		 * this faster than pair by pair (e.g. by a sparse matrix product)
+		 * override this, called by get_kernel_matrix()
+		 *
+		 * @return normalized kernel matrix of size num_lhs x num_rhs, or an
+		 * empty matrix to compute it pair by pair
+		 */
+		virtual SGMatrix<float64_t> compute_kernel_matrix()
+		{
+			return SGMatrix<float64_t>();
+		}
+
 		/** set property
 		 *
 		 * @param p kernel property to set
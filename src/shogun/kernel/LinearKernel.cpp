@@ -8,6 +8,8 @@
 #include <shogun/io/SGIO.h>
 #include <shogun/features/Features.h>
 #include <shogun/features/DotFeatures.h>
+#include <shogun/features/SparseFeatures.h>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/kernel/LinearKernel.h>
 
 using namespace shogun;
@@ -90,3 +92,22 @@ float64_t LinearKernel::compute_optimized(int32_t idx)
 	float64_t result = rhs->as<DotFeatures>()->dot(idx, normal);
 	return normalizer->normalize_rhs(result, idx);
 }
+
+SGMatrix<float64_t> LinearKernel::compute_kernel_matrix()
+{
+	auto sparse_lhs=std::dynamic_pointer_cast<SparseFeatures<float64_t>>(lhs);
+	auto sparse_rhs=std::dynamic_pointer_cast<SparseFeatures<float64_t>>(rhs);
+	if (!sparse_lhs || !sparse_rhs)
+		return SGMatrix<float64_t>();
+
+	SGMatrix<float64_t> result=sparse_lhs->sparse_dot_matrix(sparse_rhs);
+
+#pragma omp parallel for num_threads(env()->get_num_threads())
+	for (int32_t j=0; j<result.num_cols; j++)
+	{
+		for (int32_t i=0; i<result.num_rows; i++)
+			result(i, j)=normalizer->normalize(result(i, j), i, j);
+	}
+
+	return result;
+}
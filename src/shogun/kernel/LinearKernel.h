@@ -129,6 +129,14 @@ class LinearKernel: public DotKernel
 			this->normal = w;
 		}
 
+	protected:
+		/** compute the kernel matrix of sparse real valued features as one
+		 * sparse matrix product
+		 *
+		 * @return kernel matrix, empty for other features
+		 */
+		virtual SGMatrix<float64_t> compute_kernel_matrix();
+
 	protected:
 		/** normal vector (used in case of optimized kernel) */
 		SGVector<float64_t> normal;
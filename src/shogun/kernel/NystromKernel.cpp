@@ -0,0 +1,384 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#include <shogun/kernel/NystromKernel.h>
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/io/SGIO.h>
+#include <shogun/mathematics/RandomNamespace.h>
+#include <shogun/mathematics/UniformIntDistribution.h>
+#include <shogun/mathematics/UniformRealDistribution.h>
+#include <shogun/mathematics/eigen3.h>
+
+#include <algorithm>
+#include <limits>
+#include <utility>
+
+using namespace shogun;
+using namespace Eigen;
+
+NystromKernel::NystromKernel() : RandomMixin<Kernel>()
+{
+	init();
+}
+
+NystromKernel::NystromKernel(
+    std::shared_ptr<Kernel> kernel, int32_t num_landmarks,
+    ENystromLandmarks landmarks)
+    : RandomMixin<Kernel>()
+{
+	init();
+	set_kernel(std::move(kernel));
+	set_num_landmarks(num_landmarks);
+	m_landmark_selection = landmarks;
+}
+
+NystromKernel::~NystromKernel()
+{
+	cleanup();
+}
+
+void NystromKernel::init()
+{
+	m_num_landmarks = 100;
+	m_landmark_selection = NYSTROM_UNIFORM;
+	m_leverage_regularization = 1e-3;
+
+	SG_ADD(
+	    &m_kernel, "kernel", "kernel to approximate",
+	    ParameterProperties::HYPER);
+	SG_ADD(
+	    &m_num_landmarks, "num_landmarks", "number of landmarks",
+	    ParameterProperties::HYPER);
+	SG_ADD_OPTIONS(
+	    (machine_int_t*)&m_landmark_selection, "landmark_selection",
+	    "landmark selection", ParameterProperties::NONE,
+	    SG_OPTIONS(NYSTROM_UNIFORM, NYSTROM_KMEANSPP, NYSTROM_LEVERAGE));
+	SG_ADD(
+	    &m_leverage_regularization, "leverage_regularization",
+	    "ridge of the leverage scores");
+	SG_ADD(&m_landmarks, "landmarks", "landmark vectors");
+	SG_ADD(
+	    &m_projection, "projection",
+	    "pseudo inverse of the square root of the landmark kernel matrix");
+	SG_ADD(
+	    &m_fitted_kernel, "fitted_kernel",
+	    "copy of the kernel the landmarks were selected with");
+	SG_ADD(&m_lhs_map, "lhs_map", "feature map of the left hand side");
+	SG_ADD(&m_rhs_map, "rhs_map", "feature map of the right hand side");
+
+	for (auto name : {"kernel", "num_landmarks", "landmark_selection",
+	                  "leverage_regularization"})
+		add_callback_function(name, [&]() { reset_landmarks(); });
+}
+
+bool NystromKernel::init(std::shared_ptr<Features> l, std::shared_ptr<Features> r)
+{
+	require(m_kernel, "Kernel to approximate not set");
+
+	Kernel::init(l, r);
+	if (landmarks_outdated())
+		fit(l);
+
+	m_lhs_map = compute_feature_map(l);
+	m_rhs_map = l == r ? m_lhs_map : compute_feature_map(r);
+
+	return init_normalizer();
+}
+
+void NystromKernel::fit(std::shared_ptr<Features> features)
+{
+	require(m_kernel, "Kernel to approximate not set");
+	require(
+	    features && features->get_num_vectors() > 0,
+	    "Vectors to select landmarks from required");
+
+	SGVector<index_t> indices;
+	switch (m_landmark_selection)
+	{
+	case NYSTROM_UNIFORM:
+		indices = select_uniform(features);
+		break;
+	case NYSTROM_KMEANSPP:
+		indices = select_kmeanspp(features);
+		break;
+	case NYSTROM_LEVERAGE:
+		indices = select_leverage(features);
+		break;
+	}
+
+	set_landmarks(features, indices);
+}
+
+std::shared_ptr<DenseFeatures<float64_t>>
+NystromKernel::get_feature_map(std::shared_ptr<Features> features)
+{
+	require(m_kernel, "Kernel to approximate not set");
+	if (landmarks_outdated())
+		fit(features);
+
+	return std::make_shared<DenseFeatures<float64_t>>(
+	    compute_feature_map(features));
+}
+
+float64_t NystromKernel::compute(int32_t idx_a, int32_t idx_b)
+{
+	auto dim = m_lhs_map.num_rows;
+	return Map<VectorXd>(m_lhs_map.get_column_vector(idx_a), dim)
+	    .dot(Map<VectorXd>(m_rhs_map.get_column_vector(idx_b), dim));
+}
+
+SGMatrix<float64_t>
+NystromKernel::compute_feature_map(std::shared_ptr<Features> features)
+{
+	auto num_vectors = features->get_num_vectors();
+	auto num_landmarks = m_projection.num_rows;
+
+	m_kernel->init(features, m_landmarks);
+	auto cross_kernel = m_kernel->get_kernel_matrix();
+	m_kernel->remove_lhs_and_rhs();
+
+	SGMatrix<float64_t> feature_map(num_landmarks, num_vectors);
+	Map<MatrixXd>(feature_map.matrix, num_landmarks, num_vectors).noalias() =
+	    Map<MatrixXd>(m_projection.matrix, num_landmarks, num_landmarks) *
+	    Map<MatrixXd>(cross_kernel.matrix, num_vectors, num_landmarks)
+	        .transpose();
+
+	return feature_map;
+}
+
+bool NystromKernel::landmarks_outdated() const
+{
+	// only the hyper-parameters, the kernel state depends on the features
+	// it was last initialised with
+	return !m_landmarks || !m_fitted_kernel ||
+	       !make_clone(m_kernel, ParameterProperties::HYPER)
+	            ->equals(m_fitted_kernel);
+}
+
+void NystromKernel::reset_landmarks()
+{
+	m_landmarks = nullptr;
+	m_projection = SGMatrix<float64_t>();
+	m_fitted_kernel = nullptr;
+}
+
+void NystromKernel::set_landmarks(
+    std::shared_ptr<Features> features, SGVector<index_t> indices)
+{
+	auto num_landmarks = indices.vlen;
+	m_landmarks = features->copy_subset(indices);
+
+	m_kernel->init(m_landmarks, m_landmarks);
+	auto landmark_kernel = m_kernel->get_kernel_matrix();
+	m_kernel->remove_lhs_and_rhs();
+	m_fitted_kernel = make_clone(m_kernel, ParameterProperties::HYPER);
+
+	// pseudo inverse of the square root, ignoring the directions the
+	// landmarks do not span
+	SelfAdjointEigenSolver<MatrixXd> solver(
+	    Map<MatrixXd>(landmark_kernel.matrix, num_landmarks, num_landmarks));
+	VectorXd inv_sqrt = solver.eigenvalues();
+	auto tolerance = std::numeric_limits<float64_t>::epsilon() *
+	                 num_landmarks * inv_sqrt.cwiseAbs().maxCoeff();
+	for (index_t i = 0; i < num_landmarks; ++i)
+		inv_sqrt[i] =
+		    inv_sqrt[i] > tolerance ? 1.0 / std::sqrt(inv_sqrt[i]) : 0;
+
+	m_projection = SGMatrix<float64_t>(num_landmarks, num_landmarks);
+	Map<MatrixXd>(m_projection.matrix, num_landmarks, num_landmarks) =
+	    solver.eigenvectors() * inv_sqrt.asDiagonal() *
+	    solver.eigenvectors().transpose();
+}
+
+SGVector<index_t> NystromKernel::select_uniform(std::shared_ptr<Features> features)
+{
+	auto num_vectors = features->get_num_vectors();
+	auto num_landmarks = std::min(m_num_landmarks, num_vectors);
+
+	SGVector<index_t> permutation(num_vectors);
+	permutation.range_fill();
+	random::shuffle(permutation, m_prng);
+
+	SGVector<index_t> indices(num_landmarks);
+	std::copy_n(permutation.begin(), num_landmarks, indices.begin());
+	std::sort(indices.begin(), indices.end());
+	return indices;
+}
+
+SGVector<index_t> NystromKernel::select_kmeanspp(std::shared_ptr<Features> features)
+{
+	auto num_vectors = features->get_num_vectors();
+	auto num_landmarks = std::min(m_num_landmarks, num_vectors);
+	auto num_threads = env()->get_num_threads();
+
+	m_kernel->init(features, features);
+
+	SGVector<float64_t> diagonal(num_vectors);
+#pragma omp parallel for num_threads(num_threads)
+	for (index_t i = 0; i < num_vectors; ++i)
+		diagonal[i] = m_kernel->kernel(i, i);
+
+	// squared distance in feature space to the closest landmark
+	SGVector<float64_t> distances(num_vectors);
+	distances.set_const(std::numeric_limits<float64_t>::infinity());
+
+	SGVector<index_t> indices(num_landmarks);
+	UniformIntDistribution<index_t> uniform_index(0, num_vectors - 1);
+	UniformRealDistribution<float64_t> uniform(0.0, 1.0);
+	index_t next = uniform_index(m_prng);
+	for (index_t c = 0; c < num_landmarks; ++c)
+	{
+		indices[c] = next;
+
+#pragma omp parallel for num_threads(num_threads)
+		for (index_t i = 0; i < num_vectors; ++i)
+		{
+			auto distance = diagonal[i] + diagonal[next] -
+			                2 * m_kernel->kernel(i, next);
+			distances[i] = std::min(distances[i], std::max(distance, 0.0));
+		}
+		distances[next] = 0;
+
+		if (c + 1 == num_landmarks)
+			break;
+
+		auto total = SGVector<float64_t>::sum(distances);
+		if (total > 0)
+		{
+			auto target = uniform(m_prng) * total;
+			float64_t cumulative = 0;
+			for (next = 0; next < num_vectors - 1; ++next)
+			{
+				cumulative += distances[next];
+				if (distances[next] > 0 && cumulative >= target)
+					break;
+			}
+			// rounding may leave the target above the last sum
+			while (distances[next] == 0)
+				--next;
+		}
+		else
+		{
+			// all vectors coincide with a landmark, pick any other one
+			do
+				next = uniform_index(m_prng);
+			while (std::find(indices.begin(), indices.begin() + c + 1, next) !=
+			       indices.begin() + c + 1);
+		}
+	}
+	m_kernel->remove_lhs_and_rhs();
+
+	std::sort(indices.begin(), indices.end());
+	return indices;
+}
+
+SGVector<index_t> NystromKernel::select_leverage(std::shared_ptr<Features> features)
+{
+	auto num_vectors = features->get_num_vectors();
+	auto num_landmarks = std::min(m_num_landmarks, num_vectors);
+
+	// leverage scores of a uniform approximation with as many landmarks
+	set_landmarks(features, select_uniform(features));
+	auto feature_map = compute_feature_map(features);
+	auto dim = feature_map.num_rows;
+	Map<MatrixXd> phi(feature_map.matrix, dim, num_vectors);
+
+	MatrixXd gram = phi * phi.transpose();
+	auto ridge = m_leverage_regularization * gram.trace();
+	gram.diagonal().array() += std::max(
+	    ridge, std::numeric_limits<float64_t>::epsilon());
+	LLT<MatrixXd> llt(gram);
+
+	SGVector<float64_t> scores(num_vectors);
+	const index_t block = 1024;
+#pragma omp parallel for num_threads(env()->get_num_threads())
+	for (index_t start = 0; start < num_vectors; start += block)
+	{
+		auto size = std::min(block, num_vectors - start);
+		MatrixXd z = llt.matrixL().solve(phi.middleCols(start, size));
+		Map<VectorXd>(scores.vector + start, size) =
+		    z.colwise().squaredNorm().transpose();
+	}
+
+	// weighted sampling without replacement by the largest of
+	// log(u) / score, Efraimidis and Spirakis (2006)
+	UniformRealDistribution<float64_t> uniform(0.0, 1.0);
+	std::vector<std::pair<float64_t, index_t>> keys(num_vectors);
+	for (index_t i = 0; i < num_vectors; ++i)
+	{
+		auto u = std::max(uniform(m_prng), std::numeric_limits<float64_t>::min());
+		keys[i] = {scores[i] > 0
+		               ? std::log(u) / scores[i]
+		               : -std::numeric_limits<float64_t>::infinity(),
+		           i};
+	}
+	std::partial_sort(
+	    keys.begin(), keys.begin() + num_landmarks, keys.end(),
+	    std::greater<std::pair<float64_t, index_t>>());
+
+	SGVector<index_t> indices(num_landmarks);
+	for (index_t i = 0; i < num_landmarks; ++i)
+		indices[i] = keys[i].second;
+	std::sort(indices.begin(), indices.end());
+	return indices;
+}
+
+void NystromKernel::remove_lhs_and_rhs()
+{
+	Kernel::remove_lhs_and_rhs();
+	m_lhs_map = SGMatrix<float64_t>();
+	m_rhs_map = SGMatrix<float64_t>();
+}
+
+void NystromKernel::remove_lhs()
+{
+	Kernel::remove_lhs();
+	m_lhs_map = SGMatrix<float64_t>();
+	if (!rhs)
+		m_rhs_map = SGMatrix<float64_t>();
+}
+
+void NystromKernel::remove_rhs()
+{
+	Kernel::remove_rhs();
+	m_rhs_map = SGMatrix<float64_t>();
+}
+
+void NystromKernel::set_kernel(std::shared_ptr<Kernel> kernel)
+{
+	m_kernel = std::move(kernel);
+	reset_landmarks();
+}
+
+void NystromKernel::set_num_landmarks(int32_t num_landmarks)
+{
+	require(
+	    num_landmarks > 0, "Number of landmarks ({}) must be positive",
+	    num_landmarks);
+	if (num_landmarks != m_num_landmarks)
+		reset_landmarks();
+	m_num_landmarks = num_landmarks;
+}
+
+void NystromKernel::set_leverage_regularization(float64_t regularization)
+{
+	require(
+	    regularization >= 0, "Regularization ({}) must not be negative",
+	    regularization);
+	if (regularization != m_leverage_regularization)
+		reset_landmarks();
+	m_leverage_regularization = regularization;
+}
+
+EFeatureClass NystromKernel::get_feature_class()
+{
+	return m_kernel ? m_kernel->get_feature_class() : C_ANY;
+}
+
+EFeatureType NystromKernel::get_feature_type()
+{
+	return m_kernel ? m_kernel->get_feature_type() : F_ANY;
+}
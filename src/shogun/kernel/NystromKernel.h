@@ -0,0 +1,270 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#ifndef _NYSTROMKERNEL_H___
+#define _NYSTROMKERNEL_H___
+
+#include <shogun/lib/config.h>
+
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/Kernel.h>
+#include <shogun/lib/common.h>
+#include <shogun/mathematics/RandomMixin.h>
+
+namespace shogun
+{
+
+/** landmark selection of NystromKernel */
+enum ENystromLandmarks
+{
+	/** landmarks sampled uniformly without replacement */
+	NYSTROM_UNIFORM = 10,
+	/** landmarks seeded by k-means++ in the feature space of the kernel */
+	NYSTROM_KMEANSPP = 20,
+	/** landmarks sampled without replacement proportionally to approximate
+	 * ridge leverage scores
+	 */
+	NYSTROM_LEVERAGE = 30
+};
+
+/** @brief Low-rank Nystroem approximation of a kernel.
+ *
+ * Given a kernel \f$k\f$ and m landmark vectors, the kernel is approximated by
+ * \f[
+ * \tilde{k}({\bf x}, {\bf y}) = \phi({\bf x})^T\phi({\bf y}), \quad
+ * \phi({\bf x}) = K_{mm}^{-1/2}k_m({\bf x})
+ * \f]
+ * where \f$K_{mm}\f$ is the kernel matrix of the landmarks and
+ * \f$k_m({\bf x})\f$ the vector of kernels between \f${\bf x}\f$ and the
+ * landmarks.
+ *
+ * On init(), the m-dimensional feature maps of the left and right hand side
+ * are computed with the kernel matrix between the vectors and the
+ * landmarks, in parallel, and then every kernel evaluation is a dot product
+ * of length m. This takes O(nm) memory and kernel evaluations instead of
+ * O(n^2), so any KernelMachine, GaussianProcess or KernelPCA can use the
+ * approximation by using this kernel instead of the wrapped one.
+ * get_feature_map() returns the map itself as DenseFeatures, on which the
+ * problem can be solved with a linear machine.
+ *
+ * Landmarks are selected from the left hand side of the first init(), or
+ * explicitly with fit(), and kept until the next fit(). init() selects them
+ * again when the number of landmarks, their selection or the wrapped kernel
+ * has changed since. They are selected
+ * uniformly, by k-means++ seeding with the distance induced by the kernel,
+ * or proportionally to ridge leverage scores of a uniform Nystroem
+ * approximation with the same number of landmarks.
+ *
+ * Williams, C. K. I., & Seeger, M. (2001).
+ * Using the Nystroem method to speed up kernel machines.
+ * Advances in Neural Information Processing Systems 13, 682-688.
+ *
+ * Alaoui, A. E., & Mahoney, M. W. (2015).
+ * Fast randomized kernel ridge regression with statistical guarantees.
+ * Advances in Neural Information Processing Systems 28, 775-783.
+ */
+class NystromKernel : public RandomMixin<Kernel>
+{
+public:
+	/** default constructor */
+	NystromKernel();
+
+	/** constructor
+	 *
+	 * @param kernel kernel to approximate
+	 * @param num_landmarks number of landmarks
+	 * @param landmarks landmark selection
+	 */
+	NystromKernel(
+	    std::shared_ptr<Kernel> kernel, int32_t num_landmarks,
+	    ENystromLandmarks landmarks = NYSTROM_UNIFORM);
+
+	virtual ~NystromKernel();
+
+	/** initialize kernel, selecting landmarks from the left hand side if
+	 * there are none
+	 *
+	 * @param l features of left-hand side
+	 * @param r features of right-hand side
+	 * @return if initializing was successful
+	 */
+	virtual bool init(std::shared_ptr<Features> l, std::shared_ptr<Features> r);
+
+	/** Selects the landmarks among the given vectors.
+	 *
+	 * @param features vectors to select from
+	 */
+	void fit(std::shared_ptr<Features> features);
+
+	/** @return approximate feature map, with one m-dimensional vector per
+	 * vector of the given features
+	 *
+	 * @param features vectors of the wrapped kernel's type
+	 */
+	std::shared_ptr<DenseFeatures<float64_t>>
+	get_feature_map(std::shared_ptr<Features> features);
+
+	/** remove lhs and rhs from kernel */
+	virtual void remove_lhs_and_rhs();
+
+	/** remove lhs from kernel */
+	virtual void remove_lhs();
+
+	/** remove rhs from kernel */
+	virtual void remove_rhs();
+
+	/** @return landmarks, after fit() or init() */
+	std::shared_ptr<Features> get_landmarks() const
+	{
+		return m_landmarks;
+	}
+
+	/** @return the m x m matrix \f$K_{mm}^{-1/2}\f$, pseudo inverse of the
+	 * square root of the kernel matrix of the landmarks
+	 */
+	SGMatrix<float64_t> get_projection() const
+	{
+		return m_projection;
+	}
+
+	/** @param kernel kernel to approximate */
+	void set_kernel(std::shared_ptr<Kernel> kernel);
+
+	/** @return kernel to approximate */
+	std::shared_ptr<Kernel> get_kernel() const
+	{
+		return m_kernel;
+	}
+
+	/** @param num_landmarks number of landmarks */
+	void set_num_landmarks(int32_t num_landmarks);
+
+	/** @return number of landmarks */
+	int32_t get_num_landmarks() const
+	{
+		return m_num_landmarks;
+	}
+
+	/** @param landmarks landmark selection */
+	void set_landmark_selection(ENystromLandmarks landmarks)
+	{
+		if (landmarks != m_landmark_selection)
+			reset_landmarks();
+		m_landmark_selection = landmarks;
+	}
+
+	/** @return landmark selection */
+	ENystromLandmarks get_landmark_selection() const
+	{
+		return m_landmark_selection;
+	}
+
+	/** @param regularization ridge of the leverage scores, relative to the
+	 * trace of the kernel matrix
+	 */
+	void set_leverage_regularization(float64_t regularization);
+
+	/** @return ridge of the leverage scores */
+	float64_t get_leverage_regularization() const
+	{
+		return m_leverage_regularization;
+	}
+
+	/** return what type of kernel we are
+	 *
+	 * @return kernel type NYSTROM
+	 */
+	virtual EKernelType get_kernel_type()
+	{
+		return K_NYSTROM;
+	}
+
+	/** return feature class the kernel can deal with
+	 *
+	 * @return feature class of the wrapped kernel
+	 */
+	virtual EFeatureClass get_feature_class();
+
+	/** return feature type the kernel can deal with
+	 *
+	 * @return feature type of the wrapped kernel
+	 */
+	virtual EFeatureType get_feature_type();
+
+	/** return the kernel's name
+	 *
+	 * @return name NystromKernel
+	 */
+	virtual const char* get_name() const
+	{
+		return "NystromKernel";
+	}
+
+protected:
+	/** compute kernel function for features a and b
+	 *
+	 * @param idx_a index a
+	 * @param idx_b index b
+	 * @return dot product of the feature maps at indices a,b
+	 */
+	virtual float64_t compute(int32_t idx_a, int32_t idx_b);
+
+	/** @return m x n feature map of the given vectors */
+	SGMatrix<float64_t> compute_feature_map(std::shared_ptr<Features> features);
+
+	/** @return whether the landmarks have to be selected (again) */
+	bool landmarks_outdated() const;
+
+	/** drops the landmarks, they are selected again on the next init() */
+	void reset_landmarks();
+
+	/** Sets the landmarks and computes their projection. */
+	void set_landmarks(
+	    std::shared_ptr<Features> features, SGVector<index_t> indices);
+
+	/** @return indices of uniformly sampled landmarks */
+	SGVector<index_t> select_uniform(std::shared_ptr<Features> features);
+
+	/** @return indices of k-means++ seeded landmarks */
+	SGVector<index_t> select_kmeanspp(std::shared_ptr<Features> features);
+
+	/** @return indices of landmarks sampled by leverage scores */
+	SGVector<index_t> select_leverage(std::shared_ptr<Features> features);
+
+private:
+	void init();
+
+protected:
+	/** kernel to approximate */
+	std::shared_ptr<Kernel> m_kernel;
+
+	/** number of landmarks */
+	int32_t m_num_landmarks;
+
+	/** landmark selection */
+	ENystromLandmarks m_landmark_selection;
+
+	/** ridge of the leverage scores */
+	float64_t m_leverage_regularization;
+
+	/** landmark vectors */
+	std::shared_ptr<Features> m_landmarks;
+
+	/** pseudo inverse of the square root of the landmark kernel matrix */
+	SGMatrix<float64_t> m_projection;
+
+	/** hyper-parameters of the wrapped kernel the landmarks were selected
+	 * with
+	 */
+	std::shared_ptr<Kernel> m_fitted_kernel;
+
+	/** feature map of the left hand side */
+	SGMatrix<float64_t> m_lhs_map;
+
+	/** feature map of the right hand side */
+	SGMatrix<float64_t> m_rhs_map;
+};
+} // namespace shogun
+#endif /* _NYSTROMKERNEL_H___ */
@@ -17,31 +17,10 @@
 #include <shogun/features/Features.h>
 #include <shogun/features/StringFeatures.h>
 
-#ifdef HAVE_PTHREAD
-#include <pthread.h>
-
-#endif
+#include <vector>
 
 using namespace shogun;
 
-#ifndef DOXYGEN_SHOULD_SKIP_THIS
-struct S_THREAD_PARAM_WD
-{
-
-	int32_t* vec;
-	float64_t* result;
-	float64_t* weights;
-	WeightedDegreeStringKernel* kernel;
-	CTrie<DNATrie>* tries;
-	float64_t factor;
-	int32_t j;
-	int32_t start;
-	int32_t end;
-	int32_t length;
-	int32_t* vec_idx;
-};
-#endif // DOXYGEN_SHOULD_SKIP_THIS
-
 WeightedDegreeStringKernel::WeightedDegreeStringKernel ()
 : StringKernel<char>()
 {
@@ -210,6 +189,13 @@ bool WeightedDegreeStringKernel::init_optimization(int32_t count, int32_t* IDX,
 	if (tree_num<0)
 		SG_DEBUG("initializing CWeightedDegreeStringKernel optimization")
 
+	if (tree_num<0 && env()->get_num_threads()>1 && seq_length>1)
+	{
+		init_tries_parallel(count, IDX, alphas);
+		set_is_initialized(true);
+		return true;
+	}
+
 	for (auto i : SG_PROGRESS(range(count)))
 	{
 		if (tree_num<0)
@@ -503,6 +489,80 @@ void WeightedDegreeStringKernel::add_example_to_single_tree_mismatch(
 }
 
 
+void WeightedDegreeStringKernel::add_example_to_trees(
+	CTrie<DNATrie>* trie, int32_t idx, float64_t alpha, int32_t start,
+	int32_t end, int32_t* vec)
+{
+	ASSERT(trie)
+	ASSERT(alphabet)
+	ASSERT(alphabet->get_alphabet()==DNA || alphabet->get_alphabet()==RNA)
+
+	if (alpha==0.0)
+		return;
+
+	int32_t len=0;
+	bool free_vec;
+	char* char_vec=lhs->as<StringFeatures<char>>()->get_feature_vector(idx, len, free_vec);
+
+	// the trees of positions start..end-1 only see the next degree symbols
+	for (int32_t i=start; i<len && i<end+degree; i++)
+		vec[i]=alphabet->remap_to_bin(char_vec[i]);
+	lhs->as<StringFeatures<char>>()->free_feature_vector(char_vec, idx, free_vec);
+
+	float64_t alpha_normalized=normalizer->normalize_lhs(alpha, idx);
+	for (int32_t i=start; i<len && i<end; i++)
+	{
+		if (max_mismatch==0)
+			trie->add_to_trie(i, 0, vec, alpha_normalized, weights, (length!=0));
+		else
+			trie->add_example_to_tree_mismatch_recursion(
+				NO_CHILD, i, alpha_normalized, &vec[i], len-i, 0, 0,
+				max_mismatch, weights);
+	}
+}
+
+void WeightedDegreeStringKernel::init_tries_parallel(
+	int32_t count, int32_t* IDX, float64_t* alphas)
+{
+	ASSERT(tries)
+
+	int32_t num_threads=Math::min(env()->get_num_threads(), seq_length);
+	std::vector<std::shared_ptr<CTrie<DNATrie>>> thread_tries(num_threads);
+	auto pb=SG_PROGRESS(range(count));
+
+	// every thread builds the trees of a contiguous range of positions into
+	// its own trie, as the node memory of a trie can only grow serially
+	#pragma omp parallel for num_threads(num_threads) schedule(static, 1)
+	for (int32_t t=0; t<num_threads; t++)
+	{
+		int32_t start=t*seq_length/num_threads;
+		int32_t end=(t+1)*seq_length/num_threads;
+
+		auto trie=std::make_shared<CTrie<DNATrie>>(degree, max_mismatch==0);
+		trie->create(seq_length, max_mismatch==0);
+		SGVector<int32_t> vec(seq_length);
+
+		for (int32_t i=0; i<count; i++)
+		{
+			add_example_to_trees(trie.get(), IDX[i], alphas[i], start, end, vec.vector);
+			if (t==0)
+				pb.print_progress();
+		}
+		thread_tries[t]=trie;
+	}
+	pb.complete();
+
+	for (int32_t t=0; t<num_threads; t++)
+	{
+		tries->merge_trees(
+			*thread_tries[t], t*seq_length/num_threads,
+			(t+1)*seq_length/num_threads);
+		thread_tries[t].reset();
+	}
+	tree_initialized=true;
+}
+
+
 float64_t WeightedDegreeStringKernel::compute_by_tree(int32_t idx)
 {
 	ASSERT(alphabet)
@@ -816,42 +876,6 @@ bool WeightedDegreeStringKernel::init_block_weights()
 }
 
 
-void* WeightedDegreeStringKernel::compute_batch_helper(void* p)
-{
-	S_THREAD_PARAM_WD* params = (S_THREAD_PARAM_WD*) p;
-	int32_t j=params->j;
-	WeightedDegreeStringKernel* wd=params->kernel;
-	CTrie<DNATrie>* tries=params->tries;
-	float64_t* weights=params->weights;
-	int32_t length=params->length;
-	int32_t* vec=params->vec;
-	float64_t* result=params->result;
-	float64_t factor=params->factor;
-	int32_t* vec_idx=params->vec_idx;
-
-	StringFeatures<char>* rhs_feat=(StringFeatures<char>*)(wd->get_rhs().get());
-	auto alpha=wd->alphabet;
-
-	for (int32_t i=params->start; i<params->end; i++)
-	{
-		int32_t len=0;
-		bool free_vec;
-		char* char_vec=rhs_feat->get_feature_vector(vec_idx[i], len, free_vec);
-		for (int32_t k=j; k<Math::min(len,j+wd->get_degree()); k++)
-			vec[k]=alpha->remap_to_bin(char_vec[k]);
-		rhs_feat->free_feature_vector(char_vec, vec_idx[i], free_vec);
-
-		ASSERT(tries)
-
-		result[i]+=factor*
-			wd->normalizer->normalize_rhs(tries->compute_by_tree_helper(vec, len, j, j, j, weights, (length!=0)), vec_idx[i]);
-	}
-
-
-
-	return NULL;
-}
-
 void WeightedDegreeStringKernel::compute_batch(
 	int32_t num_vec, int32_t* vec_idx, float64_t* result, int32_t num_suppvec,
 	int32_t* IDX, float64_t* alphas, float64_t factor)
@@ -864,98 +888,66 @@ void WeightedDegreeStringKernel::compute_batch(
 	ASSERT(num_vec>0)
 	ASSERT(vec_idx)
 	ASSERT(result)
+	delete_optimization();
 	create_empty_tries();
 
-	int32_t num_feat=rhs->as<StringFeatures<char>>()->get_max_vector_length();
+	auto rhs_feat=rhs->as<StringFeatures<char>>();
+	int32_t num_feat=rhs_feat->get_max_vector_length();
 	ASSERT(num_feat>0)
-	// TODO: port to use OpenMP backend instead of pthread
-#ifdef HAVE_PTHREAD
-	int32_t num_threads=env()->get_num_threads();
-#else
-	int32_t num_threads=1;
-#endif
+	int32_t num_threads=Math::min(env()->get_num_threads(), num_feat);
 	ASSERT(num_threads>0)
-	int32_t* vec=SG_MALLOC(int32_t, num_threads*num_feat);
+	std::vector<SGVector<float64_t>> thread_results(num_threads);
 	auto pb = SG_PROGRESS(range(num_feat));
 
-	if (num_threads < 2)
+	// Every thread takes a contiguous range of positions and, one position
+	// at a time, builds the tree of the support vectors into its own trie
+	// and streams all vectors through it. Only a single tree per thread is
+	// kept in memory and the results are summed up in a fixed order.
+	#pragma omp parallel for num_threads(num_threads) schedule(static, 1)
+	for (int32_t t=0; t<num_threads; t++)
 	{
-		// TODO: replace with the new signal
-		// for (int32_t j=0; j<num_feat && !Signal::cancel_computations(); j++)
-		for (int32_t j = 0; j < num_feat; j++)
-		{
-			init_optimization(num_suppvec, IDX, alphas, j);
-			S_THREAD_PARAM_WD params;
-			params.vec=vec;
-			params.result=result;
-			params.weights=weights;
-			params.kernel=this;
-			params.tries=tries.get();
-			params.factor=factor;
-			params.j=j;
-			params.start=0;
-			params.end=num_vec;
-			params.length=length;
-			params.vec_idx=vec_idx;
-			compute_batch_helper((void*) &params);
+		int32_t start=t*num_feat/num_threads;
+		int32_t end=(t+1)*num_feat/num_threads;
+
+		auto trie=std::make_shared<CTrie<DNATrie>>(degree, max_mismatch==0);
+		trie->create(seq_length, max_mismatch==0);
+		trie->set_position_weights(position_weights);
+		SGVector<int32_t> vec(Math::max(seq_length, num_feat));
+		SGVector<float64_t> thread_result(num_vec);
+		thread_result.zero();
 
-			pb.print_progress();
-		}
-		pb.complete();
-	}
-#ifdef HAVE_PTHREAD
-	else
-	{
 		// TODO: replace with the new signal
-		// for (int32_t j=0; j<num_feat && !Signal::cancel_computations(); j++)
-		for (int32_t j = 0; j < num_feat; j++)
+		// for (int32_t j=start; j<end && !Signal::cancel_computations(); j++)
+		for (int32_t j=start; j<end; j++)
 		{
-			init_optimization(num_suppvec, IDX, alphas, j);
-			pthread_t* threads = SG_MALLOC(pthread_t, num_threads-1);
-			S_THREAD_PARAM_WD* params = SG_MALLOC(S_THREAD_PARAM_WD, num_threads);
-			int32_t step= num_vec/num_threads;
-			int32_t t;
+			trie->delete_trees(max_mismatch==0);
+			for (int32_t i=0; i<num_suppvec; i++)
+				add_example_to_trees(trie.get(), IDX[i], alphas[i], j, j+1, vec.vector);
 
-			for (t=0; t<num_threads-1; t++)
+			for (int32_t i=0; i<num_vec; i++)
 			{
-				params[t].vec=&vec[num_feat*t];
-				params[t].result=result;
-				params[t].weights=weights;
-				params[t].kernel=this;
-				params[t].tries=tries.get();
-				params[t].factor=factor;
-				params[t].j=j;
-				params[t].start = t*step;
-				params[t].end = (t+1)*step;
-				params[t].length=length;
-				params[t].vec_idx=vec_idx;
-				pthread_create(&threads[t], NULL, WeightedDegreeStringKernel::compute_batch_helper, (void*)&params[t]);
+				int32_t len=0;
+				bool free_vec;
+				char* char_vec=rhs_feat->get_feature_vector(vec_idx[i], len, free_vec);
+				for (int32_t k=j; k<Math::min(len, j+degree); k++)
+					vec[k]=alphabet->remap_to_bin(char_vec[k]);
+				rhs_feat->free_feature_vector(char_vec, vec_idx[i], free_vec);
+
+				thread_result[i]+=factor*normalizer->normalize_rhs(
+					trie->compute_by_tree_helper(vec.vector, len, j, j, j, weights, (length!=0)),
+					vec_idx[i]);
 			}
-			params[t].vec=&vec[num_feat*t];
-			params[t].result=result;
-			params[t].weights=weights;
-			params[t].kernel=this;
-			params[t].tries=tries.get();
-			params[t].factor=factor;
-			params[t].j=j;
-			params[t].start=t*step;
-			params[t].end=num_vec;
-			params[t].length=length;
-			params[t].vec_idx=vec_idx;
-			compute_batch_helper((void*) &params[t]);
-
-			for (t=0; t<num_threads-1; t++)
-				pthread_join(threads[t], NULL);
 			pb.print_progress();
-
-			SG_FREE(params);
-			SG_FREE(threads);
 		}
-		pb.complete();
+		thread_results[t]=thread_result;
 	}
-#endif
+	pb.complete();
 
-	SG_FREE(vec);
+	for (int32_t t=0; t<num_threads; t++)
+	{
+		for (int32_t i=0; i<num_vec; i++)
+			result[i]+=thread_results[t][i];
+	}
 
 	//really also free memory as this can be huge on testing especially when
 	//using the combined kernel
@@ -164,13 +164,11 @@ class WeightedDegreeStringKernel: public StringKernel<char>
 			return 0;
 		}
 
-		/** helper for compute batch
-		 *
-		 * @param p thread parameter
-		 */
-		static void* compute_batch_helper(void* p);
-
 		/** compute batch
+		 *
+		 * Positions are distributed over env()->get_num_threads() threads,
+		 * each of which builds one tree at a time and scores all vectors on
+		 * it.
 		 *
 		 * @param num_vec number of vectors
 		 * @param vec_idx vector index
@@ -635,6 +633,29 @@ class WeightedDegreeStringKernel: public StringKernel<char>
 		void add_example_to_single_tree_mismatch(
 			int32_t idx, float64_t weight, int32_t tree_num);
 
+		/** add example to the trees of a range of positions of a trie
+		 *
+		 * @param trie trie to add to
+		 * @param idx index
+		 * @param weight weight
+		 * @param start first position
+		 * @param end one past the last position
+		 * @param vec buffer for the remapped example of at least seq_length
+		 */
+		void add_example_to_trees(
+			CTrie<DNATrie>* trie, int32_t idx, float64_t weight,
+			int32_t start, int32_t end, int32_t* vec);
+
+		/** construct all trees with env()->get_num_threads() threads, each
+		 * building the trees of a range of positions, and merge them
+		 *
+		 * @param count count
+		 * @param IDX IDX
+		 * @param alphas alphas
+		 */
+		void init_tries_parallel(
+			int32_t count, int32_t* IDX, float64_t* alphas);
+
 		/** compute by tree
 		 *
 		 * @param idx index
@@ -0,0 +1,81 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#ifndef __CANCELLATIONTOKEN_H_
+#define __CANCELLATIONTOKEN_H_
+
+#include <shogun/base/macros.h>
+#include <shogun/lib/common.h>
+
+#include <atomic>
+
+namespace shogun
+{
+	/**
+	 * @brief Requests to stop or pause a computation, packed into one
+	 * atomic word. Loops poll the token with a single relaxed load and only
+	 * look at the individual requests once any of them is set.
+	 */
+	class CancellationToken
+	{
+	public:
+		/** requests that can be set on the token */
+		enum ERequest : uint32_t
+		{
+			/** stop the computation */
+			CANCEL = 1,
+			/** pause the computation */
+			PAUSE = 2,
+			/** evaluate an additional stopping condition */
+			CONDITION = 4
+		};
+
+		/** constructor */
+		CancellationToken() : m_requests(0)
+		{
+		}
+
+		/** @return whether any request is set */
+		SG_FORCED_INLINE bool any() const
+		{
+			return m_requests.load(std::memory_order_relaxed) != 0;
+		}
+
+		/** @return the requests that are set */
+		SG_FORCED_INLINE uint32_t get() const
+		{
+			return m_requests.load(std::memory_order_relaxed);
+		}
+
+		/** @return whether a request is set
+		 * @param request the request
+		 */
+		SG_FORCED_INLINE bool is_set(ERequest request) const
+		{
+			return (m_requests.load(std::memory_order_relaxed) & request) != 0;
+		}
+
+		/** Sets a request
+		 * @param request the request
+		 */
+		void set(ERequest request)
+		{
+			m_requests.fetch_or(request, std::memory_order_release);
+		}
+
+		/** Clears a request
+		 * @param request the request
+		 */
+		void clear(ERequest request)
+		{
+			m_requests.fetch_and(~(uint32_t)request, std::memory_order_release);
+		}
+
+	private:
+		/** requests that are set */
+		std::atomic<uint32_t> m_requests;
+	};
+} // namespace shogun
+#endif
@@ -14,9 +14,6 @@ using namespace shogun;
 
 StoppableSGObject::StoppableSGObject() : SGObject()
 {
-	m_cancel_computation = false;
-	m_pause_computation_flag = false;
-
 	m_callback = nullptr;
 };
 
@@ -39,23 +36,27 @@ rxcpp::subscription StoppableSGObject::connect_to_signal_handler()
 void StoppableSGObject::set_callback(std::function<bool()> callback)
 {
 	m_callback = std::move(callback);
+	if (m_callback)
+		m_token.set(CancellationToken::CONDITION);
+	else
+		m_token.clear(CancellationToken::CONDITION);
 }
 
 void StoppableSGObject::reset_computation_variables()
 {
-	m_cancel_computation = false;
-	m_pause_computation_flag = false;
+	m_token.clear(CancellationToken::CANCEL);
+	m_token.clear(CancellationToken::PAUSE);
 }
 
 void StoppableSGObject::on_next()
 {
-	m_cancel_computation.store(true);
+	m_token.set(CancellationToken::CANCEL);
 	on_next_impl();
 }
 
 void StoppableSGObject::on_pause()
 {
-	m_pause_computation_flag.store(true);
+	m_token.set(CancellationToken::PAUSE);
 	on_pause_impl();
 	resume_computation();
 }
@@ -8,6 +8,7 @@
 #define __STOPPABLESGOBJECT_H_
 
 #include <shogun/base/SGObject.h>
+#include <shogun/lib/CancellationToken.h>
 
 #include <condition_variable>
 #include <mutex>
@@ -15,9 +16,12 @@
 namespace shogun
 {
 #define COMPUTATION_CONTROLLERS                                                \
-	if (this->cancel_computation())                                            \
-		break;                                                                 \
-	this->pause_computation();
+	if (SG_UNLIKELY(this->computation_interrupted()))                          \
+	{                                                                          \
+		if (this->cancel_computation())                                        \
+			break;                                                             \
+		this->pause_computation();                                             \
+	}
 
 	/**
 	 * Class that abstracts all premature stopping code
@@ -31,13 +35,29 @@ namespace shogun
 		/** destructor */
 		virtual ~StoppableSGObject();
 
+#ifndef SWIG
+		/** @return whether the algorithm may need to be stopped or paused,
+		 * with a single relaxed load
+		 */
+		SG_FORCED_INLINE bool computation_interrupted() const
+		{
+			return m_token.any();
+		}
+#endif
+
 #ifndef SWIG
 		/** @return whether the algorithm needs to be stopped */
 		SG_FORCED_INLINE bool cancel_computation() const
 		{
-			/* Execute the callback, if present*/
-			return (m_callback) ? (m_cancel_computation.load() || m_callback())
-			                    : m_cancel_computation.load();
+			auto requests = m_token.get();
+			if (SG_UNLIKELY(requests != 0))
+			{
+				/* Execute the callback, if present*/
+				return (requests & CancellationToken::CANCEL) ||
+				       ((requests & CancellationToken::CONDITION) &&
+				        m_callback());
+			}
+			return false;
 		}
 #endif
 
@@ -45,10 +65,10 @@ namespace shogun
 		/** Pause the algorithm if the flag is set */
 		SG_FORCED_INLINE void pause_computation()
 		{
-			if (m_pause_computation_flag.load())
+			if (SG_UNLIKELY(m_token.is_set(CancellationToken::PAUSE)))
 			{
 				std::unique_lock<std::mutex> lck(m_mutex);
-				while (m_pause_computation_flag.load())
+				while (m_token.is_set(CancellationToken::PAUSE))
 					m_pause_computation.wait(lck);
 			}
 		}
@@ -59,7 +79,7 @@ namespace shogun
 		SG_FORCED_INLINE void resume_computation()
 		{
 			std::unique_lock<std::mutex> lck(m_mutex);
-			m_pause_computation_flag = false;
+			m_token.clear(CancellationToken::PAUSE);
 			m_pause_computation.notify_all();
 		}
 #endif
@@ -103,11 +123,8 @@ namespace shogun
 		virtual void on_complete_impl();
 
 	protected:
-		/** Cancel computation */
-		std::atomic<bool> m_cancel_computation;
-
-		/** Pause computation flag */
-		std::atomic<bool> m_pause_computation_flag;
+		/** Cancel and pause requests, and whether there is a callback */
+		CancellationToken m_token;
 
 		/** Conditional variable to make threads wait */
 		std::condition_variable m_pause_computation;
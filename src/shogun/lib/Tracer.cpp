@@ -0,0 +1,294 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/io/SGIO.h>
+#include <shogun/io/ShogunErrc.h>
+#include <shogun/io/fs/FileSystem.h>
+#include <shogun/lib/Tracer.h>
+#include <shogun/lib/observers/ObservedValueTemplated.h>
+
+#include <algorithm>
+#include <array>
+#include <memory>
+#include <mutex>
+#include <sstream>
+
+using namespace shogun;
+
+namespace
+{
+	/** totals of a section on one thread, only written by that thread */
+	struct Totals
+	{
+		std::atomic<int64_t> count{0};
+		std::atomic<int64_t> nanoseconds{0};
+	};
+
+	/** pass through a section */
+	struct Event
+	{
+		int32_t section;
+		int64_t begin;
+		int64_t end;
+	};
+
+	/** trace data of one thread */
+	struct ThreadBuffer
+	{
+		explicit ThreadBuffer(int32_t thread_id) : id(thread_id)
+		{
+		}
+
+		int32_t id;
+		std::array<Totals, Tracer::MAX_SECTIONS> totals;
+		std::mutex events_lock;
+		std::vector<Event> events;
+	};
+
+	/** sections and buffers of all threads */
+	struct Registry
+	{
+		std::mutex lock;
+		std::vector<std::string> sections;
+		std::vector<std::shared_ptr<ThreadBuffer>> buffers;
+		int32_t next_thread_id = 0;
+		std::atomic<int64_t> epoch{0};
+	};
+
+	/* never destroyed, as threads may trace during static destruction */
+	Registry& registry()
+	{
+		static auto instance = new Registry();
+		return *instance;
+	}
+
+	ThreadBuffer& thread_buffer()
+	{
+		thread_local std::shared_ptr<ThreadBuffer> buffer = []() {
+			auto& r = registry();
+			std::lock_guard<std::mutex> lock(r.lock);
+			auto b = std::make_shared<ThreadBuffer>(r.next_thread_id++);
+			r.buffers.push_back(b);
+			return b;
+		}();
+		return *buffer;
+	}
+
+	void accumulate(std::atomic<int64_t>& total, int64_t value)
+	{
+		/* single writer, readers only need to see some recent value */
+		total.store(
+		    total.load(std::memory_order_relaxed) + value,
+		    std::memory_order_relaxed);
+	}
+} // namespace
+
+std::atomic<bool> Tracer::s_enabled{false};
+std::atomic<bool> Tracer::s_recording{false};
+
+Tracer::Tracer() : SGObject()
+{
+}
+
+Tracer::~Tracer()
+{
+}
+
+void Tracer::enable(bool record_events)
+{
+	auto& r = registry();
+	int64_t expected = 0;
+	r.epoch.compare_exchange_strong(expected, now());
+	s_recording.store(record_events);
+	s_enabled.store(true);
+}
+
+void Tracer::disable()
+{
+	s_enabled.store(false);
+	s_recording.store(false);
+}
+
+int32_t Tracer::register_section(const char* name)
+{
+	auto& r = registry();
+	std::lock_guard<std::mutex> lock(r.lock);
+	auto it = std::find(r.sections.begin(), r.sections.end(), name);
+	if (it != r.sections.end())
+		return std::distance(r.sections.begin(), it);
+
+	if (r.sections.size() >= MAX_SECTIONS)
+	{
+		io::warn(
+		    "Section {} is not traced, at most {} sections are supported.",
+		    name, MAX_SECTIONS);
+		return -1;
+	}
+
+	r.sections.emplace_back(name);
+	return r.sections.size() - 1;
+}
+
+void Tracer::add(int32_t section, int64_t count, int64_t nanoseconds)
+{
+	if (section < 0)
+		return;
+
+	auto& totals = thread_buffer().totals[section];
+	accumulate(totals.count, count);
+	if (nanoseconds)
+		accumulate(totals.nanoseconds, nanoseconds);
+}
+
+void Tracer::record(int32_t section, int64_t begin, int64_t end)
+{
+	if (section < 0)
+		return;
+
+	auto& buffer = thread_buffer();
+	std::lock_guard<std::mutex> lock(buffer.events_lock);
+	buffer.events.push_back({section, begin, end});
+}
+
+void Tracer::reset()
+{
+	auto& r = registry();
+	std::lock_guard<std::mutex> lock(r.lock);
+	/* buffers only referenced here belong to threads that have exited */
+	r.buffers.erase(
+	    std::remove_if(
+	        r.buffers.begin(), r.buffers.end(),
+	        [](const auto& b) { return b.use_count() == 1; }),
+	    r.buffers.end());
+	for (auto& buffer : r.buffers)
+	{
+		for (auto& totals : buffer->totals)
+		{
+			totals.count.store(0, std::memory_order_relaxed);
+			totals.nanoseconds.store(0, std::memory_order_relaxed);
+		}
+		std::lock_guard<std::mutex> events_lock(buffer->events_lock);
+		buffer->events.clear();
+	}
+	r.epoch.store(now());
+}
+
+namespace
+{
+	/** @return sum over threads of the totals of a section, with the
+	 * registry locked */
+	std::pair<int64_t, int64_t> sum_totals(const Registry& r, size_t section)
+	{
+		int64_t count = 0;
+		int64_t nanoseconds = 0;
+		for (const auto& buffer : r.buffers)
+		{
+			count += buffer->totals[section].count.load(
+			    std::memory_order_relaxed);
+			nanoseconds += buffer->totals[section].nanoseconds.load(
+			    std::memory_order_relaxed);
+		}
+		return std::make_pair(count, nanoseconds);
+	}
+
+	/** @return id of a section or -1, with the registry locked */
+	int32_t find_section(const Registry& r, std::string_view name)
+	{
+		auto it = std::find(r.sections.begin(), r.sections.end(), name);
+		return it == r.sections.end()
+		           ? -1
+		           : (int32_t)std::distance(r.sections.begin(), it);
+	}
+} // namespace
+
+std::vector<std::string> Tracer::get_sections() const
+{
+	auto& r = registry();
+	std::lock_guard<std::mutex> lock(r.lock);
+	std::vector<std::string> names;
+	for (size_t i = 0; i < r.sections.size(); ++i)
+	{
+		if (sum_totals(r, i).first > 0)
+			names.push_back(r.sections[i]);
+	}
+	return names;
+}
+
+int64_t Tracer::get_count(std::string_view name) const
+{
+	auto& r = registry();
+	std::lock_guard<std::mutex> lock(r.lock);
+	auto section = find_section(r, name);
+	return section < 0 ? 0 : sum_totals(r, section).first;
+}
+
+float64_t Tracer::get_seconds(std::string_view name) const
+{
+	auto& r = registry();
+	std::lock_guard<std::mutex> lock(r.lock);
+	auto section = find_section(r, name);
+	return section < 0 ? 0.0 : sum_totals(r, section).second * 1e-9;
+}
+
+void Tracer::observe_totals(int64_t step)
+{
+	std::vector<std::tuple<std::string, int64_t, float64_t>> totals;
+	{
+		auto& r = registry();
+		std::lock_guard<std::mutex> lock(r.lock);
+		for (size_t i = 0; i < r.sections.size(); ++i)
+		{
+			auto sum = sum_totals(r, i);
+			if (sum.first > 0)
+				totals.emplace_back(r.sections[i], sum.first, sum.second * 1e-9);
+		}
+	}
+
+	for (const auto& [name, count, seconds] : totals)
+	{
+		observe<int64_t>(
+		    step, name + "_count", "Number of passes through the section",
+		    count);
+		observe<float64_t>(
+		    step, name + "_seconds", "Seconds spent in the section", seconds);
+	}
+}
+
+void Tracer::write_chrome_trace(const std::string& filename) const
+{
+	std::stringstream json;
+	json << "{\"traceEvents\":[";
+	{
+		auto& r = registry();
+		std::lock_guard<std::mutex> lock(r.lock);
+		auto epoch = r.epoch.load();
+		bool first = true;
+		for (const auto& buffer : r.buffers)
+		{
+			std::lock_guard<std::mutex> events_lock(buffer->events_lock);
+			for (const auto& event : buffer->events)
+			{
+				if (!first)
+					json << ",";
+				first = false;
+				json << "{\"name\":\"" << r.sections[event.section]
+				     << "\",\"ph\":\"X\",\"pid\":0,\"tid\":" << buffer->id
+				     << ",\"ts\":" << (event.begin - epoch) * 1e-3
+				     << ",\"dur\":" << (event.end - event.begin) * 1e-3
+				     << "}";
+			}
+		}
+	}
+	json << "],\"displayTimeUnit\":\"ms\"}\n";
+
+	std::unique_ptr<io::WritableFile> file;
+	if (auto ec = env()->new_writable_file(filename, &file))
+		throw io::to_system_error(ec);
+	if (auto ec = file->append(json.str()))
+		throw io::to_system_error(ec);
+	if (auto ec = file->close())
+		throw io::to_system_error(ec);
+}
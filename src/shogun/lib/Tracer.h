@@ -0,0 +1,217 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#ifndef __TRACER_H__
+#define __TRACER_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/SGObject.h>
+#include <shogun/base/macros.h>
+#include <shogun/io/SGIO.h>
+#include <shogun/lib/common.h>
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace shogun
+{
+	/** @brief Collects the time spent in and the number of passes through
+	 * traced code sections, such as kernel matrix computation, kernel cache
+	 * misses or solver iterations.
+	 *
+	 * Sections are marked with SG_TRACE_SCOPE and counted with
+	 * SG_TRACE_COUNT. Every thread accumulates into its own buffer, so
+	 * traced code never takes a lock. When tracing is disabled, which is the
+	 * default, a traced section costs one relaxed load. Tracing is enabled
+	 * with enable() or by setting the environment variable SHOGUN_TRACE to
+	 * "on", or to "events" to also record every pass through a section.
+	 *
+	 * The totals of all threads are emitted as observed values of the
+	 * tracer, see observe_totals(), so they can be written to TensorBoard by
+	 * subscribing a ParameterObserver to env()->tracer(). Recorded events
+	 * are written as a Chrome trace with write_chrome_trace(), which can be
+	 * opened in chrome://tracing.
+	 *
+	 * At most MAX_SECTIONS sections are traced, further sections are
+	 * ignored.
+	 */
+	class Tracer : public SGObject
+	{
+	public:
+		/** maximum number of traced sections */
+		static constexpr int32_t MAX_SECTIONS = 256;
+
+		/** default constructor */
+		Tracer();
+
+		virtual ~Tracer();
+
+		/** @return whether tracing is enabled */
+		static SG_FORCED_INLINE bool is_enabled()
+		{
+			return s_enabled.load(std::memory_order_relaxed);
+		}
+
+		/** @return whether every pass through a section is recorded */
+		static SG_FORCED_INLINE bool is_recording()
+		{
+			return s_recording.load(std::memory_order_relaxed);
+		}
+
+		/** Enables tracing.
+		 *
+		 * @param record_events whether to record every pass through a
+		 * section for write_chrome_trace()
+		 */
+		static void enable(bool record_events = false);
+
+		/** Disables tracing. Collected totals and events are kept. */
+		static void disable();
+
+		/** Registers a traced section, once per section.
+		 *
+		 * @param name name of the section
+		 * @return id of the section, or -1 if there are too many sections
+		 */
+		static int32_t register_section(const char* name);
+
+		/** Adds to the totals of a section on the calling thread.
+		 *
+		 * @param section id of the section
+		 * @param count number of passes
+		 * @param nanoseconds time spent in the section
+		 */
+		static void add(int32_t section, int64_t count, int64_t nanoseconds);
+
+		/** Records a pass through a section on the calling thread.
+		 *
+		 * @param section id of the section
+		 * @param begin start time in nanoseconds since the epoch of
+		 * now()
+		 * @param end end time in nanoseconds since the epoch of now()
+		 */
+		static void record(int32_t section, int64_t begin, int64_t end);
+
+		/** @return current time in nanoseconds of a steady clock */
+		static SG_FORCED_INLINE int64_t now()
+		{
+			return std::chrono::duration_cast<std::chrono::nanoseconds>(
+			           std::chrono::steady_clock::now().time_since_epoch())
+			    .count();
+		}
+
+		/** Clears the totals and the recorded events of all threads.
+		 * Should not be called while traced code is running.
+		 */
+		void reset();
+
+		/** @return names of the sections passed through so far */
+		std::vector<std::string> get_sections() const;
+
+		/** @return number of passes through a section, summed over threads
+		 *
+		 * @param name name of the section
+		 */
+		int64_t get_count(std::string_view name) const;
+
+		/** @return seconds spent in a section, summed over threads
+		 *
+		 * @param name name of the section
+		 */
+		float64_t get_seconds(std::string_view name) const;
+
+		/** Emits the totals of every section passed through so far as the
+		 * observed values "<section>_count" and "<section>_seconds".
+		 *
+		 * @param step step of the observed values
+		 */
+		void observe_totals(int64_t step);
+
+		/** Writes the recorded events of all threads in the Chrome trace
+		 * event format.
+		 *
+		 * @param filename name of the JSON file
+		 */
+		void write_chrome_trace(const std::string& filename) const;
+
+		/** @return object name */
+		virtual const char* get_name() const
+		{
+			return "Tracer";
+		}
+
+	private:
+		/** whether tracing is enabled */
+		static std::atomic<bool> s_enabled;
+
+		/** whether events are recorded */
+		static std::atomic<bool> s_recording;
+	};
+
+	/** @brief Adds the time between its construction and destruction to a
+	 * traced section, if tracing was enabled on construction.
+	 */
+	class TraceScope
+	{
+	public:
+		/** constructor
+		 *
+		 * @param section id of the section
+		 */
+		SG_FORCED_INLINE explicit TraceScope(int32_t section)
+		    : m_section(section), m_begin(0)
+		{
+			if (SG_UNLIKELY(Tracer::is_enabled()))
+				m_begin = Tracer::now();
+		}
+
+		SG_FORCED_INLINE ~TraceScope()
+		{
+			if (SG_UNLIKELY(m_begin != 0))
+			{
+				auto end = Tracer::now();
+				Tracer::add(m_section, 1, end - m_begin);
+				if (Tracer::is_recording())
+					Tracer::record(m_section, m_begin, end);
+			}
+		}
+
+		SG_DELETE_COPY_AND_ASSIGN(TraceScope);
+
+	private:
+		/** id of the section */
+		int32_t m_section;
+
+		/** start time, 0 when not traced */
+		int64_t m_begin;
+	};
+} // namespace shogun
+
+#define SG_TRACE_CONCAT_IMPL(a, b) a##b
+#define SG_TRACE_CONCAT(a, b) SG_TRACE_CONCAT_IMPL(a, b)
+
+/** Traces the rest of the enclosing scope as the section name */
+#define SG_TRACE_SCOPE(name)                                                   \
+	static const int32_t SG_TRACE_CONCAT(sg_trace_section_, __LINE__) =        \
+	    shogun::Tracer::register_section(name);                                \
+	shogun::TraceScope SG_TRACE_CONCAT(sg_trace_scope_, __LINE__)(            \
+	    SG_TRACE_CONCAT(sg_trace_section_, __LINE__))
+
+/** Counts n passes through the section name */
+#define SG_TRACE_COUNT(name, n)                                                \
+	do                                                                         \
+	{                                                                          \
+		if (SG_UNLIKELY(shogun::Tracer::is_enabled()))                         \
+		{                                                                      \
+			static const int32_t sg_trace_section =                            \
+			    shogun::Tracer::register_section(name);                        \
+			shogun::Tracer::add(sg_trace_section, n, 0);                       \
+		}                                                                      \
+	} while (0)
+
+#endif // __TRACER_H__
@@ -234,6 +234,20 @@ IGNORE_IN_CLASSLIST template <class Trie> class CTrie : public SGObject
 		 */
 		void delete_trees(bool p_use_compact_terminal_nodes=true);
 
+		/** merge trees of another trie with the same degree and length into
+		 * this one, e.g. ones that were built by another thread
+		 *
+		 * The nodes are copied depth first with the children of every node
+		 * stored next to each other, which keeps the nodes visited by a
+		 * lookup close in memory. The trees of this trie in the given range
+		 * are expected to be empty.
+		 *
+		 * @param other trie to copy trees from
+		 * @param start first tree to merge
+		 * @param end one past the last tree to merge
+		 */
+		void merge_trees(const CTrie & other, int32_t start, int32_t end);
+
 		/** add to trie
 		 *
 		 * @param i i
@@ -539,6 +553,17 @@ IGNORE_IN_CLASSLIST template <class Trie> class CTrie : public SGObject
 			return weights_in_tree;
 		}
 
+		/** copy a subtree of another trie below a node of this one
+		 *
+		 * @param other trie to copy from
+		 * @param other_node root of the subtree in the other trie
+		 * @param node node of this trie to copy the root to
+		 * @param depth depth of the root
+		 */
+		void copy_subtree(
+			const CTrie & other, int32_t other_node, int32_t node,
+			int32_t depth);
+
 		/** POIMs extract W helper
 		 *
 		 * @param nodeIdx node index
@@ -1176,6 +1201,56 @@ template <class Trie> void CTrie<Trie>::delete_trees(
 	use_compact_terminal_nodes=p_use_compact_terminal_nodes ;
 }
 
+template <class Trie> void CTrie<Trie>::merge_trees(
+	const CTrie & other, int32_t start, int32_t end)
+{
+	ASSERT(other.degree==degree)
+	ASSERT(other.length==length)
+	ASSERT((start>=0) && (end<=length))
+
+	for (int32_t i=start; i<end; i++)
+		copy_subtree(other, other.trees[i], trees[i], 0);
+}
+
+template <class Trie> void CTrie<Trie>::copy_subtree(
+	const CTrie & other, int32_t other_node, int32_t node, int32_t depth)
+{
+	TreeMem[node]=other.TreeMem[other_node];
+
+	// nodes of the last level hold the weights of their children
+	if (depth>=degree-1)
+		return;
+
+	// allocate all children first so that they are stored next to each other
+	// (note that get_node() may move TreeMem)
+	int32_t children[4];
+	for (int32_t q=0; q<4; q++)
+	{
+		int32_t child=other.TreeMem[other_node].children[q];
+		if (child==NO_CHILD)
+		{
+			children[q]=NO_CHILD;
+			continue;
+		}
+
+		children[q]=get_node();
+		// negative indices point to compact terminal nodes
+		TreeMem[node].children[q]=(child<0) ? -children[q] : children[q];
+	}
+
+	for (int32_t q=0; q<4; q++)
+	{
+		if (children[q]==NO_CHILD)
+			continue;
+
+		int32_t child=other.TreeMem[other_node].children[q];
+		if (child<0)
+			TreeMem[children[q]]=other.TreeMem[-child];
+		else
+			copy_subtree(other, child, children[q], depth+1);
+	}
+}
+
 	template <class Trie>
 float64_t CTrie<Trie>::compute_abs_weights_tree(int32_t tree, int32_t depth)
 {
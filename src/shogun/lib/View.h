@@ -6,6 +6,7 @@
 #ifndef _VIEW__H__
 #define _VIEW__H__
 
+#include <shogun/features/DenseIndexViewFeatures.h>
 #include <shogun/features/Features.h>
 #include <shogun/labels/Labels.h>
 #include <shogun/lib/SGVector.h>
@@ -15,7 +16,9 @@ namespace shogun
 {
 
 	/** Creates a subset view of the viewable object containing the elements
-	 * whose indices are listed in the passed vector
+	 * whose indices are listed in the passed vector. Dense features with a
+	 * feature matrix are viewed with DenseIndexViewFeatures, which share
+	 * the matrix, other objects are duplicated and get the subset added.
 	 *
 	 * @param viewable pointer to the viewable object
 	 * @param subset subset of indices
@@ -28,6 +31,11 @@ namespace shogun
 		    std::is_base_of<Features, T>::value ||
 		        std::is_base_of<Labels, T>::value,
 		    "Class is not viewable.");
+		if constexpr (std::is_base_of<Features, T>::value)
+		{
+			if (auto result = dense_index_view(viewable, subset))
+				return result->template as<T>();
+		}
 		auto result = viewable->duplicate();
 		result->add_subset(subset);
 		return result->template as<T>();
@@ -24,6 +24,34 @@ class LSHNearestNeighborTableError : public FalconnError {
   LSHNearestNeighborTableError(const char* msg) : FalconnError(msg) {}
 };
 
+///
+/// A query object that probes a table independently of the table's own
+/// query methods, so that several threads can query the same table, each
+/// with its own query object.
+///
+template <typename PointType, typename KeyType = int32_t>
+class LSHNearestNeighborQuery {
+ public:
+  ///
+  /// Find the keys of the k closest candidates in the probing sequence for q.
+  /// The keys are returned in order of increasing distance to q.
+  ///
+  virtual void find_k_nearest_neighbors(const PointType& q, int_fast64_t k,
+                                        std::vector<KeyType>* result) = 0;
+
+  ///
+  /// Returns the keys of all candidates in the probing sequence for q.
+  /// Every candidate key occurs only once in the result.
+  ///
+  virtual void get_unique_candidates(const PointType& q,
+                                     std::vector<KeyType>* result) = 0;
+
+  ///
+  /// Virtual destructor.
+  ///
+  virtual ~LSHNearestNeighborQuery() {}
+};
+
 ///
 /// The common interface shared by all LSH table wrappers.
 ///
@@ -36,6 +64,14 @@ class LSHNearestNeighborTableError : public FalconnError {
 template <typename PointType, typename KeyType = int32_t>
 class LSHNearestNeighborTable {
  public:
+  ///
+  /// Constructs a query object for the table. The number of probes and the
+  /// maximum number of candidates default to the settings of the table.
+  ///
+  virtual std::unique_ptr<LSHNearestNeighborQuery<PointType, KeyType>>
+  construct_query_object(int_fast64_t num_probes = -1,
+                         int_fast64_t max_num_candidates = -1) const = 0;
+
   ///
   /// Sets the number of probes used for each query.
   /// The default setting is l (number of tables), which effectively disables
@@ -315,6 +315,35 @@ struct GetDefaultParameters<SparseVector<CoordinateType>> {
   }
 };
 
+template <typename PointType, typename KeyType, typename LSHTable,
+          typename NNQuery, typename DataStorage>
+class LSHNNQueryWrapper : public LSHNearestNeighborQuery<PointType, KeyType> {
+ public:
+  LSHNNQueryWrapper(const LSHTable& lsh_table, const DataStorage& data_storage,
+                    int_fast64_t num_probes, int_fast64_t max_num_candidates)
+      : query_(new typename LSHTable::Query(lsh_table)),
+        nn_query_(new NNQuery(query_.get(), data_storage)),
+        num_probes_(num_probes),
+        max_num_candidates_(max_num_candidates) {}
+
+  void find_k_nearest_neighbors(const PointType& q, int_fast64_t k,
+                                std::vector<KeyType>* result) {
+    nn_query_->find_k_nearest_neighbors(q, q, k, num_probes_,
+                                        max_num_candidates_, result);
+  }
+
+  void get_unique_candidates(const PointType& q, std::vector<KeyType>* result) {
+    query_->get_unique_candidates(q, num_probes_, max_num_candidates_, result);
+  }
+
+ protected:
+  std::unique_ptr<typename LSHTable::Query> query_;
+  std::unique_ptr<NNQuery> nn_query_;
+
+  int_fast64_t num_probes_;
+  int_fast64_t max_num_candidates_;
+};
+
 template <typename PointType, typename KeyType, typename DistanceType,
           typename DistanceFunction, typename LSHTable, typename LSHFunction,
           typename HashTableFactory, typename CompositeHashTable,
@@ -348,6 +377,21 @@ class LSHNNTableWrapper : public LSHNearestNeighborTable<PointType, KeyType> {
 
   int_fast64_t get_num_probes() { return num_probes_; }
 
+  std::unique_ptr<LSHNearestNeighborQuery<PointType, KeyType>>
+  construct_query_object(int_fast64_t num_probes = -1,
+                         int_fast64_t max_num_candidates = -1) const {
+    if (num_probes <= 0) {
+      num_probes = num_probes_;
+    }
+    if (max_num_candidates == -1) {
+      max_num_candidates = max_num_candidates_;
+    }
+    return std::unique_ptr<LSHNearestNeighborQuery<PointType, KeyType>>(
+        new LSHNNQueryWrapper<PointType, KeyType, LSHTable, NNQuery,
+                              DataStorage>(*lsh_table_, *data_storage_,
+                                           num_probes, max_num_candidates));
+  }
+
   void set_max_num_candidates(int_fast64_t max_num_candidates) {
     max_num_candidates_ = max_num_candidates;
   }
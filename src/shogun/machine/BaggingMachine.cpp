@@ -13,6 +13,7 @@
 #include <shogun/mathematics/UniformIntDistribution.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/evaluation/Evaluation.h>
+#include <shogun/features/DenseIndexViewFeatures.h>
 
 #include <utility>
 
@@ -155,7 +156,7 @@ bool BaggingMachine::train_machine(std::shared_ptr<Features> data)
 	random::fill_array(rnd_indicies, 0, m_bag_size - 1, m_prng);
 
 	auto pb = SG_PROGRESS(range(m_num_bags));
-#pragma omp parallel for
+#pragma omp parallel for num_threads(env()->get_num_threads())
 	for (int32_t i = 0; i < m_num_bags; ++i)
 	{
 		auto c=std::dynamic_pointer_cast<Machine>(m_machine->clone());
@@ -163,20 +164,18 @@ bool BaggingMachine::train_machine(std::shared_ptr<Features> data)
 		SGVector<index_t> idx(
 		    rnd_indicies.get_column_vector(i), m_bag_size, false);
 
-		std::shared_ptr<Features> features;
-		std::shared_ptr<Labels> labels;
-
-		if (env()->get_num_threads() == 1)
-		{
-			features = m_features;
-			labels = m_labels;
-		}
-		else
+		/* dense features are viewed without being copied, others get the
+		 * subset on a shallow copy, or in place if single threaded */
+		bool in_place = env()->get_num_threads() == 1;
+		auto features = dense_index_view(m_features, idx);
+		bool viewed = features != nullptr;
+		if (!viewed)
 		{
-			features = m_features->shallow_subset_copy();
-			labels = m_labels->shallow_subset_copy();
+			features =
+			    in_place ? m_features : m_features->shallow_subset_copy();
+			features->add_subset(idx);
 		}
-
+		auto labels = in_place ? m_labels : m_labels->shallow_subset_copy();
 		labels->add_subset(idx);
 		/* TODO:
 		   if it's a binary labeling ensure that
@@ -194,11 +193,11 @@ bool BaggingMachine::train_machine(std::shared_ptr<Features> data)
 		    }
 		}
 		*/
-		features->add_subset(idx);
 		set_machine_parameters(c, idx);
 		c->set_labels(labels);
 		c->train(features);
-		features->remove_subset();
+		if (!viewed)
+			features->remove_subset();
 		labels->remove_subset();
 
 #pragma omp critical
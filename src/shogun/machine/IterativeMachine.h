@@ -32,6 +32,7 @@ namespace shogun
 		{
 			m_current_iteration = 0;
 			m_complete = false;
+			m_warm_start = false;
 			m_continue_features = nullptr;
 
 			SG_ADD(
@@ -42,6 +43,10 @@ namespace shogun
 			    "Maximum number of Iterations", ParameterProperties::HYPER);
 			SG_ADD(
 			    &m_complete, "complete", "Convergence status");
+			SG_ADD(
+			    &m_warm_start, "warm_start",
+			    "Whether training starts from the current model",
+			    ParameterProperties::SETTING);
 			SG_ADD(
 			    &m_continue_features, "continue_features", "Continue Features");
 		}
@@ -56,6 +61,17 @@ namespace shogun
 			return m_complete;
 		}
 
+		/** If enabled, train() starts from the current model (e.g. the
+		 * solution for other hyperparameters) if the learner supports it,
+		 * see init_warm_start().
+		 *
+		 * @param warm_start whether to start from the current model
+		 */
+		void set_warm_start(bool warm_start)
+		{
+			m_warm_start = warm_start;
+		}
+
 		virtual bool continue_train()
 		{
 			this->reset_computation_variables();
@@ -102,7 +118,8 @@ namespace shogun
 			}
 			m_current_iteration = 0;
 			m_complete = false;
-			init_model(data);
+			if (!m_warm_start || !init_warm_start(data))
+				init_model(data);
 			return continue_train();
 		}
 
@@ -115,6 +132,16 @@ namespace shogun
 		  */
 		virtual void init_model(std::shared_ptr<Features> data = NULL) = 0;
 
+		/** Can be overloaded in subclasses to initialize training from the
+		 * current model instead of init_model()
+		 *
+		 * @return false if the current model cannot be used
+		 */
+		virtual bool init_warm_start(std::shared_ptr<Features> data)
+		{
+			return false;
+		}
+
 		/** Can be overloaded in subclasses to show more information
 		  * and/or clean up states
 		  */
@@ -130,6 +157,8 @@ namespace shogun
 		int32_t m_current_iteration;
 		/** Completion status */
 		bool m_complete;
+		/** Whether training starts from the current model */
+		bool m_warm_start;
 	};
 }
 #endif
@@ -7,7 +7,9 @@
 
 #include <shogun/machine/KernelMulticlassMachine.h>
 #include <shogun/features/Features.h>
+#include <shogun/kernel/CustomKernel.h>
 #include <shogun/kernel/Kernel.h>
+#include <shogun/lib/View.h>
 #include <shogun/machine/KernelMachine.h>
 
 #include <unordered_set>
@@ -158,6 +160,72 @@ std::shared_ptr<Machine> KernelMulticlassMachine::get_machine_from_trained(std::
 	return std::make_shared<KernelMachine>(machine->as<KernelMachine>());
 }
 
+std::shared_ptr<Machine> KernelMulticlassMachine::get_machine_for_concurrent_train(
+    SGVector<index_t> subset)
+{
+	/* detach the kernel while cloning, the machine would otherwise deep copy
+	 * it together with its features */
+	auto base_machine = m_machine->as<KernelMachine>();
+	auto base_kernel = base_machine->get_kernel();
+	base_machine->set_kernel(nullptr);
+	auto machine = make_clone(
+	    base_machine,
+	    ParameterProperties::HYPER | ParameterProperties::SETTING);
+	base_machine->set_kernel(base_kernel);
+
+	machine->set_kernel(get_task_kernel(subset));
+
+	return machine;
+}
+
+std::shared_ptr<Machine> KernelMulticlassMachine::get_machine_from_task(
+    std::shared_ptr<Machine> machine, SGVector<index_t> subset) const
+{
+	auto result = get_machine_from_trained(machine)->as<KernelMachine>();
+
+	if (subset.vlen)
+	{
+		for (int32_t j = 0; j < result->get_num_support_vectors(); ++j)
+			result->set_support_vector(j, subset[result->get_support_vector(j)]);
+	}
+
+	/* the task kernel only covers the training vectors of the task */
+	result->set_kernel(m_kernel);
+
+	return result;
+}
+
+std::shared_ptr<Kernel>
+KernelMulticlassMachine::get_task_kernel(SGVector<index_t> subset) const
+{
+	if (m_kernel->get_kernel_type() == K_CUSTOM)
+	{
+		auto kernel = m_kernel->as<CustomKernel>()->shallow_copy();
+		if (subset.vlen)
+		{
+			kernel->add_row_subset(subset);
+			kernel->add_col_subset(subset);
+		}
+		return kernel;
+	}
+
+	auto kernel = make_clone(
+	    m_kernel, ParameterProperties::HYPER | ParameterProperties::SETTING);
+	kernel->set_cache_size(m_kernel->get_cache_size());
+
+	auto lhs = m_kernel->get_lhs();
+	auto rhs = m_kernel->get_rhs();
+	if (subset.vlen)
+	{
+		auto lhs_view = view(lhs, subset);
+		rhs = lhs == rhs ? lhs_view : view(rhs, subset);
+		lhs = lhs_view;
+	}
+	kernel->init(lhs, rhs);
+
+	return kernel;
+}
+
 int32_t KernelMulticlassMachine::get_num_rhs_vectors() const
 {
 	return m_kernel->get_num_vec_rhs();
@@ -165,12 +233,12 @@ int32_t KernelMulticlassMachine::get_num_rhs_vectors() const
 
 void KernelMulticlassMachine::add_machine_subset(SGVector<index_t> subset)
 {
-	not_implemented(SOURCE_LOCATION);
+	m_machine->as<KernelMachine>()->set_kernel(get_task_kernel(subset));
 }
 
 void KernelMulticlassMachine::remove_machine_subset()
 {
-	not_implemented(SOURCE_LOCATION);
+	m_machine->as<KernelMachine>()->set_kernel(m_kernel);
 }
 
 
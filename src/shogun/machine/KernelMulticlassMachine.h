@@ -77,16 +77,47 @@ class KernelMulticlassMachine : public MulticlassMachine
 		/** construct kernel machine from given kernel machine */
 		virtual std::shared_ptr<Machine> get_machine_from_trained(std::shared_ptr<Machine> machine) const;
 
+		/** sub-machines train on per-task copies of the kernel */
+		virtual bool supports_concurrent_train() const
+		{
+			return true;
+		}
+
+		/** clone the hyper-parameters of the base machine and give it its
+		 * own kernel from get_task_kernel()
+		 */
+		virtual std::shared_ptr<Machine> get_machine_for_concurrent_train(
+		    SGVector<index_t> subset);
+
+		/** construct kernel machine from the machine trained on a task, the
+		 * support vectors of a subset task are mapped back to the indices
+		 * of all training vectors
+		 */
+		virtual std::shared_ptr<Machine> get_machine_from_task(
+		    std::shared_ptr<Machine> machine, SGVector<index_t> subset) const;
+
+		/** creates a copy of the kernel on the training vectors of a task.
+		 * The copy is initialised on views of the shared features,
+		 * precomputed kernels share the kernel matrix and get the subset
+		 * on their rows and columns.
+		 *
+		 * @param subset indices of the training vectors of the task, empty
+		 * if all vectors are used
+		 * @return kernel of the task
+		 */
+		std::shared_ptr<Kernel> get_task_kernel(SGVector<index_t> subset) const;
+
 		/** return number of rhs feature vectors */
 		virtual int32_t get_num_rhs_vectors() const;
 
-		/** set subset to the features of the machine, deletes old one
+		/** give the base machine a kernel on the subset, see
+		 * get_task_kernel()
 		 *
 		 * @param subset subset indices to set
 		 */
 		virtual void add_machine_subset(SGVector<index_t> subset);
 
-		/** deletes any subset set to the features of the machine */
+		/** give the base machine the kernel on all vectors back */
 		virtual void remove_machine_subset();
 
 	protected:
@@ -13,6 +13,7 @@
 
 #include <shogun/lib/common.h>
 #include <shogun/features/DotFeatures.h>
+#include <shogun/lib/View.h>
 #include <shogun/machine/LinearMachine.h>
 #include <shogun/machine/MulticlassMachine.h>
 
@@ -128,6 +129,33 @@ class LinearMulticlassMachine : public MulticlassMachine
 			return std::make_shared<LinearMachine>(machine->as<LinearMachine>());
 		}
 
+		/** linear machines only read the shared features */
+		virtual bool supports_concurrent_train() const
+		{
+			return true;
+		}
+
+		/** clone the hyper-parameters of the base machine and give it a
+		 * view on the training features
+		 */
+		virtual std::shared_ptr<Machine> get_machine_for_concurrent_train(
+		    SGVector<index_t> subset)
+		{
+			auto machine = make_clone(
+			    m_machine, ParameterProperties::HYPER |
+			                   ParameterProperties::SETTING);
+			machine->as<LinearMachine>()->set_features(
+			    subset.vlen ? view(m_features, subset) : m_features);
+
+			return machine;
+		}
+
+		/** outputs are computed with dense_dot_range on shared features */
+		virtual bool supports_concurrent_apply() const
+		{
+			return true;
+		}
+
 		/** get number of rhs feature vectors */
 		virtual int32_t get_num_rhs_vectors() const
 		{
@@ -90,7 +90,8 @@ enum EMachineType
 	CT_BAGGING = 570,
 	CT_FWSOSVM = 580,
 	CT_BCFWSOSVM = 590,
-	CT_GAUSSIANPROCESSCLASS
+	CT_GAUSSIANPROCESSCLASS,
+	CT_ELASTICNET = 600
 };
 
 /** solver type */
@@ -7,6 +7,8 @@
  */
 
 #include <shogun/multiclass/MulticlassOneVsRestStrategy.h>
+#include <shogun/base/Parallel.h>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/machine/LinearMachine.h>
 #include <shogun/machine/KernelMachine.h>
 #include <shogun/machine/MulticlassMachine.h>
@@ -14,6 +16,8 @@
 #include <shogun/mathematics/Statistics.h>
 #include <shogun/labels/MultilabelLabels.h>
 
+#include <algorithm>
+#include <exception>
 #include <utility>
 
 using namespace shogun;
@@ -108,6 +112,10 @@ std::shared_ptr<MulticlassLabels> MulticlassMachine::apply_multiclass(std::share
 		SGVector<float64_t> As(num_machines);
 		SGVector<float64_t> Bs(num_machines);
 
+		int32_t num_threads = supports_concurrent_apply() ?
+			std::min(env()->get_num_threads(), num_machines) : 1;
+
+		#pragma omp parallel for num_threads(num_threads) if (num_threads>1)
 		for (int32_t i=0; i<num_machines; ++i)
 		{
 			outputs[i] = get_submachine_outputs(i);
@@ -192,6 +200,10 @@ std::shared_ptr<MultilabelLabels> MulticlassMachine::apply_multilabel_output(std
 		auto result=std::make_shared<MultilabelLabels>(num_vectors, n_outputs);
 		std::vector<std::shared_ptr<BinaryLabels>> outputs(num_machines);
 
+		int32_t num_threads = supports_concurrent_apply() ?
+			std::min(env()->get_num_threads(), num_machines) : 1;
+
+		#pragma omp parallel for num_threads(num_threads) if (num_threads>1)
 		for (int32_t i=0; i < num_machines; ++i)
 			outputs[i] = get_submachine_outputs(i);
 
@@ -231,6 +243,23 @@ bool MulticlassMachine::train_machine(std::shared_ptr<Features> data)
 
 	m_multiclass_strategy->train_start(
 	    multiclass_labels(m_labels), train_labels);
+
+	int32_t num_threads = std::min(
+	    env()->get_num_threads(), m_multiclass_strategy->get_num_machines());
+	if (num_threads > 1 && supports_concurrent_train())
+		train_submachines_concurrently(train_labels, num_threads);
+	else
+		train_submachines(train_labels);
+
+	m_multiclass_strategy->train_stop();
+
+
+	return true;
+}
+
+void MulticlassMachine::train_submachines(
+    const std::shared_ptr<BinaryLabels>& train_labels)
+{
 	while (m_multiclass_strategy->train_has_more())
 	{
 		SGVector<index_t> subset=m_multiclass_strategy->train_prepare_next();
@@ -241,7 +270,7 @@ bool MulticlassMachine::train_machine(std::shared_ptr<Features> data)
 		}
 
 		m_machine->train();
-		m_machines.push_back(get_machine_from_trained(m_machine));
+		m_machines.push_back(get_machine_from_task(m_machine, subset));
 
 		if (subset.vlen)
 		{
@@ -249,11 +278,86 @@ bool MulticlassMachine::train_machine(std::shared_ptr<Features> data)
 			remove_machine_subset();
 		}
 	}
+}
 
-	m_multiclass_strategy->train_stop();
+void MulticlassMachine::train_submachines_concurrently(
+    const std::shared_ptr<BinaryLabels>& train_labels, int32_t num_threads)
+{
+	SG_DEBUG("training sub-machines of {} using {} threads", get_name(), num_threads)
 
+	index_t num_tasks = 0;
+	int32_t num_machine_threads =
+	    std::max(env()->get_num_threads() / num_threads, 1);
+	std::exception_ptr exception;
 
-	return true;
+	/* the strategy writes the binary labels of the next task into
+	 * train_labels, so preparing a task (and copying its labels) is
+	 * serialized, while training the sub-machines runs concurrently */
+	#pragma omp parallel num_threads(num_threads)
+	{
+		/* limits the sub-machines of this thread only */
+		Parallel::ThreadBudget budget(num_machine_threads);
+		while (true)
+		{
+			index_t task = -1;
+			SGVector<index_t> subset;
+			std::shared_ptr<BinaryLabels> task_labels;
+			std::shared_ptr<Machine> machine;
+
+			#pragma omp critical (multiclass_prepare_next)
+			{
+				try
+				{
+					if (!exception && m_multiclass_strategy->train_has_more())
+					{
+						task = num_tasks++;
+						subset = m_multiclass_strategy->train_prepare_next();
+						task_labels = std::make_shared<BinaryLabels>(
+						    train_labels->get_num_labels());
+						task_labels->set_labels(
+						    train_labels->get_labels().clone());
+						machine = get_machine_for_concurrent_train(subset);
+					}
+				}
+				catch (...)
+				{
+					task = -1;
+					if (!exception)
+						exception = std::current_exception();
+				}
+			}
+
+			if (task < 0)
+				break;
+
+			try
+			{
+				if (subset.vlen)
+					task_labels->add_subset(subset);
+
+				machine->set_labels(task_labels);
+				machine->train();
+				auto trained = get_machine_from_task(machine, subset);
+
+				#pragma omp critical (multiclass_store_machine)
+				{
+					if (task >= (index_t)m_machines.size())
+						m_machines.resize(task + 1);
+					m_machines[task] = trained;
+				}
+			}
+			catch (...)
+			{
+				/* no further tasks are prepared after an exception */
+				#pragma omp critical (multiclass_prepare_next)
+				if (!exception)
+					exception = std::current_exception();
+			}
+		}
+	}
+
+	if (exception)
+		std::rethrow_exception(exception);
 }
 
 float64_t MulticlassMachine::apply_one(int32_t vec_idx)
@@ -162,6 +162,70 @@ class MulticlassMachine : public BaseMulticlassMachine
 		/** train machine */
 		virtual bool train_machine(std::shared_ptr<Features> data = NULL);
 
+		/** trains the sub-machines one after another, reusing the base
+		 * machine for every task of the strategy
+		 *
+		 * @param train_labels binary labels the strategy writes into
+		 */
+		void train_submachines(const std::shared_ptr<BinaryLabels>& train_labels);
+
+		/** trains the sub-machines concurrently. Tasks are taken from the
+		 * strategy one at a time and every task trains its own copy of the
+		 * base machine obtained from get_machine_for_concurrent_train().
+		 *
+		 * @param train_labels binary labels the strategy writes into
+		 * @param num_threads number of threads to use
+		 */
+		void train_submachines_concurrently(
+		    const std::shared_ptr<BinaryLabels>& train_labels,
+		    int32_t num_threads);
+
+		/** whether sub-machines can be trained concurrently, i.e. whether
+		 * get_machine_for_concurrent_train() is implemented
+		 */
+		virtual bool supports_concurrent_train() const
+		{
+			return false;
+		}
+
+		/** creates an untrained copy of the base machine that only shares
+		 * read-only data (features, precomputed kernels) with the other
+		 * sub-machines, so that it can be trained concurrently. Called
+		 * serially from train_submachines_concurrently().
+		 *
+		 * @param subset indices of the training vectors of this task,
+		 * empty if all vectors are used
+		 * @return machine ready to be trained
+		 */
+		virtual std::shared_ptr<Machine> get_machine_for_concurrent_train(
+		    SGVector<index_t> subset)
+		{
+			not_implemented(SOURCE_LOCATION);
+			return nullptr;
+		}
+
+		/** constructs the sub-machine to store from the machine trained on
+		 * a task of the strategy
+		 *
+		 * @param machine trained machine
+		 * @param subset indices of the training vectors of the task, empty
+		 * if all vectors were used
+		 * @return sub-machine
+		 */
+		virtual std::shared_ptr<Machine> get_machine_from_task(
+		    std::shared_ptr<Machine> machine, SGVector<index_t> subset) const
+		{
+			return get_machine_from_trained(machine);
+		}
+
+		/** whether the outputs of the trained sub-machines can be computed
+		 * concurrently on the shared features
+		 */
+		virtual bool supports_concurrent_apply() const
+		{
+			return false;
+		}
+
 		/** abstract init machine for training method */
 		virtual bool init_machine_for_train(std::shared_ptr<Features> data) = 0;
 
@@ -104,9 +104,13 @@ float64_t StructuredOutputMachine::risk_nslack_margin_rescale(SGVector<float64_t
 	float64_t R = 0.0;
 	linalg::zero(subgrad);
 
+	SGVector<int32_t> examples(to-from);
+	examples.range_fill(from);
+	auto results = m_model->argmax_batch(SGVector<float64_t>(W.vector,dim,false), examples, true);
+
 	for (int32_t i=from; i<to; i++)
 	{
-		auto result = m_model->argmax(SGVector<float64_t>(W.vector,dim,false), i, true);
+		const auto& result = results[i-from];
 		SGVector<float64_t> psi_pred = result->psi_pred;
 		SGVector<float64_t> psi_truth = result->psi_truth;
 		SGVector<float64_t>::vec1_plus_scalar_times_vec2(subgrad.vector, 1.0, psi_pred.vector, dim);
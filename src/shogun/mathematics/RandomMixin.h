@@ -56,7 +56,7 @@ namespace shogun
 
 		virtual std::shared_ptr<SGObject> clone(ParameterProperties pp = ParameterProperties::ALL) const override
 		{
-			auto clone = std::dynamic_pointer_cast<this_t>(Parent::clone());
+			auto clone = std::dynamic_pointer_cast<this_t>(Parent::clone(pp));
 			clone->m_prng = m_prng;
 			return clone;
 		}
@@ -0,0 +1,76 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#ifndef RANDOMIZED_RANGE_FINDER_H_
+#define RANDOMIZED_RANGE_FINDER_H_
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/mathematics/eigen3.h>
+
+namespace shogun
+{
+	namespace randomized
+	{
+		/** @return matrix with orthonormal columns spanning the columns of
+		 * the given matrix
+		 *
+		 * @param m matrix with at least as many rows as columns
+		 */
+		inline Eigen::MatrixXd orthonormalize(const Eigen::MatrixXd& m)
+		{
+			Eigen::HouseholderQR<Eigen::MatrixXd> qr(m);
+			return qr.householderQ() *
+			       Eigen::MatrixXd::Identity(m.rows(), m.cols());
+		}
+
+		/** Finds an orthonormal basis of the approximate range of a
+		 * rows x cols matrix A, which is only accessed through products with
+		 * blocks of vectors, so it never has to be formed.
+		 *
+		 * Halko, N., Martinsson, P. G., & Tropp, J. A. (2011).
+		 * Finding structure with randomness: Probabilistic algorithms for
+		 * constructing approximate matrix decompositions.
+		 * SIAM Review, 53(2), 217-288.
+		 *
+		 * @param rows number of rows of A
+		 * @param cols number of columns of A
+		 * @param size number of basis vectors, the target rank plus the
+		 * oversampling
+		 * @param power_iterations number of power iterations, which sharpen
+		 * the basis when the spectrum of A decays slowly
+		 * @param product computes A*M for a cols x size matrix M
+		 * @param transposed_product computes A'*M for a rows x size matrix M
+		 * @param prng pseudo random number generator of the test matrix
+		 * @return rows x size matrix with orthonormal columns
+		 */
+		template <typename Product, typename TransposedProduct, typename PRNG>
+		Eigen::MatrixXd range_finder(
+		    index_t rows, index_t cols, index_t size, int32_t power_iterations,
+		    Product&& product, TransposedProduct&& transposed_product,
+		    PRNG& prng)
+		{
+			NormalDistribution<float64_t> normal;
+			Eigen::MatrixXd omega(cols, size);
+			for (index_t i = 0; i < omega.size(); ++i)
+				omega.data()[i] = normal(prng);
+
+			// orthonormalize after every product to keep the small singular
+			// values from being lost in rounding
+			Eigen::MatrixXd q = orthonormalize(product(omega));
+			for (int32_t i = 0; i < power_iterations; ++i)
+			{
+				q = orthonormalize(transposed_product(q));
+				q = orthonormalize(product(q));
+			}
+			ASSERT(q.rows() == rows)
+			return q;
+		}
+	} // namespace randomized
+} // namespace shogun
+
+#endif // RANDOMIZED_RANGE_FINDER_H_
@@ -9,6 +9,7 @@
 
 #include <shogun/base/progress.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/RandomNamespace.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/metric/LMNNImpl.h>
 #include <shogun/labels/MulticlassLabels.h>
@@ -62,10 +63,21 @@ void LMNN::train(SGMatrix<float64_t> init_transform)
 	// Compute target or genuine neighbours
 	SG_DEBUG("Finding target nearest neighbors.")
 	SGMatrix<index_t> target_nn = LMNNImpl::find_target_nn(x, y, m_k);
-	// Initialize (sub-)gradient
-	SG_DEBUG("Summing outer products for (sub-)gradient initialization.")
-	auto gradient = LMNNImpl::sum_outer_products(x, target_nn);
-	linalg::scale(gradient, gradient, 1 - m_regularization);
+	// In stochastic training, the mini-batches are consecutive slices of a
+	// permutation of the examples that is shuffled at every pass over the data
+	index_t num_vectors = x->get_num_vectors();
+	bool stochastic = m_batch_size > 0 && m_batch_size < num_vectors;
+	SGVector<index_t> permutation(num_vectors);
+	permutation.range_fill();
+	index_t batch_begin = num_vectors;
+	// Initialize (sub-)gradient, updated incrementally unless training is stochastic
+	SGMatrix<float64_t> gradient;
+	if (!stochastic)
+	{
+		SG_DEBUG("Summing outer products for (sub-)gradient initialization.")
+		gradient = LMNNImpl::sum_outer_products(x, target_nn);
+		linalg::scale(gradient, gradient, 1 - m_regularization);
+	}
 	// Value of the objective function at every iteration
 	SGVector<float64_t> obj(m_maxiter);
 	// The step size is modified depending on how the objective changes, leave the
@@ -86,27 +98,69 @@ void LMNN::train(SGMatrix<float64_t> init_transform)
 	// Main loop
 	while (!stop)
 	{
-		// Find current set of impostors
-		SG_DEBUG("Finding impostors.")
-		cur_impostors = LMNNImpl::find_impostors(x,y,L,target_nn,iter,m_correction);
-		SG_DEBUG("Found {} impostors in the current set.", cur_impostors.size())
-
-		// (Sub-) gradient computation
-		SG_DEBUG("Updating gradient.")
-		LMNNImpl::update_gradient(x, gradient, cur_impostors, prev_impostors, m_regularization);
-		// Take gradient step
-		SG_DEBUG("Taking gradient step.")
-		LMNNImpl::gradient_step(L, gradient, stepsize, m_diagonal);
-
-		// Compute the objective, trace of Mahalanobis distance matrix (L squared) times the gradient
-		// plus the number of current impostors to account for the margin
-		SG_DEBUG("Computing objective.")
-		obj[iter] = m_regularization * cur_impostors.size();
-		obj[iter] +=
-		    linalg::trace_dot(linalg::matrix_prod(L, L, true, false), gradient);
-
-		// Correct step size
-		LMNNImpl::correct_stepsize(stepsize, obj, iter);
+		if (stochastic)
+		{
+			if (batch_begin + m_batch_size > num_vectors)
+			{
+				random::shuffle(permutation, m_prng);
+				batch_begin = 0;
+			}
+			SGVector<index_t> batch(
+			    permutation.vector + batch_begin, m_batch_size, false);
+			batch_begin += m_batch_size;
+
+			// Find the impostors of the mini-batch
+			SG_DEBUG("Finding impostors of the mini-batch.")
+			cur_impostors = LMNNImpl::find_impostors(x, y, L, target_nn, batch);
+			SG_DEBUG("Found {} impostors in the current set.", cur_impostors.size())
+
+			// Estimate the (sub-) gradient of the whole data from the mini-batch
+			SG_DEBUG("Computing gradient.")
+			gradient = LMNNImpl::sum_outer_products(x, target_nn, batch);
+			linalg::scale(gradient, gradient, 1 - m_regularization);
+			LMNNImpl::update_gradient(x, gradient, cur_impostors, ImpostorsSetType(), m_regularization);
+			float64_t scale = float64_t(num_vectors) / m_batch_size;
+			linalg::scale(gradient, gradient, scale);
+
+			// The objective of the mini-batch before and after the step; unlike
+			// the objectives of different mini-batches, they tell whether the step
+			// was too long
+			SGVector<float64_t> batch_obj(2);
+			float64_t margin = m_regularization * cur_impostors.size() * scale;
+			batch_obj[0] = margin + linalg::trace_dot(
+			    linalg::matrix_prod(L, L, true, false), gradient);
+			SG_DEBUG("Taking gradient step.")
+			LMNNImpl::gradient_step(L, gradient, stepsize, m_diagonal);
+			batch_obj[1] = margin + linalg::trace_dot(
+			    linalg::matrix_prod(L, L, true, false), gradient);
+			obj[iter] = batch_obj[1];
+
+			LMNNImpl::correct_stepsize(stepsize, batch_obj, 1);
+		}
+		else
+		{
+			// Find current set of impostors
+			SG_DEBUG("Finding impostors.")
+			cur_impostors = LMNNImpl::find_impostors(x,y,L,target_nn,iter,m_correction);
+			SG_DEBUG("Found {} impostors in the current set.", cur_impostors.size())
+
+			// (Sub-) gradient computation
+			SG_DEBUG("Updating gradient.")
+			LMNNImpl::update_gradient(x, gradient, cur_impostors, prev_impostors, m_regularization);
+			// Take gradient step
+			SG_DEBUG("Taking gradient step.")
+			LMNNImpl::gradient_step(L, gradient, stepsize, m_diagonal);
+
+			// Compute the objective, trace of Mahalanobis distance matrix (L squared) times the gradient
+			// plus the number of current impostors to account for the margin
+			SG_DEBUG("Computing objective.")
+			obj[iter] = m_regularization * cur_impostors.size();
+			obj[iter] +=
+			    linalg::trace_dot(linalg::matrix_prod(L, L, true, false), gradient);
+
+			// Correct step size
+			LMNNImpl::correct_stepsize(stepsize, obj, iter);
+		}
 
 		// Check termination criterion
 		stop = LMNNImpl::check_termination(stepsize, obj, iter, m_maxiter, m_stepsize_threshold, m_obj_threshold);
@@ -241,6 +295,17 @@ void LMNN::set_diagonal(const bool diagonal)
 	m_diagonal = diagonal;
 }
 
+int32_t LMNN::get_batch_size() const
+{
+	return m_batch_size;
+}
+
+void LMNN::set_batch_size(const int32_t batch_size)
+{
+	require(batch_size>=0, "The number of examples per iteration must not be negative");
+	m_batch_size = batch_size;
+}
+
 std::shared_ptr<LMNNStatistics> LMNN::get_statistics() const
 {
 
@@ -263,6 +328,8 @@ void LMNN::init()
 			"Iterations between exact impostors search");
 	SG_ADD(&m_obj_threshold, "obj_threshold", "Objective threshold");
 	SG_ADD(&m_diagonal, "m_diagonal", "Diagonal transformation");
+	SG_ADD(&m_batch_size, "batch_size",
+			"Number of examples per iteration of stochastic training");
 	SG_ADD((std::shared_ptr<SGObject>*) &m_statistics, "statistics", "Training statistics");
 
 	m_features = NULL;
@@ -275,6 +342,7 @@ void LMNN::init()
 	m_correction = 15;
 	m_obj_threshold = 1e-9;
 	m_diagonal = false;
+	m_batch_size = 0;
 	m_statistics = NULL;
 }
 
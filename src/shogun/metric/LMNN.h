@@ -15,6 +15,7 @@
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/labels/Labels.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/mathematics/RandomMixin.h>
 
 namespace shogun
 {
@@ -29,7 +30,7 @@ class LMNNStatistics;
  * Weinberger, K. Q., Saul, L. K.
  * Distance Metric Learning for Large Margin Nearest Neighbor Classification.
  */
-class LMNN : public SGObject
+class LMNN : public RandomMixin<SGObject>
 {
 	public:
 		/** default constructor */
@@ -168,6 +169,26 @@ class LMNN : public SGObject
 		 */
 		void set_diagonal(const bool diagonal);
 
+		/** get the number of examples per iteration of stochastic training
+		 *
+		 * @return number of examples per iteration, 0 if every iteration uses
+		 * all the examples
+		 */
+		int32_t get_batch_size() const;
+
+		/** set the number of examples per iteration; if it is positive and
+		 * smaller than the number of examples, every iteration takes a
+		 * gradient step on the target neighbours and impostors of a mini-batch
+		 * of examples, drawn without replacement within every pass over the
+		 * data. The impostors of the mini-batch are searched exactly at every
+		 * iteration, so the correction is not used; convergence is mostly
+		 * determined by the step size and the maximum number of iterations,
+		 * since the objective is estimated on the mini-batch.
+		 *
+		 * @param batch_size number of examples per iteration, 0 to use all
+		 */
+		void set_batch_size(const int32_t batch_size);
+
 		/** get LMNN training statistics
 		 *
 		 * @return LMNN training statistics
@@ -233,6 +254,12 @@ class LMNN : public SGObject
 		 */
 		bool m_diagonal;
 
+		/**
+		 * number of examples per iteration of stochastic training, 0 for
+		 * full gradient steps. Its default value is 0.
+		 */
+		int32_t m_batch_size;
+
 		/** training statistics, @see LMNNStatistics */
 		std::shared_ptr<LMNNStatistics> m_statistics;
 
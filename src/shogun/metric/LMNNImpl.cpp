@@ -11,13 +11,98 @@
 #include <unordered_map>
 #include <utility>
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/lib/View.h>
+#include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/multiclass/KNN.h>
 #include <shogun/preprocessor/PCA.h>
 #include <shogun/preprocessor/PruneVarSubMean.h>
 
 using namespace shogun;
+using namespace Eigen;
+
+namespace
+{
+	/** number of vector differences stacked in a matrix product when summing
+	 * outer products
+	 */
+	const index_t OUTER_PRODUCTS_BLOCK_SIZE = 256;
+
+	/** number of examples in the tiles of the impostors search */
+	const index_t IMPOSTORS_BLOCK_SIZE = 256;
+
+	/** Adds scale*(xa-xb)*(xa-xb)' to G for the num_pairs pairs of columns
+	 * (a,b)=pair(p) of X. Blocks of differences are summed with matrix
+	 * products, each thread into its own matrix; these are added in thread
+	 * order, so the result does not depend on the scheduling.
+	 */
+	template <typename Pair>
+	void add_outer_products(
+	    const SGMatrix<float64_t>& X, index_t num_pairs, Pair&& pair,
+	    float64_t scale, SGMatrix<float64_t>& G)
+	{
+		if (num_pairs == 0)
+			return;
+
+		index_t d = X.num_rows;
+		index_t num_blocks =
+		    (num_pairs + OUTER_PRODUCTS_BLOCK_SIZE - 1) /
+		    OUTER_PRODUCTS_BLOCK_SIZE;
+		int64_t num_partial =
+		    std::min<int64_t>(env()->get_num_threads(), num_blocks);
+		std::vector<MatrixXd> partial(num_partial, MatrixXd::Zero(d, d));
+		Map<const MatrixXd> X_eig(X.matrix, d, X.num_cols);
+
+#pragma omp parallel for num_threads(num_partial)
+		for (int64_t t = 0; t < num_partial; ++t)
+		{
+			MatrixXd diffs(d, OUTER_PRODUCTS_BLOCK_SIZE);
+			for (index_t block = t; block < num_blocks; block += num_partial)
+			{
+				index_t begin = block * OUTER_PRODUCTS_BLOCK_SIZE;
+				index_t size =
+				    std::min(OUTER_PRODUCTS_BLOCK_SIZE, num_pairs - begin);
+				for (index_t p = 0; p < size; ++p)
+				{
+					auto ab = pair(begin + p);
+					diffs.col(p) = X_eig.col(ab.first) - X_eig.col(ab.second);
+				}
+				partial[t].selfadjointView<Lower>().rankUpdate(
+				    diffs.leftCols(size));
+			}
+		}
+
+		for (int64_t t = 1; t < num_partial; ++t)
+			partial[0] += partial[t];
+		MatrixXd sum = partial[0].selfadjointView<Lower>();
+		Map<MatrixXd>(G.matrix, d, d) += scale * sum;
+	}
+
+	/** Squared distance between columns a and b of LX, computed from their
+	 * squared norms the same way as EuclideanDistance does.
+	 */
+	float64_t squared_distance(
+	    const SGMatrix<float64_t>& LX, const SGVector<float64_t>& norms,
+	    index_t a, index_t b)
+	{
+		Map<const VectorXd> xa(LX.get_column_vector(a), LX.num_rows);
+		Map<const VectorXd> xb(LX.get_column_vector(b), LX.num_rows);
+		return norms[a] + norms[b] - 2 * xa.dot(xb);
+	}
+
+	/** Concatenates the impostors found by every thread into a set. */
+	ImpostorsSetType
+	merge_impostors(std::vector<std::vector<CImpostorNode>>& partial)
+	{
+		std::vector<CImpostorNode> impostors;
+		for (auto& p : partial)
+			impostors.insert(impostors.end(), p.begin(), p.end());
+		// inserting in order takes constant time per impostor
+		std::sort(impostors.begin(), impostors.end());
+		return ImpostorsSetType(impostors.begin(), impostors.end());
+	}
+} // namespace
 
 CImpostorNode::CImpostorNode(index_t ex, index_t tar, index_t imp)
 : example(ex), target(tar), impostor(imp)
@@ -168,19 +253,40 @@ SGMatrix<float64_t> LMNNImpl::sum_outer_products(
 	int32_t d = x->get_num_features();
 	// initialize the sum of outer products (sop)
 	SGMatrix<float64_t> sop(d, d);
+	sop.zero();
 
 	auto X = x->get_feature_matrix();
 
 	// sum the outer products stored in C using the indices specified in target_nn
-	for (index_t i = 0; i < target_nn.num_cols; ++i)
-	{
-		for (index_t j = 0; j < target_nn.num_rows; ++j)
-		{
-			auto dx = linalg::add(
-			    X.get_column(i), X.get_column(target_nn(j, i)), 1.0, -1.0);
-			linalg::rank_update(sop, dx);
-		}
-	}
+	int32_t k = target_nn.num_rows;
+	add_outer_products(
+	    X, index_t(k) * target_nn.num_cols,
+	    [&](index_t p) {
+		    return std::make_pair(p / k, target_nn(p % k, p / k));
+	    },
+	    1.0, sop);
+
+	return sop;
+}
+
+SGMatrix<float64_t> LMNNImpl::sum_outer_products(
+    const std::shared_ptr<DenseFeatures<float64_t>>& x, const SGMatrix<index_t>& target_nn,
+    const SGVector<index_t>& examples)
+{
+	int32_t d = x->get_num_features();
+	SGMatrix<float64_t> sop(d, d);
+	sop.zero();
+
+	auto X = x->get_feature_matrix();
+
+	int32_t k = target_nn.num_rows;
+	add_outer_products(
+	    X, index_t(k) * examples.vlen,
+	    [&](index_t p) {
+		    index_t i = examples[p / k];
+		    return std::make_pair(i, target_nn(p % k, i));
+	    },
+	    1.0, sop);
 
 	return sop;
 }
@@ -227,6 +333,70 @@ ImpostorsSetType LMNNImpl::find_impostors(
 	return N;
 }
 
+ImpostorsSetType LMNNImpl::find_impostors(
+    const std::shared_ptr<DenseFeatures<float64_t>>& x, const std::shared_ptr<MulticlassLabels>& y,
+    const SGMatrix<float64_t>& L, const SGMatrix<index_t>& target_nn,
+    const SGVector<index_t>& examples)
+{
+	SG_TRACE("Entering LMNNImpl::find_impostors().");
+
+	int32_t k = target_nn.num_rows;
+	auto LX = linalg::matrix_prod(L, x->get_feature_matrix());
+	index_t n = LX.num_cols;
+	auto norms = LMNNImpl::compute_squared_norms(LX);
+	auto labels = y->get_labels();
+
+	index_t num_blocks = (examples.vlen + IMPOSTORS_BLOCK_SIZE - 1) / IMPOSTORS_BLOCK_SIZE;
+	int64_t num_partial = std::min<int64_t>(env()->get_num_threads(), num_blocks);
+	std::vector<std::vector<CImpostorNode>> partial(num_partial);
+
+#pragma omp parallel for num_threads(num_partial)
+	for (int64_t t = 0; t < num_partial; ++t)
+	{
+		SGVector<float64_t> sqdists(k);
+		for (index_t block = t; block < num_blocks; block += num_partial)
+		{
+			index_t begin = block * IMPOSTORS_BLOCK_SIZE;
+			index_t end = std::min(begin + IMPOSTORS_BLOCK_SIZE, examples.vlen);
+			for (index_t b = begin; b < end; ++b)
+			{
+				index_t i = examples[b];
+				Map<const VectorXd> lx(LX.get_column_vector(i), LX.num_rows);
+				// square distances plus margin to the target neighbors, no
+				// impostor is farther than the largest one
+				float64_t radius = 0;
+				for (int32_t l = 0; l < k; ++l)
+				{
+					Map<const VectorXd> target(
+					    LX.get_column_vector(target_nn(l, i)), LX.num_rows);
+					sqdists[l] = (lx - target).squaredNorm() + 1;
+					radius = std::max(radius, sqdists[l]);
+				}
+
+				for (index_t j = 0; j < n; ++j)
+				{
+					if (labels[j] == labels[i])
+						continue;
+
+					float64_t distance = squared_distance(LX, norms, i, j);
+					if (distance > radius)
+						continue;
+
+					for (int32_t l = 0; l < k; ++l)
+					{
+						if (distance <= sqdists[l])
+							partial[t].emplace_back(i, target_nn(l, i), j);
+					}
+				}
+			}
+		}
+	}
+
+	SG_TRACE("Leaving LMNNImpl::find_impostors().");
+
+	return merge_impostors(partial);
+}
+
 void LMNNImpl::update_gradient(
     const std::shared_ptr<DenseFeatures<float64_t>>& x, SGMatrix<float64_t>& G,
     const ImpostorsSetType& Nc, const ImpostorsSetType& Np,
@@ -240,28 +410,25 @@ void LMNNImpl::update_gradient(
 	auto X = x->get_feature_matrix();
 
 	// remove the gradient contributions of the impostors that were in the previous
-	// set but disappeared in the current
-	for (ImpostorsSetType::iterator it = Np_Nc.begin(); it != Np_Nc.end(); ++it)
-	{
-		// G -= regularization*(dx1*dx1' - dx2*dx2');
-		auto dx1 = linalg::add(
-		    X.get_column(it->example), X.get_column(it->target), 1.0, -1.0);
-		auto dx2 = linalg::add(
-		    X.get_column(it->example), X.get_column(it->impostor), 1.0, -1.0);
-		linalg::rank_update(G, dx1, -regularization);
-		linalg::rank_update(G, dx2, regularization);
-	}
-
-	// add the gradient contributions of the new impostors
-	for (ImpostorsSetType::iterator it = Nc_Np.begin(); it != Nc_Np.end(); ++it)
+	// set but disappeared in the current, and add the contributions of the new
+	// impostors: G -/+= regularization*(dx1*dx1' - dx2*dx2')
+	for (auto* diff : {&Np_Nc, &Nc_Np})
 	{
-		// G += regularization*(dx1*dx1' - dx2*dx2');
-		auto dx1 = linalg::add(
-		    X.get_column(it->example), X.get_column(it->target), 1.0, -1.0);
-		auto dx2 = linalg::add(
-		    X.get_column(it->example), X.get_column(it->impostor), 1.0, -1.0);
-		linalg::rank_update(G, dx1, regularization);
-		linalg::rank_update(G, dx2, -regularization);
+		std::vector<CImpostorNode> triplets(diff->begin(), diff->end());
+		float64_t scale = diff == &Np_Nc ? -regularization : regularization;
+		add_outer_products(
+		    X, triplets.size(),
+		    [&](index_t p) {
+			    return std::make_pair(triplets[p].example, triplets[p].target);
+		    },
+		    scale, G);
+		add_outer_products(
+		    X, triplets.size(),
+		    [&](index_t p) {
+			    return std::make_pair(
+			        triplets[p].example, triplets[p].impostor);
+		    },
+		    -scale, G);
 	}
 }
 
@@ -367,6 +534,18 @@ SGMatrix<float64_t> LMNNImpl::compute_pca_transform(const std::shared_ptr<DenseF
 	return pca_transform;
 }
 
+SGVector<float64_t> LMNNImpl::compute_squared_norms(const SGMatrix<float64_t>& LX)
+{
+	SGVector<float64_t> norms(LX.num_cols);
+	Map<const MatrixXd> LX_eig(LX.matrix, LX.num_rows, LX.num_cols);
+
+#pragma omp parallel for num_threads(env()->get_num_threads())
+	for (index_t i = 0; i < LX.num_cols; ++i)
+		norms[i] = LX_eig.col(i).dot(LX_eig.col(i));
+
+	return norms;
+}
+
 SGMatrix<float64_t> LMNNImpl::compute_sqdists(
     const SGMatrix<float64_t>& LX, const SGMatrix<index_t>& target_nn)
 {
@@ -411,53 +590,67 @@ ImpostorsSetType LMNNImpl::find_impostors_exact(
 {
 	SG_TRACE("Entering LMNNImpl::find_impostors_exact().");
 
-	// initialize empty impostors set
-	ImpostorsSetType N = ImpostorsSetType();
-
-	// create Shogun features from LX to later apply subset
-	auto lx = std::make_shared<DenseFeatures<float64_t>>(LX);
+	index_t n = LX.num_cols;
+	auto norms = LMNNImpl::compute_squared_norms(LX);
+	auto labels = y->get_labels();
 
-	// get a vector with unique label values
-	SGVector<float64_t> unique = y->get_unique_labels();
-
-	// for each label except from the largest one
-	for (index_t i = 0; i < unique.vlen-1; ++i)
+	// no impostor is farther from an example than its farthest target
+	// neighbor plus margin
+	SGVector<float64_t> radius(n);
+	for (index_t i = 0; i < n; ++i)
 	{
-		// get the indices of the examples labelled as unique[i]
-		std::vector<index_t> iidxs = LMNNImpl::get_examples_label(y,unique[i]);
-		// get the indices of the examples that have a larger label value, so that
-		// pairwise distances are computed once
-		std::vector<index_t> gtidxs = LMNNImpl::get_examples_gtlabel(y,unique[i]);
+		radius[i] = sqdists(0, i);
+		for (int32_t j = 1; j < k; ++j)
+			radius[i] = std::max(radius[i], sqdists(j, i));
+	}
 
-		// get distance with features indexed by iidxs and gtidxs separated
-		auto euclidean = LMNNImpl::setup_distance(lx,iidxs,gtidxs);
-		euclidean->set_disable_sqrt(true);
+	// the pairwise distances are computed in tiles of examples, in parallel
+	// over rows of tiles; each distance is computed once, for the pairs
+	// whose first example has the smaller label, and checked in both
+	// directions
+	index_t num_blocks = (n + IMPOSTORS_BLOCK_SIZE - 1) / IMPOSTORS_BLOCK_SIZE;
+	int64_t num_partial = std::min<int64_t>(env()->get_num_threads(), num_blocks);
+	std::vector<std::vector<CImpostorNode>> partial(num_partial);
 
-		for (int32_t j = 0; j < k; ++j)
+#pragma omp parallel for num_threads(num_partial)
+	for (int64_t t = 0; t < num_partial; ++t)
+	{
+		for (index_t block = t; block < num_blocks; block += num_partial)
 		{
-			for (std::size_t ii = 0; ii < iidxs.size(); ++ii)
+			index_t ii_begin = block * IMPOSTORS_BLOCK_SIZE;
+			index_t ii_end = std::min(ii_begin + IMPOSTORS_BLOCK_SIZE, n);
+			for (index_t jj_begin = 0; jj_begin < n; jj_begin += IMPOSTORS_BLOCK_SIZE)
 			{
-				for (std::size_t jj = 0; jj < gtidxs.size(); ++jj)
+				index_t jj_end = std::min(jj_begin + IMPOSTORS_BLOCK_SIZE, n);
+				for (index_t ii = ii_begin; ii < ii_end; ++ii)
 				{
-					// FIXME study if using upper bounded distances can be an improvement
-					float64_t distance = euclidean->distance(ii,jj);
-
-					if (distance <= sqdists(j,iidxs[ii]))
-						N.insert( CImpostorNode(iidxs[ii], target_nn(j,iidxs[ii]), gtidxs[jj]) );
-
-					if (distance <= sqdists(j,gtidxs[jj]))
-						N.insert( CImpostorNode(gtidxs[jj], target_nn(j,gtidxs[jj]), iidxs[ii]) );
+					for (index_t jj = jj_begin; jj < jj_end; ++jj)
+					{
+						if (labels[jj] <= labels[ii])
+							continue;
+
+						// FIXME study if using upper bounded distances can be an improvement
+						float64_t distance = squared_distance(LX, norms, ii, jj);
+						if (distance > radius[ii] && distance > radius[jj])
+							continue;
+
+						for (int32_t j = 0; j < k; ++j)
+						{
+							if (distance <= sqdists(j, ii))
+								partial[t].emplace_back(ii, target_nn(j, ii), jj);
+
+							if (distance <= sqdists(j, jj))
+								partial[t].emplace_back(jj, target_nn(j, jj), ii);
+						}
+					}
 				}
 			}
 		}
-
-
 	}
 
-
 	SG_TRACE("Leaving LMNNImpl::find_impostors_exact().");
 
-	return N;
+	return merge_impostors(partial);
 }
 
 ImpostorsSetType LMNNImpl::find_impostors_approx(
@@ -501,65 +694,15 @@ SGVector<float64_t> LMNNImpl::compute_impostors_sqdists(
 	size_t num_impostors = Nexact.size();
 
 	/// compute square distances to impostors
-
-	// create Shogun features from LX and distance
-	auto lx = std::make_shared<DenseFeatures<float64_t>>(LX);
-	auto euclidean = std::make_shared<EuclideanDistance>(lx,lx);
-	euclidean->set_disable_sqrt(true);
+	auto norms = LMNNImpl::compute_squared_norms(LX);
+	std::vector<CImpostorNode> impostors(Nexact.begin(), Nexact.end());
 
 	// initialize vector of square distances
 	SGVector<float64_t> sqdists(num_impostors);
 	// compute square distances
-	index_t i = 0;
-	for (ImpostorsSetType::iterator it = Nexact.begin(); it != Nexact.end(); ++it)
-		sqdists[i++] = euclidean->distance(it->example,it->impostor);
-
-	// clean up distance
-
+#pragma omp parallel for num_threads(env()->get_num_threads())
+	for (index_t i = 0; i < index_t(num_impostors); ++i)
+		sqdists[i] = squared_distance(LX, norms, impostors[i].example, impostors[i].impostor);
 
 	return sqdists;
 }
-
-std::vector<index_t> LMNNImpl::get_examples_label(const std::shared_ptr<MulticlassLabels>& y,
-		float64_t yi)
-{
-	// indices of the examples with label equal to yi
-	std::vector<index_t> idxs;
-
-	for (index_t i = 0; i < index_t(y->get_num_labels()); ++i)
-	{
-		if (y->get_label(i) == yi)
-			idxs.push_back(i);
-	}
-
-	return idxs;
-}
-
-std::vector<index_t> LMNNImpl::get_examples_gtlabel(const std::shared_ptr<MulticlassLabels>& y,
-		float64_t yi)
-{
-	// indices of the examples with label equal greater than yi
-	std::vector<index_t> idxs;
-
-	for (index_t i = 0; i < index_t(y->get_num_labels()); ++i)
-	{
-		if (y->get_label(i) > yi)
-			idxs.push_back(i);
-	}
-
-	return idxs;
-}
-
-std::shared_ptr<EuclideanDistance> LMNNImpl::setup_distance(const std::shared_ptr<DenseFeatures<float64_t>>& x,
-		std::vector<index_t>& a, std::vector<index_t>& b)
-{
-	// create new features only containing examples whose indices are in a
-	auto afeats = view(x, SGVector<index_t>(a.data(), a.size(), false));
-
-	// create new features only containing examples whose indices are in b
-	auto bfeats = view(x, SGVector<index_t>(b.data(), b.size(), false));
-
-	// create and return distance
-	return std::make_shared<EuclideanDistance>(afeats,bfeats);
-}
-
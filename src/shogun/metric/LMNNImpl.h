@@ -92,12 +92,26 @@ class LMNNImpl
 		static SGMatrix<float64_t> sum_outer_products(
 		    const std::shared_ptr<DenseFeatures<float64_t>>& x, const SGMatrix<index_t>& target_nn);
 
+		/** sum the outer products indicated by target_nn for the given examples only */
+		static SGMatrix<float64_t> sum_outer_products(
+		    const std::shared_ptr<DenseFeatures<float64_t>>& x, const SGMatrix<index_t>& target_nn,
+		    const SGVector<index_t>& examples);
+
 		/** find the impostors that remain after applying the transformation L */
 		static ImpostorsSetType find_impostors(
 		    const std::shared_ptr<DenseFeatures<float64_t>>& x, std::shared_ptr<MulticlassLabels> y,
 		    const SGMatrix<float64_t>& L, const SGMatrix<index_t>& target_nn,
 		    const int32_t iter, const int32_t correction);
 
+		/**
+		 * find the impostors of the given examples after applying the transformation L;
+		 * the search is exact, against all the data
+		 */
+		static ImpostorsSetType find_impostors(
+		    const std::shared_ptr<DenseFeatures<float64_t>>& x, const std::shared_ptr<MulticlassLabels>& y,
+		    const SGMatrix<float64_t>& L, const SGMatrix<index_t>& target_nn,
+		    const SGVector<index_t>& examples);
+
 		/** update the gradient using the last transition in the impostors sets */
 		static void update_gradient(
 		    const std::shared_ptr<DenseFeatures<float64_t>>& x, SGMatrix<float64_t>& G,
@@ -129,6 +143,9 @@ class LMNNImpl
 		/** initial default transform given by PCA */
 		static SGMatrix<float64_t> compute_pca_transform(const std::shared_ptr<DenseFeatures<float64_t>>& features);
 
+		/** compute the squared norms of the columns of LX */
+		static SGVector<float64_t> compute_squared_norms(const SGMatrix<float64_t>& LX);
+
 		/**
 		 * compute squared distances plus margin between each example and its target neighbors
 		 * in the transformed feature space
@@ -154,19 +171,6 @@ class LMNNImpl
 		    const SGMatrix<float64_t>& LX, const SGMatrix<float64_t>& sqdists,
 		    const ImpostorsSetType& Nexact, const SGMatrix<index_t>& target_nn);
 
-		/** get the indices of the examples whose label is equal to yi */
-		static std::vector<index_t> get_examples_label(const std::shared_ptr<MulticlassLabels>& y, float64_t yi);
-
-		/** get the indices of the examples whose label is greater than yi */
-		static std::vector<index_t> get_examples_gtlabel(const std::shared_ptr<MulticlassLabels>& y, float64_t yi);
-
-		/**
-		 * create Euclidean distance where the lhs features are the features in x indexed
-		 * by the elements in a, and the rhs features are the ones indexed by b; caller
-		 * is responsible of releasing memory
-		 */
-		static std::shared_ptr<EuclideanDistance> setup_distance(const std::shared_ptr<DenseFeatures<float64_t>>& x, std::vector<index_t>& a, std::vector<index_t>& b);
-
 		/**
 		 * check that k is less than the minimum number of examples in any
 		 * class.
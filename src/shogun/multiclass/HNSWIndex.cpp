@@ -0,0 +1,406 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#include <shogun/base/progress.h>
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/features/Features.h>
+#include <shogun/mathematics/UniformRealDistribution.h>
+#include <shogun/multiclass/HNSWIndex.h>
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+#include <queue>
+
+using namespace shogun;
+
+HNSWIndex::HNSWIndex() : RandomMixin<SGObject>()
+{
+	init();
+}
+
+HNSWIndex::HNSWIndex(int32_t m, int32_t ef_construction)
+    : RandomMixin<SGObject>()
+{
+	init();
+
+	m_m = m;
+	m_ef_construction = ef_construction;
+}
+
+HNSWIndex::~HNSWIndex()
+{
+}
+
+void HNSWIndex::init()
+{
+	m_m = 16;
+	m_ef_construction = 200;
+	m_entry_point = 0;
+	m_max_level = 0;
+
+	SG_ADD(&m_m, "m", "Number of links on the upper layers");
+	SG_ADD(
+	    &m_ef_construction, "ef_construction",
+	    "Size of the candidate list during construction");
+	SG_ADD(&m_levels, "levels", "Top layer of every vector");
+	SG_ADD(&m_offsets, "offsets", "Offsets of the links of every vector");
+	SG_ADD(&m_links, "links", "Links of all vectors and layers");
+	SG_ADD(&m_entry_point, "entry_point", "Vector the search starts at");
+	SG_ADD(&m_max_level, "max_level", "Top layer of the graph");
+}
+
+void HNSWIndex::build(const std::shared_ptr<Distance>& d)
+{
+	require(d, "Distance not set.");
+	auto lhs = d->get_lhs();
+	require(
+	    lhs && lhs->get_num_vectors(), "No vectors on left hand side.");
+	require(m_m > 1, "Number of links ({}) must be larger than 1.", m_m);
+	require(
+	    m_ef_construction > 0,
+	    "Size of the candidate list ({}) must be positive.",
+	    m_ef_construction);
+
+	auto rhs = d->get_rhs();
+	if (rhs != lhs)
+		d->init(lhs, lhs);
+
+	auto num_vectors = lhs->get_num_vectors();
+	m_levels = SGVector<int32_t>(num_vectors);
+	m_offsets = SGVector<index_t>(num_vectors);
+
+	// levels are drawn up front so that they do not depend on threads
+	UniformRealDistribution<float64_t> uniform(0.0, 1.0);
+	auto level_mult = 1.0 / std::log((float64_t)m_m);
+	index_t num_links = 0;
+	for (index_t i = 0; i < num_vectors; ++i)
+	{
+		m_levels[i] = (int32_t)std::floor(
+		    -std::log(1.0 - uniform(m_prng)) * level_mult);
+		m_offsets[i] = num_links;
+		num_links += 2 * m_m + 1 + m_levels[i] * (m_m + 1);
+	}
+	m_links = SGVector<index_t>(num_links);
+	m_links.zero();
+	m_entry_point = 0;
+	m_max_level = m_levels[0];
+
+	std::vector<std::mutex> locks(num_vectors);
+	std::mutex entry_lock;
+	auto num_threads = env()->get_num_threads();
+	auto pb = SG_PROGRESS(range(num_vectors - 1));
+
+#pragma omp parallel num_threads(num_threads)
+	{
+		std::vector<uint32_t> visited(num_vectors, 0);
+		uint32_t tag = 0;
+
+#pragma omp for schedule(dynamic, 16)
+		for (index_t i = 1; i < num_vectors; ++i)
+		{
+			insert(d, i, locks, entry_lock, visited, tag);
+			pb.print_progress();
+		}
+	}
+	pb.complete();
+
+	SG_DEBUG(
+	    "Built index on {} vectors with {} layers", num_vectors,
+	    m_max_level + 1);
+
+	if (rhs && rhs != lhs)
+		d->init(lhs, rhs);
+}
+
+SGMatrix<index_t> HNSWIndex::query(
+    const std::shared_ptr<Distance>& d, int32_t k, int32_t ef) const
+{
+	require(d, "Distance not set.");
+	require(get_num_vectors(), "Index not built.");
+	require(
+	    d->get_num_vec_lhs() == get_num_vectors(),
+	    "Index built on {} vectors, distance has {} on the left hand side.",
+	    get_num_vectors(), d->get_num_vec_lhs());
+	require(
+	    k > 0 && k <= get_num_vectors(),
+	    "K ({}) must be positive and not larger than the number of indexed "
+	    "vectors ({}).",
+	    k, get_num_vectors());
+
+	auto num_queries = d->get_num_vec_rhs();
+	auto num_vectors = get_num_vectors();
+	ef = std::max(ef, k);
+
+	SGMatrix<index_t> NN(k, num_queries);
+	auto num_threads = env()->get_num_threads();
+	auto pb = SG_PROGRESS(range(num_queries));
+
+#pragma omp parallel num_threads(num_threads)
+	{
+		std::vector<uint32_t> visited(num_vectors, 0);
+		uint32_t tag = 0;
+
+#pragma omp for schedule(dynamic, 16)
+		for (index_t i = 0; i < num_queries; ++i)
+		{
+			auto dist = [&d, i](index_t idx) { return d->distance(idx, i); };
+			auto entry = descend(
+			    dist, std::make_pair(dist(m_entry_point), m_entry_point),
+			    m_max_level, 0, NULL);
+			auto nearest =
+			    search_layer(dist, entry, ef, 0, NULL, visited, tag);
+
+			// the bottom layer is connected, so there are at least k
+			// candidates unless the graph was pruned apart, in which case
+			// the query falls back to an exhaustive search
+			if (nearest.size() < (size_t)k)
+			{
+				nearest.clear();
+				for (index_t idx = 0; idx < num_vectors; ++idx)
+					nearest.emplace_back(dist(idx), idx);
+				std::partial_sort(
+				    nearest.begin(), nearest.begin() + k, nearest.end());
+			}
+
+			for (index_t j = 0; j < k; ++j)
+				NN(j, i) = nearest[j].second;
+			pb.print_progress();
+		}
+	}
+	pb.complete();
+
+	return NN;
+}
+
+void HNSWIndex::copy_links(
+    index_t idx, int32_t layer, std::vector<std::mutex>* locks,
+    std::vector<index_t>& links) const
+{
+	std::unique_lock<std::mutex> guard;
+	if (locks)
+		guard = std::unique_lock<std::mutex>((*locks)[idx]);
+
+	auto list = m_links.vector + link_offset(idx, layer);
+	links.assign(list + 1, list + 1 + list[0]);
+}
+
+void HNSWIndex::insert(
+    const std::shared_ptr<Distance>& d, index_t idx,
+    std::vector<std::mutex>& locks, std::mutex& entry_lock,
+    std::vector<uint32_t>& visited, uint32_t& tag)
+{
+	// insertions above the top layer hold the entry point until the new
+	// vector becomes the entry point
+	std::unique_lock<std::mutex> entry_guard(entry_lock);
+	auto entry_point = m_entry_point;
+	auto max_level = m_max_level;
+	auto level = m_levels[idx];
+	if (level <= max_level)
+		entry_guard.unlock();
+
+	auto dist = [&d, idx](index_t other) { return d->distance(other, idx); };
+	auto current = descend(
+	    dist, std::make_pair(dist(entry_point), entry_point), max_level,
+	    level, &locks);
+
+	std::vector<std::pair<float64_t, index_t>> pruned;
+	for (auto layer = std::min(level, max_level); layer >= 0; --layer)
+	{
+		auto candidates = search_layer(
+		    dist, current, m_ef_construction, layer, &locks, visited, tag);
+
+		// concurrent insertions may have linked the vector already
+		candidates.erase(
+		    std::remove_if(
+		        candidates.begin(), candidates.end(),
+		        [idx](const std::pair<float64_t, index_t>& c) {
+			        return c.second == idx;
+		        }),
+		    candidates.end());
+		if (candidates.empty())
+			continue;
+		current = candidates.front();
+
+		auto neighbors = select_neighbors(d, candidates, m_m);
+		{
+			std::lock_guard<std::mutex> guard(locks[idx]);
+			auto links = m_links.vector + link_offset(idx, layer);
+
+			// keep links that concurrent insertions added meanwhile
+			if (links[0] > 0)
+			{
+				pruned.clear();
+				for (auto neighbor : neighbors)
+					pruned.emplace_back(dist(neighbor), neighbor);
+				for (index_t j = 1; j <= links[0]; ++j)
+				{
+					if (std::find(neighbors.begin(), neighbors.end(),
+					              links[j]) == neighbors.end())
+						pruned.emplace_back(dist(links[j]), links[j]);
+				}
+				std::sort(pruned.begin(), pruned.end());
+				neighbors = select_neighbors(d, pruned, max_links(layer));
+			}
+
+			links[0] = neighbors.size();
+			std::copy(neighbors.begin(), neighbors.end(), links + 1);
+		}
+
+		auto max = max_links(layer);
+		for (auto neighbor : neighbors)
+		{
+			std::lock_guard<std::mutex> guard(locks[neighbor]);
+			auto links = m_links.vector + link_offset(neighbor, layer);
+			if (std::find(links + 1, links + 1 + links[0], idx) !=
+			    links + 1 + links[0])
+				continue;
+
+			if (links[0] < max)
+			{
+				links[++links[0]] = idx;
+				continue;
+			}
+
+			pruned.clear();
+			pruned.emplace_back(d->distance(neighbor, idx), idx);
+			for (index_t j = 1; j <= links[0]; ++j)
+				pruned.emplace_back(
+				    d->distance(neighbor, links[j]), links[j]);
+			std::sort(pruned.begin(), pruned.end());
+
+			auto selected = select_neighbors(d, pruned, max);
+			links[0] = selected.size();
+			std::copy(selected.begin(), selected.end(), links + 1);
+		}
+	}
+
+	if (level > max_level)
+	{
+		m_entry_point = idx;
+		m_max_level = level;
+	}
+}
+
+template <typename DistanceFunction>
+std::vector<std::pair<float64_t, index_t>> HNSWIndex::search_layer(
+    const DistanceFunction& dist, std::pair<float64_t, index_t> entry,
+    int32_t ef, int32_t layer, std::vector<std::mutex>* locks,
+    std::vector<uint32_t>& visited, uint32_t& tag) const
+{
+	typedef std::pair<float64_t, index_t> Candidate;
+
+	if (++tag == 0)
+	{
+		std::fill(visited.begin(), visited.end(), 0);
+		tag = 1;
+	}
+
+	// closest unexpanded candidates first, furthest result first
+	std::priority_queue<
+	    Candidate, std::vector<Candidate>, std::greater<Candidate>>
+	    candidates;
+	std::priority_queue<Candidate> nearest;
+
+	visited[entry.second] = tag;
+	candidates.push(entry);
+	nearest.push(entry);
+
+	std::vector<index_t> links;
+	while (!candidates.empty())
+	{
+		auto current = candidates.top();
+		if (current.first > nearest.top().first)
+			break;
+		candidates.pop();
+
+		copy_links(current.second, layer, locks, links);
+		for (auto neighbor : links)
+		{
+			if (visited[neighbor] == tag)
+				continue;
+			visited[neighbor] = tag;
+
+			auto neighbor_dist = dist(neighbor);
+			if ((int32_t)nearest.size() < ef ||
+			    neighbor_dist < nearest.top().first)
+			{
+				candidates.emplace(neighbor_dist, neighbor);
+				nearest.emplace(neighbor_dist, neighbor);
+				if ((int32_t)nearest.size() > ef)
+					nearest.pop();
+			}
+		}
+	}
+
+	std::vector<Candidate> result(nearest.size());
+	for (auto i = (index_t)result.size() - 1; i >= 0; --i)
+	{
+		result[i] = nearest.top();
+		nearest.pop();
+	}
+
+	return result;
+}
+
+template <typename DistanceFunction>
+std::pair<float64_t, index_t> HNSWIndex::descend(
+    const DistanceFunction& dist, std::pair<float64_t, index_t> entry,
+    int32_t top, int32_t bottom, std::vector<std::mutex>* locks) const
+{
+	std::vector<index_t> links;
+	for (auto layer = top; layer > bottom; --layer)
+	{
+		bool changed = true;
+		while (changed)
+		{
+			changed = false;
+			copy_links(entry.second, layer, locks, links);
+			for (auto neighbor : links)
+			{
+				auto neighbor_dist = dist(neighbor);
+				if (neighbor_dist < entry.first)
+				{
+					entry = std::make_pair(neighbor_dist, neighbor);
+					changed = true;
+				}
+			}
+		}
+	}
+
+	return entry;
+}
+
+std::vector<index_t> HNSWIndex::select_neighbors(
+    const std::shared_ptr<Distance>& d,
+    const std::vector<std::pair<float64_t, index_t>>& candidates,
+    int32_t max_links) const
+{
+	std::vector<index_t> selected;
+	std::vector<index_t> skipped;
+	for (const auto& candidate : candidates)
+	{
+		if ((int32_t)selected.size() >= max_links)
+			break;
+
+		bool diverse = std::none_of(
+		    selected.begin(), selected.end(), [&](index_t s) {
+			    return d->distance(s, candidate.second) < candidate.first;
+		    });
+		if (diverse)
+			selected.push_back(candidate.second);
+		else
+			skipped.push_back(candidate.second);
+	}
+
+	for (auto idx : skipped)
+	{
+		if ((int32_t)selected.size() >= max_links)
+			break;
+		selected.push_back(idx);
+	}
+
+	return selected;
+}
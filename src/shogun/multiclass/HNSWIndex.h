@@ -0,0 +1,219 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#ifndef _HNSWINDEX_H__
+#define _HNSWINDEX_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/SGObject.h>
+#include <shogun/distance/Distance.h>
+#include <shogun/lib/SGMatrix.h>
+#include <shogun/lib/SGVector.h>
+#include <shogun/mathematics/RandomMixin.h>
+
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace shogun
+{
+
+/** @brief Hierarchical navigable small world graph for approximate nearest
+ * neighbor search, cf.
+ *
+ * Malkov, Y. A. and Yashunin, D. A. (2018). Efficient and robust approximate
+ * nearest neighbor search using Hierarchical Navigable Small World graphs.
+ * IEEE Transactions on Pattern Analysis and Machine Intelligence.
+ *
+ * The index is built on the left hand side vectors of a distance and only
+ * uses Distance::distance(), so it works with any distance and features.
+ * Vectors are inserted concurrently using env()->get_num_threads() threads
+ * and queries for all right hand side vectors are answered in parallel.
+ *
+ * The graph is stored in flat arrays that are registered parameters, so a
+ * built index is serialized and cloned with its owner and can be reused
+ * without being rebuilt. Levels of the vectors are drawn from the random
+ * generator of the index, the links depend on the order of concurrent
+ * insertions.
+ */
+class HNSWIndex : public RandomMixin<SGObject>
+{
+public:
+	/** default constructor */
+	HNSWIndex();
+
+	/** constructor
+	 *
+	 * @param m number of links of every vector on the upper layers, twice
+	 * as many on the bottom layer
+	 * @param ef_construction size of the candidate list during construction
+	 */
+	HNSWIndex(int32_t m, int32_t ef_construction);
+
+	virtual ~HNSWIndex();
+
+	/** Builds the index on the left hand side vectors of the distance. The
+	 * distance is initialized with these vectors on both sides while the
+	 * index is built and its right hand side is restored afterwards.
+	 *
+	 * @param d distance with the vectors to index on the left hand side
+	 */
+	void build(const std::shared_ptr<Distance>& d);
+
+	/** Finds approximate nearest neighbors of the right hand side vectors
+	 * of the distance among the indexed left hand side vectors.
+	 *
+	 * @param d distance with the indexed vectors on the left hand side
+	 * @param k number of neighbors
+	 * @param ef size of the candidate list, at least k is used
+	 * @return matrix with k rows and one column per right hand side vector,
+	 * with the indices of the neighbors ordered by increasing distance
+	 */
+	SGMatrix<index_t>
+	query(const std::shared_ptr<Distance>& d, int32_t k, int32_t ef) const;
+
+	/** @return number of indexed vectors */
+	inline index_t get_num_vectors() const
+	{
+		return m_levels.vlen;
+	}
+
+	/** @return number of links on the upper layers */
+	inline int32_t get_m() const
+	{
+		return m_m;
+	}
+
+	/** @return size of the candidate list during construction */
+	inline int32_t get_ef_construction() const
+	{
+		return m_ef_construction;
+	}
+
+	/** @return object name */
+	virtual const char* get_name() const
+	{
+		return "HNSWIndex";
+	}
+
+private:
+	void init();
+
+	/** @return offset of the links of a vector on a layer, the first
+	 * element is the number of links
+	 */
+	inline index_t link_offset(index_t idx, int32_t layer) const
+	{
+		if (layer == 0)
+			return m_offsets[idx];
+
+		return m_offsets[idx] + 2 * m_m + 1 + (layer - 1) * (m_m + 1);
+	}
+
+	/** @return maximum number of links on a layer */
+	inline int32_t max_links(int32_t layer) const
+	{
+		return layer == 0 ? 2 * m_m : m_m;
+	}
+
+	/** Copies the links of a vector on a layer.
+	 *
+	 * @param idx index of the vector
+	 * @param layer layer of the links
+	 * @param locks locks of the links, or NULL
+	 * @param links buffer for the links
+	 */
+	void copy_links(
+	    index_t idx, int32_t layer, std::vector<std::mutex>* locks,
+	    std::vector<index_t>& links) const;
+
+	/** Inserts a vector into the graph.
+	 *
+	 * @param d distance with the indexed vectors on both sides
+	 * @param idx index of the vector
+	 * @param locks locks of the links of all vectors
+	 * @param entry_lock lock of the entry point
+	 * @param visited visited tags of the thread
+	 * @param tag last tag used in visited
+	 */
+	void insert(
+	    const std::shared_ptr<Distance>& d, index_t idx,
+	    std::vector<std::mutex>& locks, std::mutex& entry_lock,
+	    std::vector<uint32_t>& visited, uint32_t& tag);
+
+	/** Greedy search on one layer, returning the candidates closest to the
+	 * query ordered by increasing distance.
+	 *
+	 * @param dist distance of a vector to the query
+	 * @param entry entry vector and its distance
+	 * @param ef size of the candidate list
+	 * @param layer layer to search
+	 * @param locks locks of the links, or NULL when the graph is not
+	 * modified concurrently
+	 * @param visited visited tags of the thread
+	 * @param tag last tag used in visited
+	 */
+	template <typename DistanceFunction>
+	std::vector<std::pair<float64_t, index_t>> search_layer(
+	    const DistanceFunction& dist, std::pair<float64_t, index_t> entry,
+	    int32_t ef, int32_t layer, std::vector<std::mutex>* locks,
+	    std::vector<uint32_t>& visited, uint32_t& tag) const;
+
+	/** Moves greedily to the closest vector on the layers above a layer.
+	 *
+	 * @param dist distance of a vector to the query
+	 * @param entry entry vector and its distance
+	 * @param top highest layer to search
+	 * @param bottom layer above which to stop
+	 * @param locks locks of the links, or NULL
+	 * @return closest vector found and its distance
+	 */
+	template <typename DistanceFunction>
+	std::pair<float64_t, index_t> descend(
+	    const DistanceFunction& dist, std::pair<float64_t, index_t> entry,
+	    int32_t top, int32_t bottom, std::vector<std::mutex>* locks) const;
+
+	/** Selects up to max_links diverse neighbors from candidates ordered by
+	 * increasing distance: a candidate is skipped when it is closer to an
+	 * already selected neighbor than to the base vector. Skipped candidates
+	 * fill the remaining links.
+	 *
+	 * @param d distance with the indexed vectors on both sides
+	 * @param candidates candidates with their distance to the base vector
+	 * @param max_links maximum number of neighbors
+	 * @return selected neighbors
+	 */
+	std::vector<index_t> select_neighbors(
+	    const std::shared_ptr<Distance>& d,
+	    const std::vector<std::pair<float64_t, index_t>>& candidates,
+	    int32_t max_links) const;
+
+protected:
+	/** number of links on the upper layers */
+	int32_t m_m;
+
+	/** size of the candidate list during construction */
+	int32_t m_ef_construction;
+
+	/** top layer of every vector */
+	SGVector<int32_t> m_levels;
+
+	/** offset of the links of every vector in m_links */
+	SGVector<index_t> m_offsets;
+
+	/** links of all vectors and layers, every list prefixed with its
+	 * length */
+	SGVector<index_t> m_links;
+
+	/** vector the search starts at */
+	index_t m_entry_point;
+
+	/** top layer of the graph */
+	int32_t m_max_level;
+};
+} // namespace shogun
+
+#endif
@@ -0,0 +1,62 @@
+/* This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#include <shogun/base/progress.h>
+#include <shogun/lib/Signal.h>
+#include <shogun/multiclass/HNSWKNNSolver.h>
+
+using namespace shogun;
+
+HNSWKNNSolver::HNSWKNNSolver(const int32_t k, const float64_t q, const int32_t num_classes, const int32_t min_label, const SGVector<int32_t> train_labels, std::shared_ptr<HNSWIndex> index, const int32_t ef):
+KNNSolver(k, q, num_classes, min_label, train_labels)
+{
+	init();
+
+	require(index, "Index not set.");
+	m_index=std::move(index);
+	m_ef=ef;
+}
+
+std::shared_ptr<MulticlassLabels> HNSWKNNSolver::classify_objects(std::shared_ptr<Distance> knn_distance, const int32_t num_lab, SGVector<int32_t>& train_lab, SGVector<float64_t>& classes) const
+{
+	auto output=std::make_shared<MulticlassLabels>(num_lab);
+
+	//get the approximate k nearest neighbors of all examples in parallel
+	SGMatrix<index_t> NN = m_index->query(knn_distance, m_k, m_ef);
+
+	for (auto i : SG_PROGRESS(range(num_lab)))
+	{
+		if (cancel_computation())
+			break;
+		//write the labels of the k nearest neighbors from theirs indices
+		for (index_t j=0; j<m_k; j++)
+			train_lab[j] = m_train_labels[ NN(j,i) ];
+
+		//get the index of the 'nearest' class
+		index_t out_idx = choose_class(classes.vector, train_lab.vector);
+		//write the label of 'nearest' in the output
+		output->set_label(i, out_idx + m_min_label);
+	}
+
+	return output;
+}
+
+SGVector<int32_t> HNSWKNNSolver::classify_objects_k(std::shared_ptr<Distance> knn_distance, const int32_t num_lab, SGVector<int32_t>& train_lab, SGVector<int32_t>& classes) const
+{
+	SGVector<int32_t> output(m_k*num_lab);
+
+	//neighbors are ordered by increasing distance
+	SGMatrix<index_t> NN = m_index->query(knn_distance, m_k, m_ef);
+
+	for (index_t i = 0; i < num_lab && (!cancel_computation()); i++)
+	{
+		//write the labels of the k nearest neighbors from theirs indices
+		for (index_t j=0; j<m_k; j++)
+			train_lab[j] = m_train_labels[ NN(j,i) ];
+
+		choose_class_for_multiple_k(output.vector+i, classes.vector, train_lab.vector, num_lab);
+	}
+
+	return output;
+}
@@ -0,0 +1,70 @@
+/* This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#ifndef HNSWSOLVER_H__
+#define HNSWSOLVER_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/common.h>
+#include <shogun/distance/Distance.h>
+#include <shogun/multiclass/HNSWIndex.h>
+#include <shogun/multiclass/KNNSolver.h>
+
+namespace shogun
+{
+
+/**
+ * HNSW solver. It finds approximate nearest neighbours by searching a
+ * hierarchical navigable small world graph, see HNSWIndex. The index is
+ * built on the training vectors once and shared by all classifications.
+ */
+class HNSWKNNSolver : public KNNSolver
+{
+	public:
+		/** default constructor */
+		HNSWKNNSolver() : KNNSolver()
+		{
+			init();
+		}
+
+		/** deconstructor */
+		virtual ~HNSWKNNSolver() { /* nothing to do */ }
+
+		/** constructor
+		 *
+		 * @param k k
+		 * @param q m_q
+		 * @param num_classes m_num_classes
+		 * @param min_label m_min_label
+		 * @param train_labels m_train_labels
+		 * @param index index built on the training vectors
+		 * @param ef size of the candidate list of a query
+		 */
+		HNSWKNNSolver(const int32_t k, const float64_t q, const int32_t num_classes, const int32_t min_label, const SGVector<int32_t> train_labels, std::shared_ptr<HNSWIndex> index, const int32_t ef);
+
+		virtual std::shared_ptr<MulticlassLabels> classify_objects(std::shared_ptr<Distance> d, const int32_t num_lab, SGVector<int32_t>& train_lab, SGVector<float64_t>& classes) const;
+
+		virtual SGVector<int32_t> classify_objects_k(std::shared_ptr<Distance> d, const int32_t num_lab, SGVector<int32_t>& train_lab, SGVector<int32_t>& classes) const;
+
+		/** @return object name */
+		const char* get_name() const { return "HNSWKNNSolver"; }
+
+	private:
+		void init()
+		{
+			m_index=NULL;
+			m_ef=0;
+		}
+
+	protected:
+		/* Index built on the training vectors */
+		std::shared_ptr<HNSWIndex> m_index;
+
+		/* Size of the candidate list of a query */
+		int32_t m_ef;
+};
+}
+
+#endif
@@ -53,6 +53,11 @@ void KNN::init()
 	solver=NULL;
 	m_lsh_l = 0;
 	m_lsh_t = 0;
+	m_hnsw_m = 16;
+	m_hnsw_ef_construction = 200;
+	m_hnsw_ef = 50;
+	m_hnsw_index = NULL;
+	m_lsh_index = NULL;
 
 	/* use the method classify_multiply_k to experiment with different values
 	 * of k */
@@ -63,7 +68,18 @@ void KNN::init()
 	SG_ADD_OPTIONS(
 	    (machine_int_t*)&m_knn_solver, "knn_solver", "Algorithm to solve knn",
 	    ParameterProperties::NONE,
-	    SG_OPTIONS(KNN_BRUTE, KNN_KDTREE, KNN_COVER_TREE, KNN_LSH));
+	    SG_OPTIONS(KNN_BRUTE, KNN_KDTREE, KNN_COVER_TREE, KNN_LSH, KNN_HNSW));
+	SG_ADD(&m_hnsw_m, "hnsw_m", "Number of links on the upper layers for HNSW");
+	SG_ADD(&m_hnsw_ef_construction, "hnsw_ef_construction",
+	    "Size of the candidate list during construction for HNSW");
+	SG_ADD(&m_hnsw_ef, "hnsw_ef",
+	    "Size of the candidate list of a query for HNSW");
+	SG_ADD(&m_hnsw_index, "hnsw_index",
+	    "HNSW index built on the training vectors");
+	SG_ADD(&m_lsh_l, "lsh_l", "Number of hash tables for LSH");
+	SG_ADD(&m_lsh_t, "lsh_t", "Number of probes per query for LSH");
+	SG_ADD(&m_lsh_index, "lsh_index",
+	    "LSH index built on the training vectors");
 	watch_method("nearest_neighbors", &KNN::nearest_neighbors);
 	watch_method("classify_for_multiple_k", &KNN::classify_for_multiple_k);
 }
@@ -103,6 +119,19 @@ bool KNN::train_machine(std::shared_ptr<Features> data)
 	io::info("m_num_classes: {} ({:+d} to {:+d}) num_train: {}", m_num_classes,
 			min_class, max_class, m_train_labels.vlen);
 
+	m_hnsw_index = NULL;
+	m_lsh_index = NULL;
+	if (m_knn_solver == KNN_HNSW)
+	{
+		m_hnsw_index = std::make_shared<HNSWIndex>(m_hnsw_m, m_hnsw_ef_construction);
+		m_hnsw_index->build(distance);
+	}
+	else if (m_knn_solver == KNN_LSH)
+	{
+		m_lsh_index = std::make_shared<LSHIndex>(m_lsh_l, m_lsh_t);
+		m_lsh_index->build(distance->get_lhs());
+	}
+
 	return true;
 }
 
@@ -283,6 +312,74 @@ bool KNN::save(FILE* dstfile)
 	return false;
 }
 
+void KNN::set_hnsw_parameters(int32_t m, int32_t ef_construction, int32_t ef)
+{
+	require(m > 1, "Number of links ({}) must be larger than 1.", m);
+	require(ef > 0, "Size of the candidate list ({}) must be positive.", ef);
+
+	if (m != m_hnsw_m || ef_construction != m_hnsw_ef_construction)
+		m_hnsw_index = NULL;
+
+	m_hnsw_m = m;
+	m_hnsw_ef_construction = ef_construction;
+	m_hnsw_ef = ef;
+}
+
+void KNN::set_lsh_parameters(int32_t l, int32_t t)
+{
+	if (l != m_lsh_l || t != m_lsh_t)
+		m_lsh_index = NULL;
+
+	m_lsh_l = l;
+	m_lsh_t = t;
+}
+
+void KNN::add_training_data(std::shared_ptr<Features> data, std::shared_ptr<Labels> labs)
+{
+	require(m_num_classes > 0, "Machine not trained.");
+	require(distance, "Distance not set.");
+	require(data, "Features not set.");
+	require(labs, "Labels not set.");
+	require(
+	    labs->get_num_labels() == data->get_num_vectors(),
+	    "Number of vectors ({}) does not match number of labels ({})",
+	    data->get_num_vectors(), labs->get_num_labels());
+
+	auto lhs = distance->get_lhs();
+	require(lhs, "No vectors on left hand side");
+
+	std::shared_ptr<Features> merged;
+	if (m_lsh_index && m_lsh_index->get_num_vectors() == lhs->get_num_vectors())
+	{
+		m_lsh_index->add(data);
+		merged = m_lsh_index->get_features();
+	}
+	else
+	{
+		m_lsh_index = NULL;
+		merged = lhs->create_merged_copy(data);
+	}
+	m_hnsw_index = NULL;
+	distance->init(merged, merged);
+
+	// labels are stored relative to the smallest label, which may change
+	SGVector<int32_t> added = multiclass_labels(labs)->get_int_labels();
+	SGVector<int32_t> lab(m_train_labels.vlen + added.vlen);
+	for (index_t i = 0; i < m_train_labels.vlen; i++)
+		lab[i] = m_train_labels[i] + m_min_label;
+	for (index_t i = 0; i < added.vlen; i++)
+		lab[m_train_labels.vlen + i] = added[i];
+
+	auto min_class = Math::min(lab.vector, lab.vlen);
+	auto max_class = Math::max(lab.vector, lab.vlen);
+
+	set_labels(std::make_shared<MulticlassLabels>(SGVector<float64_t>(lab.begin(), lab.end())));
+	linalg::add_scalar(lab, -min_class);
+	m_train_labels = lab;
+	m_min_label = min_class;
+	m_num_classes = max_class - min_class + 1;
+}
+
 void KNN::init_solver(KNN_SOLVER knn_solver)
 {
 	switch (knn_solver)
@@ -312,7 +409,27 @@ void KNN::init_solver(KNN_SOLVER knn_solver)
 	}
 	case KNN_LSH:
 	{
-		solver = std::make_shared<LSHKNNSolver>(m_k, m_q, m_num_classes, m_min_label, m_train_labels, m_lsh_l, m_lsh_t);
+		// the index is built in training, or here if the solver was chosen
+		// after training
+		if (!m_lsh_index || m_lsh_index->get_num_vectors() != distance->get_num_vec_lhs())
+		{
+			m_lsh_index = std::make_shared<LSHIndex>(m_lsh_l, m_lsh_t);
+			m_lsh_index->build(distance->get_lhs());
+		}
+		solver = std::make_shared<LSHKNNSolver>(m_k, m_q, m_num_classes, m_min_label, m_train_labels, m_lsh_index);
+
+		break;
+	}
+	case KNN_HNSW:
+	{
+		// the index is built in training, or here if the solver was chosen
+		// after training
+		if (!m_hnsw_index || m_hnsw_index->get_num_vectors() != distance->get_num_vec_lhs())
+		{
+			m_hnsw_index = std::make_shared<HNSWIndex>(m_hnsw_m, m_hnsw_ef_construction);
+			m_hnsw_index->build(distance);
+		}
+		solver = std::make_shared<HNSWKNNSolver>(m_k, m_q, m_num_classes, m_min_label, m_train_labels, m_hnsw_index, m_hnsw_ef);
 
 		break;
 	}
@@ -24,6 +24,7 @@
 #include <shogun/multiclass/CoverTreeKNNSolver.h>
 #endif
 #include <shogun/multiclass/LSHKNNSolver.h>
+#include <shogun/multiclass/HNSWKNNSolver.h>
 
 namespace shogun
 {
@@ -32,7 +33,8 @@ namespace shogun
 		KNN_BRUTE,
 		KNN_KDTREE,
 		KNN_COVER_TREE,
-		KNN_LSH
+		KNN_LSH,
+		KNN_HNSW
 	};
 
 class DistanceMachine;
@@ -120,6 +122,16 @@ class KNN : public DistanceMachine
 		 */
 		SGMatrix<int32_t> classify_for_multiple_k();
 
+		/** Adds training vectors to a trained classifier. The LSH index
+		 * inserts them without rebuilding its hash tables, other indices
+		 * are rebuilt when they are used next.
+		 *
+		 * @param data training vectors to add, of the same type as the
+		 * training vectors
+		 * @param labs labels of the vectors
+		 */
+		void add_training_data(std::shared_ptr<Features> data, std::shared_ptr<Labels> labs);
+
 		/** load from file
 		 *
 		 * @param srcfile file to load from
@@ -200,14 +212,38 @@ class KNN : public DistanceMachine
 			m_knn_solver = knn_solver;
 		}
 
-		/** set parameters for LSH solver
+		/** set parameters for LSH solver. Changing them discards an index
+		  * that was already built.
+		  *
 		  * @param l number of hash tables for LSH
 		  * @param t number of probes per query for LSH
 		  */
-		inline void set_lsh_parameters(int32_t l, int32_t t)
+		void set_lsh_parameters(int32_t l, int32_t t);
+
+		/** @return LSH index built on the training vectors, NULL if the
+		 * LSH solver has not been trained
+		 */
+		inline std::shared_ptr<LSHIndex> get_lsh_index() const
 		{
-			m_lsh_l = l;
-			m_lsh_t = t;
+			return m_lsh_index;
+		}
+
+		/** set parameters for HNSW solver. Changing m or ef_construction
+		 * discards an index that was already built.
+		 *
+		 * @param m number of links of every vector on the upper layers
+		 * @param ef_construction size of the candidate list during
+		 * construction of the index
+		 * @param ef size of the candidate list of a query
+		 */
+		void set_hnsw_parameters(int32_t m, int32_t ef_construction, int32_t ef);
+
+		/** @return HNSW index built on the training vectors, NULL if the
+		 * HNSW solver has not been trained
+		 */
+		inline std::shared_ptr<HNSWIndex> get_hnsw_index() const
+		{
+			return m_hnsw_index;
 		}
 
 	protected:
@@ -295,6 +331,21 @@ class KNN : public DistanceMachine
 
 		/* Number of probes per query for LSH */
 		int32_t m_lsh_t;
+
+		/* Number of links on the upper layers for HNSW */
+		int32_t m_hnsw_m;
+
+		/* Size of the candidate list during construction for HNSW */
+		int32_t m_hnsw_ef_construction;
+
+		/* Size of the candidate list of a query for HNSW */
+		int32_t m_hnsw_ef;
+
+		/* HNSW index built on the training vectors */
+		std::shared_ptr<HNSWIndex> m_hnsw_index;
+
+		/* LSH index built on the training vectors */
+		std::shared_ptr<LSHIndex> m_lsh_index;
 };
 
 }
@@ -0,0 +1,286 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#include <shogun/base/progress.h>
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/SparseFeatures.h>
+#include <shogun/mathematics/eigen3.h>
+#include <shogun/multiclass/LSHIndex.h>
+
+#include <shogun/lib/external/falconn/lsh_nn_table.h>
+
+#include <algorithm>
+#include <functional>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+using namespace shogun;
+using namespace Eigen;
+
+namespace shogun
+{
+	class LSHIndex::Table
+	{
+	public:
+		virtual ~Table()
+		{
+		}
+
+		/** @return function writing the candidates of a query vector,
+		 * to be used by one thread only
+		 */
+		virtual std::function<void(index_t, std::vector<int32_t>&)>
+		prober(const std::shared_ptr<Features>& queries) const = 0;
+	};
+} // namespace shogun
+
+template <typename PointType, typename FeatureType>
+PointType get_falconn_point(FeatureType* f, index_t i);
+
+template <>
+falconn::DenseVector<double>
+get_falconn_point(DenseFeatures<float64_t>* f, index_t i)
+{
+	index_t len;
+	bool free;
+	float64_t* vec = f->get_feature_vector(i, len, free);
+	return Map<VectorXd>(vec, len);
+}
+
+template <>
+falconn::SparseVector<double>
+get_falconn_point(SparseFeatures<float64_t>* f, index_t i)
+{
+	// FIXME: this basically copies the data :(
+	auto fv = f->get_sparse_feature_vector(i);
+	falconn::SparseVector<double> mapped(fv.num_feat_entries);
+	for (index_t j = 0; j < fv.num_feat_entries; ++j)
+		mapped[j] = std::make_pair(fv.features[j].feat_index, fv.features[j].entry);
+	return mapped;
+}
+
+template <typename PointType, typename FeatureType>
+class LSHTableImpl : public LSHIndex::Table
+{
+public:
+	LSHTableImpl(FeatureType* features, index_t num_vectors, int32_t l, int32_t t)
+	{
+		m_points.resize(num_vectors);
+		for (index_t i = 0; i < num_vectors; ++i)
+			m_points[i] = get_falconn_point<PointType>(features, i);
+
+		auto params = falconn::get_default_parameters<PointType>(
+		    num_vectors, features->get_num_features(),
+		    falconn::DistanceFunction::EuclideanSquared, true);
+		if (l)
+			params.l = l;
+		params.num_setup_threads = env()->get_num_threads();
+
+		m_table = falconn::construct_table<PointType>(m_points, params);
+		if (t)
+			m_table->set_num_probes(t);
+	}
+
+	virtual std::function<void(index_t, std::vector<int32_t>&)>
+	prober(const std::shared_ptr<Features>& queries) const
+	{
+		auto features = queries->as<FeatureType>();
+		std::shared_ptr<falconn::LSHNearestNeighborQuery<PointType>> query =
+		    m_table->construct_query_object();
+
+		return [features, query](index_t i, std::vector<int32_t>& result) {
+			query->get_unique_candidates(
+			    get_falconn_point<PointType>(features.get(), i), &result);
+		};
+	}
+
+private:
+	/** points of the table, which must outlive it */
+	std::vector<PointType> m_points;
+
+	std::unique_ptr<falconn::LSHNearestNeighborTable<PointType>> m_table;
+};
+
+LSHIndex::LSHIndex() : SGObject()
+{
+	init();
+}
+
+LSHIndex::LSHIndex(int32_t l, int32_t t) : SGObject()
+{
+	init();
+
+	m_l = l;
+	m_t = t;
+}
+
+LSHIndex::~LSHIndex()
+{
+}
+
+void LSHIndex::init()
+{
+	m_l = 0;
+	m_t = 0;
+	m_rebuild_fraction = 0.1;
+	m_features = NULL;
+	m_num_hashed = 0;
+	m_table = NULL;
+
+	SG_ADD(&m_l, "l", "Number of hash tables");
+	SG_ADD(&m_t, "t", "Number of probes per query");
+	SG_ADD(
+	    &m_rebuild_fraction, "rebuild_fraction",
+	    "Fraction of added vectors that triggers a rebuild");
+	SG_ADD(&m_features, "features", "Indexed vectors");
+	SG_ADD(&m_num_hashed, "num_hashed", "Number of vectors in the hash tables");
+}
+
+void LSHIndex::build(std::shared_ptr<Features> features)
+{
+	require(features, "Features not set.");
+	require(
+	    (features->get_feature_class() == C_DENSE ||
+	     features->get_feature_class() == C_SPARSE) &&
+	        features->get_feature_type() == F_DREAL,
+	    "Unsupported feature type {}!", features->get_name());
+	require(features->get_num_vectors(), "No vectors to index.");
+
+	{
+		std::lock_guard<std::mutex> guard(m_table_lock);
+		m_features = std::move(features);
+		m_num_hashed = m_features->get_num_vectors();
+		m_table = NULL;
+	}
+	get_table();
+}
+
+void LSHIndex::add(std::shared_ptr<Features> features)
+{
+	require(features, "Features not set.");
+	if (!m_features)
+	{
+		build(features);
+		return;
+	}
+
+	auto merged = m_features->create_merged_copy(features);
+
+	{
+		std::lock_guard<std::mutex> guard(m_table_lock);
+		m_features = merged;
+		auto num_added = m_features->get_num_vectors() - m_num_hashed;
+		if (num_added <= m_rebuild_fraction * m_num_hashed)
+			return;
+
+		SG_DEBUG(
+		    "{} vectors added to {} hashed ones, rebuilding", num_added,
+		    m_num_hashed);
+		m_num_hashed = m_features->get_num_vectors();
+		m_table = NULL;
+	}
+	get_table();
+}
+
+void LSHIndex::set_rebuild_fraction(float64_t fraction)
+{
+	require(fraction >= 0, "Rebuild fraction ({}) must not be negative.", fraction);
+	m_rebuild_fraction = fraction;
+}
+
+std::shared_ptr<LSHIndex::Table> LSHIndex::get_table() const
+{
+	std::lock_guard<std::mutex> guard(m_table_lock);
+	if (m_table)
+		return m_table;
+
+	if (m_features->get_feature_class() == C_DENSE)
+	{
+		m_table = std::make_shared<
+		    LSHTableImpl<falconn::DenseVector<double>, DenseFeatures<float64_t>>>(
+		    m_features->as<DenseFeatures<float64_t>>().get(), m_num_hashed,
+		    m_l, m_t);
+	}
+	else
+	{
+		m_table = std::make_shared<LSHTableImpl<
+		    falconn::SparseVector<double>, SparseFeatures<float64_t>>>(
+		    m_features->as<SparseFeatures<float64_t>>().get(), m_num_hashed,
+		    m_l, m_t);
+	}
+
+	return m_table;
+}
+
+SGMatrix<index_t>
+LSHIndex::query(const std::shared_ptr<Distance>& d, int32_t k) const
+{
+	require(d, "Distance not set.");
+	require(get_num_vectors(), "Index not built.");
+	require(
+	    d->get_num_vec_lhs() == get_num_vectors(),
+	    "Index has {} vectors, distance has {} on the left hand side.",
+	    get_num_vectors(), d->get_num_vec_lhs());
+	require(
+	    k > 0 && k <= get_num_vectors(),
+	    "K ({}) must be positive and not larger than the number of indexed "
+	    "vectors ({}).",
+	    k, get_num_vectors());
+
+	auto queries = d->get_rhs();
+	require(
+	    queries->get_feature_class() == m_features->get_feature_class() &&
+	        queries->get_feature_type() == m_features->get_feature_type(),
+	    "Queries ({}) must be of the same type as the indexed vectors ({}).",
+	    queries->get_name(), m_features->get_name());
+
+	auto table = get_table();
+	auto num_vectors = get_num_vectors();
+	auto num_hashed = m_num_hashed;
+	auto num_queries = d->get_num_vec_rhs();
+
+	SGMatrix<index_t> NN(k, num_queries);
+	auto num_threads = env()->get_num_threads();
+	auto pb = SG_PROGRESS(range(num_queries));
+
+#pragma omp parallel num_threads(num_threads)
+	{
+		auto probe = table->prober(queries);
+		std::vector<int32_t> candidates;
+		std::vector<std::pair<float64_t, index_t>> nearest;
+
+#pragma omp for schedule(dynamic, 16)
+		for (index_t i = 0; i < num_queries; ++i)
+		{
+			probe(i, candidates);
+
+			// added vectors that are not hashed yet are always candidates
+			for (index_t j = num_hashed; j < num_vectors; ++j)
+				candidates.push_back(j);
+
+			// compare with all vectors if there are not enough candidates
+			if ((index_t)candidates.size() < k)
+			{
+				candidates.resize(num_vectors);
+				std::iota(candidates.begin(), candidates.end(), 0);
+			}
+
+			nearest.clear();
+			for (auto c : candidates)
+				nearest.emplace_back(d->distance(c, i), c);
+			std::partial_sort(
+			    nearest.begin(), nearest.begin() + k, nearest.end());
+
+			for (index_t j = 0; j < k; ++j)
+				NN(j, i) = nearest[j].second;
+			pb.print_progress();
+		}
+	}
+	pb.complete();
+
+	return NN;
+}
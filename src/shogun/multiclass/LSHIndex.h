@@ -0,0 +1,140 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#ifndef _LSHINDEX_H__
+#define _LSHINDEX_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/SGObject.h>
+#include <shogun/distance/Distance.h>
+#include <shogun/features/Features.h>
+#include <shogun/lib/SGMatrix.h>
+
+#include <mutex>
+
+namespace shogun
+{
+
+/** @brief Locality-sensitive hashing index for approximate nearest neighbor
+ * search on DenseFeatures<float64_t> or SparseFeatures<float64_t>, using
+ * falconn's LSH tables with the squared Euclidean distance.
+ *
+ * The indexed vectors and the table parameters are registered parameters,
+ * so the index is serialized and cloned with its owner. The hash tables
+ * themselves are rebuilt from them on first use, with falconn's fixed seed,
+ * so a loaded index returns the same candidates as the saved one.
+ *
+ * Vectors added after the tables were built are kept aside and compared
+ * exhaustively with every query, until they exceed a fraction of the hashed
+ * vectors and the tables are rebuilt, see set_rebuild_fraction().
+ *
+ * Queries are answered in parallel with one falconn query object per
+ * thread. Candidates of the tables are ranked by the distance that is
+ * queried.
+ */
+class LSHIndex : public SGObject
+{
+public:
+	/** default constructor */
+	LSHIndex();
+
+	/** constructor
+	 *
+	 * @param l number of hash tables, 0 for falconn's default
+	 * @param t number of probes per query, 0 for falconn's default
+	 */
+	LSHIndex(int32_t l, int32_t t);
+
+	virtual ~LSHIndex();
+
+	/** Builds the index on the given vectors.
+	 *
+	 * @param features DenseFeatures<float64_t> or SparseFeatures<float64_t>
+	 */
+	void build(std::shared_ptr<Features> features);
+
+	/** Adds vectors to the index, after the vectors already indexed.
+	 * Tables are only rebuilt once the vectors that are not hashed exceed
+	 * the rebuild fraction.
+	 *
+	 * @param features vectors of the same type as the indexed ones, which
+	 * need to support Features::create_merged_copy()
+	 */
+	void add(std::shared_ptr<Features> features);
+
+	/** Finds approximate nearest neighbors of the right hand side vectors
+	 * of the distance among the indexed vectors.
+	 *
+	 * @param d distance with the indexed vectors on the left hand side
+	 * @param k number of neighbors
+	 * @return matrix with k rows and one column per right hand side vector,
+	 * with the indices of the neighbors ordered by increasing distance
+	 */
+	SGMatrix<index_t> query(const std::shared_ptr<Distance>& d, int32_t k) const;
+
+	/** @return indexed vectors */
+	inline std::shared_ptr<Features> get_features() const
+	{
+		return m_features;
+	}
+
+	/** @return number of indexed vectors */
+	inline index_t get_num_vectors() const
+	{
+		return m_features ? m_features->get_num_vectors() : 0;
+	}
+
+	/** @return number of vectors in the hash tables */
+	inline index_t get_num_hashed() const
+	{
+		return m_num_hashed;
+	}
+
+	/** @param fraction fraction of the hashed vectors that can be added
+	 * before the tables are rebuilt
+	 */
+	void set_rebuild_fraction(float64_t fraction);
+
+	/** @return object name */
+	virtual const char* get_name() const
+	{
+		return "LSHIndex";
+	}
+
+	/** hash tables of the index, defined in the implementation */
+	class Table;
+
+private:
+	void init();
+
+	/** @return hash tables of the hashed vectors, built if necessary */
+	std::shared_ptr<Table> get_table() const;
+
+protected:
+	/** number of hash tables */
+	int32_t m_l;
+
+	/** number of probes per query */
+	int32_t m_t;
+
+	/** fraction of added vectors that triggers a rebuild */
+	float64_t m_rebuild_fraction;
+
+	/** indexed vectors */
+	std::shared_ptr<Features> m_features;
+
+	/** number of leading vectors of m_features in the hash tables */
+	index_t m_num_hashed;
+
+	/** hash tables, built on first use */
+	mutable std::shared_ptr<Table> m_table;
+
+	/** lock of m_table */
+	mutable std::mutex m_table_lock;
+};
+} // namespace shogun
+
+#endif
@@ -4,78 +4,27 @@
  */
 
 #include <shogun/base/progress.h>
-#include <shogun/features/DenseFeatures.h>
-#include <shogun/features/SparseFeatures.h>
 #include <shogun/lib/Signal.h>
-#include <shogun/mathematics/eigen3.h>
 #include <shogun/multiclass/LSHKNNSolver.h>
 
 using namespace shogun;
-using namespace Eigen;
 
-#include <shogun/lib/external/falconn/lsh_nn_table.h>
-
-LSHKNNSolver::LSHKNNSolver(const int32_t k, const float64_t q, const int32_t num_classes, const int32_t min_label, const SGVector<int32_t> train_labels, const int32_t lsh_l, const int32_t lsh_t):
+LSHKNNSolver::LSHKNNSolver(const int32_t k, const float64_t q, const int32_t num_classes, const int32_t min_label, const SGVector<int32_t> train_labels, std::shared_ptr<LSHIndex> index):
 KNNSolver(k, q, num_classes, min_label, train_labels)
 {
 	init();
 
-	m_lsh_l=lsh_l;
-	m_lsh_t=lsh_t;
-}
-
-template<typename PointType, typename FeatureType>
-PointType get_falconn_point(FeatureType* f, index_t i);
-
-template<>
-falconn::DenseVector<double> get_falconn_point(DenseFeatures<float64_t>* f, index_t i)
-{
-	index_t len;
-	bool free;
-	float64_t* vec = f->get_feature_vector(i, len, free);
-	return Map<VectorXd>(vec, len);
-}
-
-template<>
-falconn::SparseVector<double> get_falconn_point(SparseFeatures<float64_t>* f, index_t i)
-{
-	// FIXME: this basically copies the data :(
-	auto fv = f->get_sparse_feature_vector(i);
-	falconn::SparseVector<double> mapped(fv.num_feat_entries);
-	for (index_t j = 0; j < fv.num_feat_entries; ++j)
-		mapped[j] = std::make_pair(fv.features[j].feat_index, fv.features[j].entry);
-	return mapped;
+	require(index, "Index not set.");
+	m_index=std::move(index);
 }
 
-template<typename PointType, typename FeatureType>
-std::shared_ptr<MulticlassLabels> LSHKNNSolver::classify_objects(FeatureType* lhs, FeatureType* query_features, const int32_t num_lab, SGVector<int32_t>& train_lab, SGVector<float64_t>& classes) const
+std::shared_ptr<MulticlassLabels> LSHKNNSolver::classify_objects(std::shared_ptr<Distance> knn_distance, const int32_t num_lab, SGVector<int32_t>& train_lab, SGVector<float64_t>& classes) const
 {
 	auto output = std::make_shared<MulticlassLabels>(num_lab);
-	std::vector<PointType> feats(lhs->get_num_vectors());
-	for(index_t i = 0; i < lhs->get_num_vectors(); ++i)
-		feats[i] = get_falconn_point<PointType>(lhs, i);
-
-	falconn::LSHConstructionParameters params
-		= falconn::get_default_parameters<PointType>(lhs->get_num_vectors(),
-                           lhs->get_num_features(),
-                           falconn::DistanceFunction::EuclideanSquared,
-                           true);
-
-	if (m_lsh_l && m_lsh_t)
-		params.l = m_lsh_l;
 
-	auto lsh_table = falconn::construct_table<PointType>(feats, params);
-	if (m_lsh_t)
-		lsh_table->set_num_probes(m_lsh_t);
+	//probe the hash tables for all examples in parallel
+	SGMatrix<index_t> NN = m_index->query(knn_distance, m_k);
 
-	SGMatrix<index_t> NN (m_k, query_features->get_num_vectors());
-	for(index_t i = 0; i < query_features->get_num_vectors(); ++i)
-	{
-		auto indices = new std::vector<index_t> ();
-		lsh_table->find_k_nearest_neighbors(get_falconn_point<PointType>(query_features, i), (int_fast64_t)m_k, indices);
-		sg_memcpy(NN.get_column_vector(i), indices->data(), sizeof(index_t)*m_k);
-		delete indices;
-	}
 	for (auto i : SG_PROGRESS(range(num_lab)))
 	{
 		if (cancel_computation())
@@ -90,34 +39,24 @@ std::shared_ptr<MulticlassLabels> LSHKNNSolver::classify_objects(FeatureType* lh
 		output->set_label(i, out_idx + m_min_label);
 	}
 
-
 	return output;
 }
 
-std::shared_ptr<MulticlassLabels> LSHKNNSolver::classify_objects(std::shared_ptr<Distance> knn_distance, const int32_t num_lab, SGVector<int32_t>& train_lab, SGVector<float64_t>& classes) const
+SGVector<int32_t> LSHKNNSolver::classify_objects_k(std::shared_ptr<Distance> knn_distance, const int32_t num_lab, SGVector<int32_t>& train_lab, SGVector<int32_t>& classes) const
 {
-	auto lhs = knn_distance->get_lhs();
-	auto rhs = knn_distance->get_rhs();
-	if ((lhs->get_feature_class() == C_DENSE) && (rhs->get_feature_class() == C_DENSE))
-	{
-		auto features = lhs->as<DenseFeatures<float64_t>>();
-		auto query_features = rhs->as<DenseFeatures<float64_t>>();
-		return classify_objects<falconn::DenseVector<double>>(features.get(), query_features.get(), num_lab, train_lab, classes);
-	}
-	else if ((lhs->get_feature_class() == C_SPARSE) && (rhs->get_feature_class() == C_SPARSE))
-	{
-		auto features = lhs->as<SparseFeatures<float64_t>>();
-		auto query_features = rhs->as<SparseFeatures<float64_t>>();
-		return classify_objects<falconn::SparseVector<double>>(features.get(), query_features.get(), num_lab, train_lab, classes);
-	}
-	else
+	SGVector<int32_t> output(m_k*num_lab);
+
+	//neighbors are ordered by increasing distance
+	SGMatrix<index_t> NN = m_index->query(knn_distance, m_k);
+
+	for (index_t i = 0; i < num_lab && (!cancel_computation()); i++)
 	{
-		error("Unsupported feature type!");
+		//write the labels of the k nearest neighbors from theirs indices
+		for (index_t j=0; j<m_k; j++)
+			train_lab[j] = m_train_labels[ NN(j,i) ];
+
+		choose_class_for_multiple_k(output.vector+i, classes.vector, train_lab.vector, num_lab);
 	}
-}
 
-SGVector<int32_t> LSHKNNSolver::classify_objects_k(std::shared_ptr<Distance> d, const int32_t num_lab, SGVector<int32_t>& train_lab, SGVector<int32_t>& classes) const
-{
-	not_implemented(SOURCE_LOCATION);
-	return 0;
+	return output;
 }
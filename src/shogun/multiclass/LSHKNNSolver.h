@@ -11,6 +11,7 @@
 #include <shogun/lib/common.h>
 #include <shogun/distance/Distance.h>
 #include <shogun/multiclass/KNNSolver.h>
+#include <shogun/multiclass/LSHIndex.h>
 
 namespace shogun
 {
@@ -18,6 +19,8 @@ namespace shogun
 /**
  * LSH solver. It uses LSH (short for Locality-sensitive hashing) to do the nearest neighbour computation.
  * For more information, see https://en.wikipedia.org/wiki/Locality-sensitive_hashing.
+ * The hash tables are built on the training vectors once and shared by all
+ * classifications, see LSHIndex.
  *
  */
 class LSHKNNSolver : public KNNSolver
@@ -39,10 +42,9 @@ class LSHKNNSolver : public KNNSolver
 		 * @param num_classes m_num_classes
 		 * @param min_label m_min_label
 		 * @param train_labels m_train_labels
-		 * @param lsh_l m_lsh_l
-		 * @param lsh_t m_lsh_t
+		 * @param index index built on the training vectors
 		 */
-		LSHKNNSolver(const int32_t k, const float64_t q, const int32_t num_classes, const int32_t min_label, const SGVector<int32_t> train_labels, const int32_t lsh_l, const int32_t lsh_t);
+		LSHKNNSolver(const int32_t k, const float64_t q, const int32_t num_classes, const int32_t min_label, const SGVector<int32_t> train_labels, std::shared_ptr<LSHIndex> index);
 
 		virtual std::shared_ptr<MulticlassLabels> classify_objects(std::shared_ptr<Distance> d, const int32_t num_lab, SGVector<int32_t>& train_lab, SGVector<float64_t>& classes) const;
 
@@ -54,19 +56,12 @@ class LSHKNNSolver : public KNNSolver
 	private:
 		void init()
 		{
-			m_lsh_l=0;
-			m_lsh_t=0;
+			m_index=NULL;
 		}
 
-		template<typename PointType, typename FeatureType>
-		std::shared_ptr<MulticlassLabels> classify_objects(FeatureType* lhs, FeatureType* query_features, const int32_t num_lab, SGVector<int32_t>& train_lab, SGVector<float64_t>& classes) const;
-
 	protected:
-		/* Number of hash tables for LSH */
-		int32_t m_lsh_l;
-
-		/* Number of probes per query for LSH */
-		int32_t m_lsh_t;
+		/* Index built on the training vectors */
+		std::shared_ptr<LSHIndex> m_index;
 
 };
 }
@@ -7,6 +7,7 @@
 #include <shogun/multiclass/MulticlassOCAS.h>
 
 #include <shogun/multiclass/MulticlassOneVsRestStrategy.h>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 #include <shogun/labels/MulticlassLabels.h>
@@ -27,6 +28,8 @@ struct mocas_data
 	uint32_t nData;
 	uint32_t nDim;
 	float64_t* new_a;
+	int32_t* cut_index;
+	float64_t* cut_alphas;
 };
 
 MulticlassOCAS::MulticlassOCAS() :
@@ -97,6 +100,8 @@ bool MulticlassOCAS::train_machine(std::shared_ptr<Features> data)
 	user_data.new_a = SG_CALLOC(float64_t, (int64_t)num_features*num_classes);
 	user_data.full_A = SG_CALLOC(float64_t, (int64_t)num_features*num_classes*m_buf_size);
 	user_data.output_values = SG_CALLOC(float64_t, num_vectors);
+	user_data.cut_index = SG_MALLOC(int32_t, num_vectors);
+	user_data.cut_alphas = SG_MALLOC(float64_t, num_vectors);
 	user_data.data_y = labels.vector;
 	user_data.nY = num_classes;
 	user_data.nDim = num_features;
@@ -143,6 +148,8 @@ bool MulticlassOCAS::train_machine(std::shared_ptr<Features> data)
 	SG_FREE(user_data.new_a);
 	SG_FREE(user_data.full_A);
 	SG_FREE(user_data.output_values);
+	SG_FREE(user_data.cut_index);
+	SG_FREE(user_data.cut_alphas);
 
 	return true;
 }
@@ -171,16 +178,15 @@ void MulticlassOCAS::msvm_full_compute_W(float64_t *sq_norm_W, float64_t *dp_Wol
 	SGVector<float64_t> W(((mocas_data*)user_data)->W, nDim*nY, false);
 	SGVector<float64_t> oldW(((mocas_data*)user_data)->oldW, nDim*nY, false);
 
-	uint32_t i,j;
-
 	sg_memcpy(oldW.vector, W.vector, sizeof(float64_t)*nDim*nY);
 	linalg::zero(W);
 
-	for(i=0; i<nSel; i++)
+#pragma omp parallel for schedule(static) num_threads(env()->get_num_threads())
+	for(int64_t j=0; j<int64_t(nDim)*nY; j++)
 	{
-		if(alpha[i] > 0)
+		for(uint32_t i=0; i<nSel; i++)
 		{
-			for(j=0; j<nDim*nY; j++)
+			if(alpha[i] > 0)
 				W[j] += alpha[i]*full_A[LIBOCAS_INDEX(j,i,nDim*nY)];
 		}
 	}
@@ -200,38 +206,48 @@ int MulticlassOCAS::msvm_full_add_new_cut(float64_t *new_col_H, uint32_t *new_cu
 	uint32_t nDim = ((mocas_data*)user_data)->nDim;
 	uint32_t nData = ((mocas_data*)user_data)->nData;
 	SGVector<float64_t> new_a(((mocas_data*)user_data)->new_a, nDim*nY, false);
+	int32_t* cut_index = ((mocas_data*)user_data)->cut_index;
+	float64_t* cut_alphas = ((mocas_data*)user_data)->cut_alphas;
 	auto features = ((mocas_data*)user_data)->features;
 
 	float64_t sq_norm_a;
-	uint32_t i, j, y, y2;
+	uint32_t i, y, y2;
 
 	linalg::zero(new_a);
 
-	for(i=0; i < nData; i++)
+	// the examples of the cut are added to the block of their true class and
+	// subtracted from the block of the violating class
+	for(uint32_t c=0; c < nY; c++)
 	{
-		y = (uint32_t)(data_y[i]);
-		y2 = (uint32_t)new_cut[i];
-		if(y2 != y)
+		int32_t num = 0;
+		for(i=0; i < nData; i++)
 		{
-			features->add_to_dense_vec(1.0,i,&new_a[nDim*y],nDim);
-			features->add_to_dense_vec(-1.0,i,&new_a[nDim*y2],nDim);
+			y = (uint32_t)(data_y[i]);
+			y2 = (uint32_t)new_cut[i];
+			if(y2 != y && (y == c || y2 == c))
+			{
+				cut_index[num++] = i;
+				cut_alphas[i] = (y == c) ? 1.0 : -1.0;
+			}
 		}
+
+		features->add_to_dense_vec_subset(cut_index,num,cut_alphas,&new_a[nDim*c],nDim);
 	}
 
 	// compute new_a'*new_a and insert new_a to the last column of full_A
 	sq_norm_a = linalg::dot(new_a,new_a);
-	for(j=0; j < nDim*nY; j++ )
-		full_A[LIBOCAS_INDEX(j,nSel,nDim*nY)] = new_a[j];
+	sg_memcpy(&full_A[LIBOCAS_INDEX(0,nSel,nDim*nY)], new_a.vector, sizeof(float64_t)*nDim*nY);
 
 	new_col_H[nSel] = sq_norm_a;
-	for(i=0; i < nSel; i++)
+#pragma omp parallel for schedule(dynamic) num_threads(env()->get_num_threads())
+	for(uint32_t k=0; k < nSel; k++)
 	{
 		float64_t tmp = 0;
 
-		for(j=0; j < nDim*nY; j++ )
-			tmp += new_a[j]*full_A[LIBOCAS_INDEX(j,i,nDim*nY)];
+		for(uint32_t l=0; l < nDim*nY; l++ )
+			tmp += new_a[l]*full_A[LIBOCAS_INDEX(l,k,nDim*nY)];
 
-		new_col_H[i] = tmp;
+		new_col_H[k] = tmp;
 	}
 
 	return 0;
@@ -0,0 +1,368 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#include <shogun/preprocessor/IncrementalPCA.h>
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
+#include <shogun/io/SGIO.h>
+#include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/eigen3.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
+
+#include <vector>
+
+using namespace shogun;
+using namespace Eigen;
+
+IncrementalPCA::IncrementalPCA() : DensePreprocessor<float64_t>()
+{
+	init();
+}
+
+IncrementalPCA::IncrementalPCA(int32_t target_dim, bool do_whitening)
+    : DensePreprocessor<float64_t>()
+{
+	init();
+	set_target_dim(target_dim);
+	m_whitening = do_whitening;
+}
+
+IncrementalPCA::~IncrementalPCA()
+{
+}
+
+void IncrementalPCA::init()
+{
+	m_target_dim = 1;
+	m_batch_size = 1000;
+	m_whitening = false;
+	m_eigenvalue_zero_tolerance = 1e-15;
+	m_num_vectors_seen = 0;
+
+	SG_ADD(
+	    &m_target_dim, "target_dim", "target dimensionality of preprocessor",
+	    ParameterProperties::HYPER);
+	SG_ADD(&m_batch_size, "batch_size", "Number of vectors per batch.");
+	SG_ADD(
+	    &m_whitening, "whitening", "Whether data shall be whitened.",
+	    ParameterProperties::HYPER);
+	SG_ADD(
+	    &m_eigenvalue_zero_tolerance, "eigenvalue_zero_tolerance",
+	    "zero tolerance"
+	    " for determining zero eigenvalues during whitening to avoid numerical "
+	    "issues");
+	SG_ADD(&m_num_vectors_seen, "num_vectors_seen", "Number of vectors seen.");
+	SG_ADD(&m_mean_vector, "mean_vector", "Mean Vector.");
+	SG_ADD(
+	    &m_components, "components",
+	    "Leading left singular vectors of the centered vectors.");
+	SG_ADD(
+	    &m_singular_values, "singular_values",
+	    "Leading singular values of the centered vectors.");
+	SG_ADD(
+	    &m_transformation_matrix, "transformation_matrix",
+	    "Transformation matrix (Eigenvectors of covariance matrix).");
+}
+
+void IncrementalPCA::cleanup()
+{
+	m_num_vectors_seen = 0;
+	m_mean_vector = SGVector<float64_t>();
+	m_components = SGMatrix<float64_t>();
+	m_singular_values = SGVector<float64_t>();
+	m_transformation_matrix = SGMatrix<float64_t>();
+	m_fitted = false;
+}
+
+void IncrementalPCA::fit(std::shared_ptr<Features> features)
+{
+	cleanup();
+
+	auto num_threads = env()->get_num_threads();
+	std::vector<std::shared_ptr<IncrementalPCA>> partial(num_threads);
+	for (auto& p : partial)
+		p = std::make_shared<IncrementalPCA>(m_target_dim);
+
+	// thread t adds batches t, t + num_threads, ...
+	auto fit_batches = [&partial](const std::vector<SGMatrix<float64_t>>& batches) {
+		int64_t num_partial = partial.size();
+#pragma omp parallel for num_threads(num_partial)
+		for (int64_t t = 0; t < num_partial; ++t)
+		{
+			for (size_t i = t; i < batches.size(); i += num_partial)
+				partial[t]->partial_fit(batches[i]);
+		}
+	};
+
+	if (features->get_feature_class() == C_STREAMING_DENSE)
+	{
+		require(
+		    features->get_feature_type() == F_DREAL,
+		    "Streaming features of type {} are not supported",
+		    features->get_feature_type());
+		auto stream = features->as<StreamingDenseFeatures<float64_t>>();
+
+		stream->start_parser();
+		std::vector<SGMatrix<float64_t>> batches;
+		std::vector<SGVector<float64_t>> vectors;
+		bool has_next = true;
+		while (has_next)
+		{
+			has_next = stream->get_next_example();
+			if (has_next)
+			{
+				vectors.push_back(stream->get_vector().clone());
+				stream->release_example();
+			}
+
+			if (!vectors.empty() &&
+			    (!has_next || (index_t)vectors.size() == m_batch_size))
+			{
+				SGMatrix<float64_t> batch(vectors[0].vlen, vectors.size());
+				for (index_t i = 0; i < batch.num_cols; ++i)
+				{
+					require(
+					    vectors[i].vlen == batch.num_rows,
+					    "Dimension of streamed vector ({}) does not match "
+					    "dimension of previous vectors ({})",
+					    vectors[i].vlen, batch.num_rows);
+					batch.set_column(i, vectors[i]);
+				}
+				vectors.clear();
+				batches.push_back(batch);
+			}
+
+			if (!batches.empty() &&
+			    (!has_next || (int32_t)batches.size() == num_threads))
+			{
+				fit_batches(batches);
+				batches.clear();
+			}
+		}
+		stream->end_parser();
+	}
+	else
+	{
+		auto feature_matrix =
+		    features->as<DenseFeatures<float64_t>>()->get_feature_matrix();
+		std::vector<SGMatrix<float64_t>> batches;
+		for (index_t start = 0; start < feature_matrix.num_cols;
+		     start += m_batch_size)
+		{
+			auto size =
+			    std::min(m_batch_size, feature_matrix.num_cols - start);
+			batches.push_back(SGMatrix<float64_t>(
+			    feature_matrix.get_column_vector(start),
+			    feature_matrix.num_rows, size, false));
+		}
+		fit_batches(batches);
+	}
+
+	for (const auto& p : partial)
+		merge(p);
+
+	require(m_num_vectors_seen > 0, "No feature vectors to fit");
+	io::info(
+	    "Reducing from {} to {} features", m_mean_vector.vlen,
+	    m_transformation_matrix.num_cols);
+}
+
+void IncrementalPCA::partial_fit(const SGMatrix<float64_t>& batch)
+{
+	if (batch.num_cols == 0)
+		return;
+
+	Map<MatrixXd> batch_matrix(batch.matrix, batch.num_rows, batch.num_cols);
+	SGVector<float64_t> mean(batch.num_rows);
+	Map<VectorXd>(mean.vector, mean.vlen) = batch_matrix.rowwise().mean();
+
+	SGMatrix<float64_t> centered(batch.num_rows, batch.num_cols);
+	Map<MatrixXd>(centered.matrix, batch.num_rows, batch.num_cols) =
+	    batch_matrix.colwise() - Map<VectorXd>(mean.vector, mean.vlen);
+
+	update(batch.num_cols, mean, centered);
+}
+
+void IncrementalPCA::merge(const std::shared_ptr<IncrementalPCA>& other)
+{
+	require(other, "No preprocessor to merge");
+	if (other->m_num_vectors_seen == 0)
+		return;
+
+	auto num_components = other->m_singular_values.vlen;
+	SGMatrix<float64_t> factor(other->m_components.num_rows, num_components);
+	Map<MatrixXd>(factor.matrix, factor.num_rows, factor.num_cols) =
+	    Map<MatrixXd>(
+	        other->m_components.matrix, factor.num_rows, num_components) *
+	    Map<VectorXd>(other->m_singular_values.vector, num_components)
+	        .asDiagonal();
+
+	update(other->m_num_vectors_seen, other->m_mean_vector, factor);
+}
+
+void IncrementalPCA::update(
+    int64_t num_vectors, const SGVector<float64_t>& mean,
+    const SGMatrix<float64_t>& factor)
+{
+	auto num_features = mean.vlen;
+	Map<VectorXd> new_mean(mean.vector, num_features);
+	Map<MatrixXd> new_factor(factor.matrix, num_features, factor.num_cols);
+
+	SGMatrix<float64_t> stacked;
+	if (m_num_vectors_seen == 0)
+	{
+		stacked = factor;
+		m_mean_vector = mean.clone();
+	}
+	else
+	{
+		require(
+		    num_features == m_mean_vector.vlen,
+		    "Dimension of vectors ({}) does not match dimension of previous "
+		    "vectors ({})",
+		    num_features, m_mean_vector.vlen);
+
+		auto num_components = m_singular_values.vlen;
+		stacked = SGMatrix<float64_t>(
+		    num_features, num_components + factor.num_cols + 1);
+		Map<MatrixXd> stacked_matrix(
+		    stacked.matrix, stacked.num_rows, stacked.num_cols);
+		Map<VectorXd> old_mean(m_mean_vector.vector, num_features);
+
+		float64_t n1 = m_num_vectors_seen;
+		float64_t n2 = num_vectors;
+		stacked_matrix.leftCols(num_components) =
+		    Map<MatrixXd>(m_components.matrix, num_features, num_components) *
+		    Map<VectorXd>(m_singular_values.vector, num_components)
+		        .asDiagonal();
+		stacked_matrix.middleCols(num_components, factor.num_cols) =
+		    new_factor;
+		// the scatter between the two means
+		stacked_matrix.rightCols(1) =
+		    std::sqrt(n1 * n2 / (n1 + n2)) * (old_mean - new_mean);
+
+		old_mean = (n1 * old_mean + n2 * new_mean) / (n1 + n2);
+	}
+	m_num_vectors_seen += num_vectors;
+
+	auto rank = std::min(stacked.num_rows, stacked.num_cols);
+	SGVector<float64_t> singular_values(rank);
+	SGMatrix<float64_t> left_vectors(stacked.num_rows, rank);
+	linalg::svd(stacked, singular_values, left_vectors);
+
+	auto num_components = std::min(m_target_dim, rank);
+	m_singular_values = SGVector<float64_t>(num_components);
+	m_components = SGMatrix<float64_t>(num_features, num_components);
+	Map<VectorXd>(m_singular_values.vector, num_components) =
+	    Map<VectorXd>(singular_values.vector, rank).head(num_components);
+	Map<MatrixXd>(m_components.matrix, num_features, num_components) =
+	    Map<MatrixXd>(left_vectors.matrix, num_features, rank)
+	        .leftCols(num_components);
+
+	update_transformation_matrix();
+	m_fitted = true;
+}
+
+void IncrementalPCA::update_transformation_matrix()
+{
+	m_transformation_matrix = m_components.clone();
+	if (!m_whitening)
+		return;
+
+	auto eigenvalues = get_eigenvalues();
+	for (index_t i = 0; i < m_transformation_matrix.num_cols; ++i)
+	{
+		auto column = m_transformation_matrix.get_column(i);
+		if (Math::fequals_abs<float64_t>(
+		        0.0, eigenvalues[i], m_eigenvalue_zero_tolerance))
+		{
+			io::warn(
+			    "Covariance matrix has almost zero Eigenvalue (ie "
+			    "Eigenvalue within a tolerance of {:E} around 0) at "
+			    "dimension {}. Consider reducing its dimension.",
+			    m_eigenvalue_zero_tolerance, i + 1);
+			column.zero();
+			continue;
+		}
+		linalg::scale(column, column, 1.0 / m_singular_values[i]);
+	}
+}
+
+SGMatrix<float64_t> IncrementalPCA::apply_to_matrix(SGMatrix<float64_t> matrix)
+{
+	assert_fitted();
+	require(
+	    matrix.num_rows == m_mean_vector.vlen,
+	    "Dimension of vectors ({}) does not match dimension of fitted "
+	    "vectors ({})",
+	    matrix.num_rows, m_mean_vector.vlen);
+
+	auto num_dim = m_transformation_matrix.num_cols;
+	SGMatrix<float64_t> result(num_dim, matrix.num_cols);
+	Map<MatrixXd> feature_matrix(
+	    matrix.matrix, matrix.num_rows, matrix.num_cols);
+	Map<MatrixXd>(result.matrix, num_dim, matrix.num_cols) =
+	    Map<MatrixXd>(
+	        m_transformation_matrix.matrix, matrix.num_rows, num_dim)
+	        .transpose() *
+	    (feature_matrix.colwise() -
+	     Map<VectorXd>(m_mean_vector.vector, m_mean_vector.vlen));
+
+	return result;
+}
+
+SGVector<float64_t>
+IncrementalPCA::apply_to_feature_vector(SGVector<float64_t> vector)
+{
+	return SGVector<float64_t>(apply_to_matrix(SGMatrix<float64_t>(vector)));
+}
+
+SGMatrix<float64_t> IncrementalPCA::get_transformation_matrix() const
+{
+	return m_transformation_matrix;
+}
+
+SGVector<float64_t> IncrementalPCA::get_eigenvalues() const
+{
+	SGVector<float64_t> eigenvalues(m_singular_values.vlen);
+	for (index_t i = 0; i < eigenvalues.vlen; ++i)
+		eigenvalues[i] = m_singular_values[i] * m_singular_values[i] /
+		                 std::max<int64_t>(m_num_vectors_seen - 1, 1);
+	return eigenvalues;
+}
+
+SGVector<float64_t> IncrementalPCA::get_mean() const
+{
+	return m_mean_vector;
+}
+
+int64_t IncrementalPCA::get_num_vectors_seen() const
+{
+	return m_num_vectors_seen;
+}
+
+void IncrementalPCA::set_target_dim(int32_t dim)
+{
+	require(dim > 0, "Target dimension ({}) must be positive", dim);
+	m_target_dim = dim;
+}
+
+int32_t IncrementalPCA::get_target_dim() const
+{
+	return m_target_dim;
+}
+
+void IncrementalPCA::set_batch_size(int32_t batch_size)
+{
+	require(batch_size > 0, "Batch size ({}) must be positive", batch_size);
+	m_batch_size = batch_size;
+}
+
+int32_t IncrementalPCA::get_batch_size() const
+{
+	return m_batch_size;
+}
@@ -0,0 +1,196 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#ifndef INCREMENTALPCA_H_
+#define INCREMENTALPCA_H_
+
+#include <shogun/lib/config.h>
+
+#include <shogun/features/Features.h>
+#include <shogun/lib/common.h>
+#include <shogun/preprocessor/DensePreprocessor.h>
+
+namespace shogun
+{
+/** @brief Preprocessor IncrementalPCA performs principal component analysis
+ * on feature vectors that are seen in mini-batches, so the feature matrix
+ * never has to be in memory at once.
+ *
+ * The preprocessor keeps the number of vectors seen, their mean, and the
+ * leading T singular values and left singular vectors of the centered
+ * \f$D \times N\f$ matrix of the vectors seen, where T is the target
+ * dimension. A batch X with mean
+ * \f$\mu_X\f$ is added by computing the thin SVD of the
+ * \f$D \times (T+M+1)\f$ matrix
+ * \f[
+ * [U\Sigma,\; X-\mu_X 1^T,\; \sqrt{NM/(N+M)}(\mu-\mu_X)]
+ * \f]
+ * where N is the number of vectors seen, M the number of vectors of the
+ * batch, \f$\mu\f$ the mean of the vectors seen and \f$U\Sigma\f$ the
+ * components scaled by their singular values, and truncating it to T
+ * components.
+ *
+ * Ross, D. A., Lim, J., Lin, R.-S., & Yang, M.-H. (2008).
+ * Incremental Learning for Robust Visual Tracking.
+ * International Journal of Computer Vision, 77(1-3), 125-141.
+ *
+ * The partial results of two preprocessors are combined the same way by
+ * merge(), so batches can be processed in parallel. fit() accepts
+ * DenseFeatures<float64_t>, which it splits into batches, and
+ * StreamingDenseFeatures<float64_t>, which it reads batch by batch until
+ * the stream ends. Batches are distributed over the threads of env(), each
+ * thread collecting a partial result that is merged in the end.
+ *
+ * The transformation matrix, eigenvalues and mean are those of PCA, up to
+ * the error of truncating to T components after every batch, which is small
+ * when the discarded eigenvalues are.
+ */
+class IncrementalPCA : public DensePreprocessor<float64_t>
+{
+public:
+	/** default constructor */
+	IncrementalPCA();
+
+	/** constructor
+	 *
+	 * @param target_dim number of components
+	 * @param do_whitening normalize columns (eigenvectors) of the
+	 * transformation matrix
+	 */
+	IncrementalPCA(int32_t target_dim, bool do_whitening = false);
+
+	/** destructor */
+	virtual ~IncrementalPCA();
+
+	/** Fits the components to all vectors of the features, discarding
+	 * previous results.
+	 *
+	 * @param features DenseFeatures<float64_t> or
+	 * StreamingDenseFeatures<float64_t>
+	 */
+	virtual void fit(std::shared_ptr<Features> features);
+
+	/** Updates the components with a batch of vectors.
+	 *
+	 * @param batch matrix with one vector per column
+	 */
+	void partial_fit(const SGMatrix<float64_t>& batch);
+
+	/** Updates the components with the vectors seen by another
+	 * preprocessor of the same dimension.
+	 *
+	 * @param other preprocessor to merge
+	 */
+	void merge(const std::shared_ptr<IncrementalPCA>& other);
+
+	/** cleanup */
+	virtual void cleanup();
+
+	/** apply preprocessor to feature vector
+	 * @param vector feature vector
+	 * @return processed feature vector
+	 */
+	virtual SGVector<float64_t>
+	apply_to_feature_vector(SGVector<float64_t> vector);
+
+	/** get transformation matrix, i.e. eigenvectors (potentially scaled if
+	 * do_whitening is true)
+	 */
+	SGMatrix<float64_t> get_transformation_matrix() const;
+
+	/** get eigenvalues of the covariance matrix, in decreasing order */
+	SGVector<float64_t> get_eigenvalues() const;
+
+	/** get mean vector of the vectors seen */
+	SGVector<float64_t> get_mean() const;
+
+	/** @return number of vectors seen */
+	int64_t get_num_vectors_seen() const;
+
+	/** setter for target dimension
+	 * @param dim target dimension
+	 */
+	void set_target_dim(int32_t dim);
+
+	/** getter for target dimension
+	 * @return target dimension
+	 */
+	int32_t get_target_dim() const;
+
+	/** setter for the number of vectors per batch of fit()
+	 * @param batch_size batch size
+	 */
+	void set_batch_size(int32_t batch_size);
+
+	/** getter for the number of vectors per batch of fit()
+	 * @return batch size
+	 */
+	int32_t get_batch_size() const;
+
+	/** @return object name */
+	virtual const char* get_name() const
+	{
+		return "IncrementalPCA";
+	}
+
+	/** @return a type of preprocessor */
+	virtual EPreprocessorType get_type() const
+	{
+		return P_INCREMENTALPCA;
+	}
+
+protected:
+	void init();
+
+	virtual SGMatrix<float64_t> apply_to_matrix(SGMatrix<float64_t> matrix);
+
+	/** Updates the components with the vectors of a partial result.
+	 *
+	 * @param num_vectors number of vectors
+	 * @param mean mean of the vectors
+	 * @param factor matrix whose outer product is the scatter matrix of
+	 * the vectors, the centered vectors or the components scaled by their
+	 * singular values
+	 */
+	void update(
+	    int64_t num_vectors, const SGVector<float64_t>& mean,
+	    const SGMatrix<float64_t>& factor);
+
+	/** Computes the transformation matrix from the components. */
+	void update_transformation_matrix();
+
+protected:
+	/** target dimension */
+	int32_t m_target_dim;
+
+	/** number of vectors per batch of fit() */
+	int32_t m_batch_size;
+
+	/** whitening */
+	bool m_whitening;
+
+	/** eigenvalues within zero tolerance
+	 * region are considered 0 while
+	 * whitening to tackle numerical issues
+	 */
+	float64_t m_eigenvalue_zero_tolerance;
+
+	/** number of vectors seen */
+	int64_t m_num_vectors_seen;
+
+	/** mean vector of the vectors seen */
+	SGVector<float64_t> m_mean_vector;
+
+	/** leading left singular vectors of the centered vectors seen */
+	SGMatrix<float64_t> m_components;
+
+	/** leading singular values of the centered vectors seen */
+	SGVector<float64_t> m_singular_values;
+
+	/** transformation matrix */
+	SGMatrix<float64_t> m_transformation_matrix;
+};
+} // namespace shogun
+#endif // INCREMENTALPCA_H_
@@ -17,17 +17,21 @@
 #include <shogun/features/Features.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/kernel/Kernel.h>
+#include <shogun/kernel/NystromKernel.h>
 #include <shogun/lib/common.h>
+#include <shogun/mathematics/RandomizedRangeFinder.h>
+#include <shogun/mathematics/eigen3.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 
 using namespace shogun;
+using namespace Eigen;
 
-KernelPCA::KernelPCA() : Preprocessor()
+KernelPCA::KernelPCA() : RandomMixin<Preprocessor>()
 {
 	init();
 }
 
-KernelPCA::KernelPCA(std::shared_ptr<Kernel> k) : Preprocessor()
+KernelPCA::KernelPCA(std::shared_ptr<Kernel> k) : RandomMixin<Preprocessor>()
 {
 	init();
 	set_kernel(std::move(k));
@@ -41,6 +45,10 @@ void KernelPCA::init()
 	m_bias_vector = SGVector<float64_t>();
 	m_target_dim = 1;
 	m_kernel = NULL;
+	m_method = KPCA_EXACT;
+	m_num_landmarks = 100;
+	m_oversampling = 10;
+	m_power_iterations = 2;
 
 	SG_ADD(&m_transformation_matrix, "transformation_matrix",
 		"matrix used to transform data");
@@ -50,6 +58,20 @@ void KernelPCA::init()
 	    &m_target_dim, "target_dim", "target dimensionality of preprocessor",
 	    ParameterProperties::HYPER);
 	SG_ADD(&m_kernel, "kernel", "kernel to be used", ParameterProperties::HYPER);
+	SG_ADD_OPTIONS(
+	    (machine_int_t*)&m_method, "method", "eigendecomposition method",
+	    ParameterProperties::NONE,
+	    SG_OPTIONS(KPCA_EXACT, KPCA_RANDOMIZED, KPCA_NYSTROM));
+	SG_ADD(
+	    &m_num_landmarks, "num_landmarks",
+	    "number of landmarks of the Nystroem method",
+	    ParameterProperties::HYPER);
+	SG_ADD(
+	    &m_oversampling, "oversampling",
+	    "number of additional random vectors of the randomized method");
+	SG_ADD(
+	    &m_power_iterations, "power_iterations",
+	    "number of power iterations of the randomized method");
 }
 
 void KernelPCA::cleanup()
@@ -72,7 +94,17 @@ void KernelPCA::fit(std::shared_ptr<Features> features)
 	if (m_fitted)
 		cleanup();
 
+	if (m_method == KPCA_NYSTROM)
+		fit_nystrom(features);
+	else
+		fit_kernel_matrix(features);
 
+	m_fitted = true;
+	io::info("Done");
+}
+
+void KernelPCA::fit_kernel_matrix(std::shared_ptr<Features> features)
+{
 	m_init_features = features;
 
 	m_kernel->init(features, features);
@@ -100,8 +132,27 @@ void KernelPCA::fit(std::shared_ptr<Features> features)
 
 	SGVector<float64_t> eigenvalues(m_target_dim);
 	SGMatrix<float64_t> eigenvectors(kernel_matrix.num_rows, m_target_dim);
-	linalg::eigen_solver_symmetric(
-	    kernel_matrix, eigenvalues, eigenvectors, m_target_dim);
+	if (m_method == KPCA_RANDOMIZED)
+	{
+		auto num_components = std::min(m_target_dim + m_oversampling, n);
+		Map<MatrixXd> kmatrix(kernel_matrix.matrix, n, n);
+		auto product = [&kmatrix](const MatrixXd& m) -> MatrixXd {
+			return kmatrix * m;
+		};
+		MatrixXd basis = randomized::range_finder(
+		    n, n, num_components, m_power_iterations, product, product,
+		    m_prng);
+
+		SelfAdjointEigenSolver<MatrixXd> eigen_solver(
+		    basis.transpose() * kmatrix * basis);
+		Map<VectorXd>(eigenvalues.vector, m_target_dim) =
+		    eigen_solver.eigenvalues().tail(m_target_dim);
+		Map<MatrixXd>(eigenvectors.matrix, n, m_target_dim) =
+		    basis * eigen_solver.eigenvectors().rightCols(m_target_dim);
+	}
+	else
+		linalg::eigen_solver_symmetric(
+		    kernel_matrix, eigenvalues, eigenvectors, m_target_dim);
 
 	m_transformation_matrix =
 	    SGMatrix<float64_t>(kernel_matrix.num_rows, m_target_dim);
@@ -118,9 +169,45 @@ void KernelPCA::fit(std::shared_ptr<Features> features)
 
 	m_bias_vector = SGVector<float64_t>(m_target_dim);
 	linalg::matrix_prod(m_transformation_matrix, bias_tmp, m_bias_vector, true);
+}
 
-	m_fitted = true;
-	io::info("Done");
+void KernelPCA::fit_nystrom(std::shared_ptr<Features> features)
+{
+	int32_t num_landmarks =
+	    std::min(m_num_landmarks, features->get_num_vectors());
+	if (m_target_dim > num_landmarks)
+	{
+		io::warn(
+		    "Target dimension ({}) is not a valid value, it must be"
+		    "less or equal than the number of landmarks."
+		    "Setting it to maximum allowed size ({}).",
+		    m_target_dim, num_landmarks);
+		m_target_dim = num_landmarks;
+	}
+
+	io::info("Computing kernel to {} landmarks", num_landmarks);
+	auto nystrom = std::make_shared<NystromKernel>(m_kernel, num_landmarks);
+	seed(nystrom);
+	auto feature_map = nystrom->get_feature_map(features)->get_feature_matrix();
+	auto projection = nystrom->get_projection();
+	m_init_features = nystrom->get_landmarks();
+
+	// linear PCA on the approximated feature map
+	Map<MatrixXd> phi(feature_map.matrix, num_landmarks, feature_map.num_cols);
+	VectorXd feature_mean = phi.rowwise().mean();
+	MatrixXd centered = phi.colwise() - feature_mean;
+	SelfAdjointEigenSolver<MatrixXd> solver(centered * centered.transpose());
+	MatrixXd components =
+	    solver.eigenvectors().rightCols(m_target_dim).rowwise().reverse();
+
+	m_transformation_matrix = SGMatrix<float64_t>(num_landmarks, m_target_dim);
+	Map<MatrixXd>(m_transformation_matrix.matrix, num_landmarks, m_target_dim) =
+	    Map<MatrixXd>(projection.matrix, num_landmarks, num_landmarks) *
+	    components;
+
+	m_bias_vector = SGVector<float64_t>(m_target_dim);
+	Map<VectorXd>(m_bias_vector.vector, m_target_dim) =
+	    -components.transpose() * feature_mean;
 }
 
 std::shared_ptr<Features> KernelPCA::transform(std::shared_ptr<Features> features, bool inplace)
@@ -135,6 +222,9 @@ std::shared_ptr<Features> KernelPCA::transform(std::shared_ptr<Features> feature
 
 	if (features->get_feature_class() == C_STRING)
 	{
+		if (m_method == KPCA_NYSTROM)
+			return std::make_shared<DenseFeatures<float64_t>>(
+			    apply_to_feature_matrix(features));
 		return apply_to_string_features(features);
 	}
 
@@ -150,8 +240,14 @@ SGMatrix<float64_t> KernelPCA::apply_to_feature_matrix(std::shared_ptr<Features>
 	m_kernel->init(std::move(features), m_init_features);
 	auto kernel_matrix = m_kernel->get_kernel_matrix();
 
-	auto rows_sum = linalg::rowwise_sum(kernel_matrix);
-	linalg::add_vector(kernel_matrix, rows_sum, kernel_matrix, 1.0, -1.0 / n);
+	// the approximated feature map of the Nystroem method is centered by the
+	// bias
+	if (m_method != KPCA_NYSTROM)
+	{
+		auto rows_sum = linalg::rowwise_sum(kernel_matrix);
+		linalg::add_vector(
+		    kernel_matrix, rows_sum, kernel_matrix, 1.0, -1.0 / n);
+	}
 
 	SGMatrix<float64_t> new_feature_matrix =
 	    linalg::matrix_prod(m_transformation_matrix, kernel_matrix, true, true);
@@ -240,3 +336,53 @@ std::shared_ptr<Kernel> KernelPCA::get_kernel() const
 
 	return m_kernel;
 }
+
+void KernelPCA::set_method(EKernelPCAMethod method)
+{
+	m_method = method;
+}
+
+EKernelPCAMethod KernelPCA::get_method() const
+{
+	return m_method;
+}
+
+void KernelPCA::set_num_landmarks(int32_t num_landmarks)
+{
+	require(
+	    num_landmarks > 0, "Number of landmarks ({}) must be positive",
+	    num_landmarks);
+	m_num_landmarks = num_landmarks;
+}
+
+int32_t KernelPCA::get_num_landmarks() const
+{
+	return m_num_landmarks;
+}
+
+void KernelPCA::set_oversampling(int32_t oversampling)
+{
+	require(
+	    oversampling >= 0, "Oversampling ({}) must not be negative",
+	    oversampling);
+	m_oversampling = oversampling;
+}
+
+int32_t KernelPCA::get_oversampling() const
+{
+	return m_oversampling;
+}
+
+void KernelPCA::set_power_iterations(int32_t power_iterations)
+{
+	require(
+	    power_iterations >= 0,
+	    "Number of power iterations ({}) must not be negative",
+	    power_iterations);
+	m_power_iterations = power_iterations;
+}
+
+int32_t KernelPCA::get_power_iterations() const
+{
+	return m_power_iterations;
+}
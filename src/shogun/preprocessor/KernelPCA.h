@@ -12,11 +12,28 @@
 #include <shogun/features/Features.h>
 #include <shogun/kernel/Kernel.h>
 #include <shogun/lib/common.h>
+#include <shogun/mathematics/RandomMixin.h>
 #include <shogun/preprocessor/DensePreprocessor.h>
 
 namespace shogun
 {
 
+/** Eigendecomposition method of KernelPCA */
+enum EKernelPCAMethod
+{
+	/** exact eigendecomposition of the centered kernel matrix */
+	KPCA_EXACT = 10,
+	/** randomized eigendecomposition of the centered kernel matrix, which
+	 * only computes the leading eigenvectors
+	 */
+	KPCA_RANDOMIZED = 20,
+	/** eigendecomposition of the Nystroem approximation of the kernel
+	 * matrix, which only needs the kernel between the vectors and a random
+	 * subset of landmark vectors
+	 */
+	KPCA_NYSTROM = 30
+};
+
 class Features;
 class Kernel;
 
@@ -27,8 +44,25 @@ class Kernel;
  * Advances in kernel methods support vector learning, 1327(3), 327-352. MIT Press.
  * Retrieved from http://citeseerx.ist.psu.edu/viewdoc/summary?doi=10.1.1.32.8744
  *
+ * The KPCA_EXACT method fully decomposes the centered n x n kernel matrix of
+ * the n training vectors. The KPCA_RANDOMIZED method finds the leading
+ * eigenvectors of the same matrix from its products with the target dimension
+ * plus an oversampling of random vectors, refined by power iterations, which
+ * takes O(n^2) instead of O(n^3) time.
+ *
+ * The KPCA_NYSTROM method never computes the full kernel matrix. It samples m
+ * landmark vectors and approximates the feature map as
+ * \f$\phi(x) = K_{mm}^{-1/2}k_m(x)\f$, where \f$K_{mm}\f$ is the kernel
+ * matrix of the landmarks and \f$k_m(x)\f$ the kernel between x and the
+ * landmarks. Linear PCA on these m-dimensional features then takes
+ * O(nm^2) time and O(nm) memory, and vectors are transformed with the
+ * kernel to the landmarks only.
+ *
+ * Williams, C. K. I., & Seeger, M. (2001).
+ * Using the Nystroem method to speed up kernel machines.
+ * Advances in Neural Information Processing Systems 13, 682-688.
  */
-class KernelPCA : public Preprocessor
+class KernelPCA : public RandomMixin<Preprocessor>
 {
 public:
 		/** default constructor
@@ -111,14 +145,67 @@ public:
 		 */
 		std::shared_ptr<Kernel> get_kernel() const;
 
+		/** setter for the eigendecomposition method
+		 * @param method KPCA_EXACT, KPCA_RANDOMIZED or KPCA_NYSTROM
+		 */
+		void set_method(EKernelPCAMethod method);
+
+		/** getter for the eigendecomposition method
+		 * @return method
+		 */
+		EKernelPCAMethod get_method() const;
+
+		/** setter for the number of landmarks of the KPCA_NYSTROM method
+		 * @param num_landmarks number of landmarks
+		 */
+		void set_num_landmarks(int32_t num_landmarks);
+
+		/** getter for the number of landmarks of the KPCA_NYSTROM method
+		 * @return number of landmarks
+		 */
+		int32_t get_num_landmarks() const;
+
+		/** setter for the number of additional random vectors of the
+		 * KPCA_RANDOMIZED method
+		 * @param oversampling oversampling
+		 */
+		void set_oversampling(int32_t oversampling);
+
+		/** getter for the oversampling of the KPCA_RANDOMIZED method
+		 * @return oversampling
+		 */
+		int32_t get_oversampling() const;
+
+		/** setter for the number of power iterations of the KPCA_RANDOMIZED
+		 * method
+		 * @param power_iterations number of power iterations
+		 */
+		void set_power_iterations(int32_t power_iterations);
+
+		/** getter for the number of power iterations of the KPCA_RANDOMIZED
+		 * method
+		 * @return number of power iterations
+		 */
+		int32_t get_power_iterations() const;
+
 	protected:
 
 		/** default init */
 		void init();
 
+		/** Computes the eigenvectors of the kernel matrix of the features */
+		void fit_kernel_matrix(std::shared_ptr<Features> features);
+
+		/** Computes the eigenvectors of the Nystroem approximation of the
+		 * kernel matrix of the features
+		 */
+		void fit_nystrom(std::shared_ptr<Features> features);
+
 	protected:
 
-		/** features used by init. needed for apply */
+		/** features used by init, or the landmarks of the KPCA_NYSTROM
+		 * method. needed for apply
+		 */
 		std::shared_ptr<Features> m_init_features;
 
 		/** transformation matrix */
@@ -132,6 +219,18 @@ public:
 
 		/** kernel to be used */
 		std::shared_ptr<Kernel> m_kernel;
+
+		/** eigendecomposition method */
+		EKernelPCAMethod m_method;
+
+		/** number of landmarks of the KPCA_NYSTROM method */
+		int32_t m_num_landmarks;
+
+		/** oversampling of the KPCA_RANDOMIZED method */
+		int32_t m_oversampling;
+
+		/** number of power iterations of the KPCA_RANDOMIZED method */
+		int32_t m_power_iterations;
 };
 }
 #endif
@@ -9,6 +9,7 @@
 #include <shogun/features/Features.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/mathematics/Math.h>
+#include <shogun/mathematics/RandomizedRangeFinder.h>
 #include <shogun/mathematics/eigen3.h>
 #include <shogun/preprocessor/DensePreprocessor.h>
 #include <shogun/preprocessor/PCA.h>
@@ -19,7 +20,7 @@ using namespace Eigen;
 PCA::PCA(
     bool do_whitening, EPCAMode mode, float64_t thresh, EPCAMethod method,
     EPCAMemoryMode mem_mode)
-    : DensePreprocessor<float64_t>()
+    : RandomMixin<DensePreprocessor<float64_t>>()
 {
 	init();
 	m_whitening = do_whitening;
@@ -30,7 +31,7 @@ PCA::PCA(
 }
 
 PCA::PCA(EPCAMethod method, bool do_whitening, EPCAMemoryMode mem_mode)
-    : DensePreprocessor<float64_t>()
+    : RandomMixin<DensePreprocessor<float64_t>>()
 {
 	init();
 	m_whitening = do_whitening;
@@ -51,6 +52,8 @@ void PCA::init()
 	m_method = AUTO;
 	m_eigenvalue_zero_tolerance = 1e-15;
 	m_target_dim = 1;
+	m_oversampling = 10;
+	m_power_iterations = 2;
 
 	SG_ADD(
 	    &m_transformation_matrix, "transformation_matrix",
@@ -72,6 +75,12 @@ void PCA::init()
 	SG_ADD(
 	    &m_target_dim, "target_dim", "target dimensionality of preprocessor",
 	    ParameterProperties::HYPER);
+	SG_ADD(
+	    &m_oversampling, "oversampling",
+	    "Number of additional random vectors of the randomized method.");
+	SG_ADD(
+	    &m_power_iterations, "power_iterations",
+	    "Number of power iterations of the randomized method.");
 	SG_ADD_OPTIONS(
 	    (machine_int_t*)&m_mode, "mode", "PCA Mode.",
 	    ParameterProperties::HYPER,
@@ -83,7 +92,7 @@ void PCA::init()
 	SG_ADD_OPTIONS(
 	    (machine_int_t*)&m_method, "method",
 	    "Method used for PCA calculation", ParameterProperties::NONE,
-	    SG_OPTIONS(AUTO, SVD, EVD));
+	    SG_OPTIONS(AUTO, SVD, EVD, RANDOMIZED));
 }
 
 PCA::~PCA()
@@ -124,6 +133,8 @@ void PCA::fit(std::shared_ptr<Features> features)
 
 	if (m_method == EVD)
 		init_with_evd(feature_matrix, max_dim_allowed);
+	else if (m_method == RANDOMIZED)
+		init_with_randomized(feature_matrix, max_dim_allowed);
 	else
 		init_with_svd(feature_matrix, max_dim_allowed);
 
@@ -289,6 +300,99 @@ void PCA::init_with_svd(const SGMatrix<float64_t> &feature_matrix, int32_t max_d
 	}
 }
 
+void PCA::init_with_randomized(
+    const SGMatrix<float64_t>& feature_matrix, int32_t max_dim_allowed)
+{
+	int32_t num_vectors = feature_matrix.num_cols;
+	int32_t num_features = feature_matrix.num_rows;
+	int32_t num_components =
+	    std::min(m_target_dim + m_oversampling, max_dim_allowed);
+
+	Map<MatrixXd> fmatrix(feature_matrix.matrix, num_features, num_vectors);
+
+	io::info("Computing randomized range of {} components", num_components);
+	MatrixXd basis = randomized::range_finder(
+	    num_features, num_vectors, num_components, m_power_iterations,
+	    [&fmatrix](const MatrixXd& m) -> MatrixXd { return fmatrix * m; },
+	    [&fmatrix](const MatrixXd& m) -> MatrixXd {
+		    return fmatrix.transpose() * m;
+	    },
+	    m_prng);
+
+	// eigenvectors of the projected covariance, in increasing order
+	MatrixXd projected = basis.transpose() * fmatrix;
+	MatrixXd projected_cov = projected * projected.transpose();
+	SelfAdjointEigenSolver<MatrixXd> eigenSolve(projected_cov);
+
+	m_eigenvalues_vector = SGVector<float64_t>(num_components);
+	Map<VectorXd> eigenValues(m_eigenvalues_vector.vector, num_components);
+	eigenValues = eigenSolve.eigenvalues().reverse().cwiseMax(0.0) /
+	              (num_vectors - 1);
+
+	// target dimension
+	switch (m_mode)
+	{
+		case FIXED_NUMBER:
+			num_dim = m_target_dim;
+			break;
+
+		case VARIANCE_EXPLAINED:
+		{
+			float64_t eig_sum =
+			    fmatrix.squaredNorm() / (num_vectors - 1);
+			float64_t com_sum = 0;
+			for (int32_t i = 0; i < num_components; i++)
+			{
+				num_dim++;
+				com_sum += m_eigenvalues_vector.vector[i];
+				if (com_sum / eig_sum >= m_thresh)
+					break;
+			}
+		}
+		break;
+
+		case THRESHOLD:
+			for (int32_t i = 0; i < num_components; i++)
+			{
+				if (m_eigenvalues_vector.vector[i] > m_thresh)
+					num_dim++;
+				else
+					break;
+			}
+			break;
+	};
+	io::info("Reducing from {} to {} features...", num_features, num_dim);
+
+	m_transformation_matrix = SGMatrix<float64_t>(num_features, num_dim);
+	Map<MatrixXd> transformMatrix(
+	    m_transformation_matrix.matrix, num_features, num_dim);
+	num_old_dim = num_features;
+	transformMatrix =
+	    basis * eigenSolve.eigenvectors().rowwise().reverse().leftCols(num_dim);
+
+	if (m_whitening)
+	{
+		for (int32_t i = 0; i < num_dim; i++)
+		{
+			if (Math::fequals_abs<float64_t>(
+			        0.0, eigenValues[i], m_eigenvalue_zero_tolerance))
+			{
+				io::warn(
+				    "Covariance matrix has almost zero Eigenvalue (ie "
+				    "Eigenvalue within a tolerance of {:E} around 0) at "
+				    "dimension {}. Consider reducing its dimension.",
+				    m_eigenvalue_zero_tolerance, i + 1);
+
+				transformMatrix.col(i) = MatrixXd::Zero(num_features, 1);
+				continue;
+			}
+
+			transformMatrix.col(i) /=
+			    std::sqrt(eigenValues[i] * (num_vectors - 1));
+		}
+	}
+}
+
 void PCA::cleanup()
 {
 	m_transformation_matrix=SGMatrix<float64_t>();
@@ -409,3 +513,28 @@ int32_t PCA::get_target_dim() const
 {
 	return m_target_dim;
 }
+
+void PCA::set_oversampling(int32_t oversampling)
+{
+	require(oversampling >= 0, "Oversampling ({}) must not be negative", oversampling);
+	m_oversampling = oversampling;
+}
+
+int32_t PCA::get_oversampling() const
+{
+	return m_oversampling;
+}
+
+void PCA::set_power_iterations(int32_t power_iterations)
+{
+	require(
+	    power_iterations >= 0,
+	    "Number of power iterations ({}) must not be negative",
+	    power_iterations);
+	m_power_iterations = power_iterations;
+}
+
+int32_t PCA::get_power_iterations() const
+{
+	return m_power_iterations;
+}
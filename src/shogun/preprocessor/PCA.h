@@ -13,6 +13,7 @@
 
 #include <shogun/features/Features.h>
 #include <shogun/lib/common.h>
+#include <shogun/mathematics/RandomMixin.h>
 #include <shogun/preprocessor/DensePreprocessor.h>
 
 namespace shogun
@@ -29,7 +30,12 @@ enum EPCAMethod
 	/** Eigenvalue decomposition of covariance matrix.
 	 * Time complexity ~10d^3 (d-dimensions n-number of vectors)
 	 */
-	EVD = 30
+	EVD = 30,
+	/** Randomized SVD of the data matrix, computing only the leading
+	 * components. Time complexity ~(2q+2)dnl (d-dimensions n-number of
+	 * vectors, l-target dimension plus oversampling, q-power iterations)
+	 */
+	RANDOMIZED = 40
 };
 
 /** mode of pca */
@@ -86,6 +92,16 @@ enum EPCAMemoryMode
  * <em>AUTO</em> : This mode automagically chooses one of the above modes for the user
  * based on whether N > D (chooses EVD) or N < D (chooses SVD).
  *
+ * <em>RANDOMIZED</em> : Randomized SVD of the feature matrix X
+ * (Halko et al., 2011). An orthonormal basis Q of the range of X is found from
+ * the product of X with T+p random vectors, refined by q power iterations,
+ * where p is the oversampling. The leading eigenvectors are then computed
+ * from the small matrix \f$Q^TX\f$. Only products of X with blocks of T+p
+ * vectors are formed, never the covariance matrix, so the time complexity is
+ * \f$~(2q+2)DN(T+p)\f$. In the VARIANCE_EXPLAINED and THRESHOLD modes, T is
+ * chosen among the T+p leading eigenvalues, where the initial T is the
+ * target dimension.
+ *
  * This class provides 3 modes to determine the value of T :
  *
  * <em>FIXED_NUMBER</em> : T is supplied by user directly using set_target_dims method
@@ -104,7 +120,7 @@ enum EPCAMemoryMode
  *
  * Note that vectors/matrices don't have to have zero mean as it is substracted within the class.
  */
-class PCA : public DensePreprocessor<float64_t>
+class PCA : public RandomMixin<DensePreprocessor<float64_t>>
 {
 	public:
 
@@ -113,7 +129,7 @@ class PCA : public DensePreprocessor<float64_t>
 		 * @param do_whitening normalize columns(eigenvectors) in transformation matrix
 		 * @param mode mode of pca : FIXED_NUMBER/VARIANCE_EXPLAINED/THRESHOLD
 		 * @param thresh threshold value for VARIANCE_EXPLAINED or THRESHOLD mode
-		 * @param method Matrix decomposition method used : SVD/EVD/AUTO[default]
+		 * @param method Matrix decomposition method used : SVD/EVD/RANDOMIZED/AUTO[default]
 		 * @param mem_mode memory usage mode of PCA : MEM_REALLOCATE/MEM_IN_PLACE
 		 */
 		PCA(bool do_whitening=false, EPCAMode mode=FIXED_NUMBER, float64_t thresh=1e-6,
@@ -121,7 +137,7 @@ class PCA : public DensePreprocessor<float64_t>
 
 		/** special constructor for FIXED_NUMBER mode
 		 *
-		 * @param method Matrix decomposition method used : SVD/EVD/AUTO[default]
+		 * @param method Matrix decomposition method used : SVD/EVD/RANDOMIZED/AUTO[default]
 		 * @param do_whitening normalize columns(eigenvectors) in transformation matrix
 		 * @param mem memory usage mode of PCA : MEM_REALLOCATE/MEM_IN_PLACE
 		 */
@@ -188,6 +204,28 @@ class PCA : public DensePreprocessor<float64_t>
 		 */
 		int32_t get_target_dim() const;
 
+		/** setter for the number of additional random vectors of the
+		 * RANDOMIZED method
+		 * @param oversampling oversampling
+		 */
+		void set_oversampling(int32_t oversampling);
+
+		/** getter for the oversampling of the RANDOMIZED method
+		 * @return oversampling
+		 */
+		int32_t get_oversampling() const;
+
+		/** setter for the number of power iterations of the RANDOMIZED
+		 * method
+		 * @param power_iterations number of power iterations
+		 */
+		void set_power_iterations(int32_t power_iterations);
+
+		/** getter for the number of power iterations of the RANDOMIZED method
+		 * @return number of power iterations
+		 */
+		int32_t get_power_iterations() const;
+
 	protected:
 
 		void init();
@@ -225,11 +263,19 @@ class PCA : public DensePreprocessor<float64_t>
 		/** target dimension */
 		int32_t m_target_dim;
 
+		/** oversampling of the RANDOMIZED method */
+		int32_t m_oversampling;
+
+		/** number of power iterations of the RANDOMIZED method */
+		int32_t m_power_iterations;
+
 	private:
 		/** Computes the transformation matrix using an eigenvalue decomposition. */
 		void init_with_evd(const SGMatrix<float64_t>& feature_matrix, int32_t max_dim_allowed);
 		/** Computes the transformation matrix using svd */
 		void init_with_svd(const SGMatrix<float64_t>& feature_matrix, int32_t max_dim_allowed);
+		/** Computes the transformation matrix using randomized svd */
+		void init_with_randomized(const SGMatrix<float64_t>& feature_matrix, int32_t max_dim_allowed);
 };
 }
 #endif // PCA_H_
@@ -110,6 +110,9 @@ namespace shogun
 			string_features = std::make_shared<StringFeatures<ST>>(*string_features);
 		}
 
+		// the strings are modified in place
+		if (string_features->is_packed())
+			string_features->unpack();
 		auto& string_list = string_features->get_string_list();
 
 		apply_to_string_list(string_list);
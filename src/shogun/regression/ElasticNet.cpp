@@ -0,0 +1,614 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#include <shogun/lib/config.h>
+
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/base/progress.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/SparseFeatures.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/mathematics/eigen3.h>
+#include <shogun/regression/ElasticNet.h>
+
+#include <algorithm>
+#include <cmath>
+#include <memory>
+#include <vector>
+
+using namespace Eigen;
+using namespace shogun;
+
+namespace
+{
+	/** number of features per parallel block */
+	constexpr index_t FEATURE_BLOCK = 1024;
+
+	/** Training data with one row per feature, centered implicitly by
+	 * the given means.
+	 */
+	class Design
+	{
+	public:
+		virtual ~Design() = default;
+
+		/** @return number of features */
+		index_t num_features() const
+		{
+			return m_means.size();
+		}
+
+		/** @return feature means subtracted from the data */
+		const VectorXd& means() const
+		{
+			return m_means;
+		}
+
+		/** Computes the inner products of all centered features with a
+		 * vector of values per example.
+		 */
+		virtual void correlate(const VectorXd& v, VectorXd& out) const = 0;
+
+		/** @return centered values of a feature for all examples */
+		virtual VectorXd feature(index_t j) const = 0;
+
+		/** @return squared norms of the centered features */
+		virtual VectorXd squared_norms() const = 0;
+
+	protected:
+		VectorXd m_means;
+	};
+
+	class DenseDesign : public Design
+	{
+	public:
+		DenseDesign(
+		    const std::shared_ptr<DenseFeatures<float64_t>>& features,
+		    bool center)
+		    : m_matrix(features->get_feature_matrix())
+		{
+			auto x = matrix();
+			m_means = center ? VectorXd(x.rowwise().mean())
+			                 : VectorXd::Zero(x.rows());
+		}
+
+		virtual void correlate(const VectorXd& v, VectorXd& out) const
+		{
+			auto x = matrix();
+			out.resize(x.rows());
+			float64_t sum = v.sum();
+			int64_t num_blocks = (x.rows() + FEATURE_BLOCK - 1) / FEATURE_BLOCK;
+#pragma omp parallel for num_threads(env()->get_num_threads())
+			for (int64_t b = 0; b < num_blocks; ++b)
+			{
+				index_t begin = b * FEATURE_BLOCK;
+				index_t len = std::min(FEATURE_BLOCK, index_t(x.rows()) - begin);
+				out.segment(begin, len).noalias() =
+				    x.middleRows(begin, len) * v;
+				out.segment(begin, len) -= m_means.segment(begin, len) * sum;
+			}
+		}
+
+		virtual VectorXd feature(index_t j) const
+		{
+			return matrix().row(j).transpose().array() - m_means[j];
+		}
+
+		virtual VectorXd squared_norms() const
+		{
+			auto x = matrix();
+			VectorXd norms(x.rows());
+#pragma omp parallel for num_threads(env()->get_num_threads())
+			for (index_t j = 0; j < x.rows(); ++j)
+				norms[j] = (x.row(j).array() - m_means[j]).square().sum();
+			return norms;
+		}
+
+	private:
+		Map<const MatrixXd> matrix() const
+		{
+			return Map<const MatrixXd>(
+			    m_matrix.matrix, m_matrix.num_rows, m_matrix.num_cols);
+		}
+
+		SGMatrix<float64_t> m_matrix;
+	};
+
+	class SparseDesign : public Design
+	{
+	public:
+		SparseDesign(
+		    const std::shared_ptr<SparseFeatures<float64_t>>& features,
+		    bool center)
+		    : m_num_vectors(features->get_num_vectors())
+		{
+			index_t num_features = features->get_num_features();
+
+			// transpose to one row per feature
+			m_offsets.assign(num_features + 1, 0);
+			for (index_t i = 0; i < m_num_vectors; ++i)
+			{
+				auto sv = features->get_sparse_feature_vector(i);
+				for (index_t k = 0; k < sv.num_feat_entries; ++k)
+					m_offsets[sv.features[k].feat_index + 1]++;
+				features->free_sparse_feature_vector(i);
+			}
+			for (index_t j = 0; j < num_features; ++j)
+				m_offsets[j + 1] += m_offsets[j];
+
+			m_indices.resize(m_offsets.back());
+			m_values.resize(m_offsets.back());
+			std::vector<int64_t> next(m_offsets.begin(), m_offsets.end() - 1);
+			for (index_t i = 0; i < m_num_vectors; ++i)
+			{
+				auto sv = features->get_sparse_feature_vector(i);
+				for (index_t k = 0; k < sv.num_feat_entries; ++k)
+				{
+					auto pos = next[sv.features[k].feat_index]++;
+					m_indices[pos] = i;
+					m_values[pos] = sv.features[k].entry;
+				}
+				features->free_sparse_feature_vector(i);
+			}
+
+			m_means = VectorXd::Zero(num_features);
+			if (center)
+			{
+				for (index_t j = 0; j < num_features; ++j)
+				{
+					for (auto k = m_offsets[j]; k < m_offsets[j + 1]; ++k)
+						m_means[j] += m_values[k];
+				}
+				m_means /= m_num_vectors;
+			}
+		}
+
+		virtual void correlate(const VectorXd& v, VectorXd& out) const
+		{
+			index_t num_features = m_means.size();
+			out.resize(num_features);
+			float64_t sum = v.sum();
+#pragma omp parallel for num_threads(env()->get_num_threads())
+			for (index_t j = 0; j < num_features; ++j)
+			{
+				float64_t dot = 0;
+				for (auto k = m_offsets[j]; k < m_offsets[j + 1]; ++k)
+					dot += m_values[k] * v[m_indices[k]];
+				out[j] = dot - m_means[j] * sum;
+			}
+		}
+
+		virtual VectorXd feature(index_t j) const
+		{
+			VectorXd x = VectorXd::Constant(m_num_vectors, -m_means[j]);
+			for (auto k = m_offsets[j]; k < m_offsets[j + 1]; ++k)
+				x[m_indices[k]] += m_values[k];
+			return x;
+		}
+
+		virtual VectorXd squared_norms() const
+		{
+			index_t num_features = m_means.size();
+			VectorXd norms(num_features);
+#pragma omp parallel for num_threads(env()->get_num_threads())
+			for (index_t j = 0; j < num_features; ++j)
+			{
+				float64_t mean = m_means[j];
+				int64_t nnz = m_offsets[j + 1] - m_offsets[j];
+				float64_t norm = (m_num_vectors - nnz) * mean * mean;
+				for (auto k = m_offsets[j]; k < m_offsets[j + 1]; ++k)
+					norm += (m_values[k] - mean) * (m_values[k] - mean);
+				norms[j] = norm;
+			}
+			return norms;
+		}
+
+	private:
+		index_t m_num_vectors;
+		std::vector<int64_t> m_offsets;
+		std::vector<index_t> m_indices;
+		std::vector<float64_t> m_values;
+	};
+
+	float64_t soft_threshold(float64_t x, float64_t t)
+	{
+		return x > t ? x - t : (x < -t ? x + t : 0);
+	}
+
+	/** Coordinate descent with covariance updates, keeping the weights of
+	 * the last solution to warm start the next one.
+	 *
+	 * All quantities are scaled by the number of examples N, so the
+	 * gradient of feature j is z_j = x_j'r for the residual r, and the
+	 * penalties are N times the ones of the objective.
+	 */
+	class CoordinateDescent
+	{
+	public:
+		CoordinateDescent(const Design& design, const VectorXd& y)
+		    : m_design(design), m_num_vectors(y.size()),
+		      m_yy(y.squaredNorm()),
+		      m_gram_index(design.num_features(), -1),
+		      m_w(VectorXd::Zero(design.num_features()))
+		{
+			design.correlate(y, m_c);
+			m_q = design.squared_norms();
+		}
+
+		/** @return smallest lambda for which all weights are zero */
+		float64_t lambda_max(float64_t l1_ratio) const
+		{
+			return m_c.lpNorm<Infinity>() / (m_num_vectors * l1_ratio);
+		}
+
+		const VectorXd& weights() const
+		{
+			return m_w;
+		}
+
+		/** Solves for lambda, starting from the solution for
+		 * previous_lambda.
+		 *
+		 * @return number of sweeps, max_iter if not converged
+		 */
+		int32_t solve(
+		    float64_t lambda, float64_t previous_lambda, float64_t l1_ratio,
+		    float64_t epsilon, int32_t max_iter)
+		{
+			const index_t num_features = m_design.num_features();
+			const float64_t l1 = m_num_vectors * lambda * l1_ratio;
+			const float64_t l2 = m_num_vectors * lambda * (1 - l1_ratio);
+			const float64_t tolerance = epsilon * 0.5 * m_yy;
+
+			std::vector<char> screened(num_features, 0);
+			std::vector<char> working(num_features, 0);
+			VectorXd z;
+			gradient(z);
+			float64_t scale;
+			float64_t gap = duality_gap(z, l1, l2, scale);
+			screen(z, l2, gap, l1, scale, screened);
+
+			// sequential strong rule
+			const float64_t strong =
+			    m_num_vectors * l1_ratio * (2 * lambda - previous_lambda);
+#pragma omp parallel for num_threads(env()->get_num_threads())
+			for (index_t j = 0; j < num_features; ++j)
+				working[j] = !screened[j] &&
+				             (m_w[j] != 0 || std::abs(z[j]) >= strong);
+			std::vector<index_t> working_set;
+			for (index_t j = 0; j < num_features; ++j)
+			{
+				if (working[j])
+					working_set.push_back(j);
+			}
+
+			int32_t iter = 0;
+			for (; iter < max_iter; ++iter)
+			{
+				// z is only kept up to date on the working set
+				float64_t max_change = 0;
+				for (auto j : working_set)
+				{
+					float64_t w_old = m_w[j];
+					float64_t w_new =
+					    soft_threshold(z[j] + m_q[j] * w_old, l1) /
+					    (m_q[j] + l2);
+					float64_t delta = w_new - w_old;
+					if (delta == 0)
+						continue;
+
+					const auto& gram_j = gram(j);
+					for (auto k : working_set)
+						z[k] -= gram_j[k] * delta;
+					m_w[j] = w_new;
+					max_change =
+					    std::max(max_change, m_q[j] * delta * delta);
+				}
+
+				if (max_change >= tolerance && (iter + 1) % 10 != 0)
+					continue;
+
+				// check the optimality conditions of the other features
+				gradient(z);
+#pragma omp parallel for num_threads(env()->get_num_threads())
+				for (index_t j = 0; j < num_features; ++j)
+				{
+					if (!working[j] && !screened[j] && std::abs(z[j]) > l1)
+						working[j] = 2;
+				}
+				bool violated = false;
+				for (index_t j = 0; j < num_features; ++j)
+				{
+					if (working[j] == 2)
+					{
+						working[j] = 1;
+						working_set.push_back(j);
+						violated = true;
+					}
+				}
+				if (violated)
+					continue;
+
+				gap = duality_gap(z, l1, l2, scale);
+				if (gap <= tolerance)
+					break;
+
+				screen(z, l2, gap, l1, scale, screened);
+				working_set.erase(
+				    std::remove_if(
+				        working_set.begin(), working_set.end(),
+				        [&screened](index_t j) { return screened[j]; }),
+				    working_set.end());
+				for (index_t j = 0; j < num_features; ++j)
+					working[j] = working[j] && !screened[j];
+			}
+			return iter;
+		}
+
+	private:
+		/** @return inner products of feature j with all features */
+		const VectorXd& gram(index_t j)
+		{
+			if (m_gram_index[j] < 0)
+			{
+				m_gram_index[j] = m_gram.size();
+				m_gram.emplace_back();
+				m_design.correlate(m_design.feature(j), m_gram.back());
+			}
+			return m_gram[m_gram_index[j]];
+		}
+
+		/** Computes the gradient z = c - Gw of all features. */
+		void gradient(VectorXd& z)
+		{
+			std::vector<index_t> active;
+			for (index_t j = 0; j < m_w.size(); ++j)
+			{
+				if (m_w[j] != 0)
+				{
+					gram(j);
+					active.push_back(j);
+				}
+			}
+
+			z = m_c;
+			int64_t num_blocks = (z.size() + FEATURE_BLOCK - 1) / FEATURE_BLOCK;
+#pragma omp parallel for num_threads(env()->get_num_threads())
+			for (int64_t b = 0; b < num_blocks; ++b)
+			{
+				index_t begin = b * FEATURE_BLOCK;
+				index_t len = std::min(FEATURE_BLOCK, index_t(z.size()) - begin);
+				for (auto k : active)
+					z.segment(begin, len) -=
+					    m_w[k] * m_gram[m_gram_index[k]].segment(begin, len);
+			}
+		}
+
+		/** Computes the duality gap of the Elastic-Net written as a Lasso
+		 * on the data augmented with sqrt(l2) times the identity.
+		 *
+		 * @param scale set to the scale of the residual that gives the
+		 * dual feasible point
+		 */
+		float64_t duality_gap(
+		    const VectorXd& z, float64_t l1, float64_t l2,
+		    float64_t& scale) const
+		{
+			float64_t wc = m_w.dot(m_c);
+			float64_t ww = m_w.squaredNorm();
+			float64_t rr = m_yy - wc - m_w.dot(z);
+			float64_t primal = 0.5 * (rr + l2 * ww) + l1 * m_w.lpNorm<1>();
+
+			float64_t dual_norm = (z - l2 * m_w).lpNorm<Infinity>();
+			scale = 1.0 / std::max(l1, dual_norm);
+			float64_t t = l1 * scale;
+			float64_t dual = t * (m_yy - wc) - 0.5 * t * t * (rr + l2 * ww);
+			return primal - dual;
+		}
+
+		/** Marks the zero weights that are zero at the optimum by the gap
+		 * safe rule.
+		 */
+		void screen(
+		    const VectorXd& z, float64_t l2, float64_t gap, float64_t l1,
+		    float64_t scale, std::vector<char>& screened) const
+		{
+			float64_t radius = std::sqrt(2 * std::max(gap, 0.0)) / l1;
+#pragma omp parallel for num_threads(env()->get_num_threads())
+			for (index_t j = 0; j < m_w.size(); ++j)
+			{
+				if (m_w[j] == 0 &&
+				    std::abs(z[j]) * scale + radius * std::sqrt(m_q[j] + l2) <
+				        1)
+					screened[j] = 1;
+			}
+		}
+
+		const Design& m_design;
+		const index_t m_num_vectors;
+		const float64_t m_yy;
+		/** inner products of the features with the labels */
+		VectorXd m_c;
+		/** squared norms of the features */
+		VectorXd m_q;
+		/** position of the gram column of every feature, -1 if none */
+		std::vector<int32_t> m_gram_index;
+		std::vector<VectorXd> m_gram;
+		VectorXd m_w;
+	};
+} // namespace
+
+ElasticNet::ElasticNet() : LinearMachine()
+{
+	init();
+}
+
+ElasticNet::ElasticNet(float64_t lambda, float64_t l1_ratio) : LinearMachine()
+{
+	init();
+	set_lambda(lambda);
+	set_l1_ratio(l1_ratio);
+}
+
+ElasticNet::~ElasticNet()
+{
+}
+
+void ElasticNet::init()
+{
+	m_lambda = 1.0;
+	m_l1_ratio = 1.0;
+	m_num_lambdas = 100;
+	m_max_iter = 1000;
+	m_epsilon = 1e-7;
+	m_use_bias = true;
+
+	SG_ADD(&m_lambda, "lambda", "Regularization constant",
+	    ParameterProperties::HYPER);
+	SG_ADD(&m_l1_ratio, "l1_ratio", "Fraction of the l1 penalty",
+	    ParameterProperties::HYPER);
+	SG_ADD(&m_num_lambdas, "num_lambdas",
+	    "Number of regularization constants on the path");
+	SG_ADD(&m_max_iter, "max_iter",
+	    "Maximum number of sweeps per regularization constant");
+	SG_ADD(&m_epsilon, "epsilon", "Relative duality gap for convergence");
+	SG_ADD(&m_use_bias, "use_bias", "Whether or not to fit an offset term",
+	    ParameterProperties::SETTING);
+	watch_method("path_size", &ElasticNet::get_path_size);
+}
+
+void ElasticNet::set_lambda(float64_t lambda)
+{
+	require(lambda > 0, "Lambda ({}) must be positive", lambda);
+	m_lambda = lambda;
+}
+
+void ElasticNet::set_l1_ratio(float64_t l1_ratio)
+{
+	require(
+	    l1_ratio > 0 && l1_ratio <= 1, "L1 ratio ({}) must be in (0, 1]",
+	    l1_ratio);
+	m_l1_ratio = l1_ratio;
+}
+
+void ElasticNet::set_num_lambdas(int32_t num_lambdas)
+{
+	require(
+	    num_lambdas > 0, "Number of lambdas ({}) must be positive",
+	    num_lambdas);
+	m_num_lambdas = num_lambdas;
+}
+
+float64_t ElasticNet::get_path_lambda(int32_t i) const
+{
+	require(
+	    i >= 0 && i < get_path_size(), "Path index {} out of range [0, {})",
+	    i, get_path_size());
+	return m_path_lambdas[i];
+}
+
+SGVector<float64_t> ElasticNet::get_path_w(int32_t i) const
+{
+	require(
+	    i >= 0 && i < get_path_size(), "Path index {} out of range [0, {})",
+	    i, get_path_size());
+	SGVector<float64_t> w(m_w.vlen);
+	w.zero();
+	const auto& path_w = m_path_w[i];
+	for (index_t k = 0; k < path_w.num_feat_entries; ++k)
+		w[path_w.features[k].feat_index] = path_w.features[k].entry;
+	return w;
+}
+
+void ElasticNet::switch_w(int32_t i)
+{
+	set_w(get_path_w(i));
+	set_bias(m_path_bias[i]);
+}
+
+bool ElasticNet::train_machine(std::shared_ptr<Features> data)
+{
+	if (data)
+		set_features(data->as<DotFeatures>());
+
+	require(features, "No features provided");
+	require(
+	    m_labels && m_labels->get_label_type() == LT_REGRESSION,
+	    "Regression labels required");
+	require(
+	    features->get_feature_type() == F_DREAL,
+	    "Features of type {} are not supported",
+	    (int32_t)features->get_feature_type());
+
+	std::unique_ptr<Design> design;
+	if (features->get_feature_class() == C_DENSE)
+		design = std::make_unique<DenseDesign>(
+		    features->as<DenseFeatures<float64_t>>(), m_use_bias);
+	else if (features->get_feature_class() == C_SPARSE)
+		design = std::make_unique<SparseDesign>(
+		    features->as<SparseFeatures<float64_t>>(), m_use_bias);
+	else
+		error("Training with {} is not implemented!", features->get_name());
+
+	auto labels = regression_labels(m_labels)->get_labels();
+	VectorXd y = Map<VectorXd>(labels.vector, labels.vlen);
+	float64_t y_mean = m_use_bias ? y.mean() : 0;
+	y.array() -= y_mean;
+
+	CoordinateDescent solver(*design, y);
+
+	// geometric path from the largest lambda with non-zero weights
+	float64_t lambda_max = solver.lambda_max(m_l1_ratio);
+	int32_t num_lambdas = m_lambda < lambda_max ? m_num_lambdas : 1;
+	m_path_lambdas = SGVector<float64_t>(num_lambdas);
+	m_path_bias = SGVector<float64_t>(num_lambdas);
+	m_path_w.clear();
+	for (auto k : range(num_lambdas))
+	{
+		m_path_lambdas[k] = num_lambdas == 1
+		                        ? m_lambda
+		                        : lambda_max * std::pow(
+		                                           m_lambda / lambda_max,
+		                                           float64_t(k) /
+		                                               (num_lambdas - 1));
+	}
+
+	float64_t previous_lambda = lambda_max;
+	auto pb = SG_PROGRESS(range(num_lambdas));
+	for (auto k : range(num_lambdas))
+	{
+		auto num_iter = solver.solve(
+		    m_path_lambdas[k], previous_lambda, m_l1_ratio, m_epsilon,
+		    m_max_iter);
+		if (num_iter == m_max_iter)
+			io::warn(
+			    "ElasticNet did not converge within {} sweeps for lambda "
+			    "{}",
+			    m_max_iter, m_path_lambdas[k]);
+		previous_lambda = m_path_lambdas[k];
+
+		const auto& w = solver.weights();
+		SGSparseVector<float64_t> path_w((w.array() != 0).count());
+		index_t nnz = 0;
+		for (index_t j = 0; j < w.size(); ++j)
+		{
+			if (w[j] != 0)
+			{
+				path_w.features[nnz].feat_index = j;
+				path_w.features[nnz].entry = w[j];
+				nnz++;
+			}
+		}
+		m_path_w.push_back(path_w);
+		m_path_bias[k] = y_mean - w.dot(design->means());
+		pb.print_progress();
+	}
+	pb.complete();
+
+	m_w = SGVector<float64_t>(design->num_features());
+	switch_w(num_lambdas - 1);
+
+	return true;
+}
@@ -0,0 +1,189 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+#ifndef ELASTICNET_H__
+#define ELASTICNET_H__
+
+#include <shogun/lib/config.h>
+
+#include <shogun/lib/SGSparseVector.h>
+#include <shogun/machine/LinearMachine.h>
+
+#include <vector>
+
+namespace shogun
+{
+
+/** @brief Elastic-Net and Lasso regression by coordinate descent, on
+ * DenseFeatures<float64_t> or SparseFeatures<float64_t>.
+ *
+ * Minimizes
+ *
+ * \f[
+ * \frac{1}{2N}\|y - X^\top w - b\|^2
+ * + \lambda\alpha\|w\|_1 + \frac{\lambda(1-\alpha)}{2}\|w\|^2
+ * \f]
+ *
+ * where \f$\alpha\f$ is the l1 ratio, 1 for the Lasso. The solution is
+ * computed on a path of geometrically decreasing \f$\lambda\f$ from the
+ * smallest one with all weights zero down to the requested one, each
+ * solution warm starting the next one. All solutions of the path are kept,
+ * see switch_w().
+ *
+ * Coordinate descent uses covariance updates: the inner products of every
+ * feature with every feature that is ever non-zero are computed once, in
+ * parallel over features, so a sweep only touches the features in the
+ * working set and never the data. The working set is chosen with the
+ * sequential strong rule and checked for violations of the optimality
+ * conditions. Features are discarded for good with the gap safe rule, which
+ * also bounds the duality gap used as stopping criterion.
+ *
+ * Features are centered implicitly when a bias is fit, so sparse features
+ * stay sparse. They are not standardized, so the penalty applies to the
+ * weights of features at their given scale.
+ *
+ * @code
+ * @article{friedman2010regularization,
+ *   title={Regularization paths for generalized linear models via
+ *          coordinate descent},
+ *   author={Friedman, J. and Hastie, T. and Tibshirani, R.},
+ *   journal={Journal of Statistical Software},
+ *   volume={33},
+ *   number={1},
+ *   year={2010}
+ * }
+ * @article{ndiaye2017gap,
+ *   title={Gap safe screening rules for sparsity enforcing penalties},
+ *   author={Ndiaye, E. and Fercoq, O. and Gramfort, A. and Salmon, J.},
+ *   journal={Journal of Machine Learning Research},
+ *   volume={18},
+ *   number={128},
+ *   year={2017}
+ * }
+ * @endcode
+ */
+class ElasticNet : public LinearMachine
+{
+public:
+	/** problem type */
+	MACHINE_PROBLEM_TYPE(PT_REGRESSION);
+
+	/** default constructor */
+	ElasticNet();
+
+	/** constructor
+	 *
+	 * @param lambda regularization constant
+	 * @param l1_ratio fraction of the l1 penalty, in (0, 1]
+	 */
+	ElasticNet(float64_t lambda, float64_t l1_ratio);
+
+	virtual ~ElasticNet();
+
+	/** @param lambda regularization constant */
+	void set_lambda(float64_t lambda);
+
+	/** @return regularization constant */
+	float64_t get_lambda() const
+	{
+		return m_lambda;
+	}
+
+	/** @param l1_ratio fraction of the l1 penalty, in (0, 1] */
+	void set_l1_ratio(float64_t l1_ratio);
+
+	/** @return fraction of the l1 penalty */
+	float64_t get_l1_ratio() const
+	{
+		return m_l1_ratio;
+	}
+
+	/** @param num_lambdas number of regularization constants on the path,
+	 * 1 to solve for the requested one only
+	 */
+	void set_num_lambdas(int32_t num_lambdas);
+
+	/** @return size of the regularization path of the last training */
+	int32_t get_path_size() const
+	{
+		return m_path_lambdas.vlen;
+	}
+
+	/** @return regularization constant of the i-th solution on the path
+	 *
+	 * @param i index on the path
+	 */
+	float64_t get_path_lambda(int32_t i) const;
+
+	/** @return weights of the i-th solution on the path
+	 *
+	 * @param i index on the path
+	 */
+	SGVector<float64_t> get_path_w(int32_t i) const;
+
+	/** Sets weights and bias to the i-th solution on the path.
+	 *
+	 * @param i index on the path
+	 */
+	void switch_w(int32_t i);
+
+	/** get classifier type
+	 *
+	 * @return classifier type ElasticNet
+	 */
+	virtual EMachineType get_classifier_type()
+	{
+		return CT_ELASTICNET;
+	}
+
+	/** @return object name */
+	virtual const char* get_name() const
+	{
+		return "ElasticNet";
+	}
+
+protected:
+	/** train on DenseFeatures<float64_t> or SparseFeatures<float64_t>
+	 *
+	 * @param data training data
+	 * @return whether training was successful
+	 */
+	virtual bool train_machine(std::shared_ptr<Features> data = NULL);
+
+private:
+	void init();
+
+protected:
+	/** regularization constant */
+	float64_t m_lambda;
+
+	/** fraction of the l1 penalty */
+	float64_t m_l1_ratio;
+
+	/** number of regularization constants on the path */
+	int32_t m_num_lambdas;
+
+	/** maximum number of sweeps per regularization constant */
+	int32_t m_max_iter;
+
+	/** duality gap relative to the objective of zero weights at which
+	 * a solution is accepted
+	 */
+	float64_t m_epsilon;
+
+	/** whether to fit a bias */
+	bool m_use_bias;
+
+	/** regularization constants of the path */
+	SGVector<float64_t> m_path_lambdas;
+
+	/** weights of the solutions on the path */
+	std::vector<SGSparseVector<float64_t>> m_path_w;
+
+	/** biases of the solutions on the path */
+	SGVector<float64_t> m_path_bias;
+};
+} // namespace shogun
+
+#endif // ELASTICNET_H__
@@ -5,24 +5,88 @@
  */
 
 #include <algorithm>
-#include <functional>
+#include <cmath>
+#include <limits>
 #include <numeric>
 #include <shogun/io/SGIO.h>
+#include <shogun/mathematics/eigen3.h>
 #include <shogun/structure/BeliefPropagation.h>
 #include <stack>
 #include <utility>
 
 using namespace shogun;
+using namespace Eigen;
+
+namespace
+{
+	/** adds a message along a variable to a table, which is a sequence of
+	 * stride x card blocks with the states of the variable in the columns
+	 */
+	void add_message(
+		float64_t* table, int32_t size, int32_t stride, int32_t card,
+		const float64_t* msg)
+	{
+		if (stride == 1)
+		{
+			Map<MatrixXd>(table, card, size / card).colwise() +=
+				Map<const VectorXd>(msg, card);
+			return;
+		}
+
+		Map<const RowVectorXd> m(msg, card);
+		for (int32_t bi = 0; bi < size; bi += stride * card)
+			Map<MatrixXd>(table + bi, stride, card).rowwise() += m;
+	}
+
+	/** minimizes a table over all variables but one, see add_message() */
+	void min_message(
+		const float64_t* table, int32_t size, int32_t stride, int32_t card,
+		float64_t* msg)
+	{
+		if (stride == 1)
+		{
+			Map<VectorXd>(msg, card) =
+				Map<const MatrixXd>(table, card, size / card).rowwise().minCoeff();
+			return;
+		}
+
+		Map<RowVectorXd> m(msg, card);
+		m.setConstant(std::numeric_limits<float64_t>::infinity());
+		for (int32_t bi = 0; bi < size; bi += stride * card)
+			m = m.cwiseMin(
+				Map<const MatrixXd>(table + bi, stride, card).colwise().minCoeff());
+	}
+
+	/** shifts a message to a minimum of zero, which leaves the minimizers
+	 * unchanged and keeps repeatedly summed messages bounded
+	 */
+	void normalize_message(float64_t* msg, int32_t card)
+	{
+		Map<VectorXd> m(msg, card);
+		float64_t min = m.minCoeff();
+		if (std::isfinite(min))
+			m.array() -= min;
+	}
+
+	/** @return first state of minimum belief */
+	int32_t argmin(const float64_t* belief, int32_t card)
+	{
+		return static_cast<int32_t>(std::min_element(belief, belief + card) - belief);
+	}
+}
 
 BeliefPropagation::BeliefPropagation()
 	: MAPInferImpl()
 {
 	unstable(SOURCE_LOCATION);
+
+	m_map_energy = 0;
 }
 
 BeliefPropagation::BeliefPropagation(std::shared_ptr<FactorGraph> fg)
 	: MAPInferImpl(std::move(fg))
 {
+	m_map_energy = 0;
 }
 
 BeliefPropagation::~BeliefPropagation()
@@ -35,78 +99,185 @@ float64_t BeliefPropagation::inference(SGVector<int32_t> assignment)
 	return 0;
 }
 
-// -----------------------------------------------------------------
-
-TreeMaxProduct::TreeMaxProduct()
-	: BeliefPropagation()
+void BeliefPropagation::compile()
 {
-	unstable(SOURCE_LOCATION);
+	m_compiled_fg = m_fg;
+	m_factors = m_fg->get_factors();
+	SGVector<int32_t> cards = m_fg->get_cardinalities();
+	m_cards.assign(cards.begin(), cards.end());
+
+	int32_t num_vars = m_cards.size();
+	int32_t num_facs = m_factors.size();
+
+	// edges of each factor, in the order of its variables, which is the
+	// order of the strides in its energy table
+	m_fac_edges.assign(1, 0);
+	m_edge_var.clear();
+	m_edge_fac.clear();
+	m_edge_stride.clear();
+	m_msg_offsets.assign(1, 0);
+	m_energy_offsets.assign(1, 0);
+	int32_t max_size = 0;
+	for (int32_t fi = 0; fi < num_facs; fi++)
+	{
+		SGVector<int32_t> vars = m_factors[fi]->get_variables();
+		int32_t stride = 1;
+		for (int32_t vi = 0; vi < vars.size(); vi++)
+		{
+			m_edge_var.push_back(vars[vi]);
+			m_edge_fac.push_back(fi);
+			m_edge_stride.push_back(stride);
+			m_msg_offsets.push_back(m_msg_offsets.back() + m_cards[vars[vi]]);
+			stride *= m_cards[vars[vi]];
+		}
+		m_fac_edges.push_back(m_edge_var.size());
+		m_energy_offsets.push_back(m_energy_offsets.back() + stride);
+		max_size = std::max(max_size, stride);
+	}
 
-	init();
+	// edges of each variable, in the order of the factors
+	int32_t num_edges = m_edge_var.size();
+	m_var_edges_begin.assign(num_vars + 1, 0);
+	for (int32_t ei = 0; ei < num_edges; ei++)
+		m_var_edges_begin[m_edge_var[ei] + 1]++;
+	std::partial_sum(m_var_edges_begin.begin(), m_var_edges_begin.end(),
+		m_var_edges_begin.begin());
+
+	m_var_edges.resize(num_edges);
+	std::vector<int32_t> next(m_var_edges_begin.begin(), m_var_edges_begin.end() - 1);
+	for (int32_t ei = 0; ei < num_edges; ei++)
+		m_var_edges[next[m_edge_var[ei]]++] = ei;
+
+	m_energies.resize(m_energy_offsets.back());
+	m_table.resize(max_size);
 }
 
-TreeMaxProduct::TreeMaxProduct(std::shared_ptr<FactorGraph> fg)
-	: BeliefPropagation(std::move(fg))
+bool BeliefPropagation::is_compiled_stale() const
 {
-	ASSERT(m_fg != NULL);
+	if (m_compiled_fg != m_fg)
+		return true;
 
-	init();
+	SGVector<int32_t> cards = m_fg->get_cardinalities();
+	if (!std::equal(cards.begin(), cards.end(), m_cards.begin(), m_cards.end()))
+		return true;
 
-	auto dset = m_fg->get_disjoint_set();
-	bool is_connected = dset->get_connected();
+	std::vector<std::shared_ptr<Factor>> factors = m_fg->get_factors();
+	if (factors != m_factors)
+		return true;
 
+	// the variables and cardinalities of a factor can be changed in place
+	for (uint32_t fi = 0; fi < m_factors.size(); fi++)
+	{
+		SGVector<int32_t> vars = m_factors[fi]->get_variables();
+		SGVector<int32_t> fac_cards = m_factors[fi]->get_cardinalities();
+		if (vars.size() != m_fac_edges[fi + 1] - m_fac_edges[fi])
+			return true;
 
-	if (!is_connected)
-		m_fg->connect_components();
+		for (int32_t vi = 0; vi < vars.size(); vi++)
+		{
+			int32_t ei = m_fac_edges[fi] + vi;
+			if (vars[vi] != m_edge_var[ei] || fac_cards[vi] != m_cards[vars[vi]])
+				return true;
+		}
+	}
 
-	get_message_order(m_msg_order, m_is_root);
+	return false;
+}
+
+void BeliefPropagation::load_energies()
+{
+	if (is_compiled_stale())
+		compile();
 
-	// calculate lookup tables for forward messages
-	// a key is unique because a tree has only one root
-	// a var or a factor has only one edge towards root
-	for (uint32_t mi = 0; mi < m_msg_order.size(); mi++)
+	for (uint32_t fi = 0; fi < m_factors.size(); fi++)
 	{
-		if (m_msg_order[mi]->mtype == VAR_TO_FAC) // var_to_factor
-		{
-			// <var_id, msg_id>
-			m_msg_map_var[m_msg_order[mi]->child] = mi;
-		}
-		else // factor_to_var
-		{
-			// <fac_id, msg_id>
-			m_msg_map_fac[m_msg_order[mi]->child] = mi;
-			// collect incoming msgs for each var_id
-			m_msgset_map_var[m_msg_order[mi]->parent].insert(mi);
-		}
+		SGVector<float64_t> energies = m_factors[fi]->get_energies();
+		ASSERT(energies.size() == m_energy_offsets[fi + 1] - m_energy_offsets[fi]);
+		std::copy(energies.begin(), energies.end(),
+			m_energies.begin() + m_energy_offsets[fi]);
 	}
+}
+
+void BeliefPropagation::collect_messages(int32_t fac_id, int32_t skip_edge,
+	const std::vector<float64_t>& var_msgs)
+{
+	int32_t size = m_energy_offsets[fac_id + 1] - m_energy_offsets[fac_id];
+	std::copy_n(m_energies.begin() + m_energy_offsets[fac_id], size, m_table.begin());
 
+	for (int32_t ei = m_fac_edges[fac_id]; ei < m_fac_edges[fac_id + 1]; ei++)
+	{
+		if (ei == skip_edge)
+			continue;
+
+		add_message(m_table.data(), size, m_edge_stride[ei],
+			m_cards[m_edge_var[ei]], var_msgs.data() + m_msg_offsets[ei]);
+	}
 }
 
-TreeMaxProduct::~TreeMaxProduct()
+void BeliefPropagation::factor_to_var(int32_t edge,
+	const std::vector<float64_t>& var_msgs, float64_t* msg)
+{
+	// r_f2v = min(fenrg + sum_{j!=var_id} q_v2f[adj_var_state]), read
+	// Eq.(3.20) on [Nowozin et al. 2011] for the max-product form
+	int32_t fac_id = m_edge_fac[edge];
+	collect_messages(fac_id, edge, var_msgs);
+	min_message(m_table.data(),
+		m_energy_offsets[fac_id + 1] - m_energy_offsets[fac_id],
+		m_edge_stride[edge], m_cards[m_edge_var[edge]], msg);
+}
+
+float64_t BeliefPropagation::evaluate_energy(const SGVector<int32_t>& assignment) const
 {
-	if (!m_msg_order.empty())
+	float64_t energy = 0;
+	for (uint32_t fi = 0; fi < m_factors.size(); fi++)
 	{
-		for (std::vector<MessageEdge*>::iterator it = m_msg_order.begin(); it != m_msg_order.end(); ++it)
-			delete *it;
+		int32_t index = 0;
+		for (int32_t ei = m_fac_edges[fi]; ei < m_fac_edges[fi + 1]; ei++)
+			index += assignment[m_edge_var[ei]] * m_edge_stride[ei];
+
+		energy += m_energies[m_energy_offsets[fi] + index];
 	}
+
+	return energy;
 }
 
-void TreeMaxProduct::init()
+// -----------------------------------------------------------------
+
+TreeMaxProduct::TreeMaxProduct()
+	: BeliefPropagation()
 {
-	m_msg_order = std::vector<MessageEdge*>(m_fg->get_num_edges(), (MessageEdge*) NULL);
-	m_is_root = std::vector<bool>(m_fg->get_cardinalities().size(), false);
-	m_fw_msgs = std::vector< std::vector<float64_t> >(m_msg_order.size(),
-			std::vector<float64_t>());
-	m_bw_msgs = std::vector< std::vector<float64_t> >(m_msg_order.size(),
-			std::vector<float64_t>());
-	m_states = std::vector<int32_t>(m_fg->get_cardinalities().size(), 0);
-
-	m_msg_map_var = msg_map_type();
-	m_msg_map_fac = msg_map_type();
-	m_msgset_map_var = msgset_map_type();
+	unstable(SOURCE_LOCATION);
 }
 
-void TreeMaxProduct::get_message_order(std::vector<MessageEdge*>& order,
+TreeMaxProduct::TreeMaxProduct(std::shared_ptr<FactorGraph> fg)
+	: BeliefPropagation(std::move(fg))
+{
+	ASSERT(m_fg != NULL);
+
+	compile();
+}
+
+TreeMaxProduct::~TreeMaxProduct()
+{
+}
+
+void TreeMaxProduct::compile()
+{
+	auto dset = m_fg->get_disjoint_set();
+	if (!dset->get_connected())
+		m_fg->connect_components();
+
+	BeliefPropagation::compile();
+
+	get_message_order(m_msg_order, m_is_root);
+
+	m_fac_msgs.resize(m_msg_offsets.back());
+	m_var_msgs.resize(m_msg_offsets.back());
+	m_belief.resize(m_cards.empty() ? 0 : *std::max_element(m_cards.begin(), m_cards.end()));
+	m_states.resize(m_cards.size());
+}
+
+void TreeMaxProduct::get_message_order(std::vector<MessageEdge>& order,
 	std::vector<bool>& is_root) const
 {
 	ASSERT(m_fg->is_acyclic_graph());
@@ -118,90 +289,65 @@ void TreeMaxProduct::get_message_order(std::vector<MessageEdge*>& order,
 		error("{}::get_root_indicators(): run connect_components() first!", get_name());
 	}
 
-	int32_t num_vars = m_fg->get_cardinalities().size();
-	if (is_root.size() != (uint32_t)num_vars)
-		is_root.resize(num_vars);
-
-	std::fill(is_root.begin(), is_root.end(), false);
+	int32_t num_vars = m_cards.size();
+	is_root.assign(num_vars, false);
 
 	for (int32_t vi = 0; vi < num_vars; vi++)
 		is_root[dset->find_set(vi)] = true;
 
-
 	ASSERT(std::accumulate(is_root.begin(), is_root.end(), 0) >= 1);
 
-	// 2) caculate message order
-	// <var_id, fac_id>
-	var_factor_map_type vf_map;
-	auto facs = m_fg->get_factors();
-
-	for (int32_t fi = 0; fi < facs.size(); fi++)
-	{
-		auto& fac = facs[fi];
-		SGVector<int32_t> vars = fac->get_variables();
-		for (int32_t vi = 0; vi < vars.size(); vi++)
-			vf_map.insert(var_factor_map_type::value_type(vars[vi], fi));
-
-
-	}
-
-	std::stack<GraphNode*> node_stack;
-	// init node_stack with root nodes
-	for (uint32_t ni = 0; ni < is_root.size(); ni++)
+	// 2) caculate message order, by a depth first search from the roots
+	// over the compiled edges
+	std::stack<GraphNode> node_stack;
+	for (int32_t ni = 0; ni < num_vars; ni++)
 	{
 		if (is_root[ni])
 		{
 			// node_id = ni, node_type = variable, parent = none
-			node_stack.push(new GraphNode(ni, VAR_NODE, -1));
+			node_stack.push(GraphNode(ni, VAR_NODE, -1));
 		}
 	}
 
-	if (order.size() != (uint32_t)(m_fg->get_num_edges()))
-		order.resize(m_fg->get_num_edges());
+	int32_t num_edges = m_edge_var.size();
+	order.assign(num_edges, MessageEdge(VAR_TO_FAC, -1, -1, -1));
 
 	// find reverse order
-	int32_t eid = m_fg->get_num_edges() - 1;
+	int32_t eid = num_edges - 1;
 	while (!node_stack.empty())
 	{
-		auto node = node_stack.top();
+		GraphNode node = node_stack.top();
 		node_stack.pop();
 
-		if (node->node_type == VAR_NODE) // child: factor -> parent: var
+		if (node.node_type == VAR_NODE) // child: factor -> parent: var
 		{
-			typedef var_factor_map_type::const_iterator const_iter;
-			std::pair<const_iter, const_iter> adj_factors = vf_map.equal_range(node->node_id);
-			for (const_iter mi = adj_factors.first; mi != adj_factors.second; ++mi)
+			for (int32_t vi = m_var_edges_begin[node.node_id];
+				vi < m_var_edges_begin[node.node_id + 1]; vi++)
 			{
-				int32_t adj_factor_id = mi->second;
-				if (adj_factor_id == node->parent)
+				int32_t ei = m_var_edges[vi];
+				int32_t adj_factor_id = m_edge_fac[ei];
+				if (adj_factor_id == node.parent)
 					continue;
 
-				order[eid--] = new MessageEdge(FAC_TO_VAR, adj_factor_id, node->node_id);
-				// add factor node to node_stack
-				node_stack.push(new GraphNode(adj_factor_id, FAC_NODE, node->node_id));
+				order[eid--] = MessageEdge(FAC_TO_VAR, adj_factor_id, node.node_id, ei);
+				node_stack.push(GraphNode(adj_factor_id, FAC_NODE, node.node_id));
 			}
 		}
 		else // child: var -> parent: factor
 		{
-			auto fac = facs[node->node_id];
-			SGVector<int32_t> vars = fac->get_variables();
-
-
-			for (int32_t vi = 0; vi < vars.size(); vi++)
+			for (int32_t ei = m_fac_edges[node.node_id];
+				ei < m_fac_edges[node.node_id + 1]; ei++)
 			{
-				if (vars[vi] == node->parent)
+				if (m_edge_var[ei] == node.parent)
 					continue;
 
-				order[eid--] = new MessageEdge(VAR_TO_FAC, vars[vi], node->node_id);
-				// add variable node to node_stack
-				node_stack.push(new GraphNode(vars[vi], VAR_NODE, node->node_id));
+				order[eid--] = MessageEdge(VAR_TO_FAC, m_edge_var[ei], node.node_id, ei);
+				node_stack.push(GraphNode(m_edge_var[ei], VAR_NODE, node.node_id));
 			}
 		}
-
-		delete node;
 	}
 
-
+	ASSERT(eid == -1);
 }
 
 float64_t TreeMaxProduct::inference(SGVector<int32_t> assignment)
@@ -210,32 +356,22 @@ float64_t TreeMaxProduct::inference(SGVector<int32_t> assignment)
 		"{}::inference(): the output assignment should be prepared as"
 		"the same size as variables!", get_name());
 
+	load_energies();
 	bottom_up_pass();
 	top_down_pass();
 
 	for (int32_t vi = 0; vi < assignment.size(); vi++)
 		assignment[vi] = m_states[vi];
 
-	SG_DEBUG("fg.evaluate_energy(assignment) = {}", m_fg->evaluate_energy(assignment));
-	SG_DEBUG("minimized energy = {}", -m_map_energy);
+	SG_DEBUG("energy of assignment = {}", evaluate_energy(assignment));
+	SG_DEBUG("minimized energy = {}", m_map_energy);
 
-	return -m_map_energy;
+	return m_map_energy;
 }
 
 void TreeMaxProduct::bottom_up_pass()
 {
 	SG_DEBUG("\n***enter bottom_up_pass().");
-	auto facs = m_fg->get_factors();
-	SGVector<int32_t> cards = m_fg->get_cardinalities();
-
-	// init forward msgs to 0
-	m_fw_msgs.resize(m_msg_order.size());
-	for (uint32_t mi = 0; mi < m_msg_order.size(); ++mi)
-	{
-		// msg size is determined by var node of msg edge
-		m_fw_msgs[mi].resize(cards[m_msg_order[mi]->get_var_node()]);
-		std::fill(m_fw_msgs[mi].begin(), m_fw_msgs[mi].end(), 0);
-	}
 
 	// pass msgs along the order up to root
 	// if var -> factor
@@ -245,96 +381,43 @@ void TreeMaxProduct::bottom_up_pass()
 	// where q_v2f and r_f2v are beliefs of the edge collecting from neighborhoods
 	// by one end, which will be sent to another end, read Eq.(3.19), Eq.(3.20)
 	// on [Nowozin et al. 2011] for more detail.
-	for (uint32_t mi = 0; mi < m_msg_order.size(); ++mi)
+	for (const auto& msg : m_msg_order)
 	{
-		SG_DEBUG("mi = {}, mtype: {} {} -> {}", mi,
-			m_msg_order[mi]->mtype, m_msg_order[mi]->child, m_msg_order[mi]->parent);
-
-		if (m_msg_order[mi]->mtype == VAR_TO_FAC) // var -> factor
+		if (msg.mtype == VAR_TO_FAC) // var -> factor
 		{
-			uint32_t var_id = m_msg_order[mi]->child;
-			const std::set<uint32_t>& msgset_var = m_msgset_map_var[var_id];
-
-			// q_v2f = sum(r_f2v), i.e. sum all incoming f2v msgs
-			for (std::set<uint32_t>::const_iterator cit = msgset_var.begin(); cit != msgset_var.end(); cit++)
+			// q_v2f = sum(r_f2v), i.e. sum all incoming f2v msgs, all edges
+			// of the var but the one to its parent come from its children
+			int32_t var_id = msg.child;
+			Map<VectorXd> q(m_var_msgs.data() + m_msg_offsets[msg.edge], m_cards[var_id]);
+			q.setZero();
+			for (int32_t vi = m_var_edges_begin[var_id]; vi < m_var_edges_begin[var_id + 1]; vi++)
 			{
-				std::transform(m_fw_msgs[*cit].begin(), m_fw_msgs[*cit].end(),
-					m_fw_msgs[mi].begin(),
-					m_fw_msgs[mi].begin(),
-					std::plus<float64_t>());
+				int32_t ei = m_var_edges[vi];
+				if (ei != msg.edge)
+					q += Map<const VectorXd>(m_fac_msgs.data() + m_msg_offsets[ei], q.size());
 			}
 		}
 		else // factor -> var
 		{
-			int32_t fac_id = m_msg_order[mi]->child;
-			int32_t var_id = m_msg_order[mi]->parent;
-
-			auto fac = facs[fac_id];
-			auto ftype = fac->get_factor_type()->as<TableFactorType>();
-			SGVector<int32_t> fvars = fac->get_variables();
-			SGVector<float64_t> fenrgs = fac->get_energies();
-
-
-			// find index of var_id in the factor
-			SGVector<int32_t> fvar_set = fvars.find(var_id);
-			ASSERT(fvar_set.vlen == 1);
-			int32_t var_id_index = fvar_set[0];
-
-			std::vector<float64_t> r_f2v(fenrgs.size(), 0);
-			std::vector<float64_t> r_f2v_max(cards[var_id],
-				-std::numeric_limits<float64_t>::infinity());
-
-			// TODO: optimize with index_from_new_state()
-			// marginalization
-			// r_f2v = max(-fenrg + sum_{j!=var_id} q_v2f[adj_var_state])
-			for (int32_t ei = 0; ei < fenrgs.size(); ei++)
-			{
-				r_f2v[ei] = -fenrgs[ei];
-
-				for (int32_t vi = 0; vi < fvars.size(); vi++)
-				{
-					if (vi == var_id_index)
-						continue;
-
-					uint32_t adj_msg = m_msg_map_var[fvars[vi]];
-					int32_t adj_var_state = ftype->state_from_index(ei, vi);
-
-					r_f2v[ei] += m_fw_msgs[adj_msg][adj_var_state];
-				}
-
-				// find max value for each state of var_id
-				int32_t var_state = ftype->state_from_index(ei, var_id_index);
-				if (r_f2v[ei] > r_f2v_max[var_state])
-					r_f2v_max[var_state] = r_f2v[ei];
-			}
-
-			// in max-product, final r_f2v = r_f2v_max
-			for (int32_t si = 0; si < cards[var_id]; si++)
-				m_fw_msgs[mi][si] = r_f2v_max[si];
-
-
+			factor_to_var(msg.edge, m_var_msgs, m_fac_msgs.data() + m_msg_offsets[msg.edge]);
 		}
 	}
 
-
-	// -energy = max(sum_{f} r_f2root)
+	// energy = sum of min(sum_{f} r_f2root) over the roots, whose states can
+	// already be inferred
 	m_map_energy = 0;
 	for (uint32_t ri = 0; ri < m_is_root.size(); ri++)
 	{
 		if (!m_is_root[ri])
 			continue;
 
-		const std::set<uint32_t>& msgset_rt = m_msgset_map_var[ri];
-		std::vector<float64_t> rmarg(cards[ri], 0);
-		for (std::set<uint32_t>::const_iterator cit = msgset_rt.begin(); cit != msgset_rt.end(); cit++)
-		{
-			std::transform(m_fw_msgs[*cit].begin(), m_fw_msgs[*cit].end(),
-				rmarg.begin(),
-				rmarg.begin(),
-				std::plus<float64_t>());
-		}
+		Map<VectorXd> rmarg(m_belief.data(), m_cards[ri]);
+		rmarg.setZero();
+		for (int32_t vi = m_var_edges_begin[ri]; vi < m_var_edges_begin[ri + 1]; vi++)
+			rmarg += Map<const VectorXd>(m_fac_msgs.data() + m_msg_offsets[m_var_edges[vi]], rmarg.size());
 
-		m_map_energy += *std::max_element(rmarg.begin(), rmarg.end());
+		m_states[ri] = argmin(rmarg.data(), rmarg.size());
+		m_map_energy += rmarg[m_states[ri]];
 	}
 	SG_DEBUG("***leave bottom_up_pass().");
 }
@@ -342,211 +425,175 @@ void TreeMaxProduct::bottom_up_pass()
 void TreeMaxProduct::top_down_pass()
 {
 	SG_DEBUG("\n***enter top_down_pass().");
-	int32_t minf = std::numeric_limits<int32_t>::max();
-	auto facs = m_fg->get_factors();
-	SGVector<int32_t> cards = m_fg->get_cardinalities();
 
-	// init backward msgs to 0
-	m_bw_msgs.resize(m_msg_order.size());
-	for (uint32_t mi = 0; mi < m_msg_order.size(); ++mi)
+	// pass down to the leaves, every factor is reached by the edge from its
+	// parent var, whose state is known, and its other vars take the states
+	// minimizing fenrg + sum_{child} q_v2f given that state
+	for (auto it = m_msg_order.rbegin(); it != m_msg_order.rend(); ++it)
 	{
-		// msg size is determined by var node of msg edge
-		m_bw_msgs[mi].resize(cards[m_msg_order[mi]->get_var_node()]);
-		std::fill(m_bw_msgs[mi].begin(), m_bw_msgs[mi].end(), 0);
-	}
-
-	// init states to max infinity
-	m_states.resize(cards.size());
-	std::fill(m_states.begin(), m_states.end(), minf);
+		if (it->mtype != FAC_TO_VAR)
+			continue;
 
-	// infer states of roots first since marginal distributions of
-	// root variables are ready after bottom-up pass
-	for (uint32_t ri = 0; ri < m_is_root.size(); ri++)
-	{
-		if (!m_is_root[ri])
+		int32_t fac_id = it->child;
+		int32_t edge = it->edge;
+		if (m_fac_edges[fac_id + 1] - m_fac_edges[fac_id] == 1)
 			continue;
 
-		const std::set<uint32_t>& msgset_rt = m_msgset_map_var[ri];
-		std::vector<float64_t> rmarg(cards[ri], 0);
-		for (std::set<uint32_t>::const_iterator cit = msgset_rt.begin(); cit != msgset_rt.end(); cit++)
+		collect_messages(fac_id, edge, m_var_msgs);
+
+		// entries of the table with the known state of the parent
+		int32_t size = m_energy_offsets[fac_id + 1] - m_energy_offsets[fac_id];
+		int32_t stride = m_edge_stride[edge];
+		int32_t block = stride * m_cards[it->parent];
+		int32_t ei_min = m_states[it->parent] * stride;
+		for (int32_t bi = ei_min; bi < size; bi += block)
 		{
-			// rmarg += m_fw_msgs[*cit]
-			std::transform(m_fw_msgs[*cit].begin(), m_fw_msgs[*cit].end(),
-				rmarg.begin(),
-				rmarg.begin(),
-				std::plus<float64_t>());
+			for (int32_t ei = bi; ei < bi + stride; ei++)
+			{
+				if (m_table[ei] < m_table[ei_min])
+					ei_min = ei;
+			}
 		}
 
-		// argmax
-		m_states[ri] = static_cast<int32_t>(
-			std::max_element(rmarg.begin(), rmarg.end())
-			- rmarg.begin());
-	}
-
-	// pass msgs down to leaf
-	// if factor <- var edge
-	//   compute q_v2f
-	//   compute marginal of f
-	// else var <- factor edge
-	//   compute r_f2v
-	for (int32_t mi = (int32_t)(m_msg_order.size()-1); mi >= 0; --mi)
-	{
-		SG_DEBUG("mi = {}, mtype: {} {} <- {}", mi,
-			m_msg_order[mi]->mtype, m_msg_order[mi]->child, m_msg_order[mi]->parent);
-
-		if (m_msg_order[mi]->mtype == FAC_TO_VAR) // factor <- var
+		// infer states of neiboring vars of f
+		for (int32_t ei = m_fac_edges[fac_id]; ei < m_fac_edges[fac_id + 1]; ei++)
 		{
-			int32_t fac_id = m_msg_order[mi]->child;
-			int32_t var_id = m_msg_order[mi]->parent;
-
-			auto fac = facs[fac_id];
-			auto ftype = fac->get_factor_type()->as<TableFactorType>();
-			SGVector<int32_t> fvars = fac->get_variables();
-			SGVector<float64_t> fenrgs = fac->get_energies();
+			if (ei != edge)
+				m_states[m_edge_var[ei]] = (ei_min / m_edge_stride[ei]) % m_cards[m_edge_var[ei]];
+		}
+	}
 
+	SG_DEBUG("***leave top_down_pass().");
+}
 
-			// find index of var_id in the factor
-			SGVector<int32_t> fvar_set = fvars.find(var_id);
-			ASSERT(fvar_set.vlen == 1);
-			int32_t var_id_index = fvar_set[0];
+// -----------------------------------------------------------------
 
-			// q_v2f = r_bw_parent2v + sum_{child!=f} r_fw_child2v
-			// make sure the state of var_id has been inferred (factor marginalization)
-			// s.t. this msg computation will condition on the known state
-			ASSERT(m_states[var_id] != minf);
+LoopyMaxProduct::LoopyMaxProduct()
+	: BeliefPropagation()
+{
+	init();
+}
 
-			// parent msg: r_bw_parent2v
-			if (m_is_root[var_id] == 0)
-			{
-				uint32_t parent_msg = m_msg_map_var[var_id];
-				std::fill(m_bw_msgs[mi].begin(), m_bw_msgs[mi].end(),
-					m_bw_msgs[parent_msg][m_states[var_id]]);
-			}
+LoopyMaxProduct::LoopyMaxProduct(std::shared_ptr<FactorGraph> fg)
+	: BeliefPropagation(std::move(fg))
+{
+	ASSERT(m_fg != NULL);
 
-			// siblings: sum_{child!=f} r_fw_child2v
-			const std::set<uint32_t>& msgset_var = m_msgset_map_var[var_id];
-			for (std::set<uint32_t>::const_iterator cit = msgset_var.begin();
-				cit != msgset_var.end(); cit++)
-			{
-				if (m_msg_order[*cit]->child == fac_id)
-					continue;
+	init();
+	compile();
+}
 
-				for (uint32_t xi = 0; xi < m_bw_msgs[mi].size(); xi++)
-					m_bw_msgs[mi][xi] += m_fw_msgs[*cit][m_states[var_id]];
-			}
+LoopyMaxProduct::~LoopyMaxProduct()
+{
+}
 
-			// m_states from maximizing marginal distributions of fac_id
-			// mu(f) = -E(v_state) + sum_v q_v2f
-			std::vector<float64_t> marg(fenrgs.size(), 0);
-			for (uint32_t ei = 0; ei < marg.size(); ei++)
-			{
-				int32_t nei = ftype->index_from_new_state(ei, var_id_index, m_states[var_id]);
-				marg[ei] = -fenrgs[nei];
-
-				for (int32_t vi = 0; vi < fvars.size(); vi++)
-				{
-					if (vi == var_id_index)
-					{
-						int32_t var_id_state = ftype->state_from_index(ei, var_id_index);
-						if (m_states[var_id] != minf)
-							var_id_state = m_states[var_id];
-
-						marg[ei] += m_bw_msgs[mi][var_id_state];
-					}
-					else
-					{
-						uint32_t adj_id = fvars[vi];
-						uint32_t adj_msg = m_msg_map_var[adj_id];
-						int32_t adj_id_state = ftype->state_from_index(ei, vi);
-
-						marg[ei] += m_fw_msgs[adj_msg][adj_id_state];
-					}
-				}
-			}
+void LoopyMaxProduct::init()
+{
+	SG_ADD(&m_max_iter, "max_iter", "Maximum number of iterations");
+	SG_ADD(&m_damping, "damping", "Weight of the previous message");
+	SG_ADD(&m_tolerance, "tolerance", "Largest change of a message at convergence");
+
+	m_max_iter = 100;
+	m_damping = 0.5;
+	m_tolerance = 1e-9;
+	m_num_iter = 0;
+}
 
-			int32_t ei_max = static_cast<int32_t>(
-				std::max_element(marg.begin(), marg.end())
-				- marg.begin());
+void LoopyMaxProduct::set_max_iter(int32_t max_iter)
+{
+	require(max_iter > 0, "Maximum number of iterations ({}) must be positive", max_iter);
+	m_max_iter = max_iter;
+}
 
-			// infer states of neiboring vars of f
-			for (int32_t vi = 0; vi < fvars.size(); vi++)
-			{
-				int32_t nvar_id = fvars[vi];
-				// usually parent node has been inferred
-				if (m_states[nvar_id] != minf)
-					continue;
+void LoopyMaxProduct::set_damping(float64_t damping)
+{
+	require(damping >= 0 && damping < 1, "Damping ({}) must be in [0, 1)", damping);
+	m_damping = damping;
+}
 
-				int32_t nvar_id_state = ftype->state_from_index(ei_max, vi);
-				m_states[nvar_id] = nvar_id_state;
-			}
+void LoopyMaxProduct::set_tolerance(float64_t tolerance)
+{
+	require(tolerance >= 0, "Tolerance ({}) must be non-negative", tolerance);
+	m_tolerance = tolerance;
+}
 
+void LoopyMaxProduct::compile()
+{
+	BeliefPropagation::compile();
 
-		}
-		else // var <- factor
-		{
-			int32_t var_id = m_msg_order[mi]->child;
-			int32_t fac_id = m_msg_order[mi]->parent;
+	m_fac_msgs.resize(m_msg_offsets.back());
+	m_var_msgs.resize(m_msg_offsets.back());
+	m_msg.resize(m_cards.empty() ? 0 : *std::max_element(m_cards.begin(), m_cards.end()));
 
-			auto fac = facs[fac_id];
-			auto ftype = fac->get_factor_type()->as<TableFactorType>();
+	m_belief_offsets.assign(1, 0);
+	for (auto card : m_cards)
+		m_belief_offsets.push_back(m_belief_offsets.back() + card);
+	m_beliefs.resize(m_belief_offsets.back());
+}
 
-			SGVector<int32_t> fvars = fac->get_variables();
-			SGVector<float64_t> fenrgs = fac->get_energies();
+float64_t LoopyMaxProduct::inference(SGVector<int32_t> assignment)
+{
+	require(assignment.size() == m_fg->get_cardinalities().size(),
+		"{}::inference(): the output assignment should be prepared as"
+		"the same size as variables!", get_name());
 
+	load_energies();
 
-			// find index of var_id in the factor
-			SGVector<int32_t> fvar_set = fvars.find(var_id);
-			ASSERT(fvar_set.vlen == 1);
-			int32_t var_id_index = fvar_set[0];
+	int32_t num_vars = m_cards.size();
+	int32_t num_edges = m_edge_var.size();
 
-			uint32_t msg_parent = m_msg_map_fac[fac_id];
-			int32_t var_parent = m_msg_order[msg_parent]->parent;
+	// b_v = sum_{f} r_f2v
+	auto update_beliefs = [&]() {
+		std::fill(m_beliefs.begin(), m_beliefs.end(), 0);
+		for (int32_t ei = 0; ei < num_edges; ei++)
+		{
+			int32_t var_id = m_edge_var[ei];
+			Map<VectorXd>(m_beliefs.data() + m_belief_offsets[var_id], m_cards[var_id]) +=
+				Map<const VectorXd>(m_fac_msgs.data() + m_msg_offsets[ei], m_cards[var_id]);
+		}
+	};
 
-			std::vector<float64_t> r_f2v(fenrgs.size());
-			std::vector<float64_t> r_f2v_max(cards[var_id],
-				-std::numeric_limits<float64_t>::infinity());
+	std::fill(m_fac_msgs.begin(), m_fac_msgs.end(), 0);
+	float64_t change = std::numeric_limits<float64_t>::infinity();
+	for (m_num_iter = 0; m_num_iter < m_max_iter && change > m_tolerance; m_num_iter++)
+	{
+		// q_v2f = b_v - r_f2v, the messages of all other factors
+		update_beliefs();
+		for (int32_t ei = 0; ei < num_edges; ei++)
+		{
+			int32_t var_id = m_edge_var[ei];
+			float64_t* q = m_var_msgs.data() + m_msg_offsets[ei];
+			Map<VectorXd>(q, m_cards[var_id]) =
+				Map<const VectorXd>(m_beliefs.data() + m_belief_offsets[var_id], m_cards[var_id])
+				- Map<const VectorXd>(m_fac_msgs.data() + m_msg_offsets[ei], m_cards[var_id]);
+			normalize_message(q, m_cards[var_id]);
+		}
 
-			// r_f2v = max(-fenrg + sum_{j!=var_id} q_v2f[adj_var_state])
-			for (int32_t ei = 0; ei < fenrgs.size(); ei++)
-			{
-				r_f2v[ei] = -fenrgs[ei];
-
-				for (int32_t vi = 0; vi < fvars.size(); vi++)
-				{
-					if (vi == var_id_index)
-						continue;
-
-					if (fvars[vi] == var_parent)
-					{
-						ASSERT(m_states[var_parent] != minf);
-						r_f2v[ei] += m_bw_msgs[msg_parent][m_states[var_parent]];
-					}
-					else
-					{
-						int32_t adj_id = fvars[vi];
-						uint32_t adj_msg = m_msg_map_var[adj_id];
-						int32_t adj_var_state = ftype->state_from_index(ei, vi);
-
-						if (m_states[adj_id] != minf)
-							adj_var_state = m_states[adj_id];
-
-						r_f2v[ei] += m_fw_msgs[adj_msg][adj_var_state];
-					}
-				}
-
-				// max marginalization
-				int32_t var_id_state = ftype->state_from_index(ei, var_id_index);
-				if (r_f2v[ei] > r_f2v_max[var_id_state])
-					r_f2v_max[var_id_state] = r_f2v[ei];
-			}
+		// r_f2v from the q_v2f of the same iteration, damped
+		change = 0;
+		for (int32_t ei = 0; ei < num_edges; ei++)
+		{
+			int32_t card = m_cards[m_edge_var[ei]];
+			factor_to_var(ei, m_var_msgs, m_msg.data());
+			normalize_message(m_msg.data(), card);
+
+			Map<VectorXd> r(m_fac_msgs.data() + m_msg_offsets[ei], card);
+			Map<const VectorXd> r_new(m_msg.data(), card);
+			change = std::max(change, (r_new - r).cwiseAbs().maxCoeff());
+			r = (1 - m_damping) * r_new + m_damping * r;
+		}
+	}
 
-			for (int32_t si = 0; si < cards[var_id]; si++)
-				m_bw_msgs[mi][si] = r_f2v_max[si];
+	if (change > m_tolerance)
+		SG_DEBUG("{}::inference(): no convergence after {} iterations, "
+			"largest change of a message {}", get_name(), m_num_iter, change);
 
+	update_beliefs();
+	for (int32_t vi = 0; vi < num_vars; vi++)
+		assignment[vi] = argmin(m_beliefs.data() + m_belief_offsets[vi], m_cards[vi]);
 
-		}
-	} // end for msg edge
+	m_map_energy = evaluate_energy(assignment);
+	SG_DEBUG("energy of assignment = {}", m_map_energy);
 
-	SG_DEBUG("***leave top_down_pass().");
+	return m_map_energy;
 }
-
@@ -14,9 +14,6 @@
 #include <shogun/structure/MAPInference.h>
 
 #include <vector>
-#include <set>
-
-#include <unordered_map>
 
 #ifndef DOXYGEN_SHOULD_SKIP_THIS
 
@@ -52,24 +49,40 @@ struct MessageEdge
 	EEdgeType mtype; // 1 var_to_factor, 0 factor_to_var
 	int32_t child;
 	int32_t parent;
+	int32_t edge; // index of the (factor, variable) pair
 
-	MessageEdge(EEdgeType type, int32_t ch, int32_t pa)
-		: mtype(type), child(ch), parent(pa) { }
+	MessageEdge(EEdgeType type, int32_t ch, int32_t pa, int32_t e)
+		: mtype(type), child(ch), parent(pa), edge(e) { }
 
 	~MessageEdge() { }
 
-	inline int32_t get_var_node()
+	inline int32_t get_var_node() const
 	{
 		return mtype == VAR_TO_FAC ? child : parent;
 	}
 
-	inline int32_t get_factor_node()
+	inline int32_t get_factor_node() const
 	{
 		return mtype == VAR_TO_FAC ? parent : child;
 	}
 };
 
-/** If tree structure, do exact inference, otherwise loopy belief propagation */
+/** If tree structure, do exact inference, otherwise loopy belief propagation
+ *
+ * The factor graph is compiled once into flat arrays: the energy tables of
+ * all factors are stored contiguously, and there is one message buffer per
+ * direction with a slot for every (factor, variable) pair, an edge. Calling
+ * inference() again only copies the current energies of the factors, so it
+ * doesn't allocate and can be repeated after the energies were recomputed
+ * or loss augmented. The graph is recompiled if it was replaced, or if its
+ * factors, their variables or the cardinalities changed.
+ *
+ * Messages are computed in the min-sum form on energies. A factor table is
+ * laid out with the first variable changing fastest, so for a variable at
+ * stride s with c states the table is a sequence of s x c blocks, and adding
+ * or minimizing over its messages are vectorized row and column operations
+ * on those blocks.
+ */
 IGNORE_IN_CLASSLIST class BeliefPropagation : public MAPInferImpl
 {
 public:
@@ -83,13 +96,79 @@ public:
 
 	virtual float64_t inference(SGVector<int32_t> assignment);
 
+protected:
+	/** compiles the topology of the factor graph into flat arrays */
+	virtual void compile();
+
+	/** @return whether the factor graph differs from the compiled one */
+	bool is_compiled_stale() const;
+
+	/** copies the energies of the factors, recompiles first if the factor
+	 * graph changed since the last compilation
+	 */
+	void load_energies();
+
+	/** sums the energy table of a factor and the variable to factor
+	 * messages of all its edges but one into m_table
+	 *
+	 * @param fac_id factor
+	 * @param skip_edge edge whose message is left out
+	 * @param var_msgs variable to factor messages
+	 */
+	void collect_messages(int32_t fac_id, int32_t skip_edge,
+		const std::vector<float64_t>& var_msgs);
+
+	/** computes the factor to variable message of an edge
+	 *
+	 * @param edge edge
+	 * @param var_msgs variable to factor messages
+	 * @param msg message of the size of the cardinality of the variable
+	 */
+	void factor_to_var(int32_t edge, const std::vector<float64_t>& var_msgs,
+		float64_t* msg);
+
+	/** @return energy of an assignment, evaluated on the compiled tables */
+	float64_t evaluate_energy(const SGVector<int32_t>& assignment) const;
+
 protected:
 	float64_t m_map_energy;
+
+	/** compiled factor graph */
+	std::shared_ptr<FactorGraph> m_compiled_fg;
+	/** factors of the compiled graph */
+	std::vector<std::shared_ptr<Factor>> m_factors;
+	/** cardinalities of the variables */
+	std::vector<int32_t> m_cards;
+	/** first edge of each factor, and the number of edges at the end */
+	std::vector<int32_t> m_fac_edges;
+	/** variable of each edge */
+	std::vector<int32_t> m_edge_var;
+	/** factor of each edge */
+	std::vector<int32_t> m_edge_fac;
+	/** stride of the variable of each edge in the energy table */
+	std::vector<int32_t> m_edge_stride;
+	/** offset of the message of each edge, and the total size at the end */
+	std::vector<int32_t> m_msg_offsets;
+	/** first entry of each variable in m_var_edges, and its size at the end */
+	std::vector<int32_t> m_var_edges_begin;
+	/** edges of each variable */
+	std::vector<int32_t> m_var_edges;
+	/** offset of the energy table of each factor, and the total size at the end */
+	std::vector<int32_t> m_energy_offsets;
+	/** energy tables of all factors */
+	std::vector<float64_t> m_energies;
+	/** scratch table of the size of the largest energy table */
+	std::vector<float64_t> m_table;
 };
 
 /** max-product algorithm for tree graph
  * please refer to algorithm 1 on page 44 of [1] for more detail.
  *
+ * Messages are passed once from the leaves to the roots, along a schedule
+ * computed at compilation. The states are then decoded from the roots to
+ * the leaves, by minimizing each factor given the state of the variable
+ * towards the root.
+ *
  * [1] Sebastian Nowozin and Christoph H. Lampert,
  * Structured Learning and Prediction for Computer Vision,
  * Foundations and Trends in Computer Graphics and Vision series
@@ -97,10 +176,6 @@ protected:
  */
 IGNORE_IN_CLASSLIST class TreeMaxProduct : public BeliefPropagation
 {
-	typedef std::unordered_map<uint32_t, uint32_t> msg_map_type;
-	typedef std::unordered_map<uint32_t, std::set<uint32_t> > msgset_map_type;
-	typedef std::unordered_multimap<int32_t, int32_t> var_factor_map_type;
-
 public:
 	TreeMaxProduct();
 	TreeMaxProduct(std::shared_ptr<FactorGraph> fg);
@@ -113,23 +188,87 @@ public:
 	virtual float64_t inference(SGVector<int32_t> assignment);
 
 protected:
+	virtual void compile();
+
 	void bottom_up_pass();
 	void top_down_pass();
-	void get_message_order(std::vector<MessageEdge*>& order, std::vector<bool>& is_root) const;
+	void get_message_order(std::vector<MessageEdge>& order, std::vector<bool>& is_root) const;
 
 private:
-	void init();
-
-private:
-	std::vector<MessageEdge*> m_msg_order;
+	/** upward messages, from the leaves to the roots */
+	std::vector<MessageEdge> m_msg_order;
 	std::vector<bool> m_is_root;
-	std::vector< std::vector<float64_t> > m_fw_msgs;
-	std::vector< std::vector<float64_t> > m_bw_msgs;
+	/** factor to variable messages */
+	std::vector<float64_t> m_fac_msgs;
+	/** variable to factor messages */
+	std::vector<float64_t> m_var_msgs;
+	/** belief of a root */
+	std::vector<float64_t> m_belief;
 	std::vector<int32_t> m_states;
+};
 
-	msg_map_type m_msg_map_var;
-	msg_map_type m_msg_map_fac;
-	msgset_map_type m_msgset_map_var;
+/** max-product algorithm for graphs with cycles
+ *
+ * All messages are updated in parallel in every iteration, the factor to
+ * variable messages are damped as
+ * \f$ r \leftarrow (1 - \lambda) r_{new} + \lambda r \f$
+ * which helps the iteration to settle on graphs with tight cycles. It stops
+ * when no message changes more than the tolerance, or after the maximum
+ * number of iterations. Each variable then takes the state of minimum
+ * belief, which is exact on trees but may not be on graphs with cycles.
+ *
+ * [1] Sebastian Nowozin and Christoph H. Lampert,
+ * Structured Learning and Prediction for Computer Vision,
+ * Foundations and Trends in Computer Graphics and Vision series
+ * of now publishers, 2011.
+ */
+IGNORE_IN_CLASSLIST class LoopyMaxProduct : public BeliefPropagation
+{
+public:
+	LoopyMaxProduct();
+	LoopyMaxProduct(std::shared_ptr<FactorGraph> fg);
+
+	virtual ~LoopyMaxProduct();
+
+	/** @return class name */
+	virtual const char* get_name() const { return "LoopyMaxProduct"; }
+
+	virtual float64_t inference(SGVector<int32_t> assignment);
+
+	/** @param max_iter maximum number of iterations */
+	void set_max_iter(int32_t max_iter);
+
+	/** @param damping weight of the previous message, in [0, 1) */
+	void set_damping(float64_t damping);
+
+	/** @param tolerance largest change of a message at convergence */
+	void set_tolerance(float64_t tolerance);
+
+	/** @return number of iterations of the last inference */
+	int32_t get_num_iter() const { return m_num_iter; }
+
+protected:
+	virtual void compile();
+
+private:
+	void init();
+
+private:
+	int32_t m_max_iter;
+	float64_t m_damping;
+	float64_t m_tolerance;
+	int32_t m_num_iter;
+
+	/** factor to variable messages */
+	std::vector<float64_t> m_fac_msgs;
+	/** variable to factor messages */
+	std::vector<float64_t> m_var_msgs;
+	/** message being updated */
+	std::vector<float64_t> m_msg;
+	/** beliefs of all variables */
+	std::vector<float64_t> m_beliefs;
+	/** offset of the belief of each variable, and the total size at the end */
+	std::vector<int32_t> m_belief_offsets;
 };
 
 }
@@ -7,6 +7,7 @@
  */
 
 #include <shogun/structure/DynProg.h>
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/mathematics/Math.h>
 #include <shogun/io/SGIO.h>
 #include <shogun/lib/config.h>
@@ -21,6 +22,8 @@
 #include <ctype.h>
 #include <limits.h>
 
+#include <exception>
+#include <set>
 #include <utility>
 
 using namespace shogun;
@@ -1141,7 +1144,7 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 				{
 					T_STATES ii = elem_list[i] ;
 
-					auto penij=PEN[index_N(j, ii)]->as<PlifBase>() ;
+					const auto& penij=PEN[index_N(j, ii)] ;
 					if (penij==NULL)
 					{
 						if (long_transitions)
@@ -1219,6 +1222,52 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 			    }
 		    SG_DEBUG("Using {} long transitions", num_long_transitions)
 	    }
+
+	    /* tabulate the part of the transition penalties that only depends on
+	     * the segment length, the part using SVM values is added on lookup */
+	    std::vector<std::vector<float64_t>> pen_length_table(m_N * m_N);
+	    std::vector<bool> pen_uses_svm(m_N * m_N, false);
+	    for (int32_t j = 0; j < m_N; j++)
+	    {
+		    const T_STATES num_elem = trans_list_forward_cnt[j];
+		    const T_STATES* elem_list = trans_list_forward[j];
+
+		    for (int32_t i = 0; i < num_elem; i++)
+		    {
+			    const size_t idx = index_N(j, elem_list[i]);
+			    const auto& penij = PEN[idx];
+			    if (!penij || !pen_length_table[idx].empty())
+				    continue;
+
+			    const int32_t max_len =
+			        Math::min(look_back.element(j, elem_list[i]), max_look_back);
+			    pen_length_table[idx].resize(max_len + 1);
+			    for (int32_t len = 0; len <= max_len; len++)
+				    pen_length_table[idx][len] =
+				        penij->lookup_penalty_value_part(len);
+			    pen_uses_svm[idx] = penij->uses_svm_values();
+		    }
+	    }
+
+	    auto lookup_transition_penalty = [&](int32_t j, int32_t ii,
+	                                         int32_t from, int32_t to,
+	                                         int32_t frame) {
+		    const size_t idx = index_N(j, ii);
+		    const auto& table = pen_length_table[idx];
+		    const int32_t len = m_pos[to] - m_pos[from];
+
+		    float64_t pen_val = (len >= 0 && len < (int32_t)table.size())
+		                            ? table[len]
+		                            : PEN[idx]->lookup_penalty_value_part(len);
+		    if (pen_uses_svm[idx] && pen_val > -Math::INFTY)
+		    {
+			    lookup_content_svm_values(
+			        from, to, m_pos[from], m_pos[to], svm_value, frame);
+			    pen_val += PEN[idx]->lookup_penalty_svm_part(len, svm_value);
+		    }
+		    return pen_val;
+	    };
+
 	    // io::print("max_look_back: {} \n", max_look_back);
 
 	    // io::print("use_svm={}, genestr_len: \n", use_svm,
@@ -1425,7 +1474,7 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 					{
 						T_STATES ii = elem_list[i] ;
 
-						const auto penalty = PEN[index_N(j,ii)]->as<PlifBase>() ;
+						const auto& penalty = PEN[index_N(j,ii)] ;
 
 						/*int32_t look_back = max_look_back ;
 						  if (0)
@@ -1495,7 +1544,6 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 								////////////////////////////////////////////////////////
 
 								int32_t frame = orf_from;//m_orf_info.element(ii,0);
-								lookup_content_svm_values(ts, t, m_pos[ts], m_pos[t], svm_value, frame);
 
 								float64_t pen_val = 0.0 ;
 								if (penalty)
@@ -1503,7 +1551,7 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 #ifdef DYNPROG_TIMING_DETAIL
 									MyTime.start() ;
 #endif
-									pen_val = penalty->lookup_penalty(m_pos[t]-m_pos[ts], svm_value) ;
+									pen_val = lookup_transition_penalty(j, ii, ts, t, frame) ;
 
 #ifdef DYNPROG_TIMING_DETAIL
 									MyTime.stop() ;
@@ -1592,7 +1640,7 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 					{
 						T_STATES ii = elem_list[i] ;
 
-						const auto penalty = PEN[index_N(j,ii)]->as<PlifBase>() ;
+						const auto& penalty = PEN[index_N(j,ii)] ;
 
 						/*int32_t look_back = max_look_back ;
 						  if (0)
@@ -1662,8 +1710,7 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 								if (penalty)
 								{
 									int32_t frame = m_orf_info.element(ii,0);
-									lookup_content_svm_values(start_5p_part, end_5p_part, m_pos[start_5p_part], m_pos[end_5p_part], svm_value, frame); // * t -> end_5p_part
-									pen_val = penalty->lookup_penalty(m_pos[end_5p_part]-m_pos[start_5p_part], svm_value) ;
+									pen_val = lookup_transition_penalty(j, ii, start_5p_part, end_5p_part, frame) ; // * t -> end_5p_part
 								}
 
 								/*if (m_pos[start_5p_part]==1003)
@@ -1758,8 +1805,7 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 								if (penalty)
 								{
 									int32_t frame = orf_from ; //m_orf_info.element(ii, 0);
-									lookup_content_svm_values(ts, t, m_pos[ts], m_pos[t], svm_value, frame);
-									pen_val_3p = penalty->lookup_penalty(m_pos[t]-m_pos[ts], svm_value) ;
+									pen_val_3p = lookup_transition_penalty(j, ii, ts, t, frame) ;
 								}
 
 								float64_t mval = -(long_transition_content_scores.get_element(ii, j) + pen_val_3p*0.5) ;
@@ -1958,6 +2004,39 @@ void DynProg::compute_nbest_paths(int32_t max_num_signals, bool use_orf,
 		SG_FREE(fixedtempii);
 	}
 
+void DynProg::compute_nbest_paths_batch(
+	const std::vector<std::shared_ptr<DynProg>>& dyn_progs,
+	int32_t max_num_signals, bool use_orf, int16_t nbest, bool with_loss)
+{
+	std::set<DynProg*> distinct;
+	for (const auto& dyn_prog : dyn_progs)
+	{
+		require(dyn_prog, "All dynamic programs must be set");
+		require(distinct.insert(dyn_prog.get()).second,
+			"Each dynamic program can only be decoded once per batch");
+	}
+
+	std::exception_ptr exception;
+	const int64_t num_dyn_progs = dyn_progs.size();
+#pragma omp parallel for schedule(dynamic) num_threads(env()->get_num_threads())
+	for (int64_t i=0; i<num_dyn_progs; i++)
+	{
+		try
+		{
+			dyn_progs[i]->compute_nbest_paths(
+				max_num_signals, use_orf, nbest, with_loss, false);
+		}
+		catch (...)
+		{
+#pragma omp critical (dynprog_batch_exception)
+			if (!exception)
+				exception = std::current_exception();
+		}
+	}
+
+	if (exception)
+		std::rethrow_exception(exception);
+}
 
 void DynProg::best_path_trans_deriv(
 	int32_t *my_state_seq, int32_t *my_pos_seq,
@@ -266,6 +266,20 @@ public:
 	void compute_nbest_paths(int32_t max_num_signals,
 						 bool use_orf, int16_t nbest, bool with_loss, bool with_multiple_sequences);
 
+	/** run the viterbi algorithm for several sequences in parallel, each
+	 *  sequence is set up in its own dynamic program, which may share the
+	 *  PLiF matrices but no other state
+	 *
+	 * @param dyn_progs distinct dynamic programs to decode
+	 * @param max_num_signals maximal number of signals for a single state
+	 * @param use_orf whether orf shall be used
+	 * @param nbest number of best paths (n)
+	 * @param with_loss use loss
+	 */
+	static void compute_nbest_paths_batch(
+		const std::vector<std::shared_ptr<DynProg>>& dyn_progs,
+		int32_t max_num_signals, bool use_orf, int16_t nbest, bool with_loss);
+
 ////////////////////////////////////////////////////////////////////////////////
 
 	/** given a path though the state model and the corresponding
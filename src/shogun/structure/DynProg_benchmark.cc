@@ -0,0 +1,208 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <benchmark/benchmark.h>
+
+#include "shogun/lib/SGMatrix.h"
+#include "shogun/lib/SGNDArray.h"
+#include "shogun/lib/SGVector.h"
+#include "shogun/mathematics/Math.h"
+#include "shogun/structure/DynProg.h"
+#include "shogun/structure/PlifMatrix.h"
+#include <random>
+#include <vector>
+
+namespace shogun
+{
+
+/* a three state gene model (intergenic, exon, intron) on random sequences
+ * with candidate positions every few bases, the exon and intron segments
+ * are scored by content SVM values and by a length PLiF
+ */
+class DynProgFixture : public benchmark::Fixture
+{
+public:
+	void SetUp(const ::benchmark::State& st)
+	{
+		std::mt19937_64 prng(17);
+		create_plif_matrix(prng);
+
+		dyn_progs.clear();
+		for (index_t i=0; i<st.range(0); i++)
+			dyn_progs.push_back(create_dyn_prog(prng));
+	}
+
+	void TearDown(const ::benchmark::State&)
+	{
+		dyn_progs.clear();
+		plif_matrix.reset();
+	}
+
+	void create_plif_matrix(std::mt19937_64& prng)
+	{
+		std::uniform_real_distribution<float64_t> uniform(-1.0, 1.0);
+
+		// length PLiFs for intergenic, exon and intron segments,
+		// content PLiFs for exon and intron and one signal PLiF
+		float64_t min_values[] = {1, 1, 20, -1e6, -1e6, -10};
+		float64_t max_values[] = {2000, 600, 3000, 1e6, 1e6, 10};
+		int32_t use_svm[] = {0, 0, 0, 1, 2, 0};
+
+		SGVector<int32_t> ids(num_plifs);
+		SGVector<float64_t> min_vals(num_plifs);
+		SGVector<float64_t> max_vals(num_plifs);
+		SGVector<bool> use_cache(num_plifs);
+		SGVector<int32_t> use_svms(num_plifs);
+		SGMatrix<float64_t> limits(num_plifs, num_limits);
+		SGMatrix<float64_t> penalties(num_plifs, num_limits);
+		for (index_t i=0; i<num_plifs; i++)
+		{
+			ids[i] = i;
+			min_vals[i] = min_values[i];
+			max_vals[i] = max_values[i];
+			use_cache[i] = false;
+			use_svms[i] = use_svm[i];
+
+			float64_t lo = use_svm[i] ? -1 : min_values[i];
+			float64_t hi = use_svm[i] ? 1 : max_values[i];
+			for (index_t k=0; k<num_limits; k++)
+			{
+				limits.matrix[i*num_limits+k] = lo + (hi-lo)*k/(num_limits-1);
+				penalties.matrix[i*num_limits+k] = uniform(prng);
+			}
+		}
+
+		plif_matrix = std::make_shared<PlifMatrix>();
+		plif_matrix->create_plifs(num_plifs, num_limits);
+		plif_matrix->set_plif_ids(ids);
+		plif_matrix->set_plif_min_values(min_vals);
+		plif_matrix->set_plif_max_values(max_vals);
+		plif_matrix->set_plif_use_cache(use_cache);
+		plif_matrix->set_plif_use_svm(use_svms);
+		plif_matrix->set_plif_limits(limits);
+		plif_matrix->set_plif_penalties(penalties);
+
+		// plif ids+1 of the transitions, indexed by (to, from, plif)
+		SGVector<index_t> dims(3);
+		dims[0] = num_states;
+		dims[1] = num_states;
+		dims[2] = 2;
+		SGNDArray<float64_t> transition_plifs(dims);
+		transition_plifs.set_const(0);
+		for (index_t i=0; i<num_trans; i++)
+		{
+			index_t from = transitions[i][0];
+			index_t to = transitions[i][1];
+			transition_plifs.array[to+num_states*from] = to+1;
+			if (to!=0)
+				transition_plifs.array[to+num_states*from+num_states*num_states] = to+3;
+		}
+		plif_matrix->compute_plif_matrix(transition_plifs);
+
+		SGMatrix<int32_t> state_signals(num_states, 1);
+		state_signals.set_const(6);
+		plif_matrix->compute_signal_plifs(state_signals);
+	}
+
+	std::shared_ptr<DynProg> create_dyn_prog(std::mt19937_64& prng)
+	{
+		std::uniform_int_distribution<int32_t> base(0, 3);
+		std::uniform_real_distribution<float64_t> uniform(-1.0, 1.0);
+		const char bases[] = {'A', 'C', 'G', 'T'};
+
+		auto dyn_prog = std::make_shared<DynProg>(num_svms);
+		dyn_prog->set_num_states(num_states);
+
+		SGVector<char> genestr(seq_length);
+		for (index_t i=0; i<seq_length; i++)
+			genestr[i] = bases[base(prng)];
+
+		SGVector<int32_t> pos(seq_length/pos_step);
+		for (index_t i=0; i<pos.vlen; i++)
+			pos[i] = i*pos_step;
+
+		dyn_prog->set_pos(pos);
+		dyn_prog->set_gene_string(genestr);
+		dyn_prog->create_word_string();
+		dyn_prog->precompute_stop_codons();
+		dyn_prog->init_content_svm_value_array(num_svms);
+
+		SGMatrix<int32_t> orf_info(num_states, 2);
+		orf_info.set_const(-1);
+		dyn_prog->set_orf_info(orf_info);
+
+		SGVector<float64_t> p(num_states);
+		p.set_const(-Math::INFTY);
+		p[0] = 0;
+		SGVector<float64_t> q(num_states);
+		q.set_const(-Math::INFTY);
+		q[0] = 0;
+		dyn_prog->set_p_vector(p);
+		dyn_prog->set_q_vector(q);
+
+		SGMatrix<float64_t> a_trans(num_trans, 3);
+		for (index_t i=0; i<num_trans; i++)
+		{
+			a_trans(i, 0) = transitions[i][0];
+			a_trans(i, 1) = transitions[i][1];
+			a_trans(i, 2) = uniform(prng);
+		}
+		dyn_prog->set_a_trans_matrix(a_trans);
+
+		SGVector<index_t> dims(3);
+		dims[0] = num_states;
+		dims[1] = pos.vlen;
+		dims[2] = 1;
+		SGNDArray<float64_t> observations(dims);
+		for (index_t i=0; i<num_states*pos.vlen; i++)
+			observations.array[i] = uniform(prng);
+		dyn_prog->set_observation_matrix(observations);
+
+		SGMatrix<float64_t> dict_weights(num_words, num_svms);
+		for (index_t i=0; i<num_words*num_svms; i++)
+			dict_weights.matrix[i] = uniform(prng)*0.01;
+		dyn_prog->set_dict_weights(dict_weights);
+		dyn_prog->precompute_content_values();
+
+		dyn_prog->set_plif_matrices(plif_matrix);
+
+		return dyn_prog;
+	}
+
+	static constexpr index_t num_states = 3;
+	static constexpr index_t num_trans = 5;
+	static constexpr index_t num_plifs = 6;
+	static constexpr index_t num_limits = 10;
+	static constexpr index_t num_svms = 8;
+	static constexpr index_t num_words = 5440;
+	static constexpr index_t seq_length = 20000;
+	static constexpr index_t pos_step = 10;
+	/* (from, to) sorted by the target state */
+	static constexpr index_t transitions[num_trans][2] = {
+	    {0, 0}, {1, 0}, {0, 1}, {2, 1}, {1, 2}};
+
+	std::shared_ptr<PlifMatrix> plif_matrix;
+	std::vector<std::shared_ptr<DynProg>> dyn_progs;
+};
+
+BENCHMARK_DEFINE_F(DynProgFixture, compute_nbest_paths)(benchmark::State& st)
+{
+	for (auto _ : st)
+	{
+		for (const auto& dyn_prog : dyn_progs)
+			dyn_prog->compute_nbest_paths(1, false, 1, false, false);
+	}
+}
+
+BENCHMARK_DEFINE_F(DynProgFixture, compute_nbest_paths_batch)(benchmark::State& st)
+{
+	for (auto _ : st)
+		DynProg::compute_nbest_paths_batch(dyn_progs, 1, false, 1, false);
+}
+
+BENCHMARK_REGISTER_F(DynProgFixture, compute_nbest_paths)
+	->Arg(1)->Arg(8)->Arg(32)->Unit(benchmark::kMillisecond);
+BENCHMARK_REGISTER_F(DynProgFixture, compute_nbest_paths_batch)
+	->Arg(1)->Arg(8)->Arg(32)->Unit(benchmark::kMillisecond);
+}
@@ -97,6 +97,8 @@ bool FWSOSVM::train_machine(std::shared_ptr<Features> data)
 	int32_t k = 0;
 	SGVector<float64_t> w_s(M);
 	float64_t ell_s = 0;
+	SGVector<int32_t> examples(N);
+	examples.range_fill();
 	for (int32_t pi = 0; pi < m_num_iter; ++pi)
 	{
 		// init w_s and ell_s
@@ -104,10 +106,13 @@ bool FWSOSVM::train_machine(std::shared_ptr<Features> data)
 		w_s.zero();
 		ell_s = 0;
 
+		// 1) solve the loss-augmented inference for all points, they do not
+		// depend on each other
+		auto results = m_model->argmax_batch(m_w, examples);
+
 		for (int32_t si = 0; si < N; ++si)
 		{
-			// 1) solve the loss-augmented inference for point si
-			auto result = m_model->argmax(m_w, si);
+			const auto& result = results[si];
 
 			// 2) get the subgradient
 			// psi_i(y) := phi(x_i,y_i) - phi(x_i, y_pred)
@@ -55,6 +55,9 @@ void FactorGraphModel::init()
 		ParameterProperties::SETTING,
 		SG_OPTIONS(TREE_MAX_PROD, LOOPY_MAX_PROD, LP_RELAXATION,
 			TRWS_MAX_PROD, GRAPH_CUT, GEMP_LP));
+	add_callback_function("inf_type", [&](){
+		m_infer_cache.clear();
+	});
 
 	m_inf_type = TREE_MAX_PROD;
 	m_factor_types.clear();
@@ -332,11 +335,11 @@ std::shared_ptr<ResultSet> FactorGraphModel::argmax(SGVector<float64_t> w, int32
 		}
 	}
 
-	MAPInference infer_met(fg, m_inf_type);
-	infer_met.inference();
+	auto infer_met = get_map_inference(feat_idx, fg);
+	infer_met->inference();
 
 	// y_star
-	auto y_star = infer_met.get_structured_outputs();
+	auto y_star = infer_met->get_structured_outputs();
 	SGVector<int32_t> states_star = y_star->get_data();
 
 	io::info("Argmax: ", y_star->to_string());
@@ -391,6 +394,38 @@ float64_t FactorGraphModel::delta_loss(std::shared_ptr<StructuredData> y1, std::
 	return loss;
 }
 
+std::shared_ptr<MAPInference> FactorGraphModel::get_map_inference(
+	int32_t feat_idx, const std::shared_ptr<FactorGraph>& fg)
+{
+	// message passing is compiled for the graph and graph cuts reuse the
+	// previous max flow, both read the energies again at every inference,
+	// the other methods are set up from the energies
+	if (m_inf_type != TREE_MAX_PROD && m_inf_type != LOOPY_MAX_PROD &&
+	    m_inf_type != GRAPH_CUT)
+		return std::make_shared<MAPInference>(fg, m_inf_type);
+
+	int32_t num_samples = m_features->get_num_vectors();
+	if (m_infer_cache.size() != (uint32_t)num_samples)
+		m_infer_cache.resize(num_samples);
+
+	auto& infer_met = m_infer_cache[feat_idx];
+	if (!infer_met || infer_met->get_factor_graph() != fg)
+		infer_met = std::make_shared<MAPInference>(fg, m_inf_type);
+
+	return infer_met;
+}
+
+bool FactorGraphModel::init_argmax_batch(SGVector<float64_t> w, bool const training)
+{
+	// argmax finds the parameters cached and only reads them
+	w_to_fparams(w);
+
+	// and each example its own slot of the inference cache
+	m_infer_cache.resize(m_features->get_num_vectors());
+
+	return !m_verbose;
+}
+
 void FactorGraphModel::init_training()
 {
 }
@@ -155,6 +155,28 @@ public:
 	 */
 	virtual int32_t get_dim() const;
 
+protected:
+	/** sets the factor parameters from w, argmax is then safe to call
+	 * concurrently for different examples unless verbose information is
+	 * printed
+	 *
+	 * @param w weight vector
+	 * @param training true if argmax is called during training
+	 *
+	 * @return whether argmax can be called concurrently
+	 */
+	virtual bool init_argmax_batch(SGVector<float64_t> w, bool const training);
+
+	/** returns the MAP inference of an example, message passing and graph
+	 * cuts inference is kept and reused while the example has the same
+	 * factor graph
+	 *
+	 * @param feat_idx index of the example
+	 * @param fg factor graph of the example
+	 */
+	std::shared_ptr<MAPInference> get_map_inference(
+		int32_t feat_idx, const std::shared_ptr<FactorGraph>& fg);
+
 private:
 	/** register and initialize parameters */
 	void init();
@@ -179,6 +201,9 @@ protected:
 
 	/** whether print verbose information */
 	bool m_verbose;
+
+	/** MAP inference of each example */
+	std::vector<std::shared_ptr<MAPInference>> m_infer_cache;
 };
 
 }
@@ -32,38 +32,27 @@ GraphCut::GraphCut(int32_t num_nodes, int32_t num_edges)
 {
 	init();
 
-	m_num_nodes = num_nodes;
 	// build s-t graph
-	build_st_graph(m_num_nodes, num_edges);
+	build_st_graph(num_nodes, num_edges);
 }
 
 GraphCut::~GraphCut()
 {
-	if (m_nodes!=NULL)
-		SG_FREE(m_nodes);
-
-	if (m_edges!=NULL)
-		SG_FREE(m_edges);
 }
 
 void GraphCut::init()
 {
-	m_nodes = NULL;
-	m_edges = NULL;
-	m_edges_last = NULL;
-	m_num_nodes = 0;
-	m_num_edges = 0;
-
-	m_active_first[0] = NULL;
-	m_active_last[0] = NULL;
-	m_active_first[1] = NULL;
-	m_active_last[1] = NULL;
-	m_orphan_first = NULL;
-	m_orphan_last = NULL;
+	m_num_variables = 0;
+
+	m_active_first[0] = NO_NODE;
+	m_active_last[0] = NO_NODE;
+	m_active_first[1] = NO_NODE;
+	m_active_last[1] = NO_NODE;
 
 	m_timestamp = 0;
 	m_flow = 0;
 	m_map_energy = 0;
+	m_has_trees = false;
 
 	if (m_fg == NULL)
 		return;
@@ -87,103 +76,193 @@ void GraphCut::init()
 	{
 		int32_t num_vars = fac->get_num_vars();
 
-
-
 		if (num_vars > 3)
 		{
 			error("This implementation of the graph cut optimizer supports only factors of order <= 3.");
 		}
 
 		++m_num_factors_at_order[num_vars];
-
 	}
 
+	// each factor of order 3 has its own auxiliary node and 6 edges
 	m_num_variables = m_fg->get_num_vars();
-	int32_t max_num_edges = m_num_factors_at_order[2] + 3 * m_num_factors_at_order[3];
-	m_num_nodes = m_num_variables + m_num_factors_at_order[3];
+	int32_t max_num_edges = m_num_factors_at_order[2] + 6 * m_num_factors_at_order[3];
+	int32_t num_nodes = m_num_variables + m_num_factors_at_order[3];
 
 	// build s-t graph
-	build_st_graph(m_num_nodes, max_num_edges);
-
-	for (int32_t j = 0; j < m_fg->get_num_factors(); j++)
-	{
-		auto fac = facs[j];
-		add_factor(fac);
-
-	}
-
+	build_st_graph(num_nodes, max_num_edges);
+	m_terminal_caps.assign(num_nodes, 0);
 
+	update_capacities();
 }
 
 void GraphCut::build_st_graph(int32_t num_nodes, int32_t num_edges)
 {
-	m_num_nodes = num_nodes;
+	GCNode node;
+	node.first = NO_EDGE;
+	node.parent = NO_EDGE;
+	node.next = NO_NODE;
+	node.timestamp = 0;
+	node.dist_terminal = 0;
+	node.type_tree = SOURCE;
+	node.is_marked = false;
+	node.tree_cap = 0;
 
 	// allocate s-t graph
-	m_nodes = SG_MALLOC(GCNode, m_num_nodes);
-	m_edges = SG_MALLOC(GCEdge, 2 * num_edges);
-	m_edges_last = m_edges;
+	m_nodes.assign(num_nodes, node);
+	m_edges.clear();
+	m_edges.reserve(2 * num_edges);
 
-	for (int32_t i = 0; i < m_num_nodes; i++)
-	{
-		m_nodes[i].id = i;
-		m_nodes[i].tree_cap = 0;
-		m_nodes[i].first = NULL;
-	}
-
-	m_num_edges = 0; // m_num_edges will be counted in add_edge()
 	m_flow = 0;
 
-	m_active_first[0] = NULL;
-	m_active_last[0] = NULL;
-	m_active_first[1] = NULL;
-	m_active_last[1] = NULL;
-	m_orphan_first = NULL;
-	m_orphan_last = NULL;
+	m_active_first[0] = NO_NODE;
+	m_active_last[0] = NO_NODE;
+	m_active_first[1] = NO_NODE;
+	m_active_last[1] = NO_NODE;
+	m_orphans_front.clear();
+	m_orphans_rear.clear();
+	m_marked_nodes.clear();
 
 	m_timestamp = 0;
+	m_has_trees = false;
 }
 
-void GraphCut::init_maxflow()
+void GraphCut::init_maxflow(bool reuse_trees)
 {
-	GCNode* node_i;
-
-	m_active_first[0] = NULL;
-	m_active_last[0] = NULL;
-	m_active_first[1] = NULL;
-	m_active_last[1] = NULL;
-	m_orphan_first = NULL;
-	m_orphan_last = NULL;
+	m_active_first[0] = NO_NODE;
+	m_active_last[0] = NO_NODE;
+	m_active_first[1] = NO_NODE;
+	m_active_last[1] = NO_NODE;
+	m_orphans_front.clear();
+	m_orphans_rear.clear();
+
+	if (reuse_trees && m_has_trees)
+	{
+		repair_trees();
+		return;
+	}
 
 	m_timestamp = 0;
 
-	for (int32_t i = 0; i < m_num_nodes; i++)
+	for (int32_t i = 0; i < (int32_t)m_nodes.size(); i++)
 	{
-		node_i = m_nodes + i;
-		node_i->next = NULL;
-		node_i->timestamp = m_timestamp;
+		GCNode& node_i = m_nodes[i];
+		node_i.next = NO_NODE;
+		node_i.timestamp = m_timestamp;
+		node_i.is_marked = false;
 
-		if (node_i->tree_cap > 0)
+		if (node_i.tree_cap > 0)
 		{
 			// i is connected to the source
-			node_i->type_tree = SOURCE;
-			node_i->parent = TERMINAL_EDGE;
-			set_active(node_i);
-			node_i->dist_terminal = 1;
+			node_i.type_tree = SOURCE;
+			node_i.parent = TERMINAL_EDGE;
+			set_active(i);
+			node_i.dist_terminal = 1;
 		}
-		else if (node_i->tree_cap < 0)
+		else if (node_i.tree_cap < 0)
 		{
 			// i is connected to the sink
-			node_i->type_tree = SINK;
-			node_i->parent = TERMINAL_EDGE;
-			set_active(node_i);
-			node_i->dist_terminal = 1;
+			node_i.type_tree = SINK;
+			node_i.parent = TERMINAL_EDGE;
+			set_active(i);
+			node_i.dist_terminal = 1;
 		}
 		else
 		{
-			node_i->parent = NULL;
+			node_i.parent = NO_EDGE;
 		}
 	}
+
+	m_marked_nodes.clear();
+}
+
+void GraphCut::repair_trees()
+{
+	// the active list is empty after a max flow, so all nodes have next
+	// NO_NODE, the marked nodes and their neighbors in the other tree
+	// become active
+	m_timestamp++;
+
+	for (int32_t i : m_marked_nodes)
+	{
+		GCNode& node_i = m_nodes[i];
+		node_i.is_marked = false;
+		set_active(i);
+
+		if (node_i.tree_cap == 0)
+		{
+			if (node_i.parent != NO_EDGE)
+			{
+				set_orphan_rear(i);
+			}
+
+			continue;
+		}
+
+		if (node_i.tree_cap > 0)
+		{
+			if (node_i.parent == NO_EDGE || node_i.type_tree == SINK)
+			{
+				// i moves to the source tree, its children become orphans
+				node_i.type_tree = SOURCE;
+
+				for (int32_t edge = node_i.first; edge != NO_EDGE; edge = m_edges[edge].next)
+				{
+					int32_t j = m_edges[edge].head;
+					GCNode& node_j = m_nodes[j];
+
+					if (!node_j.is_marked)
+					{
+						if (node_j.parent == (edge ^ 1))
+						{
+							set_orphan_rear(j);
+						}
+
+						if (node_j.parent != NO_EDGE && node_j.type_tree == SINK && m_edges[edge].residual_capacity > 0)
+						{
+							set_active(j);
+						}
+					}
+				}
+			}
+		}
+		else
+		{
+			if (node_i.parent == NO_EDGE || node_i.type_tree == SOURCE)
+			{
+				// i moves to the sink tree, its children become orphans
+				node_i.type_tree = SINK;
+
+				for (int32_t edge = node_i.first; edge != NO_EDGE; edge = m_edges[edge].next)
+				{
+					int32_t j = m_edges[edge].head;
+					GCNode& node_j = m_nodes[j];
+
+					if (!node_j.is_marked)
+					{
+						if (node_j.parent == (edge ^ 1))
+						{
+							set_orphan_rear(j);
+						}
+
+						if (node_j.parent != NO_EDGE && node_j.type_tree == SOURCE && m_edges[edge ^ 1].residual_capacity > 0)
+						{
+							set_active(j);
+						}
+					}
+				}
+			}
+		}
+
+		node_i.parent = TERMINAL_EDGE;
+		node_i.timestamp = m_timestamp;
+		node_i.dist_terminal = 1;
+	}
+
+	m_marked_nodes.clear();
+
+	// adopt orphans, rebuild the search tree structure
+	process_orphans_rear();
 }
 
 float64_t GraphCut::inference(SGVector<int32_t> assignment)
@@ -192,8 +271,9 @@ float64_t GraphCut::inference(SGVector<int32_t> assignment)
 	        "{}::inference(): the output assignment should be prepared as"
 	        "the same size as variables!", get_name());
 
-	// compute max flow
-	init_maxflow();
+	// compute max flow from the previous one
+	update_capacities();
+	init_maxflow(true);
 	compute_maxflow();
 
 	for (int32_t vi = 0; vi < assignment.size(); vi++)
@@ -208,7 +288,51 @@ float64_t GraphCut::inference(SGVector<int32_t> assignment)
 	return m_map_energy;
 }
 
-void GraphCut::add_factor(const std::shared_ptr<Factor>& factor)
+void GraphCut::update_capacities()
+{
+	auto facs = m_fg->get_factors();
+
+	m_new_terminal_caps.assign(m_nodes.size(), 0);
+
+	int32_t edge = 0;
+	int32_t aux_node = m_num_variables;
+
+	for (auto& fac : facs)
+	{
+		add_factor(fac, aux_node, edge);
+
+		if (fac->get_num_vars() == 3)
+		{
+			aux_node++;
+		}
+	}
+
+	ASSERT(2 * edge == (int32_t)m_edges.size());
+
+	// change the s-t graph where the capacities differ
+	for (int32_t i = 0; i < (int32_t)m_nodes.size(); i++)
+	{
+		float64_t delta = m_new_terminal_caps[i] - m_terminal_caps[i];
+
+		if (delta > 0)
+		{
+			add_tweights(i, delta, 0);
+		}
+		else if (delta < 0)
+		{
+			add_tweights(i, 0, -delta);
+		}
+	}
+
+	std::swap(m_terminal_caps, m_new_terminal_caps);
+
+	for (int32_t e = 0; e < edge; e++)
+	{
+		set_edge_capacity(e, m_new_edge_caps[2 * e], m_new_edge_caps[2 * e + 1]);
+	}
+}
+
+void GraphCut::add_factor(const std::shared_ptr<Factor>& factor, int32_t aux_node, int32_t& edge)
 {
 	SGVector<int32_t> fcards = factor->get_cardinalities();
 
@@ -234,11 +358,11 @@ void GraphCut::add_factor(const std::shared_ptr<Factor>& factor)
 
 		if (v0 < v1)
 		{
-			add_tweights(var, v1 - v0, 0);
+			add_factor_tweights(var, v1 - v0, 0);
 		}
 		else
 		{
-			add_tweights(var, 0, v0 - v1);
+			add_factor_tweights(var, 0, v0 - v1);
 		}
 	}
 	break;
@@ -268,20 +392,20 @@ void GraphCut::add_factor(const std::shared_ptr<Factor>& factor)
 		// first variabe
 		if (C > A)
 		{
-			add_tweights(var0, C - A, 0);
+			add_factor_tweights(var0, C - A, 0);
 		}
 		else
 		{
-			add_tweights(var0, 0, A - C);
+			add_factor_tweights(var0, 0, A - C);
 		}
 		// second varibale
 		if (D > C)
 		{
-			add_tweights(var1, D - C, 0);
+			add_factor_tweights(var1, D - C, 0);
 		}
 		else
 		{
-			add_tweights(var1, 0, C - D);
+			add_factor_tweights(var1, 0, C - D);
 		}
 
 		// submodular term
@@ -294,7 +418,7 @@ void GraphCut::add_factor(const std::shared_ptr<Factor>& factor)
 			error("\nRegularity condition is not satisfied");
 		}
 
-		add_edge(var0, var1, term, 0);
+		add_factor_edge(var0, var1, term, 0, edge);
 	}
 	break;
 	case 3:
@@ -313,84 +437,85 @@ void GraphCut::add_factor(const std::shared_ptr<Factor>& factor)
 		float64_t D = fenrgs[6]; //{0,1,1}
 		float64_t H = fenrgs[7]; //{1,1,1}
 
-		int32_t id = get_tripleId(fvars);
 		float64_t P = (A + D + F + G) - (B + C + E + H);
 
+		// the edges keep their direction when the sign of P changes, so
+		// that they can be reused, only the capacity used differs
 		if (P >= 0.0)
 		{
 			if (F - B >= 0)
 			{
-				add_tweights(var0, F - B, 0);
+				add_factor_tweights(var0, F - B, 0);
 			}
 			else
 			{
-				add_tweights(var0, 0, B - F);
+				add_factor_tweights(var0, 0, B - F);
 			}
 
 			if (G - E >= 0)
 			{
-				add_tweights(var1, G - E, 0);
+				add_factor_tweights(var1, G - E, 0);
 			}
 			else
 			{
-				add_tweights(var1, 0, E - G);
+				add_factor_tweights(var1, 0, E - G);
 			}
 
 			if (D - C >= 0)
 			{
-				add_tweights(var2, D - C, 0);
+				add_factor_tweights(var2, D - C, 0);
 			}
 			else
 			{
-				add_tweights(var2, 0, C - D);
+				add_factor_tweights(var2, 0, C - D);
 			}
 
-			add_edge(var1, var2, B + C - A - D, 0);
-			add_edge(var2, var0, B + E - A - F, 0);
-			add_edge(var0, var1, C + E - A - G, 0);
+			add_factor_edge(var1, var2, B + C - A - D, 0, edge);
+			add_factor_edge(var2, var0, B + E - A - F, 0, edge);
+			add_factor_edge(var0, var1, C + E - A - G, 0, edge);
 
-			add_edge(var0, id, P, 0);
-			add_edge(var1, id, P, 0);
-			add_edge(var2, id, P, 0);
-			add_edge(id, 1, P, 0);
+			add_factor_edge(var0, aux_node, P, 0, edge);
+			add_factor_edge(var1, aux_node, P, 0, edge);
+			add_factor_edge(var2, aux_node, P, 0, edge);
+			add_factor_tweights(aux_node, 0, P);
 		}
 		else
 		{
 			if (C - G >= 0)
 			{
-				add_tweights(var0, 0, C - G);
+				add_factor_tweights(var0, 0, C - G);
 			}
 			else
 			{
-				add_tweights(var0, G - C, 0);
+				add_factor_tweights(var0, G - C, 0);
 			}
 
 			if (B - D >= 0)
 			{
-				add_tweights(var1, 0, B - D);
+				add_factor_tweights(var1, 0, B - D);
 			}
 			else
 			{
-				add_tweights(var1, D - B, 0);
+				add_factor_tweights(var1, D - B, 0);
 			}
 
 			if (E - F >= 0)
 			{
-				add_tweights(var2, 0, E - F);
+				add_factor_tweights(var2, 0, E - F);
 			}
 			else
 			{
-				add_tweights(var2, F - E, 0);
+				add_factor_tweights(var2, F - E, 0);
 			}
 
-			add_edge(var2, var1, F + G - E - H, 0);
-			add_edge(var0, var2, D + G - C - H, 0);
-			add_edge(var1, var0, D + F - B - H, 0);
+			add_factor_edge(var1, var2, 0, F + G - E - H, edge);
+			add_factor_edge(var2, var0, 0, D + G - C - H, edge);
+			add_factor_edge(var0, var1, 0, D + F - B - H, edge);
 
-			add_edge(id, var0, -P, 0);
-			add_edge(id, var1, -P, 0);
-			add_edge(id, var2, -P, 0);
-			add_tweights(id, -P, 0);
+			add_factor_edge(var0, aux_node, 0, -P, edge);
+			add_factor_edge(var1, aux_node, 0, -P, edge);
+			add_factor_edge(var2, aux_node, 0, -P, edge);
+			add_factor_tweights(aux_node, -P, 0);
 		}
 	}
 	break;
@@ -400,33 +525,35 @@ void GraphCut::add_factor(const std::shared_ptr<Factor>& factor)
 	}
 }
 
-int32_t GraphCut::get_tripleId(SGVector<int32_t> triple)
+void GraphCut::add_factor_tweights(int32_t i, float64_t cap_source, float64_t cap_sink)
 {
-	// search for triple in list
-	int32_t counter = m_num_variables;
+	ASSERT(i >= 0 && i < (int32_t)m_nodes.size());
 
-	for (int32_t i = 0; i < m_triple_list.size(); i++)
+	m_new_terminal_caps[i] += cap_source - cap_sink;
+}
+
+void GraphCut::add_factor_edge(int32_t i, int32_t j, float64_t capacity, float64_t reverse_capacity, int32_t& edge)
+{
+	if (2 * edge == (int32_t)m_edges.size())
 	{
-		SGVector<int32_t> vec = m_triple_list[i];
+		add_edge(i, j, 0, 0);
+	}
 
-		if (triple[0] == vec[0] && triple[1] == vec[1] && triple[2] == vec[2])
-		{
-			return counter;
-		}
+	ASSERT(m_edges[2 * edge].head == j && m_edges[2 * edge + 1].head == i);
 
-		m_num_variables++;
+	if ((int32_t)m_new_edge_caps.size() < 2 * (edge + 1))
+	{
+		m_new_edge_caps.resize(2 * (edge + 1));
 	}
-	// add triple to list
-	m_triple_list.push_back(triple);
 
-	ASSERT(counter - m_num_variables < m_num_factors_at_order[3]);
-
-	return counter;
+	m_new_edge_caps[2 * edge] = capacity;
+	m_new_edge_caps[2 * edge + 1] = reverse_capacity;
+	edge++;
 }
 
 void GraphCut::add_tweights(int32_t i, float64_t cap_source, float64_t cap_sink)
 {
-	ASSERT(i >= 0 && i < m_num_nodes);
+	ASSERT(i >= 0 && i < (int32_t)m_nodes.size());
 
 	float64_t delta = m_nodes[i].tree_cap;
 
@@ -442,100 +569,167 @@ void GraphCut::add_tweights(int32_t i, float64_t cap_source, float64_t cap_sink)
 	m_flow += (cap_source < cap_sink) ? cap_source : cap_sink;
 
 	m_nodes[i].tree_cap = cap_source - cap_sink;
+	mark_node(i);
 }
 
-void GraphCut::add_edge(int32_t i, int32_t j, float64_t capacity, float64_t reverse_capacity)
+int32_t GraphCut::add_edge(int32_t i, int32_t j, float64_t capacity, float64_t reverse_capacity)
 {
-	ASSERT(i >= 0 && i < m_num_nodes);
-	ASSERT(j >= 0 && j < m_num_nodes);
+	ASSERT(i >= 0 && i < (int32_t)m_nodes.size());
+	ASSERT(j >= 0 && j < (int32_t)m_nodes.size());
 	ASSERT(i != j);
 	ASSERT(capacity >= 0);
 	ASSERT(reverse_capacity >= 0);
 
-	GCEdge* e = m_edges_last++;
-	e->id = m_num_edges++;
-	GCEdge* e_rev = m_edges_last++;
-	e_rev->id = m_num_edges++;
-
-	GCNode* node_i = m_nodes + i;
-	GCNode* node_j = m_nodes + j;
-
-	e->reverse = e_rev;
-	e_rev->reverse = e;
-	e->next = node_i->first;
-	node_i->first = e;
-	e_rev->next = node_j->first;
-	node_j->first = e_rev;
-	e->head = node_j;
-	e_rev->head = node_i;
-	e->residual_capacity = capacity;
-	e_rev->residual_capacity = reverse_capacity;
+	int32_t e = m_edges.size();
+
+	GCEdge edge;
+	edge.head = j;
+	edge.next = m_nodes[i].first;
+	edge.capacity = capacity;
+	edge.residual_capacity = capacity;
+	m_edges.push_back(edge);
+
+	GCEdge edge_rev;
+	edge_rev.head = i;
+	edge_rev.next = m_nodes[j].first;
+	edge_rev.capacity = reverse_capacity;
+	edge_rev.residual_capacity = reverse_capacity;
+	m_edges.push_back(edge_rev);
+
+	m_nodes[i].first = e;
+	m_nodes[j].first = e + 1;
+
+	mark_node(i);
+	mark_node(j);
+
+	return e / 2;
 }
 
-void GraphCut::set_active(GCNode* node_i)
+void GraphCut::set_edge_capacity(int32_t edge, float64_t capacity, float64_t reverse_capacity)
 {
-	if (node_i->next == NULL)
+	ASSERT(edge >= 0 && 2 * edge < (int32_t)m_edges.size());
+	ASSERT(capacity >= 0);
+	ASSERT(reverse_capacity >= 0);
+
+	GCEdge& e = m_edges[2 * edge];
+	GCEdge& e_rev = m_edges[2 * edge + 1];
+
+	if (e.capacity == capacity && e_rev.capacity == reverse_capacity)
+	{
+		return;
+	}
+
+	int32_t i = e_rev.head;
+	int32_t j = e.head;
+
+	e.residual_capacity += capacity - e.capacity;
+	e.capacity = capacity;
+	e_rev.residual_capacity += reverse_capacity - e_rev.capacity;
+	e_rev.capacity = reverse_capacity;
+
+	// the flow exceeding the capacity stays, reparameterized by adding the
+	// excess to i->j, SOURCE->i and j->SINK and subtracting it from j->i,
+	// which adds it to the capacity of every cut
+	if (e.residual_capacity < 0)
+	{
+		float64_t excess = -e.residual_capacity;
+		e.residual_capacity = 0;
+		e_rev.residual_capacity -= excess;
+		add_tweights(i, excess, 0);
+		add_tweights(j, 0, excess);
+		m_flow -= excess;
+	}
+	else if (e_rev.residual_capacity < 0)
+	{
+		float64_t excess = -e_rev.residual_capacity;
+		e_rev.residual_capacity = 0;
+		e.residual_capacity -= excess;
+		add_tweights(j, excess, 0);
+		add_tweights(i, 0, excess);
+		m_flow -= excess;
+	}
+
+	mark_node(i);
+	mark_node(j);
+}
+
+void GraphCut::mark_node(int32_t i)
+{
+	if (!m_nodes[i].is_marked)
+	{
+		m_nodes[i].is_marked = true;
+		m_marked_nodes.push_back(i);
+	}
+}
+
+void GraphCut::set_active(int32_t i)
+{
+	GCNode& node_i = m_nodes[i];
+
+	if (node_i.next == NO_NODE)
 	{
 		// it's not in the list yet
-		if (m_active_last[1])
+		if (m_active_last[1] != NO_NODE)
 		{
-			m_active_last[1]->next = node_i;
+			m_nodes[m_active_last[1]].next = i;
 		}
 		else
 		{
-			m_active_first[1] = node_i;
+			m_active_first[1] = i;
 		}
 
-		m_active_last[1] = node_i;
-		node_i->next = node_i;
+		m_active_last[1] = i;
+		node_i.next = i;
 	}
 }
 
-GCNode* GraphCut::next_active()
+int32_t GraphCut::next_active()
 {
 	// Returns the next active node. If it is connected to the sink,
 	// it stays in the list, otherwise it is removed from the list.
-	GCNode* node_i;
+	int32_t i;
 
 	while (true)
 	{
-		if ((node_i = m_active_first[0]) == NULL)
+		if ((i = m_active_first[0]) == NO_NODE)
 		{
-			m_active_first[0] = node_i = m_active_first[1];
+			m_active_first[0] = i = m_active_first[1];
 			m_active_last[0]  = m_active_last[1];
-			m_active_first[1] = NULL;
-			m_active_last[1]  = NULL;
+			m_active_first[1] = NO_NODE;
+			m_active_last[1]  = NO_NODE;
 
-			if (node_i == NULL)
+			if (i == NO_NODE)
 			{
-				return NULL;
+				return NO_NODE;
 			}
 		}
 
+		GCNode& node_i = m_nodes[i];
+
 		// remove it from the active list
-		if (node_i->next == node_i)
+		if (node_i.next == i)
 		{
-			m_active_first[0] = NULL;
-			m_active_last[0] = NULL;
+			m_active_first[0] = NO_NODE;
+			m_active_last[0] = NO_NODE;
 		}
 		else
 		{
-			m_active_first[0] = node_i->next;
+			m_active_first[0] = node_i.next;
 		}
 
-		node_i->next = NULL;
+		node_i.next = NO_NODE;
 
 		// a node in the list is active iff it has a parent
-		if (node_i->parent != NULL)
+		if (node_i.parent != NO_EDGE)
 		{
-			return node_i;
+			return i;
 		}
 	}
 }
 
 float64_t GraphCut::compute_maxflow()
 {
-	GCNode* current_node = NULL;
+	int32_t current_node = NO_NODE;
 	bool active_set_found = true;
 
 	// start the main loop
@@ -544,7 +738,7 @@ float64_t GraphCut::compute_maxflow()
 		if (env()->io()->get_loglevel() <= io::MSG_DEBUG)
 			test_consistency(current_node);
 
-		GCEdge* connecting_edge;
+		int32_t connecting_edge;
 
 		// find a path from source to sink
 		active_set_found = grow(connecting_edge, current_node);
@@ -554,7 +748,7 @@ float64_t GraphCut::compute_maxflow()
 			break;
 		}
 
-		if (connecting_edge == NULL)
+		if (connecting_edge == NO_EDGE)
 		{
 			continue;
 		}
@@ -571,55 +765,60 @@ float64_t GraphCut::compute_maxflow()
 	if (env()->io()->get_loglevel() <= io::MSG_DEBUG)
 		test_consistency();
 
+	m_has_trees = true;
+
 	return m_flow;
 }
 
-bool GraphCut::grow(GCEdge* &edge, GCNode* &current_node)
+bool GraphCut::grow(int32_t& edge, int32_t& current_node)
 {
-	GCNode* node_i, *node_j;
+	int32_t i;
 
-	if ((node_i = current_node) != NULL)
+	if ((i = current_node) != NO_NODE)
 	{
-		node_i->next = NULL; // remove active flag
+		m_nodes[i].next = NO_NODE; // remove active flag
 
-		if (node_i->parent == NULL)
+		if (m_nodes[i].parent == NO_EDGE)
 		{
-			node_i = NULL;
+			i = NO_NODE;
 		}
 	}
 
-	if (node_i == NULL && (node_i = next_active()) == NULL)
+	if (i == NO_NODE && (i = next_active()) == NO_NODE)
 	{
 		return false;
 	}
 
-	if (node_i->type_tree == SOURCE)
+	GCNode& node_i = m_nodes[i];
+
+	if (node_i.type_tree == SOURCE)
 	{
 		// grow source tree
-		for (edge = node_i->first; edge != NULL; edge = edge->next)
+		for (edge = node_i.first; edge != NO_EDGE; edge = m_edges[edge].next)
 		{
-			if (edge->residual_capacity)
+			if (m_edges[edge].residual_capacity)
 			{
-				node_j = edge->head;
+				int32_t j = m_edges[edge].head;
+				GCNode& node_j = m_nodes[j];
 
-				if (node_j->parent == NULL)
+				if (node_j.parent == NO_EDGE)
 				{
-					node_j->type_tree = SOURCE;
-					node_j->parent = edge->reverse;
-					node_j->timestamp = node_i->timestamp;
-					node_j->dist_terminal = node_i->dist_terminal + 1;
-					set_active(node_j);
+					node_j.type_tree = SOURCE;
+					node_j.parent = edge ^ 1;
+					node_j.timestamp = node_i.timestamp;
+					node_j.dist_terminal = node_i.dist_terminal + 1;
+					set_active(j);
 				}
-				else if (node_j->type_tree == SINK)
+				else if (node_j.type_tree == SINK)
 				{
 					break;
 				}
-				else if (node_j->timestamp <= node_i->timestamp && node_j->dist_terminal > node_i->dist_terminal)
+				else if (node_j.timestamp <= node_i.timestamp && node_j.dist_terminal > node_i.dist_terminal)
 				{
 					// heuristic - trying to make the distance from j to the source shorter
-					node_j->parent = edge->reverse;
-					node_j->timestamp = node_i->timestamp;
-					node_j->dist_terminal = node_i->dist_terminal + 1;
+					node_j.parent = edge ^ 1;
+					node_j.timestamp = node_i.timestamp;
+					node_j.dist_terminal = node_i.dist_terminal + 1;
 				}
 			}
 		}
@@ -627,155 +826,156 @@ bool GraphCut::grow(GCEdge* &edge, GCNode* &current_node)
 	else
 	{
 		// grow sink tree
-		for (edge = node_i->first; edge != NULL; edge = edge->next)
+		for (edge = node_i.first; edge != NO_EDGE; edge = m_edges[edge].next)
 		{
-			if (edge->reverse->residual_capacity)
+			if (m_edges[edge ^ 1].residual_capacity)
 			{
-				node_j = edge->head;
+				int32_t j = m_edges[edge].head;
+				GCNode& node_j = m_nodes[j];
 
-				if (node_j->parent == NULL)
+				if (node_j.parent == NO_EDGE)
 				{
-					node_j->type_tree = SINK;
-					node_j->parent = edge->reverse;
-					node_j->timestamp = node_i->timestamp;
-					node_j->dist_terminal = node_i->dist_terminal + 1;
-					set_active(node_j);
+					node_j.type_tree = SINK;
+					node_j.parent = edge ^ 1;
+					node_j.timestamp = node_i.timestamp;
+					node_j.dist_terminal = node_i.dist_terminal + 1;
+					set_active(j);
 				}
-				else if (node_j->type_tree == SOURCE)
+				else if (node_j.type_tree == SOURCE)
 				{
-					edge = edge->reverse;
+					edge = edge ^ 1;
 					break;
 				}
-				else if (node_j->timestamp <= node_i->timestamp && node_j->dist_terminal > node_i->dist_terminal)
+				else if (node_j.timestamp <= node_i.timestamp && node_j.dist_terminal > node_i.dist_terminal)
 				{
 					// heuristic - trying to make the distance from j to the sink shorter
-					node_j->parent = edge->reverse;
-					node_j->timestamp = node_i->timestamp;
-					node_j->dist_terminal = node_i->dist_terminal + 1;
+					node_j.parent = edge ^ 1;
+					node_j.timestamp = node_i.timestamp;
+					node_j.dist_terminal = node_i.dist_terminal + 1;
 				}
 			}
 		}
 	} // grow sink tree
 
-	if (edge != NULL)
+	if (edge != NO_EDGE)
 	{
-		node_i->next = node_i; // set active flag
-		current_node = node_i;
+		node_i.next = i; // set active flag
+		current_node = i;
 	}
 	else
 	{
-		current_node = NULL;
+		current_node = NO_NODE;
 	}
 
 	return true;
 }
 
-void GraphCut::augment_path(GCEdge* connecting_edge)
+void GraphCut::augment_path(int32_t connecting_edge)
 {
-	GCNode* node_i;
-	GCEdge* edge;
+	int32_t i;
+	int32_t edge;
 	float64_t bottleneck;
 
 	// 1. Finding bottleneck capacity
 	// 1a the source tree
-	bottleneck = connecting_edge->residual_capacity;
+	bottleneck = m_edges[connecting_edge].residual_capacity;
 
-	for (node_i = connecting_edge->reverse->head; ; node_i = edge->head)
+	for (i = m_edges[connecting_edge ^ 1].head; ; i = m_edges[edge].head)
 	{
-		edge = node_i->parent;
+		edge = m_nodes[i].parent;
 
 		if (edge == TERMINAL_EDGE)
 		{
 			break;
 		}
 
-		if (bottleneck > edge->reverse->residual_capacity)
+		if (bottleneck > m_edges[edge ^ 1].residual_capacity)
 		{
-			bottleneck = edge->reverse->residual_capacity;
+			bottleneck = m_edges[edge ^ 1].residual_capacity;
 		}
 	}
 
-	if (bottleneck > node_i->tree_cap)
+	if (bottleneck > m_nodes[i].tree_cap)
 	{
-		bottleneck = node_i->tree_cap;
+		bottleneck = m_nodes[i].tree_cap;
 	}
 
 	// 1b the sink tree
-	for (node_i = connecting_edge->head; ; node_i = edge->head)
+	for (i = m_edges[connecting_edge].head; ; i = m_edges[edge].head)
 	{
-		edge = node_i->parent;
+		edge = m_nodes[i].parent;
 
 		if (edge == TERMINAL_EDGE)
 		{
 			break;
 		}
 
-		if (bottleneck > edge->residual_capacity)
+		if (bottleneck > m_edges[edge].residual_capacity)
 		{
-			bottleneck = edge->residual_capacity;
+			bottleneck = m_edges[edge].residual_capacity;
 		}
 	}
 
-	if (bottleneck > - node_i->tree_cap)
+	if (bottleneck > - m_nodes[i].tree_cap)
 	{
-		bottleneck = - node_i->tree_cap;
+		bottleneck = - m_nodes[i].tree_cap;
 	}
 
 
 	// 2. Augmenting
 	// 2a the source tree
-	connecting_edge->reverse->residual_capacity += bottleneck;
-	connecting_edge->residual_capacity -= bottleneck;
+	m_edges[connecting_edge ^ 1].residual_capacity += bottleneck;
+	m_edges[connecting_edge].residual_capacity -= bottleneck;
 
-	for (node_i = connecting_edge->reverse->head; ; node_i = edge->head)
+	for (i = m_edges[connecting_edge ^ 1].head; ; i = m_edges[edge].head)
 	{
-		edge = node_i->parent;
+		edge = m_nodes[i].parent;
 
 		if (edge == TERMINAL_EDGE)
 		{
 			break;
 		}
 
-		edge->residual_capacity += bottleneck;
-		edge->reverse->residual_capacity -= bottleneck;
+		m_edges[edge].residual_capacity += bottleneck;
+		m_edges[edge ^ 1].residual_capacity -= bottleneck;
 
-		if (edge->reverse->residual_capacity == 0)
+		if (m_edges[edge ^ 1].residual_capacity == 0)
 		{
-			set_orphan_front(node_i); // add node_i to the beginning of the adoptation list
+			set_orphan_front(i); // add i to the beginning of the adoptation list
 		}
 	}
 
-	node_i->tree_cap -= bottleneck;
+	m_nodes[i].tree_cap -= bottleneck;
 
-	if (node_i->tree_cap == 0)
+	if (m_nodes[i].tree_cap == 0)
 	{
-		set_orphan_front(node_i); // add node_i to the beginning of the adoptation list
+		set_orphan_front(i); // add i to the beginning of the adoptation list
 	}
 
 	// 2b the sink tree
-	for (node_i = connecting_edge->head; ; node_i = edge->head)
+	for (i = m_edges[connecting_edge].head; ; i = m_edges[edge].head)
 	{
-		edge = node_i->parent;
+		edge = m_nodes[i].parent;
 
 		if (edge == TERMINAL_EDGE)
 		{
 			break;
 		}
 
-		edge->reverse->residual_capacity += bottleneck;
-		edge->residual_capacity -= bottleneck;
+		m_edges[edge ^ 1].residual_capacity += bottleneck;
+		m_edges[edge].residual_capacity -= bottleneck;
 
-		if (edge->residual_capacity == 0)
+		if (m_edges[edge].residual_capacity == 0)
 		{
-			set_orphan_front(node_i);
+			set_orphan_front(i);
 		}
 	}
 
-	node_i->tree_cap += bottleneck;
+	m_nodes[i].tree_cap += bottleneck;
 
-	if (node_i->tree_cap == 0)
+	if (m_nodes[i].tree_cap == 0)
 	{
-		set_orphan_front(node_i);
+		set_orphan_front(i);
 	}
 
 	m_flow += bottleneck;
@@ -783,98 +983,76 @@ void GraphCut::augment_path(GCEdge* connecting_edge)
 
 void GraphCut::adopt()
 {
-	GCNodePtr* np, *np_next;
-	GCNode* node_i;
-
-	while ((np = m_orphan_first) != NULL)
+	while (!m_orphans_front.empty())
 	{
-		np_next = np->next;
-		np->next = NULL;
-
-		while ((np = m_orphan_first) != NULL)
-		{
-			m_orphan_first = np->next;
-			node_i = np->ptr;
-			SG_FREE(np);
+		int32_t i = m_orphans_front.back();
+		m_orphans_front.pop_back();
 
-			if (m_orphan_first == NULL)
-			{
-				m_orphan_last = NULL;
-			}
-
-			process_orphan(node_i, node_i->type_tree);
-		}
-
-		m_orphan_first = np_next;
+		process_orphan(i, m_nodes[i].type_tree);
+		process_orphans_rear();
 	}
 }
 
-void GraphCut::set_orphan_front(GCNode* node_i)
+void GraphCut::process_orphans_rear()
 {
-	GCNodePtr* np;
-	node_i->parent = ORPHAN_EDGE;
-	np = SG_MALLOC(GCNodePtr, 1);
-	np->ptr = node_i;
-	np->next = m_orphan_first;
-	m_orphan_first = np;
+	// processing an orphan can append new orphans
+	for (size_t k = 0; k < m_orphans_rear.size(); k++)
+	{
+		int32_t i = m_orphans_rear[k];
+		process_orphan(i, m_nodes[i].type_tree);
+	}
+
+	m_orphans_rear.clear();
 }
 
-void GraphCut::set_orphan_rear(GCNode* node_i)
+void GraphCut::set_orphan_front(int32_t i)
 {
-	GCNodePtr* np;
-	node_i->parent = ORPHAN_EDGE;
-	np = SG_MALLOC(GCNodePtr, 1);
-	np->ptr = node_i;
-
-	if (m_orphan_last != NULL)
-	{
-		m_orphan_last->next = np;
-	}
-	else
-	{
-		m_orphan_first = np;
-	}
+	m_nodes[i].parent = ORPHAN_EDGE;
+	m_orphans_front.push_back(i);
+}
 
-	m_orphan_last = np;
-	np->next = NULL;
+void GraphCut::set_orphan_rear(int32_t i)
+{
+	m_nodes[i].parent = ORPHAN_EDGE;
+	m_orphans_rear.push_back(i);
 }
 
-void GraphCut::process_orphan(GCNode* node_i, ETerminalType terminalType_tree)
+void GraphCut::process_orphan(int32_t i, ETerminalType terminalType_tree)
 {
-	GCNode* node_j;
-	GCEdge* edge0;
-	GCEdge* edge0_min = NULL;
-	GCEdge* edge;
+	int32_t j;
+	int32_t edge0;
+	int32_t edge0_min = NO_EDGE;
+	int32_t edge;
 	int32_t d;
 	int32_t d_min = INFINITE_D;
 
 	// trying to find a new parent
-	for (edge0 = node_i->first; edge0 != NULL; edge0 = edge0->next)
+	for (edge0 = m_nodes[i].first; edge0 != NO_EDGE; edge0 = m_edges[edge0].next)
 	{
-		if ((terminalType_tree == SOURCE && edge0->reverse->residual_capacity) ||
-		        (terminalType_tree == SINK && edge0->residual_capacity))
+		if ((terminalType_tree == SOURCE && m_edges[edge0 ^ 1].residual_capacity) ||
+		        (terminalType_tree == SINK && m_edges[edge0].residual_capacity))
 		{
-			node_j = edge0->head;
+			j = m_edges[edge0].head;
 
-			if (node_j->type_tree == terminalType_tree && (edge = node_j->parent) != NULL)
+			if (m_nodes[j].type_tree == terminalType_tree && (edge = m_nodes[j].parent) != NO_EDGE)
 			{
-				// check the origin of node_j
+				// check the origin of j
 				d = 0;
 				while (1)
 				{
-					if (node_j->timestamp == m_timestamp)
+					if (m_nodes[j].timestamp == m_timestamp)
 					{
-						d += node_j->dist_terminal;
+						d += m_nodes[j].dist_terminal;
 						break;
 					}
 
-					edge = node_j->parent;
+					edge = m_nodes[j].parent;
 					d++;
 
 					if (edge == TERMINAL_EDGE)
 					{
-						node_j->timestamp = m_timestamp;
-						node_j->dist_terminal = 1;
+						m_nodes[j].timestamp = m_timestamp;
+						m_nodes[j].dist_terminal = 1;
 						break;
 					}
 
@@ -884,10 +1062,10 @@ void GraphCut::process_orphan(GCNode* node_i, ETerminalType terminalType_tree)
 						break;
 					}
 
-					node_j = edge->head;
+					j = m_edges[edge].head;
 				} // while
 
-				if (d < INFINITE_D) // node_j originates from the source, done
+				if (d < INFINITE_D) // j originates from the source, done
 				{
 					if (d < d_min)
 					{
@@ -895,51 +1073,51 @@ void GraphCut::process_orphan(GCNode* node_i, ETerminalType terminalType_tree)
 						d_min = d;
 					}
 					// set marks along the path
-					for (node_j = edge0->head; node_j->timestamp != m_timestamp; node_j = node_j->parent->head)
+					for (j = m_edges[edge0].head; m_nodes[j].timestamp != m_timestamp; j = m_edges[m_nodes[j].parent].head)
 					{
-						node_j->timestamp = m_timestamp;
-						node_j->dist_terminal = d--;
+						m_nodes[j].timestamp = m_timestamp;
+						m_nodes[j].dist_terminal = d--;
 					}
 				}
 
-			} // if node_j->type_tree
-		} // if(edge0->reverse->residual_capacity)
-	} // for edge0 = node_i->first
+			} // if m_nodes[j].type_tree
+		} // if(m_edges[edge0 ^ 1].residual_capacity)
+	} // for edge0 = m_nodes[i].first
 
-	if ((node_i->parent = edge0_min) != NULL)
+	if ((m_nodes[i].parent = edge0_min) != NO_EDGE)
 	{
-		node_i->timestamp = m_timestamp;
-		node_i->dist_terminal = d_min + 1;
+		m_nodes[i].timestamp = m_timestamp;
+		m_nodes[i].dist_terminal = d_min + 1;
 	}
 	else
 	{
 		// no parent is found, process neighbors
-		for (edge0 = node_i->first; edge0 != NULL; edge0 = edge0->next)
+		for (edge0 = m_nodes[i].first; edge0 != NO_EDGE; edge0 = m_edges[edge0].next)
 		{
-			node_j = edge0->head;
+			j = m_edges[edge0].head;
 
-			if (node_j->type_tree == terminalType_tree && (edge = node_j->parent) != NULL)
+			if (m_nodes[j].type_tree == terminalType_tree && (edge = m_nodes[j].parent) != NO_EDGE)
 			{
-				bool is_active_source = (terminalType_tree == SOURCE && edge0->reverse->residual_capacity);
-				bool is_active_sink = (terminalType_tree == SINK && edge0->residual_capacity);
+				bool is_active_source = (terminalType_tree == SOURCE && m_edges[edge0 ^ 1].residual_capacity);
+				bool is_active_sink = (terminalType_tree == SINK && m_edges[edge0].residual_capacity);
 
 				if (is_active_source || is_active_sink)
 				{
-					set_active(node_j);
+					set_active(j);
 				}
 
-				if (edge != TERMINAL_EDGE && edge != ORPHAN_EDGE && edge->head == node_i)
+				if (edge != TERMINAL_EDGE && edge != ORPHAN_EDGE && m_edges[edge].head == i)
 				{
-					set_orphan_rear(node_j); // add node_j to the end of the adoptation list
+					set_orphan_rear(j); // add j to the end of the adoptation list
 				}
 			}
-		} // for edge0 = node_i->first
+		} // for edge0 = m_nodes[i].first
 	}
 }
 
 ETerminalType GraphCut::get_assignment(int32_t i, ETerminalType default_terminal)
 {
-	if (m_nodes[i].parent != NULL)
+	if (m_nodes[i].parent != NO_EDGE)
 	{
 		return m_nodes[i].type_tree;
 	}
@@ -952,60 +1130,56 @@ ETerminalType GraphCut::get_assignment(int32_t i, ETerminalType default_terminal
 void GraphCut::print_graph()
 {
 	// print SOURCE-node_i and node_i->SINK edges
-	for (int32_t i = 0; i < m_num_nodes; i++)
+	for (int32_t i = 0; i < (int32_t)m_nodes.size(); i++)
 	{
-		GCNode* node_i = m_nodes + i;
-		if (node_i->parent == TERMINAL_EDGE)
+		const GCNode& node_i = m_nodes[i];
+		if (node_i.parent == TERMINAL_EDGE)
 		{
-			if (node_i->type_tree == SOURCE)
+			if (node_i.type_tree == SOURCE)
 			{
-				io::print("\n s -> {}, cost = {}", node_i->id, node_i->tree_cap);
+				io::print("\n s -> {}, cost = {}", i, node_i.tree_cap);
 			}
 			else
 			{
-				io::print("\n {} -> t, cost = {}", node_i->id, node_i->tree_cap);
+				io::print("\n {} -> t, cost = {}", i, node_i.tree_cap);
 			}
 		}
 	}
 
 	// print node_i->node_j edges
-	for (int32_t i = 0; i < m_num_edges; i++)
+	for (int32_t e = 0; e < (int32_t)m_edges.size(); e++)
 	{
-		GCEdge* edge = m_edges + i;
-		io::print("\n {} -> {}, cost = {}", edge->reverse->head->id, edge->head->id, edge->residual_capacity);
+		io::print("\n {} -> {}, cost = {}", m_edges[e ^ 1].head, m_edges[e].head, m_edges[e].residual_capacity);
 	}
 
 }
 
 void GraphCut::print_assignment()
 {
-	for (int32_t i = 0; i < m_num_nodes; i++)
+	for (int32_t i = 0; i < (int32_t)m_nodes.size(); i++)
 	{
-		GCNode* node_i = m_nodes + i;
-
 		if (get_assignment(i) == SOURCE)
 		{
-			io::print("\nGCNode {:2d}: S", node_i->id);
+			io::print("\nGCNode {:2d}: S", i);
 		}
 		else
 		{
-			io::print("\nGCNode {:2d}: T", node_i->id);
+			io::print("\nGCNode {:2d}: T", i);
 		}
 	}
 }
 
-void GraphCut::test_consistency(GCNode* current_node)
+void GraphCut::test_consistency(int32_t current_node)
 {
-	GCNode* node_i;
-	GCEdge* edge;
+	int32_t i;
+	int32_t edge;
 	int32_t num1 = 0;
 	int32_t num2 = 0;
 
-	// test whether all nodes i with i->next!=NULL are indeed in the queue
-	for (int32_t i = 0; i < m_num_nodes; i++)
+	// test whether all nodes i with next != NO_NODE are indeed in the queue
+	for (i = 0; i < (int32_t)m_nodes.size(); i++)
 	{
-		node_i = m_nodes + i;
-		if (node_i->next || node_i == current_node)
+		if (m_nodes[i].next != NO_NODE || i == current_node)
 		{
 			num1++;
 		}
@@ -1013,20 +1187,20 @@ void GraphCut::test_consistency(GCNode* current_node)
 
 	for (int32_t r = 0; r < 3; r++)
 	{
-		node_i = (r == 2) ? current_node : m_active_first[r];
+		i = (r == 2) ? current_node : m_active_first[r];
 
-		if (node_i)
+		if (i != NO_NODE)
 		{
-			for (; ; node_i = node_i->next)
+			for (; ; i = m_nodes[i].next)
 			{
 				num2++;
 
-				if (node_i->next == node_i)
+				if (m_nodes[i].next == i)
 				{
 					if (r < 2)
-						ASSERT(node_i == m_active_last[r])
+						ASSERT(i == m_active_last[r])
 					else
-						ASSERT(node_i == current_node)
+						ASSERT(i == current_node)
 
 					break;
 				}
@@ -1036,65 +1210,68 @@ void GraphCut::test_consistency(GCNode* current_node)
 
 	ASSERT(num1 == num2);
 
-	for (int32_t i = 0; i < m_num_nodes; i++)
+	for (i = 0; i < (int32_t)m_nodes.size(); i++)
 	{
-		node_i = m_nodes + i;
+		const GCNode& node_i = m_nodes[i];
 
 		// test whether all edges in seach trees are non-saturated
-		if (node_i->parent == NULL) {}
-		else if (node_i->parent == ORPHAN_EDGE) {}
-		else if (node_i->parent == TERMINAL_EDGE)
+		if (node_i.parent == NO_EDGE) {}
+		else if (node_i.parent == ORPHAN_EDGE) {}
+		else if (node_i.parent == TERMINAL_EDGE)
 		{
-			if (node_i->type_tree == SOURCE)
-				ASSERT(node_i->tree_cap > 0)
+			if (node_i.type_tree == SOURCE)
+				ASSERT(node_i.tree_cap > 0)
 			else
-				ASSERT(node_i->tree_cap < 0)
+				ASSERT(node_i.tree_cap < 0)
 		}
 		else
 		{
-			if (node_i->type_tree == SOURCE)
-				ASSERT(node_i->parent->reverse->residual_capacity > 0)
+			if (node_i.type_tree == SOURCE)
+				ASSERT(m_edges[node_i.parent ^ 1].residual_capacity > 0)
 			else
-				ASSERT(node_i->parent->residual_capacity > 0)
+				ASSERT(m_edges[node_i.parent].residual_capacity > 0)
 		}
 
 		// test whether passive nodes in search trees have neighbors in
 		// a different tree through non-saturated edges
-		if (node_i->parent && !node_i->next)
+		if (node_i.parent != NO_EDGE && node_i.next == NO_NODE)
 		{
-			if (node_i->type_tree == SOURCE)
+			if (node_i.type_tree == SOURCE)
 			{
-				ASSERT(node_i->tree_cap >= 0);
+				ASSERT(node_i.tree_cap >= 0);
 
-				for (edge = node_i->first; edge; edge = edge->next)
+				for (edge = node_i.first; edge != NO_EDGE; edge = m_edges[edge].next)
 				{
-					if (edge->residual_capacity > 0)
+					if (m_edges[edge].residual_capacity > 0)
 					{
-						ASSERT(edge->head->parent && edge->head->type_tree == SOURCE);
+						const GCNode& node_j = m_nodes[m_edges[edge].head];
+						ASSERT(node_j.parent != NO_EDGE && node_j.type_tree == SOURCE);
 					}
 				}
 			}
 			else
 			{
-				ASSERT(node_i->tree_cap <= 0);
+				ASSERT(node_i.tree_cap <= 0);
 
-				for (edge = node_i->first; edge; edge = edge->next)
+				for (edge = node_i.first; edge != NO_EDGE; edge = m_edges[edge].next)
 				{
-					if (edge->reverse->residual_capacity > 0)
+					if (m_edges[edge ^ 1].residual_capacity > 0)
 					{
-						ASSERT(edge->head->parent && (edge->head->type_tree == SINK));
+						const GCNode& node_j = m_nodes[m_edges[edge].head];
+						ASSERT(node_j.parent != NO_EDGE && (node_j.type_tree == SINK));
 					}
 				}
 			}
 		}
 		// test marking invariants
-		if (node_i->parent && node_i->parent != ORPHAN_EDGE && node_i->parent != TERMINAL_EDGE)
+		if (node_i.parent != NO_EDGE && node_i.parent != ORPHAN_EDGE && node_i.parent != TERMINAL_EDGE)
 		{
-			ASSERT(node_i->timestamp <= node_i->parent->head->timestamp);
+			const GCNode& node_j = m_nodes[m_edges[node_i.parent].head];
+			ASSERT(node_i.timestamp <= node_j.timestamp);
 
-			if (node_i->timestamp == node_i->parent->head->timestamp)
+			if (node_i.timestamp == node_j.timestamp)
 			{
-				ASSERT(node_i->dist_terminal > node_i->parent->head->dist_terminal);
+				ASSERT(node_i.dist_terminal > node_j.dist_terminal);
 			}
 		}
 	}
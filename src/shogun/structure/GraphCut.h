@@ -14,9 +14,15 @@
 #include <shogun/structure/Factor.h>
 #include <shogun/structure/MAPInference.h>
 
-/* special constants for node->parent. */
-#define TERMINAL_EDGE ( (GCEdge *) 1 ) // to terminal
-#define ORPHAN_EDGE   ( (GCEdge *) 2 ) // orphan
+#include <vector>
+
+/* special constants for node->parent, node->first and edge->next. */
+#define NO_EDGE       -1 // none, a node without parent is free
+#define TERMINAL_EDGE -2 // to terminal
+#define ORPHAN_EDGE   -3 // orphan
+
+/* special constant for node->next. */
+#define NO_NODE       -1 // not in the active list
 
 #define INFINITE_D 1000000000 // infinite distance to the terminal
 
@@ -31,20 +37,18 @@ enum ETerminalType
 	SINK = 1
 };
 
-struct GCNode;
 /** @brief Graph cuts edge
  *
+ * Edges are stored in pairs, the reverse of edge e is edge e ^ 1.
  */
 struct GCEdge
 {
-	/** edge id */
-	int32_t id;
 	/** node the edge point to */
-	GCNode* head;
+	int32_t head;
 	/** next edge with the same originated node */
-	GCEdge* next;
-	/** reverse edge */
-	GCEdge* reverse;
+	int32_t next;
+	/** capacity */
+	float64_t capacity;
 	/** residual capacity */
 	float64_t residual_capacity;
 };
@@ -54,39 +58,28 @@ struct GCEdge
  */
 struct GCNode
 {
-	/** node id */
-	int32_t id;
 	/** first outcoming edge */
-	GCEdge* first;
-	/** node's parent */
-	GCEdge* parent;
-	/** pointer to the next active node
+	int32_t first;
+	/** node's parent edge */
+	int32_t parent;
+	/** the next active node
 	 * (or itself if it is the last node in the list)
 	 */
-	GCNode* next;
+	int32_t next;
 	/** timestamp showing when dist_to_terminal was computed */
 	int32_t timestamp;
 	/** distance to the terminal */
 	int32_t dist_terminal;
 	/** the type of the tree that the node belongs to */
 	ETerminalType type_tree;
+	/** whether its capacities changed since the last max flow */
+	bool is_marked;
 	/** if tree_cap > 0 then tree_cap is residual capacity
 	 * of the edge SOURCE->node otherwise -tree_cap is
 	 * residual capacity of the edge node->SINK */
 	float64_t tree_cap;
 };
 
-/** @brief Graph guts node pointer
- *
- */
-struct GCNodePtr
-{
-	/** pointer of the node */
-	GCNode* ptr;
-	/** point to the next */
-	GCNodePtr* next;
-};
-
 /** Graph cuts inference for fatcor graph using V. Kolmogorov's max-flow/min-cut algorithm
  *
  * Please refer to the paper for more details:
@@ -95,6 +88,20 @@ struct GCNodePtr
  * Yuri Boykov and Vladimir Kolmogorov.
  * In IEEE Transactions on Pattern Analysis and Machine Intelligence (PAMI), 2004.
  *
+ * The s-t graph can be changed after a max flow was computed, by
+ * add_tweights() and set_edge_capacity(), and the max flow of the changed
+ * graph computed from the previous flow and search trees, which only have
+ * to be repaired around the nodes whose capacities changed:
+ *
+ * "Dynamic Graph Cuts for Efficient Inference in Markov Random Fields."
+ * Pushmeet Kohli and Philip H. S. Torr.
+ * In IEEE Transactions on Pattern Analysis and Machine Intelligence (PAMI), 2007.
+ *
+ * Inference on a factor graph reuses them after its first call: the
+ * capacities are computed from the current energies of the factors, so
+ * calling it again after the energies changed, e.g. by loss augmentation,
+ * only repairs the flow where the capacities differ.
+ *
  * Currently, only binary lablel is supported, factor order <= 3
  */
 class GraphCut : public MAPInferImpl
@@ -114,6 +121,8 @@ public:
 	 * 1. use add_tweight and add_edges to add nodes and edges to the s-t graph
 	 * 2. init_maxflow()
 	 * 3. compute_maxflow()
+	 * after which capacities can be changed and the max flow computed
+	 * again with init_maxflow(true) and compute_maxflow()
 	 *
 	 * @param num_nodes number of nodes in the s-t graph (SOURCE and SINK nodes are not included)
 	 * @param num_edges number of edges in the s-t graph (the edges connecting to the SOURCE and SINK are not included)
@@ -155,8 +164,20 @@ public:
 	 * @param j node id j
 	 * @param capacity edge capacity
 	 * @param reverse_capacity reverse edge capacity
+	 * @return edge id
 	 */
-	void add_edge(int32_t i, int32_t j, float64_t capacity, float64_t reverse_capacity);
+	int32_t add_edge(int32_t i, int32_t j, float64_t capacity, float64_t reverse_capacity);
+
+	/** Changes the capacities of an edge. If the flow along the edge
+	 * exceeds the new capacity, the excess is added to the capacities of
+	 * the edges SOURCE->i, i->j and j->SINK and subtracted from j->i, which
+	 * adds it to the capacity of every cut, and is subtracted from the flow.
+	 *
+	 * @param edge edge id returned by add_edge()
+	 * @param capacity new edge capacity
+	 * @param reverse_capacity new reverse edge capacity
+	 */
+	void set_edge_capacity(int32_t edge, float64_t capacity, float64_t reverse_capacity);
 
 	/** Adds new edges 'SOURCE->i' and 'i->SINK' with corresponding weights.
 	 * Can be called multiple times for each node. Weights can be negative.
@@ -169,8 +190,13 @@ public:
 	 */
 	void add_tweights(int32_t i, float64_t cap_source, float64_t cap_sink);
 
-	/** Initialize max flow, call this function after adding nodes and edges */
-	void init_maxflow();
+	/** Initialize max flow, call this function after adding nodes and edges
+	 *
+	 * @param reuse_trees whether to keep the search trees of the previous
+	 * max flow and only repair them around the nodes whose capacities
+	 * changed since, which is much faster if few capacities changed
+	 */
+	void init_maxflow(bool reuse_trees = false);
 
 	/** Compute the maxflow
 	 *
@@ -223,58 +249,91 @@ private:
 	/** Initialize graph cuts */
 	void init();
 
-	/** Add a factor to the s-t graph
+	/** Computes the capacities of the current factor energies and
+	 * changes the s-t graph to them, which creates it on the first call
+	 */
+	void update_capacities();
+
+	/** Add a factor to the capacities of the s-t graph
 	 * More details about this function can be found in section 4 and section 5 in
 	 * V. Kolmogorov, and R. Zabin. "What energy functions can be minimized via graph cuts?."
 	 * T-PAMI. 2004.
 	 *
 	 * @param factor the factor to add
+	 * @param aux_node node of the factor in the s-t graph (for factor order = 3)
+	 * @param edge id of the next edge of the factors
+	 */
+	void add_factor(const std::shared_ptr<Factor>& factor, int32_t aux_node, int32_t& edge);
+
+	/** Add a terminal capacity to m_new_terminal_caps
+	 *
+	 * @param i node id
+	 * @param cap_source SOURCE->i capacity
+	 * @param cap_sink i->SINK capacity
+	 */
+	void add_factor_tweights(int32_t i, float64_t cap_source, float64_t cap_sink);
+
+	/** Set the capacities of the next edge in m_new_edge_caps, the edges are
+	 * created on the first call
+	 *
+	 * @param i node id i
+	 * @param j node id j
+	 * @param capacity edge capacity
+	 * @param reverse_capacity reverse edge capacity
+	 * @param edge edge id, incremented
 	 */
-	void add_factor(const std::shared_ptr<Factor>& factor);
+	void add_factor_edge(int32_t i, int32_t j, float64_t capacity, float64_t reverse_capacity, int32_t& edge);
 
-	/** Get the triple node id in s-t graph (for factor order = 3)
+	/** Marks a node whose capacities changed, for init_maxflow(true)
 	 *
-	 * @param triple triple is a vector contains the id of three nodes
-	 * @return the id of triple node in the s-t graph
+	 * @param i node id
 	 */
-	int32_t get_tripleId(SGVector<int32_t> triple);
+	void mark_node(int32_t i);
+
+	/** Repair the search trees of the previous max flow around the
+	 * marked nodes
+	 */
+	void repair_trees();
 
 	/** Add a node to the active list
 	 *
-	 * node_i->next points to the next node in the list
-	 * (or to node_i, if node_i is the last node in the list).
-	 * If node_i->next is NULL iff node_i is not in the list.
+	 * node_i.next is the next node in the list
+	 * (or i, if node_i is the last node in the list).
+	 * node_i.next is NO_NODE iff node_i is not in the list.
 	 *
 	 * There are two queues. Active nodes are added to the end
 	 * of the second queue and read from the front of the first
 	 * queue. If the first queue is empty, it is replaced by the
 	 * second queue(and the second queue becomes empty).
 	 *
-	 * @param node_i the node to add
+	 * @param i the node to add
 	 */
-	void set_active(GCNode* node_i);
+	void set_active(int32_t i);
 
 	/** Get an active node next to the current node from the list */
-	GCNode* next_active();
+	int32_t next_active();
 
 	/** Add node to the beginning of the orphan list
 	 *
-	 * @param node_i the node to add
+	 * @param i the node to add
 	 */
-	void set_orphan_front(GCNode* node_i);
+	void set_orphan_front(int32_t i);
 
 	/** Add node to the end of the orphan list
 	 *
-	 * @param node_i the node to add
+	 * @param i the node to add
 	 */
-	void set_orphan_rear(GCNode* node_i);
+	void set_orphan_rear(int32_t i);
 
 	/** Process an orphan node
 	 *
-	 * @param node_i the node to process
+	 * @param i the node to process
 	 * @param terminalType_tree SOURCE or SINK tree
 	 */
-	void process_orphan(GCNode* node_i, ETerminalType terminalType_tree);
+	void process_orphan(int32_t i, ETerminalType terminalType_tree);
+
+	/** Process the orphans at the end of the orphan list, in order */
+	void process_orphans_rear();
 
 	/** Grow to add node to active set
 	 *
@@ -283,19 +342,19 @@ private:
 	 *
 	 * @return true if the next active node is found otherwise false
 	 */
-	bool grow(GCEdge* &edge, GCNode* &current_node);
+	bool grow(int32_t& edge, int32_t& current_node);
 
 	/** Augment the source->sink path
 	 *
 	 * @param connecting_edge the edge connecting a source->sink path
 	 */
-	void augment_path(GCEdge* connecting_edge);
+	void augment_path(int32_t connecting_edge);
 
 	/** Adopt orphan nodes */
 	void adopt();
 
 	/** Test the consistency of the graph, for debug mode */
-	void test_consistency(GCNode* current_node = NULL);
+	void test_consistency(int32_t current_node = NO_NODE);
 protected:
 	/** the total energy of the factor graph */
 	float64_t m_map_energy;
@@ -305,34 +364,37 @@ private:
 	int32_t m_num_variables;
 	/** statistic of the number of the factors at order [1, 2, 3] */
 	SGVector<int32_t> m_num_factors_at_order;
-	/** list of triple nodes, for order-3 factors */
-	std::vector< SGVector<int32_t> > m_triple_list;
+
+	/** terminal capacities of the factors, SOURCE->i minus i->SINK */
+	std::vector<float64_t> m_terminal_caps;
+	/** terminal capacities of the current factor energies */
+	std::vector<float64_t> m_new_terminal_caps;
+	/** edge and reverse edge capacities of the current factor energies */
+	std::vector<float64_t> m_new_edge_caps;
 
 	/** nodes in the st graph */
-	GCNode*		m_nodes;
-	/** number of nodes */
-	int32_t		m_num_nodes;
+	std::vector<GCNode> m_nodes;
 	/** edges in the st graph */
-	GCEdge*		m_edges;
-	/** point to the end of the added edges */
-	GCEdge*		m_edges_last;
-	/** number of edges */
-	int32_t		m_num_edges;
+	std::vector<GCEdge> m_edges;
 
 	/** total flow */
 	float64_t	m_flow;
 	/** timestamp */
 	int32_t		m_timestamp;
+	/** whether the search trees are those of a max flow */
+	bool		m_has_trees;
 
 	/** list of active nodes */
-	GCNode*		m_active_first[2];
+	int32_t		m_active_first[2];
 	/** list of active nodes */
-	GCNode*		m_active_last[2];
-
-	/** list of pointers to orphans */
-	GCNodePtr*	m_orphan_first;
-	/** list of pointers to orphans */
-	GCNodePtr*	m_orphan_last;
+	int32_t		m_active_last[2];
+
+	/** orphans to process, the last one first */
+	std::vector<int32_t> m_orphans_front;
+	/** orphans to process in order, after the one being processed */
+	std::vector<int32_t> m_orphans_rear;
+	/** nodes whose capacities changed since the last max flow */
+	std::vector<int32_t> m_marked_nodes;
 };
 
 }
@@ -77,16 +77,20 @@ SGVector< float64_t > HMSVMModel::get_joint_feature_vector(
 
 	// Translate from labels sequence to state sequence
 	SGVector< int32_t > state_seq = m_state_model->labels_to_states(label_seq);
-	m_transmission_weights.zero();
+	// count in local tables, the members hold the weights used in Viterbi
+	SGMatrix< float64_t > transmission_weights(
+			m_transmission_weights.num_rows, m_transmission_weights.num_cols);
+	transmission_weights.zero();
 
 	for ( int32_t i = 0 ; i < state_seq.vlen-1 ; ++i )
-		m_transmission_weights(state_seq[i],state_seq[i+1]) += 1;
+		transmission_weights(state_seq[i],state_seq[i+1]) += 1;
 
 	SGMatrix< float64_t > obs = mf->get_feature_vector(feat_idx);
 	require(obs.num_rows == D && obs.num_cols == state_seq.vlen,
 		"obs.num_rows ({}) != D ({}) OR obs.num_cols ({}) != state_seq.vlen ({})",
 		obs.num_rows, D, obs.num_cols, state_seq.vlen);
-	m_emission_weights.zero();
+	SGVector< float64_t > emission_weights(m_emission_weights.vlen);
+	emission_weights.zero();
 	index_t aux_idx, weight_idx;
 
 	if ( !m_use_plifs )	// Do not use PLiFs
@@ -98,11 +102,11 @@ SGVector< float64_t > HMSVMModel::get_joint_feature_vector(
 			for ( int32_t j = 0 ; j < state_seq.vlen ; ++j )
 			{
 				weight_idx = aux_idx + state_seq[j]*D*m_num_obs + obs(f,j);
-				m_emission_weights[weight_idx] += 1;
+				emission_weights[weight_idx] += 1;
 			}
 		}
 
-		m_state_model->weights_to_vector(psi, m_transmission_weights, m_emission_weights,
+		m_state_model->weights_to_vector(psi, transmission_weights, emission_weights,
 				D, m_num_obs);
 	}
 	else	// Use PLiFs
@@ -133,15 +137,15 @@ SGVector< float64_t > HMSVMModel::get_joint_feature_vector(
 				weight_idx = aux_idx + state_seq[j]*D*m_num_plif_nodes;
 
 				if ( count == 0 )
-					m_emission_weights[weight_idx] += 1;
+					emission_weights[weight_idx] += 1;
 				else if ( count == m_num_plif_nodes )
-					m_emission_weights[weight_idx + m_num_plif_nodes-1] += 1;
+					emission_weights[weight_idx + m_num_plif_nodes-1] += 1;
 				else
 				{
-					m_emission_weights[weight_idx + count] +=
+					emission_weights[weight_idx + count] +=
 						(value-limits[count-1]) / (limits[count]-limits[count-1]);
 
-					m_emission_weights[weight_idx + count-1] +=
+					emission_weights[weight_idx + count-1] +=
 						(limits[count]-value) / (limits[count]-limits[count-1]);
 				}
 
@@ -149,7 +153,7 @@ SGVector< float64_t > HMSVMModel::get_joint_feature_vector(
 			}
 		}
 
-		m_state_model->weights_to_vector(psi, m_transmission_weights, m_emission_weights,
+		m_state_model->weights_to_vector(psi, transmission_weights, emission_weights,
 				D, m_num_plif_nodes);
 	}
 
@@ -189,10 +193,12 @@ std::shared_ptr<ResultSet> HMSVMModel::argmax(
 	SGMatrix< float64_t > E(S, T);
 	E.zero();
 
+	// Weights used in Viterbi
+	w_to_params(w);
+
 	if ( !m_use_plifs )	// Do not use PLiFs
 	{
 		index_t em_idx;
-		m_state_model->reshape_emission_params(m_emission_weights, w, D, m_num_obs);
 
 		for ( int32_t i = 0 ; i < T ; ++i )
 		{
@@ -208,8 +214,6 @@ std::shared_ptr<ResultSet> HMSVMModel::argmax(
 	}
 	else	// Use PLiFs
 	{
-		m_state_model->reshape_emission_params(m_plif_matrix, w, D, m_num_plif_nodes);
-
 		for ( int32_t i = 0 ; i < T ; ++i )
 		{
 			for ( int32_t f = 0 ; f < D ; ++f )
@@ -248,7 +252,6 @@ std::shared_ptr<ResultSet> HMSVMModel::argmax(
 	// Initialize the dynamic programming table and the traceback matrix
 	SGMatrix< float64_t >  dp(T, S);
 	SGMatrix< float64_t > trb(T, S);
-	m_state_model->reshape_transmission_params(m_transmission_weights, w);
 
 	for ( int32_t s = 0 ; s < S ; ++s )
 	{
@@ -481,6 +484,31 @@ bool HMSVMModel::check_training_setup() const
 	return true;
 }
 
+bool HMSVMModel::init_argmax_batch(SGVector<float64_t> w, bool const training)
+{
+	// argmax finds the weights set and only reads them
+	w_to_params(w);
+
+	return true;
+}
+
+void HMSVMModel::w_to_params(SGVector<float64_t> w)
+{
+	// if nothing changed
+	if ( m_w_cache.equals(w) )
+		return;
+
+	m_w_cache = w.clone();
+	int32_t D = m_features->as<MatrixFeatures<float64_t>>()->get_num_features();
+
+	if ( !m_use_plifs )
+		m_state_model->reshape_emission_params(m_emission_weights, w, D, m_num_obs);
+	else
+		m_state_model->reshape_emission_params(m_plif_matrix, w, D, m_num_plif_nodes);
+
+	m_state_model->reshape_transmission_params(m_transmission_weights, w);
+}
+
 void HMSVMModel::init()
 {
 	SG_ADD((std::shared_ptr<SGObject>*) &m_state_model, "m_state_model", "The state model");
@@ -543,6 +571,7 @@ void HMSVMModel::init_training()
 		m_emission_weights = SGVector< float64_t >(S*D*m_num_plif_nodes);
 	else
 		m_emission_weights = SGVector< float64_t >(S*D*m_num_obs);
+	m_w_cache = SGVector< float64_t >();
 
 	// Auxiliary variables
 
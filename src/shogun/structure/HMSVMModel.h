@@ -168,10 +168,28 @@ class HMSVMModel : public StructuredModel
 		 */
 		virtual const char* get_name() const { return "HMSVMModel"; }
 
+	protected:
+		/** sets the weights used in Viterbi from w, argmax is then safe to
+		 * call concurrently
+		 *
+		 * @param w weight vector
+		 * @param training true if argmax is called during training
+		 *
+		 * @return true
+		 */
+		virtual bool init_argmax_batch(SGVector<float64_t> w, bool const training);
+
 	private:
 		/* internal initialization */
 		void init();
 
+		/** reshapes w into the transmission and emission weights, or the
+		 * PLiFs, used in Viterbi unless they were set from the same w
+		 *
+		 * @param w weight vector
+		 */
+		void w_to_params(SGVector<float64_t> w);
+
 	private:
 		/** in case of discrete observations, the cardinality of the space of observations */
 		int32_t m_num_obs;
@@ -191,6 +209,9 @@ class HMSVMModel : public StructuredModel
 		/** emission weights used in Viterbi */
 		SGVector< float64_t > m_emission_weights;
 
+		/** weight vector the weights used in Viterbi were set from */
+		SGVector< float64_t > m_w_cache;
+
 		/** number of supporting points for each PLiF */
 		int32_t m_num_plif_nodes;
 
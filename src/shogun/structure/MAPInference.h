@@ -70,6 +70,9 @@ public:
 	/** @return minimized energy */
 	float64_t get_energy() const;
 
+	/** @return factor graph */
+	std::shared_ptr<FactorGraph> get_factor_graph() const;
+
 private:
 	/** register parameters and initialize members */
 	void init();
@@ -62,6 +62,14 @@ SGVector< float64_t > MulticlassModel::get_joint_feature_vector(int32_t feat_idx
 	return psi;
 }
 
+bool MulticlassModel::init_argmax_batch(SGVector<float64_t> w, bool const training)
+{
+	if ( training )
+		m_num_classes = m_labels->as<MulticlassSOLabels>()->get_num_classes();
+
+	return true;
+}
+
 std::shared_ptr<ResultSet> MulticlassModel::argmax(
 		SGVector< float64_t > w,
 		int32_t feat_idx,
@@ -73,7 +81,10 @@ std::shared_ptr<ResultSet> MulticlassModel::argmax(
 	if ( training )
 	{
 		auto ml = m_labels->as<MulticlassSOLabels>();
-		m_num_classes = ml->get_num_classes();
+		// set once by init_argmax_batch for concurrent calls, which then
+		// only read it
+		if ( m_num_classes != ml->get_num_classes() )
+			m_num_classes = ml->get_num_classes();
 	}
 	else
 	{
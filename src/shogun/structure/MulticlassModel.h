@@ -106,6 +106,17 @@ class MulticlassModel : public StructuredModel
 		/** @return name of SGSerializable */
 		virtual const char* get_name() const { return "MulticlassModel"; }
 
+	protected:
+		/** sets the number of classes, argmax is then safe to call
+		 * concurrently
+		 *
+		 * @param w weight vector
+		 * @param training true if argmax is called during training
+		 *
+		 * @return true
+		 */
+		virtual bool init_argmax_batch(SGVector<float64_t> w, bool const training);
+
 	private:
 		void init();
 
@@ -198,6 +198,22 @@ float64_t Plif::lookup_penalty(int32_t p_value, float64_t* svm_values) const
 	return lookup_penalty((float64_t) p_value, svm_values) ;
 }
 
+float64_t Plif::lookup_penalty_value_part(int32_t p_value) const
+{
+	if (use_svm)
+		return 0.0 ;
+
+	return lookup_penalty(p_value, NULL) ;
+}
+
+float64_t Plif::lookup_penalty_svm_part(int32_t p_value, float64_t* svm_values) const
+{
+	if (!use_svm)
+		return 0.0 ;
+
+	return lookup_penalty_svm(p_value, svm_values) ;
+}
+
 float64_t Plif::lookup_penalty(float64_t p_value, float64_t* svm_values) const
 {
 	if (use_svm)
@@ -73,6 +73,23 @@ class Plif: public PlifBase
 		 */
 		float64_t lookup_penalty(int32_t p_value, float64_t* svm_values) const;
 
+		/** lookup the part of the penalty that does not depend on
+		 * SVM values
+		 *
+		 * @param p_value value
+		 * @return the penalty, zero if the PLiF uses SVM values
+		 */
+		virtual float64_t lookup_penalty_value_part(int32_t p_value) const;
+
+		/** lookup the part of the penalty that depends on SVM values
+		 *
+		 * @param p_value value
+		 * @param svm_values SVM values
+		 * @return the penalty, zero if the PLiF does not use SVM values
+		 */
+		virtual float64_t lookup_penalty_svm_part(
+			int32_t p_value, float64_t* svm_values) const;
+
 		/** lookup
 		 *
 		 * @param p_value value
@@ -97,6 +97,27 @@ float64_t PlifArray::lookup_penalty(
 	return ret ;
 }
 
+float64_t PlifArray::lookup_penalty_value_part(int32_t p_value) const
+{
+	if (p_value<min_value || p_value>max_value)
+		return -Math::INFTY ;
+
+	float64_t ret = 0.0 ;
+	for (int32_t i=0; i<m_array.size(); i++)
+		ret += m_array[i]->lookup_penalty_value_part(p_value) ;
+	return ret ;
+}
+
+float64_t PlifArray::lookup_penalty_svm_part(
+	int32_t p_value, float64_t* svm_values) const
+{
+	float64_t ret = 0.0 ;
+	for (int32_t i=0; i<m_array.size(); i++)
+		if (m_array[i]->uses_svm_values())
+			ret += m_array[i]->lookup_penalty_svm_part(p_value, svm_values) ;
+	return ret ;
+}
+
 void PlifArray::penalty_clear_derivative()
 {
 	for (int32_t i=0; i<m_array.size(); i++)
@@ -58,6 +58,21 @@ class PlifArray: public PlifBase
 		virtual float64_t lookup_penalty(
 			int32_t p_value, float64_t* svm_values) const;
 
+		/** lookup the summed penalty of the PLiFs not using SVM values
+		 *
+		 * @param p_value value
+		 * @return penalty, -INFTY if the value is out of range
+		 */
+		virtual float64_t lookup_penalty_value_part(int32_t p_value) const;
+
+		/** lookup the summed penalty of the PLiFs using SVM values
+		 *
+		 * @param p_value value
+		 * @param svm_values SVM values
+		 */
+		virtual float64_t lookup_penalty_svm_part(
+			int32_t p_value, float64_t* svm_values) const;
+
 		/** penalty clear derivative */
 		virtual void penalty_clear_derivative();
 
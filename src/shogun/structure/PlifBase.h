@@ -45,6 +45,31 @@ class PlifBase : public SGObject
 		virtual float64_t lookup_penalty(
 			int32_t p_value, float64_t* svm_values) const =0;
 
+		/** lookup the part of the penalty that depends on the
+		 * value only, i.e. without the PLiFs using SVM values
+		 *
+		 * abstract base method
+		 *
+		 * lookup_penalty(p, svm) equals the sum of this part and
+		 * lookup_penalty_svm_part(p, svm), which allows to tabulate
+		 * this part over all values once
+		 *
+		 * @param p_value value
+		 * @return penalty part, -INFTY if the value is out of range
+		 */
+		virtual float64_t lookup_penalty_value_part(int32_t p_value) const = 0;
+
+		/** lookup the part of the penalty computed from SVM values
+		 *
+		 * abstract base method
+		 *
+		 * @param p_value value
+		 * @param svm_values SVM values
+		 * @return penalty part, zero if no SVM values are used
+		 */
+		virtual float64_t lookup_penalty_svm_part(
+			int32_t p_value, float64_t* svm_values) const = 0;
+
 		/** penalty clear derivative
 		 *
 		 * abstrace base method
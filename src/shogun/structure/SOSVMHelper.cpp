@@ -57,10 +57,14 @@ float64_t SOSVMHelper::primal_objective(SGVector<float64_t> w, const std::shared
 	int32_t N = labels->get_num_labels();
 
 
+	SGVector<int32_t> examples(N);
+	examples.range_fill();
+	auto results = model->argmax_batch(w, examples);
+
 	for (int32_t i = 0; i < N; i++)
 	{
-		// solve the loss-augmented inference for point i
-		auto result = model->argmax(w, i);
+		// the loss-augmented inference for point i
+		const auto& result = results[i];
 
 		// hinge loss for point i
 		float64_t hinge_loss_i = result->score;
@@ -88,10 +92,14 @@ float64_t SOSVMHelper::average_loss(SGVector<float64_t> w, const std::shared_ptr
 	int32_t N = labels->get_num_labels();
 
 
+	SGVector<int32_t> examples(N);
+	examples.range_fill();
+	auto results = model->argmax_batch(w, examples, is_ub);
+
 	for (int32_t i = 0; i < N; i++)
 	{
-		// solve the standard inference for point i
-		auto result = model->argmax(w, i, is_ub);
+		// the standard inference for point i
+		const auto& result = results[i];
 
 		loss += result->delta;
 
@@ -11,6 +11,8 @@
 #include <shogun/structure/StochasticSOSVM.h>
 #include <shogun/mathematics/UniformIntDistribution.h>
 
+#include <limits>
+
 using namespace shogun;
 
 StochasticSOSVM::StochasticSOSVM()
@@ -45,11 +47,13 @@ void StochasticSOSVM::init()
 	SG_ADD(&m_num_iter, "num_iter", "Number of iterations");
 	SG_ADD(&m_do_weighted_averaging, "do_weighted_averaging", "Do weighted averaging");
 	SG_ADD(&m_debug_multiplier, "debug_multiplier", "Debug multiplier");
+	SG_ADD(&m_batch_size, "batch_size", "Number of examples per step");
 
 	m_lambda = 1.0;
 	m_num_iter = 50;
 	m_do_weighted_averaging = true;
 	m_debug_multiplier = 0;
+	m_batch_size = 1;
 }
 
 StochasticSOSVM::~StochasticSOSVM()
@@ -81,6 +85,9 @@ bool StochasticSOSVM::train_machine(std::shared_ptr<Features> data)
 	require(M > 0, "StochasticSOSVM underlying model has not been initialized properly."
 		"Expected number of dimensions to be greater than 0.");
 
+	require(m_batch_size > 0, "The number of examples per step ({}) must be "
+		"greater than 0.", m_batch_size);
+
 	// Initialize the weight vector
 	m_w = SGVector<float64_t>(M);
 	m_w.zero();
@@ -95,7 +102,7 @@ bool StochasticSOSVM::train_machine(std::shared_ptr<Features> data)
 		m_helper = std::make_shared<SOSVMHelper>();
 	}
 
-	int32_t debug_iter = 1;
+	int64_t debug_iter = 1;
 	if (m_debug_multiplier == 0)
 	{
 		debug_iter = N;
@@ -107,36 +114,46 @@ bool StochasticSOSVM::train_machine(std::shared_ptr<Features> data)
 	UniformIntDistribution<int32_t> uniform_int_dist;
 	for (auto pi : SG_PROGRESS(range(m_num_iter)))
 	{
-		for (int32_t si = 0; si < N; ++si)
+		for (int32_t si = 0; si < N; si += m_batch_size)
 		{
-			// 1) Picking random example
-			int32_t i = uniform_int_dist(m_prng, {0, N-1});
+			// 1) Picking random examples
+			SGVector<int32_t> batch(Math::min(m_batch_size, N - si));
+			for (auto& i : batch)
+				i = uniform_int_dist(m_prng, {0, N-1});
 
-			// 2) solve the loss-augmented inference for point i
-			auto result = m_model->argmax(m_w, i);
+			// 2) solve the loss-augmented inference for the examples
+			auto results = m_model->argmax_batch(m_w, batch);
 
-			// 3) get the subgradient
+			// 3) get the average subgradient
 			// psi_i(y) := phi(x_i,y_i) - phi(x_i, y)
 			SGVector<float64_t> psi_i(M);
 			SGVector<float64_t> w_s(M);
+			psi_i.zero();
 
-			if (result->psi_computed)
-			{
-				SGVector<float64_t>::add(psi_i.vector,
-					1.0, result->psi_truth.vector, -1.0, result->psi_pred.vector,
-					psi_i.vlen);
-			}
-			else if(result->psi_computed_sparse)
+			for (const auto& result : results)
 			{
-				psi_i.zero();
-				result->psi_pred_sparse.add_to_dense(1.0, psi_i.vector, psi_i.vlen);
-				result->psi_truth_sparse.add_to_dense(-1.0, psi_i.vector, psi_i.vlen);
-			}
-			else
-			{
-				error("model({}) should have either of psi_computed or psi_computed_sparse"
-						"to be set true", m_model->get_name());
+				if (result->psi_computed)
+				{
+					SGVector<float64_t>::add(psi_i.vector,
+						1.0, psi_i.vector, 1.0, result->psi_truth.vector,
+						psi_i.vlen);
+					SGVector<float64_t>::add(psi_i.vector,
+						1.0, psi_i.vector, -1.0, result->psi_pred.vector,
+						psi_i.vlen);
+				}
+				else if(result->psi_computed_sparse)
+				{
+					result->psi_pred_sparse.add_to_dense(1.0, psi_i.vector, psi_i.vlen);
+					result->psi_truth_sparse.add_to_dense(-1.0, psi_i.vector, psi_i.vlen);
+				}
+				else
+				{
+					error("model({}) should have either of psi_computed or psi_computed_sparse"
+							"to be set true", m_model->get_name());
+				}
 			}
+			if (batch.vlen > 1)
+				psi_i.scale(1.0 / batch.vlen);
 
 			w_s = psi_i.clone();
 			w_s.scale(1.0 / (N*m_lambda));
@@ -160,7 +177,7 @@ bool StochasticSOSVM::train_machine(std::shared_ptr<Features> data)
 
 
 			// Debug: compute objective and training error
-			if (m_verbose && k == debug_iter)
+			if (m_verbose && int64_t(k) * m_batch_size >= debug_iter)
 			{
 				SGVector<float64_t> w_debug;
 				if (m_do_weighted_averaging)
@@ -174,9 +191,16 @@ bool StochasticSOSVM::train_machine(std::shared_ptr<Features> data)
 				SG_DEBUG("pass {} (iteration {}), SVM primal = {}, train_error = {} ",
 					pi, k, primal, train_error);
 
-				m_helper->add_debug_info(primal, (1.0*k) / N, train_error);
+				m_helper->add_debug_info(primal, (1.0*k*m_batch_size) / N, train_error);
 
-				debug_iter = Math::min(debug_iter+N, debug_iter*(1+m_debug_multiplier/100));
+				/* a batch can step over several scheduled iterations, a
+				 * schedule that does not grow stops, as with single examples */
+				int64_t num_examples = int64_t(k) * m_batch_size;
+				while (debug_iter <= num_examples)
+				{
+					int64_t next_iter = Math::min(debug_iter+N, debug_iter*(1+m_debug_multiplier/100));
+					debug_iter = next_iter > debug_iter ? next_iter : std::numeric_limits<int64_t>::max();
+				}
 			}
 		}
 	}
@@ -221,3 +245,13 @@ void StochasticSOSVM::set_debug_multiplier(int32_t multiplier)
 	m_debug_multiplier = multiplier;
 }
 
+int32_t StochasticSOSVM::get_batch_size() const
+{
+	return m_batch_size;
+}
+
+void StochasticSOSVM::set_batch_size(int32_t batch_size)
+{
+	m_batch_size = batch_size;
+}
+
@@ -82,6 +82,17 @@ public:
 	 */
 	void set_debug_multiplier(int32_t multiplier);
 
+	/** @return number of examples per step */
+	int32_t get_batch_size() const;
+
+	/** set number of examples per step; their loss-augmented inference
+	 * is solved concurrently, see StructuredModel::argmax_batch, and
+	 * the step is taken along their average subgradient
+	 *
+	 * @param batch_size number of examples per step
+	 */
+	void set_batch_size(int32_t batch_size);
+
 protected:
 	/** train primal SO-SVM
 	 *
@@ -112,6 +123,9 @@ private:
 	 */
 	int32_t m_debug_multiplier;
 
+	/** Number of examples per step (default: 1) */
+	int32_t m_batch_size;
+
 }; /* CStochasticSOSVM */
 
 } /* namespace shogun */
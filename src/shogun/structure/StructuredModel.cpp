@@ -5,8 +5,11 @@
  *          Soeren Sonnenburg, Viktor Gal, Abinash Panda, Michal Uricar
  */
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/structure/StructuredModel.h>
 
+#include <algorithm>
+#include <exception>
 #include <utility>
 
 using namespace shogun;
@@ -155,6 +158,59 @@ float64_t StructuredModel::delta_loss(std::shared_ptr<StructuredData> y1, std::s
 	return 0.0;
 }
 
+std::vector<std::shared_ptr<ResultSet>> StructuredModel::argmax_batch(
+		SGVector<float64_t> w, SGVector<int32_t> feat_idx, bool const training)
+{
+	// solve each example once, argmax may modify the data of the example
+	std::vector<int32_t> examples(feat_idx.begin(), feat_idx.end());
+	std::sort(examples.begin(), examples.end());
+	examples.erase(std::unique(examples.begin(), examples.end()), examples.end());
+	int64_t num_examples = examples.size();
+
+	std::vector<std::shared_ptr<ResultSet>> solved(num_examples);
+	if (init_argmax_batch(w, training) && num_examples > 1)
+	{
+		// exceptions must not leave the parallel region, the first one is
+		// rethrown once all threads are done
+		std::exception_ptr exception;
+#pragma omp parallel for schedule(dynamic) num_threads(env()->get_num_threads())
+		for (int64_t i = 0; i < num_examples; ++i)
+		{
+			try
+			{
+				solved[i] = argmax(w, examples[i], training);
+			}
+			catch (...)
+			{
+#pragma omp critical (structured_model_argmax_batch)
+				if (!exception)
+					exception = std::current_exception();
+			}
+		}
+		if (exception)
+			std::rethrow_exception(exception);
+	}
+	else
+	{
+		for (int64_t i = 0; i < num_examples; ++i)
+			solved[i] = argmax(w, examples[i], training);
+	}
+
+	std::vector<std::shared_ptr<ResultSet>> results(feat_idx.vlen);
+	for (index_t i = 0; i < feat_idx.vlen; ++i)
+	{
+		auto it = std::lower_bound(examples.begin(), examples.end(), feat_idx[i]);
+		results[i] = solved[it - examples.begin()];
+	}
+
+	return results;
+}
+
+bool StructuredModel::init_argmax_batch(SGVector<float64_t> w, bool const training)
+{
+	return false;
+}
+
 void StructuredModel::init()
 {
 	SG_ADD((std::shared_ptr<Labels>*) &m_labels, "labels", "Structured labels");
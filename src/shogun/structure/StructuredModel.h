@@ -21,6 +21,8 @@
 #include <shogun/lib/SGSparseVector.h>
 #include <shogun/lib/StructuredData.h>
 
+#include <vector>
+
 namespace shogun
 {
 
@@ -236,6 +238,23 @@ class StructuredModel : public SGObject
 		 */
 		virtual std::shared_ptr<ResultSet> argmax(SGVector< float64_t > w, int32_t feat_idx, bool const training = true) = 0;
 
+		/**
+		 * obtains the argmax of several examples, see argmax. The examples
+		 * are solved concurrently if the model supports it, see
+		 * init_argmax_batch; each result is written to its own slot. An
+		 * example given several times is solved once and its result shared.
+		 *
+		 * @param w weight vector
+		 * @param feat_idx indices of the features to compute the argmax
+		 * @param training true if argmax is called during training
+		 *
+		 * @return structures with the predicted outputs, in the order of
+		 * feat_idx
+		 */
+		std::vector<std::shared_ptr<ResultSet>> argmax_batch(
+		    SGVector<float64_t> w, SGVector<int32_t> feat_idx,
+		    bool const training = true);
+
 		/** computes \f$ \Delta(y_{\text{true}}, y_{\text{pred}}) \f$
 		 *
 		 * @param ytrue_idx index of the true label in labels
@@ -294,6 +313,22 @@ class StructuredModel : public SGObject
 		 */
 		virtual int32_t get_num_aux_con() const;
 
+	protected:
+		/**
+		 * prepares argmax_batch: sets up the state of the model that argmax
+		 * derives from w, so that argmax does not modify the model while the
+		 * examples are solved. In this class nothing is set up and the
+		 * examples are solved one after the other; re-implement it in
+		 * models whose argmax can be called concurrently.
+		 *
+		 * @param w weight vector
+		 * @param training true if argmax is called during training
+		 *
+		 * @return whether argmax can be called concurrently for different
+		 * examples
+		 */
+		virtual bool init_argmax_batch(SGVector<float64_t> w, bool const training);
+
 	private:
 		/** internal initialization */
 		void init();
@@ -3,6 +3,7 @@
 #include <shogun/base/progress.h>
 #include <shogun/io/SGIO.h>
 #include <thread>
+#include <vector>
 
 using namespace shogun;
 
@@ -110,6 +111,23 @@ TEST(PRange, progress_iterator_correct_bounds_negative)
 	EXPECT_EQ(std::ceil(range_test.get_current_progress()), 1);
 }
 
+TEST(PRange, progress_concurrent_increments)
+{
+	env()->io()->enable_progress();
+	range_test = progress("PROGRESS: ", range(0, 1000));
+	std::vector<std::thread> threads;
+	for (int t = 0; t < 4; t++)
+		threads.emplace_back([]() {
+			for (int i = 0; i < 250; i++)
+				range_test.print_progress();
+		});
+	for (auto& thread : threads)
+		thread.join();
+	EXPECT_EQ(std::ceil(range_test.get_current_progress()), 1000);
+	range_test.complete();
+	EXPECT_EQ(std::ceil(range_test.get_current_progress()), 1001);
+}
+
 TEST(PRange, lambda_stop)
 {
 	int test = 6;
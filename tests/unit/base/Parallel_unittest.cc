@@ -34,6 +34,7 @@
 #include <shogun/base/Parallel.h>
 #include <gtest/gtest.h>
 #include <omp.h>
+#include <thread>
 
 using namespace shogun;
 
@@ -70,4 +71,42 @@ TEST(Parallel, openmp_set_num_threads)
 
 	env()->set_num_threads(orig_num_threads);
 }
+
+TEST(Parallel, thread_budget)
+{
+	int32_t orig_num_threads = env()->get_num_threads();
+	env()->set_num_threads(4);
+
+	{
+		Parallel::ThreadBudget budget(2);
+		EXPECT_EQ(2, env()->get_num_threads());
+		{
+			Parallel::ThreadBudget nested(1);
+			EXPECT_EQ(1, env()->get_num_threads());
+		}
+		EXPECT_EQ(2, env()->get_num_threads());
+
+		/* a nested budget does not widen the enclosing one */
+		Parallel::ThreadBudget larger(8);
+		EXPECT_EQ(2, env()->get_num_threads());
+
+		/* other threads are not limited */
+		int32_t other_num_threads = 0;
+		std::thread other(
+		    [&other_num_threads]() {
+			    other_num_threads = env()->get_num_threads();
+		    });
+		other.join();
+		EXPECT_EQ(4, other_num_threads);
+	}
+	EXPECT_EQ(4, env()->get_num_threads());
+
+	/* a budget above the global setting does not add threads */
+	{
+		Parallel::ThreadBudget budget(8);
+		EXPECT_EQ(4, env()->get_num_threads());
+	}
+
+	env()->set_num_threads(orig_num_threads);
+}
 #endif // HAVE_OPENMP
@@ -0,0 +1,170 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/clustering/GMM.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/mathematics/UniformRealDistribution.h>
+
+#include <random>
+
+using namespace shogun;
+
+#ifdef HAVE_LAPACK
+
+class GMMTest : public ::testing::TestWithParam<ECovType>
+{
+public:
+	void SetUp()
+	{
+		std::mt19937_64 prng(17);
+		NormalDistribution<float64_t> normal;
+		m_data = SGMatrix<float64_t>(3, 600);
+		for (index_t i = 0; i < m_data.num_cols; ++i)
+		{
+			float64_t offset = 6.0 * (i % 3);
+			m_data(0, i) = normal(prng) + offset;
+			m_data(1, i) = 0.5 * normal(prng) - offset;
+			m_data(2, i) = normal(prng) + 0.3 * m_data(0, i);
+		}
+		m_features = std::make_shared<DenseFeatures<float64_t>>(m_data);
+	}
+
+	std::shared_ptr<GMM> create_gmm(ECovType cov_type)
+	{
+		auto gmm = std::make_shared<GMM>(3, cov_type);
+		for (index_t k = 0; k < 3; ++k)
+		{
+			SGVector<float64_t> mean(3);
+			mean[0] = 5.0 * k;
+			mean[1] = -5.0 * k;
+			mean[2] = 1.0;
+			SGMatrix<float64_t> cov(3, 3);
+			cov.zero();
+			for (index_t j = 0; j < 3; ++j)
+				cov(j, j) = 1.0 + k;
+			cov(0, 2) = cov(2, 0) = 0.3;
+			gmm->set_nth_mean(mean, k);
+			gmm->set_nth_cov(cov, k);
+		}
+		SGVector<float64_t> coef(3);
+		coef[0] = 0.2;
+		coef[1] = 0.3;
+		coef[2] = 0.5;
+		gmm->set_coef(coef);
+		gmm->train(m_features);
+		return gmm;
+	}
+
+protected:
+	SGMatrix<float64_t> m_data;
+	std::shared_ptr<DenseFeatures<float64_t>> m_features;
+};
+
+TEST_P(GMMTest, log_likelihood_of_all_vectors)
+{
+	auto gmm = create_gmm(GetParam());
+	auto log_likelihood = gmm->get_log_likelihood();
+	ASSERT_EQ(log_likelihood.vlen, m_data.num_cols);
+
+	auto components = gmm->get_comp();
+	auto coef = gmm->get_coef();
+	for (index_t i = 0; i < m_data.num_cols; ++i)
+	{
+		auto point = m_data.get_column(i);
+		float64_t expected = 0;
+		for (index_t k = 0; k < 3; ++k)
+			expected +=
+			    coef[k] * std::exp(components[k]->compute_log_PDF(point));
+		EXPECT_NEAR(log_likelihood[i], std::log(expected), 1e-10);
+		EXPECT_NEAR(
+		    gmm->get_log_likelihood_example(i), log_likelihood[i], 1e-10);
+	}
+}
+
+TEST_P(GMMTest, max_likelihood_weighted_moments)
+{
+	auto cov_type = GetParam();
+	auto gmm = create_gmm(cov_type);
+
+	std::mt19937_64 prng(3);
+	UniformRealDistribution<float64_t> uniform(0.0, 1.0);
+	SGMatrix<float64_t> alpha(m_data.num_cols, 3);
+	for (index_t i = 0; i < m_data.num_cols; ++i)
+	{
+		float64_t sum = 0;
+		for (index_t k = 0; k < 3; ++k)
+			sum += alpha[i * 3 + k] = uniform(prng);
+		for (index_t k = 0; k < 3; ++k)
+			alpha[i * 3 + k] /= sum;
+	}
+	gmm->max_likelihood(alpha, 1e-9);
+
+	float64_t total = 0;
+	for (index_t k = 0; k < 3; ++k)
+	{
+		float64_t weight = 0;
+		SGVector<float64_t> mean(3);
+		mean.zero();
+		for (index_t i = 0; i < m_data.num_cols; ++i)
+		{
+			weight += alpha[i * 3 + k];
+			for (index_t j = 0; j < 3; ++j)
+				mean[j] += alpha[i * 3 + k] * m_data(j, i);
+		}
+		SGMatrix<float64_t> cov(3, 3);
+		cov.zero();
+		for (index_t i = 0; i < m_data.num_cols; ++i)
+			for (index_t r = 0; r < 3; ++r)
+				for (index_t c = 0; c < 3; ++c)
+					cov(r, c) += alpha[i * 3 + k] *
+					             (m_data(r, i) - mean[r] / weight) *
+					             (m_data(c, i) - mean[c] / weight);
+		total += weight;
+
+		auto result_mean = gmm->get_nth_mean(k);
+		auto result_cov = gmm->get_nth_cov(k);
+		float64_t trace = (cov(0, 0) + cov(1, 1) + cov(2, 2)) / (3 * weight);
+		for (index_t r = 0; r < 3; ++r)
+		{
+			EXPECT_NEAR(result_mean[r], mean[r] / weight, 1e-10);
+			for (index_t c = 0; c < 3; ++c)
+			{
+				float64_t expected = cov(r, c) / weight;
+				if (cov_type != FULL && r != c)
+					expected = 0;
+				else if (cov_type == SPHERICAL)
+					expected = trace;
+				EXPECT_NEAR(result_cov(r, c), expected, 1e-8);
+			}
+		}
+		EXPECT_NEAR(gmm->get_coef()[k], weight / m_data.num_cols, 1e-10);
+	}
+	EXPECT_NEAR(total, m_data.num_cols, 1e-8);
+}
+
+TEST_P(GMMTest, train_em_and_smem)
+{
+	auto gmm = create_gmm(GetParam());
+	float64_t initial = 0;
+	for (auto v : gmm->get_log_likelihood())
+		initial += v;
+
+	float64_t em = gmm->train_em(1e-9, 100, 1e-9);
+	EXPECT_GT(em, initial);
+	float64_t total = 0;
+	for (auto v : gmm->get_log_likelihood())
+		total += v;
+	EXPECT_NEAR(em, total, std::abs(em) * 1e-2);
+
+	float64_t smem = gmm->train_smem(5, 3, 1e-9, 100, 1e-9);
+	EXPECT_GE(smem, em - 1e-6);
+}
+
+INSTANTIATE_TEST_CASE_P(
+    CovTypes, GMMTest, ::testing::Values(FULL, DIAG, SPHERICAL));
+
+#endif // HAVE_LAPACK
@@ -7,7 +7,9 @@
 #include <gtest/gtest.h>
 
 #include <shogun/distance/CustomMahalanobisDistance.h>
+#include <shogun/distance/SparseEuclideanDistance.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/features/SparseFeatures.h>
 #include <shogun/lib/SGMatrix.h>
 
 using namespace shogun;
@@ -37,3 +39,24 @@ TEST(Distance, custom_mahalanobis)
 
 
 }
+
+TEST(Distance, sparse_euclidean_get_distance_matrix)
+{
+	SGMatrix<float64_t> data_lhs(4, 6);
+	SGMatrix<float64_t> data_rhs(4, 5);
+	for (index_t i=0; i<data_lhs.num_rows*data_lhs.num_cols; i++)
+		data_lhs[i] = i%3==0 ? 0.0 : 0.5*i-3.0;
+	for (index_t i=0; i<data_rhs.num_rows*data_rhs.num_cols; i++)
+		data_rhs[i] = i%2==0 ? 0.0 : 4.0-0.3*i;
+
+	auto feats_lhs = std::make_shared<SparseFeatures<float64_t>>(data_lhs);
+	auto feats_rhs = std::make_shared<SparseFeatures<float64_t>>(data_rhs);
+	auto distance = std::make_shared<SparseEuclideanDistance>(feats_lhs, feats_rhs);
+
+	SGMatrix<float64_t> dm = distance->get_distance_matrix();
+	EXPECT_EQ(dm.num_rows, data_lhs.num_cols);
+	EXPECT_EQ(dm.num_cols, data_rhs.num_cols);
+	for (index_t i=0; i<dm.num_rows; i++)
+		for (index_t j=0; j<dm.num_cols; j++)
+			EXPECT_NEAR(dm(i,j), distance->distance(i,j), 1E-12);
+}
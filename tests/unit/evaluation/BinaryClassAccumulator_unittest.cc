@@ -0,0 +1,171 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/evaluation/BinaryClassAccumulator.h>
+#include <shogun/evaluation/PRCEvaluation.h>
+#include <shogun/evaluation/ROCEvaluation.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/mathematics/NormalDistribution.h>
+
+#include <limits>
+#include <random>
+
+using namespace shogun;
+
+class BinaryClassAccumulatorTest : public ::testing::Test
+{
+public:
+	void SetUp()
+	{
+		index_t num_labels = 300;
+		scores = SGVector<float64_t>(num_labels);
+		labels = SGVector<float64_t>(num_labels);
+		std::mt19937_64 prng(17);
+		NormalDistribution<float64_t> normal_dist;
+		for (index_t i = 0; i < num_labels; ++i)
+		{
+			labels[i] = i % 3 ? 1 : -1;
+			/* rounded to get ties */
+			scores[i] = std::round((normal_dist(prng) + labels[i]) * 8) / 8;
+		}
+	}
+
+	/** accumulates the scores in three chunks */
+	void accumulate(const std::shared_ptr<BinaryClassAccumulator>& acc)
+	{
+		index_t chunk = scores.vlen / 3;
+		for (index_t start : {2 * chunk, 0, chunk})
+		{
+			SGVector<float64_t> s(chunk), l(chunk);
+			for (index_t i = 0; i < chunk; ++i)
+			{
+				s[i] = scores[start + i];
+				l[i] = labels[start + i];
+			}
+			acc->update(s, l);
+		}
+	}
+
+	SGVector<float64_t> scores;
+	SGVector<float64_t> labels;
+};
+
+TEST_F(BinaryClassAccumulatorTest, exact_same_as_roc_evaluation)
+{
+	auto predicted = std::make_shared<BinaryLabels>(scores);
+	auto ground_truth = std::make_shared<BinaryLabels>(labels);
+	auto roc = std::make_shared<ROCEvaluation>();
+	auto auc = roc->evaluate(predicted, ground_truth);
+
+	auto acc = std::make_shared<BinaryClassAccumulator>();
+	accumulate(acc);
+
+	EXPECT_EQ(acc->get_num_positives(), 200);
+	EXPECT_EQ(acc->get_num_negatives(), 100);
+	EXPECT_NEAR(acc->get_auROC(), auc, 1e-12);
+	EXPECT_EQ(acc->get_auROC_error_bound(), 0.0);
+
+	auto expected = roc->get_ROC();
+	auto graph = acc->get_ROC();
+	ASSERT_EQ(graph.num_cols, expected.num_cols);
+	for (index_t i = 0; i < graph.num_rows * graph.num_cols; ++i)
+		EXPECT_NEAR(graph.matrix[i], expected.matrix[i], 1e-12);
+}
+
+TEST_F(BinaryClassAccumulatorTest, exact_same_as_prc_evaluation)
+{
+	/* distinct scores */
+	for (index_t i = 0; i < scores.vlen; ++i)
+		scores[i] += i * 1e-6;
+
+	auto predicted = std::make_shared<BinaryLabels>(scores);
+	auto ground_truth = std::make_shared<BinaryLabels>(labels);
+	auto prc = std::make_shared<PRCEvaluation>();
+	auto auc = prc->evaluate(predicted, ground_truth);
+
+	auto acc = std::make_shared<BinaryClassAccumulator>();
+	accumulate(acc);
+
+	EXPECT_NEAR(acc->get_auPRC(), auc, 1e-12);
+	EXPECT_EQ(acc->get_PRC().num_cols, scores.vlen);
+}
+
+TEST_F(BinaryClassAccumulatorTest, binned_within_error_bound)
+{
+	auto exact = std::make_shared<BinaryClassAccumulator>();
+	accumulate(exact);
+
+	auto binned = std::make_shared<BinaryClassAccumulator>(-2.0, 2.0, 16);
+	accumulate(binned);
+
+	EXPECT_EQ(binned->get_num_positives(), 200);
+	EXPECT_EQ(binned->get_num_negatives(), 100);
+	EXPECT_LE(binned->get_thresholds().vlen, 16);
+	EXPECT_GT(binned->get_auROC_error_bound(), 0.0);
+	EXPECT_LE(
+	    std::abs(binned->get_auROC() - exact->get_auROC()),
+	    binned->get_auROC_error_bound());
+}
+
+TEST_F(BinaryClassAccumulatorTest, merge_parallel_chunks)
+{
+	for (int32_t num_bins : {0, 64})
+	{
+		auto make_accumulator = [num_bins]() {
+			return num_bins ? std::make_shared<BinaryClassAccumulator>(
+			                      -2.0, 2.0, num_bins)
+			                : std::make_shared<BinaryClassAccumulator>();
+		};
+		auto sequential = make_accumulator();
+		sequential->update(scores, labels);
+
+		auto acc = make_accumulator();
+		index_t num_chunks = 10;
+		index_t chunk = scores.vlen / num_chunks;
+#pragma omp parallel for num_threads(4)
+		for (index_t c = 0; c < num_chunks; ++c)
+		{
+			auto local = make_accumulator();
+			SGVector<float64_t> s(chunk), l(chunk);
+			for (index_t i = 0; i < chunk; ++i)
+			{
+				s[i] = scores[c * chunk + i];
+				l[i] = labels[c * chunk + i];
+			}
+			local->update(s, l);
+#pragma omp critical
+			acc->merge(local);
+		}
+
+		EXPECT_EQ(acc->get_num_positives(), sequential->get_num_positives());
+		EXPECT_NEAR(acc->get_auROC(), sequential->get_auROC(), 1e-12);
+		EXPECT_NEAR(acc->get_auPRC(), sequential->get_auPRC(), 1e-12);
+	}
+}
+
+TEST(BinaryClassAccumulator, merge_different_bins)
+{
+	auto a = std::make_shared<BinaryClassAccumulator>(-1.0, 1.0, 10);
+	auto b = std::make_shared<BinaryClassAccumulator>(-1.0, 1.0, 20);
+	auto c = std::make_shared<BinaryClassAccumulator>();
+	EXPECT_THROW(a->merge(b), ShogunException);
+	EXPECT_THROW(a->merge(c), ShogunException);
+}
+
+TEST(BinaryClassAccumulator, binned_scores_out_of_range)
+{
+	auto acc = std::make_shared<BinaryClassAccumulator>(-1.0, 1.0, 4);
+	SGVector<float64_t> scores(
+	    {-std::numeric_limits<float64_t>::infinity(), -1e300, -0.5, 0.5,
+	     1e300, std::numeric_limits<float64_t>::infinity()});
+	SGVector<float64_t> labels({-1, -1, -1, 1, 1, 1});
+	acc->update(scores, labels);
+
+	EXPECT_EQ(acc->get_num_positives(), 3);
+	EXPECT_EQ(acc->get_num_negatives(), 3);
+	EXPECT_LE(acc->get_thresholds().vlen, 4);
+	EXPECT_NEAR(acc->get_auROC(), 1.0, 1e-12);
+}
@@ -101,6 +101,26 @@ protected:
 		return result;
 	}
 
+	auto test_fold_threads()
+	{
+		init();
+		this->cv->put("seed", 1);
+		this->cv->set_num_fold_threads(2);
+		env()->set_num_threads(4);
+		auto result = cv->evaluate()->get<float64_t>("mean");
+		return result;
+	}
+
+	auto test_precomputed_kernel()
+	{
+		init();
+		this->cv->put("seed", 1);
+		this->cv->set_precompute_kernel(true);
+		env()->set_num_threads(4);
+		auto result = cv->evaluate()->get<float64_t>("mean");
+		return result;
+	}
+
 	void generate_data(EProblemType pt)
 	{
 		auto N = 50;
@@ -192,3 +212,23 @@ TYPED_TEST(CrossValidationTests, single_multi_same_result)
 
 	EXPECT_NEAR(single, multi, 1e-7);
 }
+
+TYPED_TEST(CrossValidationTests, single_fold_threads_same_result)
+{
+	auto single = this->test_single_thread();
+	auto multi = this->test_fold_threads();
+
+	EXPECT_NEAR(single, multi, 1e-7);
+}
+
+TYPED_TEST(CrossValidationTests, precomputed_kernel_same_result)
+{
+	if constexpr (std::is_base_of_v<KernelMachine, TypeParam>)
+	{
+		auto single = this->test_single_thread();
+		auto precomputed = this->test_precomputed_kernel();
+
+		// kernel matrix is stored in single precision
+		EXPECT_NEAR(single, precomputed, 1e-4);
+	}
+}
@@ -0,0 +1,199 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/classifier/Perceptron.h>
+#include <shogun/classifier/svm/LibSVM.h>
+#include <shogun/evaluation/ContingencyTableEvaluation.h>
+#include <shogun/evaluation/CrossValidationSplitting.h>
+#include <shogun/evaluation/HyperparameterSearch.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/mathematics/NormalDistribution.h>
+
+using namespace shogun;
+
+class HyperparameterSearchTest : public ::testing::Test
+{
+public:
+	void SetUp()
+	{
+		index_t num_vec = 60;
+		index_t dim = 2;
+
+		SGMatrix<float64_t> matrix(dim, num_vec);
+		labels = std::make_shared<BinaryLabels>(num_vec);
+		std::mt19937_64 prng(57);
+		NormalDistribution<float64_t> normal_dist;
+		for (index_t i = 0; i < num_vec; ++i)
+		{
+			float64_t label = i % 2 ? 1 : -1;
+			for (index_t j = 0; j < dim; ++j)
+				matrix(j, i) = normal_dist(prng) + label;
+
+			labels->set_label(i, label);
+		}
+		features = std::make_shared<DenseFeatures<float64_t>>(matrix);
+	}
+
+	void TearDown()
+	{
+		env()->set_num_threads(1);
+	}
+
+	std::shared_ptr<HyperparameterSearch> svm_search()
+	{
+		auto svm = std::make_shared<LibSVM>();
+		svm->set_kernel(std::make_shared<GaussianKernel>());
+		auto splitting = std::make_shared<CrossValidationSplitting>(labels, 3);
+		auto search = std::make_shared<HyperparameterSearch>(
+		    svm, features, labels, splitting,
+		    std::make_shared<AccuracyMeasure>());
+		search->add_values("kernel::log_width", SGVector<float64_t>({0, 1}));
+		search->add_values("C1", SGVector<float64_t>({0.1, 1, 10}));
+		search->add_values("C2", SGVector<float64_t>({1}));
+		search->put("seed", 7);
+
+		return search;
+	}
+
+	std::shared_ptr<DenseFeatures<float64_t>> features;
+	std::shared_ptr<BinaryLabels> labels;
+};
+
+TEST_F(HyperparameterSearchTest, put_parameter)
+{
+	auto svm = std::make_shared<LibSVM>();
+	svm->set_kernel(std::make_shared<GaussianKernel>());
+
+	HyperparameterSearch::put_parameter(svm, "C1", 2.5);
+	HyperparameterSearch::put_parameter(svm, "kernel::log_width", 0.5);
+	EXPECT_EQ(2.5, svm->get<float64_t>("C1"));
+	EXPECT_EQ(0.5, svm->get_kernel()->get<float64_t>("log_width"));
+
+	auto perceptron = std::make_shared<Perceptron>();
+	HyperparameterSearch::put_parameter(perceptron, "max_iterations", 9.6);
+	EXPECT_EQ(10, perceptron->get<int32_t>("max_iterations"));
+
+	EXPECT_THROW(
+	    HyperparameterSearch::put_parameter(svm, "kernel::foo", 1),
+	    ShogunException);
+}
+
+TEST_F(HyperparameterSearchTest, grid_cached_kernel_same_result)
+{
+	auto search = svm_search();
+	search->set_cache_kernel_matrices(false);
+	search->search();
+	auto scores = search->get_scores();
+
+	auto cached_search = svm_search();
+	cached_search->set_cache_kernel_matrices(true);
+	auto best = cached_search->search();
+	auto cached_scores = cached_search->get_scores();
+
+	ASSERT_EQ(6, scores.vlen);
+	ASSERT_EQ(scores.vlen, cached_scores.vlen);
+	for (index_t i = 0; i < scores.vlen; ++i)
+		EXPECT_NEAR(scores[i], cached_scores[i], 1e-4);
+
+	auto parameters = cached_search->get_best_parameters();
+	EXPECT_EQ(parameters["C1"], best->get<float64_t>("C1"));
+	EXPECT_GT(cached_search->get_best_score(), 0.5);
+}
+
+TEST_F(HyperparameterSearchTest, bounded_kernel_matrix_cache_same_result)
+{
+	env()->set_num_threads(4);
+	auto search = svm_search();
+	search->search();
+	auto scores = search->get_scores();
+
+	/* a single kernel matrix at a time, candidates alternate between the
+	 * kernel widths */
+	auto bounded_search = svm_search();
+	bounded_search->set_kernel_matrix_cache_size(0);
+	bounded_search->search();
+	auto bounded_scores = bounded_search->get_scores();
+
+	ASSERT_EQ(scores.vlen, bounded_scores.vlen);
+	for (index_t i = 0; i < scores.vlen; ++i)
+		EXPECT_NEAR(scores[i], bounded_scores[i], 1e-10);
+	EXPECT_EQ(
+	    search->get_best_parameters(), bounded_search->get_best_parameters());
+}
+
+TEST_F(HyperparameterSearchTest, concurrent_candidates_same_result)
+{
+	env()->set_num_threads(1);
+	auto search = svm_search();
+	search->search();
+	auto scores = search->get_scores();
+
+	env()->set_num_threads(4);
+	auto concurrent_search = svm_search();
+	concurrent_search->search();
+	auto concurrent_scores = concurrent_search->get_scores();
+
+	EXPECT_EQ(4, env()->get_num_threads());
+	ASSERT_EQ(scores.vlen, concurrent_scores.vlen);
+	for (index_t i = 0; i < scores.vlen; ++i)
+		EXPECT_NEAR(scores[i], concurrent_scores[i], 1e-10);
+}
+
+TEST_F(HyperparameterSearchTest, successive_halving)
+{
+	auto search = svm_search();
+	search->set_strategy(SEARCH_SUCCESSIVE_HALVING);
+	search->set_num_candidates(9);
+	search->set_eta(3);
+	search->set_min_resource(1.0 / 3);
+	search->search();
+
+	auto num_vectors = search->get_num_vectors();
+	ASSERT_EQ(9, num_vectors.vlen);
+	index_t num_full = 0;
+	for (index_t i = 0; i < num_vectors.vlen; ++i)
+	{
+		EXPECT_GE(num_vectors[i], 20);
+		if (num_vectors[i] == labels->get_num_labels())
+			num_full++;
+	}
+	EXPECT_EQ(3, num_full);
+}
+
+TEST_F(HyperparameterSearchTest, hyperband_warm_start)
+{
+	auto perceptron = std::make_shared<Perceptron>();
+	auto splitting = std::make_shared<CrossValidationSplitting>(labels, 3);
+	auto search = std::make_shared<HyperparameterSearch>(
+	    perceptron, features, labels, splitting,
+	    std::make_shared<AccuracyMeasure>());
+	search->add_range("learn_rate", 1e-3, 1, true);
+	search->add_values("max_iterations", SGVector<float64_t>({10, 100}));
+	search->set_strategy(SEARCH_HYPERBAND);
+	search->set_min_resource(1.0 / 3);
+	search->set_warm_start(true);
+	search->put("seed", 7);
+
+	auto best = search->search();
+
+	/* brackets of 3 candidates on 1/3 of the vectors and 2 candidates on
+	 * all vectors */
+	auto candidates = search->get_candidates();
+	EXPECT_EQ(2, candidates.num_rows);
+	EXPECT_EQ(5, candidates.num_cols);
+	for (index_t i = 0; i < candidates.num_cols; ++i)
+	{
+		EXPECT_GE(candidates(0, i), 1e-3);
+		EXPECT_LE(candidates(0, i), 1);
+	}
+
+	auto parameters = search->get_best_parameters();
+	EXPECT_EQ(parameters["learn_rate"], best->get<float64_t>("learn_rate"));
+	EXPECT_GT(search->get_best_score(), 0.5);
+}
@@ -0,0 +1,75 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/evaluation/MeanAbsoluteError.h>
+#include <shogun/evaluation/MeanSquaredError.h>
+#include <shogun/evaluation/RegressionAccumulator.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/mathematics/NormalDistribution.h>
+
+#include <random>
+
+using namespace shogun;
+
+TEST(RegressionAccumulator, merged_chunks_same_as_evaluation)
+{
+	index_t num_labels = 1000;
+	SGVector<float64_t> predicted(num_labels), truth(num_labels);
+	std::mt19937_64 prng(17);
+	NormalDistribution<float64_t> normal_dist;
+	for (index_t i = 0; i < num_labels; ++i)
+	{
+		truth[i] = 1e3 + 10 * normal_dist(prng);
+		predicted[i] = truth[i] + normal_dist(prng);
+	}
+
+	index_t num_chunks = 7;
+	std::vector<std::shared_ptr<RegressionAccumulator>> accs;
+	for (index_t c = 0; c < num_chunks; ++c)
+	{
+		index_t start = c * num_labels / num_chunks;
+		index_t end = (c + 1) * num_labels / num_chunks;
+		SGVector<float64_t> p(end - start), t(end - start);
+		for (index_t i = start; i < end; ++i)
+		{
+			p[i - start] = predicted[i];
+			t[i - start] = truth[i];
+		}
+		auto acc = std::make_shared<RegressionAccumulator>();
+		acc->update(p, t);
+		accs.push_back(acc);
+	}
+	for (index_t c = 1; c < num_chunks; ++c)
+		accs[0]->merge(accs[c]);
+
+	auto acc = accs[0];
+	auto predicted_labels = std::make_shared<RegressionLabels>(predicted);
+	auto truth_labels = std::make_shared<RegressionLabels>(truth);
+	auto mse = std::make_shared<MeanSquaredError>()->evaluate(
+	    predicted_labels, truth_labels);
+	auto mae = std::make_shared<MeanAbsoluteError>()->evaluate(
+	    predicted_labels, truth_labels);
+
+	float64_t mean = 0, ss = 0;
+	for (index_t i = 0; i < num_labels; ++i)
+		mean += truth[i] / num_labels;
+	for (index_t i = 0; i < num_labels; ++i)
+		ss += (truth[i] - mean) * (truth[i] - mean);
+
+	EXPECT_EQ(acc->get_num_values(), num_labels);
+	EXPECT_NEAR(acc->get_mean_squared_error(), mse, 1e-10);
+	EXPECT_NEAR(acc->get_root_mean_squared_error(), std::sqrt(mse), 1e-10);
+	EXPECT_NEAR(acc->get_mean_absolute_error(), mae, 1e-10);
+	EXPECT_NEAR(acc->get_r2(), 1 - mse * num_labels / ss, 1e-10);
+}
+
+TEST(RegressionAccumulator, empty)
+{
+	auto acc = std::make_shared<RegressionAccumulator>();
+	acc->merge(std::make_shared<RegressionAccumulator>());
+	EXPECT_EQ(acc->get_num_values(), 0);
+	EXPECT_THROW(acc->get_mean_squared_error(), ShogunException);
+}
@@ -0,0 +1,152 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/features/DenseIndexViewFeatures.h>
+#include <shogun/lib/View.h>
+
+using namespace shogun;
+
+class DenseIndexViewFeaturesTest : public ::testing::Test
+{
+public:
+	void SetUp()
+	{
+		data = SGMatrix<float64_t>(5, 300);
+		for (index_t i = 0; i < data.num_rows * data.num_cols; ++i)
+			data.matrix[i] = std::sin(i);
+		features = std::make_shared<DenseFeatures<float64_t>>(data);
+		features->add_subset(SGVector<index_t>({299, 7, 3, 150, 42, 8}));
+
+		indices = SGVector<index_t>(200);
+		for (index_t i = 0; i < indices.vlen; ++i)
+			indices[i] = (i * 7) % features->get_num_vectors();
+
+		/* reference with the subsets of a duplicate */
+		reference = features->duplicate()->as<DenseFeatures<float64_t>>();
+		reference->add_subset(indices);
+	}
+
+	void TearDown()
+	{
+		env()->set_num_threads(1);
+	}
+
+	SGMatrix<float64_t> data;
+	std::shared_ptr<DenseFeatures<float64_t>> features;
+	std::shared_ptr<DenseFeatures<float64_t>> reference;
+	SGVector<index_t> indices;
+};
+
+TEST_F(DenseIndexViewFeaturesTest, view_shares_matrix)
+{
+	auto v = view(features, indices);
+	ASSERT_TRUE(std::dynamic_pointer_cast<DenseIndexViewFeatures<float64_t>>(v));
+	EXPECT_EQ(v->get_num_vectors(), indices.vlen);
+	EXPECT_EQ(v->get_num_features(), data.num_rows);
+
+	int32_t num_feat, num_vec;
+	EXPECT_EQ(v->get_feature_matrix(num_feat, num_vec), data.matrix);
+
+	auto matrix = v->get_feature_matrix();
+	auto expected = reference->get_feature_matrix();
+	EXPECT_TRUE(matrix.equals(expected));
+
+	/* a view of a view indexes the shared matrix too */
+	auto nested = view(v, SGVector<index_t>({5, 0, 5}));
+	EXPECT_EQ(nested->get_feature_matrix(num_feat, num_vec), data.matrix);
+	for (index_t i = 0; i < data.num_rows; ++i)
+	{
+		EXPECT_EQ(nested->get_feature_matrix()(i, 0), expected(i, 5));
+		EXPECT_EQ(nested->get_feature_matrix()(i, 1), expected(i, 0));
+	}
+
+	auto dup = v->duplicate();
+	EXPECT_TRUE(
+	    std::dynamic_pointer_cast<DenseIndexViewFeatures<float64_t>>(dup));
+	EXPECT_EQ(dup->get_num_vectors(), indices.vlen);
+}
+
+TEST_F(DenseIndexViewFeaturesTest, dot_products)
+{
+	auto v = std::make_shared<DenseIndexViewFeatures<float64_t>>(
+	    features, indices);
+	SGVector<float64_t> w(data.num_rows);
+	for (index_t i = 0; i < w.vlen; ++i)
+		w[i] = i - 1.5;
+
+	for (index_t i = 0; i < indices.vlen; i += 13)
+	{
+		EXPECT_NEAR(v->dot(i, w), reference->dot(i, w), 1e-12);
+		EXPECT_NEAR(v->dot(i, v, 3), reference->dot(i, reference, 3), 1e-12);
+
+		SGVector<float64_t> out(w.vlen), expected(w.vlen);
+		out.zero();
+		expected.zero();
+		v->add_to_dense_vec(0.5, i, out.vector, out.vlen, true);
+		reference->add_to_dense_vec(0.5, i, expected.vector, expected.vlen, true);
+		for (index_t j = 0; j < w.vlen; ++j)
+			EXPECT_NEAR(out[j], expected[j], 1e-12);
+	}
+}
+
+TEST_F(DenseIndexViewFeaturesTest, dense_dot_range)
+{
+	env()->set_num_threads(3);
+	auto v = std::make_shared<DenseIndexViewFeatures<float64_t>>(
+	    features, indices);
+	SGVector<float64_t> w(data.num_rows);
+	for (index_t i = 0; i < w.vlen; ++i)
+		w[i] = i - 1.5;
+	SGVector<float64_t> alphas(indices.vlen);
+	for (index_t i = 0; i < alphas.vlen; ++i)
+		alphas[i] = 0.1 * i;
+
+	SGVector<float64_t> out(indices.vlen), expected(indices.vlen);
+	v->dense_dot_range(
+	    out.vector, 10, 190, alphas.vector, w.vector, w.vlen, 0.25);
+	reference->dense_dot_range(
+	    expected.vector, 10, 190, alphas.vector, w.vector, w.vlen, 0.25);
+	for (index_t i = 0; i < 180; ++i)
+		EXPECT_NEAR(out[i], expected[i], 1e-12);
+
+	SGVector<int32_t> sub_index({199, 3, 77, 3, 0});
+	v->dense_dot_range_subset(
+	    sub_index.vector, sub_index.vlen, out.vector, alphas.vector,
+	    w.vector, w.vlen, -1);
+	reference->dense_dot_range_subset(
+	    sub_index.vector, sub_index.vlen, expected.vector, alphas.vector,
+	    w.vector, w.vlen, -1);
+	for (index_t i = 0; i < sub_index.vlen; ++i)
+		EXPECT_NEAR(out[i], expected[i], 1e-12);
+}
+
+TEST_F(DenseIndexViewFeaturesTest, subset_of_view)
+{
+	auto v = std::make_shared<DenseIndexViewFeatures<float64_t>>(
+	    features, indices);
+	SGVector<index_t> subset({150, 2, 2, 77});
+	v->add_subset(subset);
+	reference->add_subset(subset);
+	SGVector<float64_t> w(data.num_rows);
+	for (index_t i = 0; i < w.vlen; ++i)
+		w[i] = i - 1.5;
+
+	SGVector<float64_t> out(subset.vlen), expected(subset.vlen);
+	v->dense_dot_range(out.vector, 0, subset.vlen, NULL, w.vector, w.vlen, 0);
+	reference->dense_dot_range(
+	    expected.vector, 0, subset.vlen, NULL, w.vector, w.vlen, 0);
+	for (index_t i = 0; i < subset.vlen; ++i)
+	{
+		EXPECT_NEAR(out[i], expected[i], 1e-12);
+		EXPECT_NEAR(v->dot(i, w), expected[i], 1e-12);
+	}
+
+	v->remove_subset();
+	reference->remove_subset();
+	for (index_t i = 0; i < indices.vlen; i += 13)
+		EXPECT_NEAR(v->dot(i, w), reference->dot(i, w), 1e-12);
+}
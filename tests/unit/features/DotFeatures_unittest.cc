@@ -7,6 +7,7 @@
 #include <gtest/gtest.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/features/DotFeatures.h>
+#include <shogun/features/SparseFeatures.h>
 
 using namespace shogun;
 
@@ -165,3 +166,44 @@ TEST_F(DotFeaturesTest, dense_dot_range)
 		    i * (i + 1) * num_feats * ((1 + num_feats) / 2.0) + bias);
 	}
 }
+
+TEST(DotFeatures, add_to_dense_vec_subset)
+{
+	index_t num_feats = 7;
+	index_t num_vectors = 5000;
+
+	SGMatrix<float64_t> data(num_feats, num_vectors);
+	for (index_t i = 0; i < num_feats * num_vectors; i++)
+		data.matrix[i] = (i % 5 == 0) ? 0.0 : ((i * 7) % 13) - 6.0;
+
+	std::shared_ptr<DotFeatures> dense_feats =
+	    std::make_shared<DenseFeatures<float64_t>>(data);
+	std::shared_ptr<DotFeatures> sparse_feats =
+	    std::make_shared<SparseFeatures<float64_t>>(data);
+
+	SGVector<int32_t> sub_index(num_vectors / 2);
+	for (index_t i = 0; i < sub_index.vlen; i++)
+		sub_index[i] = 2 * i + 1;
+
+	SGVector<float64_t> alphas(num_vectors);
+	for (index_t i = 0; i < num_vectors; i++)
+		alphas[i] = (i % 3) - 1.0;
+
+	SGVector<float64_t> expected(num_feats);
+	expected.set_const(1.0);
+	for (index_t i = 0; i < sub_index.vlen; i++)
+		for (index_t j = 0; j < num_feats; j++)
+			expected[j] += alphas[sub_index[i]] * data(j, sub_index[i]);
+
+	for (const auto& feats : {dense_feats, sparse_feats})
+	{
+		SGVector<float64_t> vec(num_feats);
+		vec.set_const(1.0);
+		feats->add_to_dense_vec_subset(
+		    sub_index.vector, sub_index.vlen, alphas.vector, vec.vector,
+		    num_feats);
+
+		for (index_t j = 0; j < num_feats; j++)
+			EXPECT_NEAR(vec[j], expected[j], 1E-9);
+	}
+}
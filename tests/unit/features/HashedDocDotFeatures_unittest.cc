@@ -15,6 +15,7 @@
 #include <shogun/lib/Hash.h>
 #include <shogun/mathematics/UniformIntDistribution.h>
 
+#include <cstring>
 #include <random>
 
 using namespace shogun;
@@ -312,3 +313,144 @@ TEST(HashedDocDotFeaturesTest, quadratic_add_to_dense)
 
 	SG_FREE(hashes);
 }
+
+TEST(HashedDocDotFeaturesTest, index_matches_hashing)
+{
+	const char* docs[] = {
+	    "You're never too old to rock and roll, if you're too young to die",
+	    "Give me some rope, tie me to dream, give me the hope to run out of steam",
+	    "Thank you Jack Daniels, Old Number Seven, Tennessee Whiskey got me drinking in heaven",
+	    "too old to rock, too young to die, too old to rock"};
+
+	std::vector<SGVector<char>> list;
+	for (auto doc : docs)
+	{
+		SGVector<char> string(std::strlen(doc));
+		for (index_t i=0; i<string.vlen; i++)
+			string[i] = doc[i];
+		list.push_back(string);
+	}
+
+	int32_t hash_bits = 6;
+	int32_t dimension = 64;
+	auto tokenizer = std::make_shared<DelimiterTokenizer>();
+	tokenizer->delimiters[' '] = 1;
+	tokenizer->delimiters[','] = 1;
+
+	auto doc_collection = std::make_shared<StringFeatures<char>>(list, RAWBYTE);
+	auto hashed = std::make_shared<HashedDocDotFeatures>(hash_bits, doc_collection,
+			tokenizer, true, 3, 1);
+	auto indexed = std::make_shared<HashedDocDotFeatures>(hash_bits, doc_collection,
+			tokenizer, true, 3, 1);
+	indexed->build_index();
+	EXPECT_EQ(indexed->get_num_indexed(), 4);
+
+	SGVector<float64_t> w(dimension);
+	for (index_t i=0; i<dimension; i++)
+		w[i] = std::sin(i);
+
+	for (index_t i=0; i<4; i++)
+	{
+		auto computed = hashed->get_computed_dot_feature_vector(i);
+		int32_t nnz = 0;
+		for (index_t j=0; j<dimension; j++)
+			nnz += computed[j] != 0;
+		EXPECT_EQ(indexed->get_nnz_features_for_vector(i), nnz);
+		EXPECT_NEAR(indexed->dot(i, w), hashed->dot(i, w), 1e-12);
+
+		SGVector<float64_t> v1(dimension);
+		SGVector<float64_t> v2(dimension);
+		v1.zero();
+		v2.zero();
+		indexed->add_to_dense_vec(-0.5, i, v1.vector, v1.vlen, true);
+		hashed->add_to_dense_vec(-0.5, i, v2.vector, v2.vlen, true);
+		for (index_t j=0; j<dimension; j++)
+			EXPECT_NEAR(v1[j], v2[j], 1e-12);
+
+		for (index_t j=0; j<4; j++)
+			EXPECT_NEAR(indexed->dot(i, indexed, j), hashed->dot(i, hashed, j), 1e-12);
+	}
+
+	SGVector<float64_t> out1(4);
+	SGVector<float64_t> out2(4);
+	indexed->dense_dot_range(out1.vector, 0, 4, NULL, w.vector, dimension, 1.0);
+	hashed->dense_dot_range(out2.vector, 0, 4, NULL, w.vector, dimension, 1.0);
+	for (index_t i=0; i<4; i++)
+		EXPECT_NEAR(out1[i], out2[i], 1e-12);
+}
+
+TEST(HashedDocDotFeaturesTest, index_memory_budget)
+{
+	std::vector<SGVector<char>> list;
+	for (index_t d=0; d<10; d++)
+	{
+		SGVector<char> string(20);
+		for (index_t i=0; i<string.vlen; i++)
+			string[i] = (i % 4 == 3) ? ' ' : 'a' + (i * 7 + d) % 26;
+		list.push_back(string);
+	}
+
+	auto doc_collection = std::make_shared<StringFeatures<char>>(list, RAWBYTE);
+	auto hashed = std::make_shared<HashedDocDotFeatures>(8, doc_collection);
+	auto indexed = std::make_shared<HashedDocDotFeatures>(8, doc_collection);
+
+	// leading offset, then offset, scale and entries of the first 3 documents
+	indexed->build_index();
+	int64_t budget = 8;
+	for (index_t i=0; i<3; i++)
+		budget += 16 + 8 * indexed->get_nnz_features_for_vector(i);
+	indexed->build_index(budget);
+	EXPECT_EQ(indexed->get_num_indexed(), 3);
+
+	SGVector<float64_t> w(256);
+	for (index_t i=0; i<w.vlen; i++)
+		w[i] = i;
+	for (index_t i=0; i<10; i++)
+		EXPECT_NEAR(indexed->dot(i, w), hashed->dot(i, w), 1e-12);
+
+	indexed->clear_index();
+	EXPECT_EQ(indexed->get_num_indexed(), 0);
+}
+
+TEST(HashedDocDotFeaturesTest, index_invalidation)
+{
+	std::vector<SGVector<char>> list;
+	for (index_t d=0; d<10; d++)
+	{
+		SGVector<char> string(20);
+		for (index_t i=0; i<string.vlen; i++)
+			string[i] = (i % 4 == 3) ? ' ' : 'a' + (i * 7 + d) % 26;
+		list.push_back(string);
+	}
+
+	auto doc_collection = std::make_shared<StringFeatures<char>>(list, RAWBYTE);
+	auto hashed = std::make_shared<HashedDocDotFeatures>(8, doc_collection);
+	auto indexed = std::make_shared<HashedDocDotFeatures>(8, doc_collection);
+	indexed->build_index();
+	EXPECT_EQ(indexed->get_num_indexed(), 10);
+
+	SGVector<float64_t> w(256);
+	for (index_t i=0; i<w.vlen; i++)
+		w[i] = i;
+
+	// the index is not used while the collection has a subset
+	doc_collection->add_subset(SGVector<index_t>({7, 2, 9}));
+	EXPECT_THROW(indexed->build_index(), ShogunException);
+	for (index_t i=0; i<3; i++)
+	{
+		EXPECT_NEAR(indexed->dot(i, w), hashed->dot(i, w), 1e-12);
+		EXPECT_EQ(indexed->get_nnz_features_for_vector(i),
+				hashed->get_nnz_features_for_vector(i));
+	}
+	doc_collection->remove_subset();
+
+	for (auto name : {"num_bits", "ngrams", "tokens_to_skip"})
+	{
+		indexed->build_index();
+		indexed->put(name, indexed->get<int32_t>(name));
+		EXPECT_EQ(indexed->get_num_indexed(), 0);
+	}
+	indexed->build_index();
+	indexed->put("should_normalize", false);
+	EXPECT_EQ(indexed->get_num_indexed(), 0);
+}
@@ -412,3 +412,69 @@ TEST(SparseFeaturesTest,subset_get_full_feature_vector_smaller)
 
 
 }
+
+TEST(SparseFeaturesTest,dense_dot_range_and_matrix)
+{
+	SGMatrix<float64_t> data(5, 8);
+	for (index_t i=0; i<data.num_rows*data.num_cols; ++i)
+		data.matrix[i]=i%3==0 ? 0 : 0.5*i-7;
+
+	auto features=std::make_shared<SparseFeatures<float64_t>>(data);
+
+	SGVector<index_t> subset_idx(3);
+	subset_idx[0]=6;
+	subset_idx[1]=1;
+	subset_idx[2]=4;
+	features->add_subset(subset_idx);
+
+	SGMatrix<float64_t> w(5, 2);
+	for (index_t i=0; i<w.num_rows*w.num_cols; ++i)
+		w.matrix[i]=1.0/(i+1);
+
+	SGVector<float64_t> output(features->get_num_vectors());
+	SGVector<float64_t> alphas(features->get_num_vectors());
+	alphas.range_fill(1.0);
+	features->dense_dot_range(output.vector, 0, output.vlen, alphas.vector,
+		w.matrix, w.num_rows, 0.25);
+
+	SGMatrix<float64_t> result=features->dense_dot_matrix(w);
+	EXPECT_EQ(result.num_rows, subset_idx.vlen);
+	EXPECT_EQ(result.num_cols, w.num_cols);
+
+	for (index_t i=0; i<subset_idx.vlen; ++i)
+	{
+		for (index_t c=0; c<w.num_cols; ++c)
+		{
+			float64_t expected=0;
+			for (index_t k=0; k<data.num_rows; ++k)
+				expected+=data(k, subset_idx[i])*w(k, c);
+
+			EXPECT_NEAR(result(i, c), expected, 1E-12);
+			if (c==0)
+				EXPECT_NEAR(output[i], alphas[i]*expected+0.25, 1E-12);
+		}
+	}
+}
+
+TEST(SparseFeaturesTest,sparse_dot_matrix)
+{
+	SGMatrix<float64_t> data_lhs(6, 10);
+	SGMatrix<float64_t> data_rhs(6, 7);
+	for (index_t i=0; i<data_lhs.num_rows*data_lhs.num_cols; ++i)
+		data_lhs.matrix[i]=i%4==1 ? 0 : 0.1*i-2;
+	for (index_t i=0; i<data_rhs.num_rows*data_rhs.num_cols; ++i)
+		data_rhs.matrix[i]=i%3==2 ? 0 : 3-0.2*i;
+
+	auto lhs=std::make_shared<SparseFeatures<float64_t>>(data_lhs);
+	auto rhs=std::make_shared<SparseFeatures<float64_t>>(data_rhs);
+
+	SGMatrix<float64_t> result=lhs->sparse_dot_matrix(rhs);
+	EXPECT_EQ(result.num_rows, lhs->get_num_vectors());
+	EXPECT_EQ(result.num_cols, rhs->get_num_vectors());
+
+	for (index_t i=0; i<result.num_rows; ++i)
+	{
+		for (index_t j=0; j<result.num_cols; ++j)
+			EXPECT_NEAR(result(i, j), lhs->dot(i, rhs, j), 1E-12);
+	}
+}
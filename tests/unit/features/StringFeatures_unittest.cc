@@ -91,3 +91,173 @@ TEST(StringFeaturesTest,equals)
 
 
 }
+
+static std::vector<SGVector<char>> generateRandomDNAData(std::mt19937_64& prng)
+{
+	const char* acgt = "ACGT";
+	std::uniform_int_distribution<int32_t> symbol(0, 3);
+	std::uniform_int_distribution<int32_t> length(1, 80);
+
+	std::vector<SGVector<char>> strings;
+	for (index_t i = 0; i < 20; ++i)
+	{
+		SGVector<char> string(length(prng));
+		for (index_t j = 0; j < string.vlen; ++j)
+			string[j] = acgt[symbol(prng)];
+		strings.push_back(string);
+	}
+	return strings;
+}
+
+TEST(StringFeaturesTest, set_features_contiguous)
+{
+	SGVector<char> buffer(10);
+	for (index_t i = 0; i < buffer.vlen; ++i)
+		buffer[i] = "ACGTACGTTT"[i];
+
+	auto f = std::make_shared<StringFeatures<char>>(DNA);
+	EXPECT_TRUE(f->set_features(buffer, SGVector<index_t>({0, 3, 3, 10})));
+	ASSERT_EQ(3, f->get_num_vectors());
+	EXPECT_EQ(7, f->get_max_vector_length());
+
+	int32_t len;
+	bool free_vec;
+	char* str = f->get_feature_vector(2, len, free_vec);
+	EXPECT_FALSE(free_vec);
+	EXPECT_EQ(7, len);
+	EXPECT_EQ(buffer.vector + 3, str);
+	f->free_feature_vector(str, 2, free_vec);
+	EXPECT_EQ(0, f->get_vector_length(1));
+
+	EXPECT_THROW(
+	    f->set_features(buffer, SGVector<index_t>({0, 11})), ShogunException);
+}
+
+TEST(StringFeaturesTest, make_contiguous)
+{
+	std::mt19937_64 prng(25);
+	auto strings = generateRandomDNAData(prng);
+	auto f = std::make_shared<StringFeatures<char>>(strings, DNA);
+	f->make_contiguous();
+
+	char* end = nullptr;
+	for (index_t i = 0; i < f->get_num_vectors(); ++i)
+	{
+		int32_t len;
+		bool free_vec;
+		char* str = f->get_feature_vector(i, len, free_vec);
+		if (end)
+			EXPECT_EQ(end, str);
+		ASSERT_EQ(strings[i].vlen, len);
+		for (index_t j = 0; j < len; ++j)
+			EXPECT_EQ(strings[i][j], str[j]);
+		end = str + len;
+		f->free_feature_vector(str, i, free_vec);
+	}
+}
+
+TEST(StringFeaturesTest, pack_unpack)
+{
+	std::mt19937_64 prng(25);
+	auto strings = generateRandomDNAData(prng);
+	auto f = std::make_shared<StringFeatures<char>>(strings, DNA);
+	f->pack();
+	EXPECT_TRUE(f->is_packed());
+
+	auto check = [&strings](std::shared_ptr<StringFeatures<char>> features) {
+		ASSERT_EQ(strings.size(), features->get_num_vectors());
+		for (index_t i = 0; i < features->get_num_vectors(); ++i)
+		{
+			EXPECT_EQ(strings[i].vlen, features->get_vector_length(i));
+			auto vec = features->get_feature_vector(i);
+			ASSERT_EQ(strings[i].vlen, vec.vlen);
+			for (index_t j = 0; j < vec.vlen; ++j)
+				EXPECT_EQ(strings[i][j], vec[j]);
+		}
+	};
+	check(f);
+	check(f->clone()->as<StringFeatures<char>>());
+
+	f->unpack();
+	EXPECT_FALSE(f->is_packed());
+	check(f);
+
+	auto alphanum = std::make_shared<StringFeatures<char>>(strings, ALPHANUM);
+	EXPECT_THROW(alphanum->pack(), ShogunException);
+}
+
+TEST(StringFeaturesTest, packed_string_list)
+{
+	std::mt19937_64 prng(25);
+	auto strings = generateRandomDNAData(prng);
+	auto f = std::make_shared<StringFeatures<char>>(strings, DNA);
+	f->pack();
+
+	// appending copies the strings of packed features
+	auto appended = std::make_shared<StringFeatures<char>>(strings, DNA);
+	appended->append_features(f);
+	ASSERT_EQ(2 * strings.size(), appended->get_num_vectors());
+	for (index_t i = 0; i < strings.size(); ++i)
+	{
+		auto vec = appended->get_feature_vector(strings.size() + i);
+		ASSERT_EQ(strings[i].vlen, vec.vlen);
+		for (index_t j = 0; j < vec.vlen; ++j)
+			EXPECT_EQ(strings[i][j], vec[j]);
+	}
+
+	// the string list is accessed in place, so the strings are unpacked
+	// explicitly and reading does not modify the features
+	EXPECT_THROW(f->get_string_list(), ShogunException);
+	EXPECT_TRUE(f->is_packed());
+	f->unpack();
+	const auto& list = f->get_string_list();
+	ASSERT_EQ(strings.size(), list.size());
+	for (index_t i = 0; i < list.size(); ++i)
+	{
+		ASSERT_EQ(strings[i].vlen, list[i].vlen);
+		ASSERT_TRUE(list[i].vector);
+		for (index_t j = 0; j < list[i].vlen; ++j)
+			EXPECT_EQ(strings[i][j], list[i][j]);
+	}
+
+	// new strings replace the packed ones
+	f->pack();
+	ASSERT_TRUE(f->set_features(strings));
+	EXPECT_FALSE(f->is_packed());
+	EXPECT_EQ(strings.size(), f->get_string_list().size());
+}
+
+TEST(StringFeaturesTest, obtain_from_packed_char)
+{
+	std::mt19937_64 prng(25);
+	auto strings = generateRandomDNAData(prng);
+	auto chars = std::make_shared<StringFeatures<char>>(strings, DNA);
+	auto packed = std::make_shared<StringFeatures<char>>(strings, DNA);
+	packed->pack();
+
+	for (auto order : {1, 3, 20, 32})
+	{
+		for (auto start : {0, order - 1})
+		{
+			for (auto rev : {false, true})
+			{
+				auto kmers = std::make_shared<StringFeatures<uint64_t>>(DNA);
+				kmers->obtain_from_char(chars, start, order, 0, rev);
+				auto packed_kmers =
+				    std::make_shared<StringFeatures<uint64_t>>(DNA);
+				packed_kmers->obtain_from_char(packed, start, order, 0, rev);
+
+				ASSERT_EQ(
+				    kmers->get_num_vectors(), packed_kmers->get_num_vectors());
+				for (index_t i = 0; i < kmers->get_num_vectors(); ++i)
+				{
+					auto expected = kmers->get_feature_vector(i);
+					auto vec = packed_kmers->get_feature_vector(i);
+					ASSERT_EQ(expected.vlen, vec.vlen);
+					for (index_t j = 0; j < vec.vlen; ++j)
+						EXPECT_EQ(expected[j], vec[j]);
+				}
+			}
+		}
+	}
+}
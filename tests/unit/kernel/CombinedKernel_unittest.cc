@@ -335,3 +335,70 @@ TEST(CombinedKernelTest,combination)
 		++j;
 	}
 }
+
+TEST(CombinedKernelTest, precomputed_subkernel_matrices)
+{
+	std::mt19937_64 prng(17);
+	SGMatrix<float64_t> data_l(2, 70);
+	SGMatrix<float64_t> data_r(2, 90);
+	random::fill_array(data_l, 0.0, 1.0, prng);
+	random::fill_array(data_r, 0.0, 1.0, prng);
+	auto feats_l = std::make_shared<DenseFeatures<float64_t>>(data_l);
+	auto feats_r = std::make_shared<DenseFeatures<float64_t>>(data_r);
+
+	auto combined = std::make_shared<CombinedKernel>();
+	combined->append_kernel(std::make_shared<GaussianKernel>(10, 0.5));
+	combined->append_kernel(std::make_shared<GaussianKernel>(10, 2.0));
+	combined->append_kernel(std::make_shared<GaussianKernel>(10, 8.0));
+	combined->set_subkernel_weights(SGVector<float64_t>({0.2, 0.3, 0.5}));
+
+	auto precomputed = make_clone(combined)->as<CombinedKernel>();
+	precomputed->set_precompute_subkernel_matrices(true);
+
+	/* upper triangle for lhs==rhs and full matrix otherwise */
+	for (auto rhs : {feats_l, feats_r})
+	{
+		combined->init(feats_l, rhs);
+		precomputed->init(feats_l, rhs);
+		EXPECT_FALSE(combined->has_subkernel_matrices());
+		EXPECT_TRUE(precomputed->has_subkernel_matrices());
+
+		auto expected = combined->get_kernel_matrix();
+		auto result = precomputed->get_kernel_matrix();
+		ASSERT_EQ(expected.num_rows, result.num_rows);
+		ASSERT_EQ(expected.num_cols, result.num_cols);
+		for (index_t i = 0; i < expected.num_rows * expected.num_cols; ++i)
+			EXPECT_NEAR(expected.matrix[i], result.matrix[i], 1e-6);
+
+		/* changing weights does not need recomputation */
+		SGVector<float64_t> weights({1.0, 0.0, 2.0});
+		combined->set_subkernel_weights(weights);
+		precomputed->set_subkernel_weights(weights);
+		for (index_t j = 0; j < expected.num_cols; j += 7)
+		{
+			for (index_t i = 0; i < expected.num_rows; i += 5)
+				EXPECT_NEAR(
+				    combined->kernel(i, j), precomputed->kernel(i, j), 1e-6);
+		}
+	}
+
+	combined->init(feats_l, feats_l);
+	precomputed->init(feats_l, feats_l);
+	SGVector<int32_t> idx({3, 11, 42, 69});
+	SGVector<float64_t> coef({0.5, -1.0, 2.0, 0.25});
+	auto expected = combined->compute_subkernel_quadratic_forms(idx, coef);
+	auto result = precomputed->compute_subkernel_quadratic_forms(idx, coef);
+	ASSERT_EQ(3, result.vlen);
+	for (index_t k = 0; k < result.vlen; ++k)
+	{
+		auto kernel = combined->get_kernel(k);
+		float64_t sum = 0;
+		for (index_t i = 0; i < idx.vlen; ++i)
+		{
+			for (index_t j = 0; j < idx.vlen; ++j)
+				sum += coef[i] * coef[j] * kernel->kernel(idx[i], idx[j]);
+		}
+		EXPECT_NEAR(sum, expected[k], 1e-10);
+		EXPECT_NEAR(sum, result[k], 1e-5);
+	}
+}
@@ -33,7 +33,9 @@
 #include <shogun/lib/SGVector.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/features/DenseFeatures.h>
+#include <shogun/features/SparseFeatures.h>
 #include <shogun/kernel/GaussianKernel.h>
+#include <shogun/kernel/LinearKernel.h>
 #include <shogun/mathematics/NormalDistribution.h>
 
 using namespace shogun;
@@ -370,3 +372,31 @@ TEST(Kernel, gaussian_get_kernel_matrix)
 
 
 }
+
+TEST(Kernel, linear_sparse_get_kernel_matrix)
+{
+	const int32_t seed = 100;
+	const index_t dim=20;
+
+	std::mt19937_64 prng(seed);
+	SGMatrix<float64_t> data_p = generate_std_norm_matrix(30, dim, prng);
+	SGMatrix<float64_t> data_q = generate_std_norm_matrix(40, dim, prng);
+	// keep about a fifth of the entries
+	for (index_t i=0; i<data_p.num_rows*data_p.num_cols; i++)
+		if (i%5!=0)
+			data_p.matrix[i]=0;
+	for (index_t i=0; i<data_q.num_rows*data_q.num_cols; i++)
+		if (i%5!=2)
+			data_q.matrix[i]=0;
+
+	auto feats_p=std::make_shared<SparseFeatures<float64_t>>(data_p);
+	auto feats_q=std::make_shared<SparseFeatures<float64_t>>(data_q);
+
+	auto kernel=std::make_shared<LinearKernel>(feats_p, feats_q);
+	SGMatrix<float64_t> km=kernel->get_kernel_matrix();
+	EXPECT_EQ(km.num_rows, feats_p->get_num_vectors());
+	EXPECT_EQ(km.num_cols, feats_q->get_num_vectors());
+	for (index_t i=0; i<km.num_rows; i++)
+		for (index_t j=0; j<km.num_cols; ++j)
+			EXPECT_NEAR(kernel->kernel(i,j), km(i, j), 1E-12);
+}
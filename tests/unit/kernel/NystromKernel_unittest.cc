@@ -0,0 +1,178 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/classifier/svm/LibSVM.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/kernel/NystromKernel.h>
+#include <shogun/labels/BinaryLabels.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/mathematics/RandomNamespace.h>
+
+#include <random>
+#include <set>
+
+using namespace shogun;
+
+class NystromKernelTest : public ::testing::Test
+{
+public:
+	void SetUp()
+	{
+		std::mt19937_64 prng(31);
+		NormalDistribution<float64_t> normal;
+		SGMatrix<float64_t> data(2, 200);
+		random::fill_array(data, normal, prng);
+		features = std::make_shared<DenseFeatures<float64_t>>(data);
+		gaussian = std::make_shared<GaussianKernel>(2.0);
+		gaussian->init(features, features);
+		exact = gaussian->get_kernel_matrix();
+		gaussian->cleanup();
+	}
+
+	void TearDown()
+	{
+		env()->set_num_threads(1);
+	}
+
+	float64_t approximation_error(const std::shared_ptr<NystromKernel>& kernel)
+	{
+		kernel->init(features, features);
+		auto approximation = kernel->get_kernel_matrix();
+		kernel->cleanup();
+
+		float64_t error = 0;
+		for (index_t i = 0; i < exact.num_rows * exact.num_cols; ++i)
+			error = std::max(error, std::abs(approximation[i] - exact[i]));
+		return error;
+	}
+
+	std::shared_ptr<DenseFeatures<float64_t>> features;
+	std::shared_ptr<GaussianKernel> gaussian;
+	SGMatrix<float64_t> exact;
+};
+
+TEST_F(NystromKernelTest, exact_with_all_landmarks)
+{
+	env()->set_num_threads(4);
+	for (auto selection : {NYSTROM_UNIFORM, NYSTROM_KMEANSPP, NYSTROM_LEVERAGE})
+	{
+		auto kernel = std::make_shared<NystromKernel>(
+		    gaussian, features->get_num_vectors(), selection);
+		kernel->put("seed", 7);
+		EXPECT_LT(approximation_error(kernel), 1e-6);
+		EXPECT_EQ(
+		    kernel->get_landmarks()->get_num_vectors(),
+		    features->get_num_vectors());
+	}
+}
+
+TEST_F(NystromKernelTest, landmark_selection)
+{
+	env()->set_num_threads(4);
+	for (auto selection : {NYSTROM_UNIFORM, NYSTROM_KMEANSPP, NYSTROM_LEVERAGE})
+	{
+		auto kernel = std::make_shared<NystromKernel>(gaussian, 30, selection);
+		kernel->put("seed", 7);
+		kernel->fit(features);
+
+		auto landmarks = kernel->get_landmarks()
+		                     ->as<DenseFeatures<float64_t>>()
+		                     ->get_feature_matrix();
+		ASSERT_EQ(landmarks.num_cols, 30);
+		std::set<std::pair<float64_t, float64_t>> distinct;
+		for (index_t i = 0; i < landmarks.num_cols; ++i)
+			distinct.emplace(landmarks(0, i), landmarks(1, i));
+		EXPECT_EQ(distinct.size(), 30);
+
+		EXPECT_LT(approximation_error(kernel), 0.1);
+	}
+}
+
+TEST_F(NystromKernelTest, feature_map)
+{
+	auto kernel = std::make_shared<NystromKernel>(gaussian, 40);
+	kernel->put("seed", 7);
+	auto feature_map = kernel->get_feature_map(features)->get_feature_matrix();
+	ASSERT_EQ(feature_map.num_rows, 40);
+	ASSERT_EQ(feature_map.num_cols, features->get_num_vectors());
+
+	kernel->init(features, features);
+	for (index_t i = 0; i < 10; ++i)
+	{
+		for (index_t j = 0; j < 10; ++j)
+		{
+			float64_t dot = 0;
+			for (index_t k = 0; k < feature_map.num_rows; ++k)
+				dot += feature_map(k, i) * feature_map(k, j);
+			EXPECT_NEAR(kernel->kernel(i, j), dot, 1e-12);
+		}
+	}
+}
+
+TEST_F(NystromKernelTest, libsvm)
+{
+	auto data = features->get_feature_matrix();
+	SGVector<float64_t> labels(data.num_cols);
+	for (index_t i = 0; i < data.num_cols; ++i)
+		labels[i] = data(0, i) * data(0, i) + data(1, i) * data(1, i) > 1.5
+		                ? 1
+		                : -1;
+	auto binary_labels = std::make_shared<BinaryLabels>(labels);
+
+	auto kernel = std::make_shared<NystromKernel>(gaussian, 50);
+	kernel->put("seed", 7);
+	auto svm = std::make_shared<LibSVM>(10, kernel, binary_labels);
+	svm->train(features);
+
+	auto predicted = svm->apply_binary(features)->get_labels();
+	index_t num_correct = 0;
+	for (index_t i = 0; i < labels.vlen; ++i)
+		num_correct += predicted[i] == labels[i];
+	EXPECT_GT(num_correct, 0.9 * labels.vlen);
+}
+
+TEST_F(NystromKernelTest, landmarks_selected_again_after_changes)
+{
+	auto kernel = std::make_shared<NystromKernel>(gaussian, 20);
+	kernel->put("seed", 7);
+	kernel->init(features, features);
+	auto landmarks = kernel->get_landmarks();
+	ASSERT_EQ(landmarks->get_num_vectors(), 20);
+
+	// unchanged parameters keep the landmarks
+	kernel->init(features, features);
+	EXPECT_EQ(landmarks, kernel->get_landmarks());
+	kernel->set_num_landmarks(20);
+	kernel->init(features, features);
+	EXPECT_EQ(landmarks, kernel->get_landmarks());
+
+	kernel->set_num_landmarks(30);
+	kernel->init(features, features);
+	EXPECT_EQ(kernel->get_landmarks()->get_num_vectors(), 30);
+
+	kernel->put("num_landmarks", 25);
+	kernel->init(features, features);
+	EXPECT_EQ(kernel->get_landmarks()->get_num_vectors(), 25);
+	EXPECT_EQ(kernel->get_projection().num_rows, 25);
+
+	// the wrapped kernel changed without going through the Nystroem kernel
+	landmarks = kernel->get_landmarks();
+	kernel->get_kernel()->as<GaussianKernel>()->set_width(0.5);
+	kernel->init(features, features);
+	EXPECT_NE(landmarks, kernel->get_landmarks());
+
+	// clones keep the landmarks, until their parameters change
+	landmarks = kernel->get_landmarks();
+	auto cloned = kernel->clone()->as<NystromKernel>();
+	cloned->init(features, features);
+	EXPECT_TRUE(cloned->get_landmarks()->equals(landmarks));
+	cloned->put("num_landmarks", 10);
+	cloned->init(features, features);
+	EXPECT_EQ(cloned->get_landmarks()->get_num_vectors(), 10);
+	EXPECT_EQ(kernel->get_landmarks(), landmarks);
+}
@@ -0,0 +1,101 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+#include <gtest/gtest.h>
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/features/StringFeatures.h>
+#include <shogun/kernel/string/WeightedDegreeStringKernel.h>
+#include <shogun/mathematics/UniformIntDistribution.h>
+#include <shogun/mathematics/UniformRealDistribution.h>
+
+#include <random>
+
+using namespace shogun;
+
+class WeightedDegreeStringKernelTest : public ::testing::Test
+{
+public:
+	void SetUp()
+	{
+		const char* acgt = "ACGT";
+		std::mt19937_64 prng(57);
+		UniformIntDistribution<int32_t> symbol(0, 3);
+		UniformRealDistribution<float64_t> alpha(-1, 1);
+
+		std::vector<SGVector<char>> strings;
+		for (index_t i = 0; i < num_vec; ++i)
+		{
+			SGVector<char> string(seq_length);
+			for (index_t j = 0; j < seq_length; ++j)
+				string[j] = acgt[symbol(prng)];
+			strings.push_back(string);
+		}
+		features = std::make_shared<StringFeatures<char>>(strings, DNA);
+
+		kernel = std::make_shared<WeightedDegreeStringKernel>(degree);
+		kernel->init(features, features);
+
+		sv_idx = SGVector<int32_t>(num_sv);
+		alphas = SGVector<float64_t>(num_sv);
+		for (index_t i = 0; i < num_sv; ++i)
+		{
+			sv_idx[i] = 2 * i;
+			alphas[i] = alpha(prng);
+		}
+
+		expected = SGVector<float64_t>(num_vec);
+		for (index_t i = 0; i < num_vec; ++i)
+		{
+			expected[i] = 0;
+			for (index_t k = 0; k < num_sv; ++k)
+				expected[i] += alphas[k] * kernel->kernel(sv_idx[k], i);
+		}
+	}
+
+	void TearDown()
+	{
+		env()->set_num_threads(1);
+	}
+
+	const index_t num_vec = 30;
+	const index_t seq_length = 25;
+	const index_t num_sv = 12;
+	const int32_t degree = 6;
+
+	std::shared_ptr<StringFeatures<char>> features;
+	std::shared_ptr<WeightedDegreeStringKernel> kernel;
+	SGVector<int32_t> sv_idx;
+	SGVector<float64_t> alphas;
+	SGVector<float64_t> expected;
+};
+
+TEST_F(WeightedDegreeStringKernelTest, init_optimization_threads)
+{
+	for (auto num_threads : {1, 4})
+	{
+		env()->set_num_threads(num_threads);
+		kernel->init_optimization(num_sv, sv_idx.vector, alphas.vector);
+		for (index_t i = 0; i < num_vec; ++i)
+			EXPECT_NEAR(expected[i], kernel->compute_optimized(i), 1e-4);
+		kernel->delete_optimization();
+	}
+}
+
+TEST_F(WeightedDegreeStringKernelTest, compute_batch_threads)
+{
+	SGVector<int32_t> vec_idx(num_vec);
+	vec_idx.range_fill();
+
+	for (auto num_threads : {1, 3, 8})
+	{
+		env()->set_num_threads(num_threads);
+		SGVector<float64_t> result(num_vec);
+		result.zero();
+		kernel->compute_batch(
+		    num_vec, vec_idx.vector, result.vector, num_sv, sv_idx.vector,
+		    alphas.vector);
+		for (index_t i = 0; i < num_vec; ++i)
+			EXPECT_NEAR(expected[i], result[i], 1e-4);
+	}
+}
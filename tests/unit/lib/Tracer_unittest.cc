@@ -0,0 +1,130 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/lib/Tracer.h>
+#include <shogun/lib/observers/ParameterObserverLogger.h>
+
+#include "utils/Utils.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+using namespace shogun;
+
+class TracerTest : public ::testing::Test
+{
+public:
+	void SetUp()
+	{
+		Tracer::enable();
+		env()->tracer()->reset();
+	}
+
+	void TearDown()
+	{
+		Tracer::disable();
+		env()->tracer()->reset();
+	}
+
+	static void traced_section()
+	{
+		SG_TRACE_SCOPE("tracer_test::section");
+	}
+};
+
+TEST_F(TracerTest, scope_counts_passes_of_all_threads)
+{
+	std::vector<std::thread> threads;
+	for (int32_t t = 0; t < 4; ++t)
+		threads.emplace_back([]() {
+			for (int32_t i = 0; i < 100; ++i)
+				traced_section();
+		});
+	for (auto& thread : threads)
+		thread.join();
+
+	auto tracer = env()->tracer();
+	EXPECT_EQ(tracer->get_count("tracer_test::section"), 400);
+	EXPECT_GE(tracer->get_seconds("tracer_test::section"), 0.0);
+
+	auto sections = tracer->get_sections();
+	EXPECT_EQ(sections.size(), 1);
+	EXPECT_EQ(sections[0], "tracer_test::section");
+}
+
+TEST_F(TracerTest, disabled_not_counted)
+{
+	Tracer::disable();
+	traced_section();
+	SG_TRACE_COUNT("tracer_test::counter", 3);
+	EXPECT_EQ(env()->tracer()->get_count("tracer_test::section"), 0);
+	EXPECT_EQ(env()->tracer()->get_count("tracer_test::counter"), 0);
+
+	Tracer::enable();
+	traced_section();
+	SG_TRACE_COUNT("tracer_test::counter", 3);
+	EXPECT_EQ(env()->tracer()->get_count("tracer_test::section"), 1);
+	EXPECT_EQ(env()->tracer()->get_count("tracer_test::counter"), 3);
+}
+
+TEST_F(TracerTest, kernel_matrix)
+{
+	SGMatrix<float64_t> data(2, 10);
+	for (index_t i = 0; i < data.num_rows * data.num_cols; ++i)
+		data.matrix[i] = i;
+	auto features = std::make_shared<DenseFeatures<float64_t>>(data);
+	auto kernel = std::make_shared<GaussianKernel>(features, features, 1.0);
+	kernel->get_kernel_matrix();
+
+	EXPECT_EQ(env()->tracer()->get_count("kernel::get_kernel_matrix"), 1);
+}
+
+TEST_F(TracerTest, observe_totals)
+{
+	traced_section();
+	traced_section();
+
+	auto tracer = env()->tracer();
+	std::shared_ptr<ParameterObserver> observer(new ParameterObserverLogger());
+	tracer->subscribe(observer);
+	tracer->observe_totals(0);
+	tracer->unsubscribe(observer);
+
+	EXPECT_EQ(observer->get<int32_t>("num_observations"), 2);
+}
+
+TEST_F(TracerTest, write_chrome_trace)
+{
+	Tracer::enable(true);
+	traced_section();
+	traced_section();
+	Tracer::disable();
+	traced_section();
+
+	char fname[] = "Tracer_chrome_trace.XXXXXX";
+	generate_temp_filename(fname);
+	env()->tracer()->write_chrome_trace(fname);
+
+	std::ifstream file(fname);
+	std::stringstream json;
+	json << file.rdbuf();
+	std::remove(fname);
+
+	auto content = json.str();
+	EXPECT_EQ(content.find("{\"traceEvents\":["), 0);
+	size_t num_events = 0;
+	for (auto pos = content.find("\"tracer_test::section\"");
+	     pos != std::string::npos;
+	     pos = content.find("\"tracer_test::section\"", pos + 1))
+		num_events++;
+	EXPECT_EQ(num_events, 2);
+}
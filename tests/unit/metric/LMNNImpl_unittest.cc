@@ -9,8 +9,11 @@
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/labels/MulticlassLabels.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
+#include <shogun/mathematics/NormalDistribution.h>
 #include <shogun/metric/LMNNImpl.h>
 
+#include <random>
+
 using namespace shogun;
 
 TEST(LMNNImpl,find_target_nn)
@@ -189,3 +192,111 @@ TEST(LMNNImpl,find_impostors_exact)
 
 
 }
+
+TEST(LMNNImpl,find_impostors_of_examples)
+{
+	std::mt19937_64 prng(11);
+	NormalDistribution<float64_t> normal;
+
+	int32_t d=3;
+	int32_t n=90;
+	SGMatrix<float64_t> feat_mat(d,n);
+	SGVector<float64_t> lab_vec(n);
+	for (index_t i=0; i<n; i++)
+	{
+		lab_vec[i]=i%3;
+		for (index_t j=0; j<d; j++)
+			feat_mat(j,i)=normal(prng)+lab_vec[i]*(j==0);
+	}
+	auto features=std::make_shared<DenseFeatures<float64_t>>(feat_mat);
+	auto labels=std::make_shared<MulticlassLabels>(lab_vec);
+
+	int32_t k=2;
+	SGMatrix<index_t> target_nn=LMNNImpl::find_target_nn(features,labels,k);
+	SGMatrix<float64_t> L(d,d);
+	for (index_t i=0; i<d*d; i++)
+		L[i]=normal(prng);
+
+	ImpostorsSetType exact =
+	    LMNNImpl::find_impostors(features, labels, L, target_nn, 0, 1);
+	ASSERT_GT(exact.size(), 0);
+
+	SGVector<index_t> examples(n/5);
+	for (index_t i=0; i<examples.vlen; i++)
+		examples[i]=i*5;
+	ImpostorsSetType impostors =
+	    LMNNImpl::find_impostors(features, labels, L, target_nn, examples);
+
+	// the impostors of the examples are the exact ones restricted to them
+	ImpostorsSetType expected;
+	for (const auto& node : exact)
+	{
+		if (node.example%5==0)
+			expected.insert(node);
+	}
+	ASSERT_EQ(impostors.size(), expected.size());
+	auto it=expected.begin();
+	for (const auto& node : impostors)
+	{
+		EXPECT_EQ(node.example, it->example);
+		EXPECT_EQ(node.target, it->target);
+		EXPECT_EQ(node.impostor, it->impostor);
+		++it;
+	}
+}
+
+TEST(LMNNImpl,update_gradient)
+{
+	std::mt19937_64 prng(13);
+	NormalDistribution<float64_t> normal;
+
+	int32_t d=4;
+	int32_t n=50;
+	SGMatrix<float64_t> feat_mat(d,n);
+	for (index_t i=0; i<d*n; i++)
+		feat_mat[i]=normal(prng);
+	auto features=std::make_shared<DenseFeatures<float64_t>>(feat_mat);
+
+	// enough triplets for several blocks of outer products
+	ImpostorsSetType Nc, Np;
+	for (index_t i=0; i<n; i++)
+	{
+		for (index_t j=0; j<n; j+=3)
+		{
+			if (i!=j)
+				Nc.insert(CImpostorNode(i, (i+1)%n, j));
+			if (i!=j+1 && j+1<n)
+				Np.insert(CImpostorNode(i, (i+1)%n, j+1));
+		}
+	}
+	// some triplets remain from the previous set
+	for (index_t i=0; i<n; i+=2)
+		Np.insert(CImpostorNode(i, (i+1)%n, i+3<n ? i+3 : 0));
+
+	SGMatrix<float64_t> G(d,d);
+	G.zero();
+	LMNNImpl::update_gradient(features, G, Nc, Np, 0.3);
+
+	SGMatrix<float64_t> expected(d,d);
+	expected.zero();
+	auto add_triplet=[&](const CImpostorNode& node, float64_t scale)
+	{
+		for (index_t r=0; r<d; r++)
+			for (index_t c=0; c<d; c++)
+			{
+				expected(r,c) += scale*(feat_mat(r,node.example)-feat_mat(r,node.target))*
+				    (feat_mat(c,node.example)-feat_mat(c,node.target));
+				expected(r,c) -= scale*(feat_mat(r,node.example)-feat_mat(r,node.impostor))*
+				    (feat_mat(c,node.example)-feat_mat(c,node.impostor));
+			}
+	};
+	for (const auto& node : Nc)
+		if (!Np.count(node))
+			add_triplet(node, 0.3);
+	for (const auto& node : Np)
+		if (!Nc.count(node))
+			add_triplet(node, -0.3);
+
+	for (index_t i=0; i<d*d; i++)
+		EXPECT_NEAR(G[i], expected[i], 1e-10);
+}
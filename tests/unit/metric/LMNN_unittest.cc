@@ -8,8 +8,13 @@
 
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/labels/MulticlassLabels.h>
+#include <shogun/mathematics/NormalDistribution.h>
 #include <shogun/metric/LMNN.h>
 
+#include <algorithm>
+#include <random>
+#include <vector>
+
 using namespace shogun;
 
 TEST(LMNN,train_identity_init)
@@ -197,3 +202,71 @@ TEST(LMNN,train_diagonal)
 
 
 }
+
+TEST(LMNN,train_stochastic)
+{
+	// three classes separated along the first dimension, the second one is noise
+	std::mt19937_64 prng(5);
+	NormalDistribution<float64_t> normal;
+	int32_t n=90;
+	SGMatrix<float64_t> feat_mat(2,n);
+	SGVector<float64_t> lab_vec(n);
+	for (index_t i=0; i<n; i++)
+	{
+		lab_vec[i]=i%3;
+		feat_mat(0,i)=3*lab_vec[i]+normal(prng);
+		feat_mat(1,i)=10*normal(prng);
+	}
+	auto features=std::make_shared<DenseFeatures<float64_t>>(feat_mat);
+	auto labels=std::make_shared<MulticlassLabels>(lab_vec);
+
+	int32_t k=2;
+	auto lmnn=std::make_shared<LMNN>(features,labels,k);
+	lmnn->set_batch_size(10);
+	lmnn->set_maxiter(500);
+	lmnn->put("seed", 3);
+	SGMatrix<float64_t> init_transform=SGMatrix<float64_t>::create_identity_matrix(2,1);
+	lmnn->train(init_transform);
+	SGMatrix<float64_t> L=lmnn->get_linear_transform();
+
+	// LMNN objective on all the data, the target neighbours are the nearest
+	// ones in the input space
+	auto distance=[&](const SGMatrix<float64_t>& T, index_t a, index_t b)
+	{
+		float64_t result=0;
+		for (index_t r=0; r<2; r++)
+		{
+			float64_t diff=T(r,0)*(feat_mat(0,a)-feat_mat(0,b))+
+			               T(r,1)*(feat_mat(1,a)-feat_mat(1,b));
+			result+=diff*diff;
+		}
+		return result;
+	};
+	SGMatrix<float64_t> identity=SGMatrix<float64_t>::create_identity_matrix(2,1);
+	auto objective=[&](const SGMatrix<float64_t>& T)
+	{
+		float64_t result=0;
+		for (index_t i=0; i<n; i++)
+		{
+			std::vector<std::pair<float64_t, index_t>> same;
+			for (index_t j=0; j<n; j++)
+				if (j!=i && lab_vec[j]==lab_vec[i])
+					same.emplace_back(distance(identity,i,j), j);
+			std::sort(same.begin(), same.end());
+			for (index_t l=0; l<k; l++)
+			{
+				float64_t target=distance(T, i, same[l].second);
+				result+=0.5*target;
+				for (index_t j=0; j<n; j++)
+					if (lab_vec[j]!=lab_vec[i])
+						result+=0.5*std::max(0.0, target+1-distance(T,i,j));
+			}
+		}
+		return result;
+	};
+
+	EXPECT_EQ(lmnn->get_statistics()->obj.vlen, 500);
+	EXPECT_LT(objective(L), 0.5*objective(identity));
+	// the noise dimension is shrunk
+	EXPECT_LT(std::abs(L(1,1)), 0.75*std::abs(L(0,0)));
+}
@@ -1,5 +1,6 @@
 #include <gtest/gtest.h>
 
+#include <shogun/base/ShogunEnv.h>
 #include <shogun/labels/MulticlassLabels.h>
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/features/SparseFeatures.h>
@@ -9,6 +10,8 @@
 #include <shogun/features/DataGenerator.h>
 #include <shogun/mathematics/RandomNamespace.h>
 
+#include <set>
+
 using namespace shogun;
 
 template <typename PRNG>
@@ -129,6 +132,122 @@ TEST_F(KNNTest, lsh_solver_sparse)
 
 }
 
+TEST_F(KNNTest, lsh_solver_index_reused)
+{
+	env()->set_num_threads(4);
+	auto knn = std::make_shared<KNN>(k, distance, labels, KNN_LSH);
+	knn->train(features);
+	auto index = knn->get_lsh_index();
+	ASSERT_TRUE(index);
+	EXPECT_EQ(features->get_num_vectors(), index->get_num_hashed());
+
+	auto output = knn->apply(features_test)->as<MulticlassLabels>();
+	EXPECT_EQ(index, knn->get_lsh_index());
+
+	// the LSH index does not depend on the HNSW settings
+	knn->set_hnsw_parameters(8, 100, 20);
+	EXPECT_EQ(index, knn->get_lsh_index());
+
+	auto cloned = knn->clone()->as<KNN>();
+	ASSERT_TRUE(cloned->get_lsh_index());
+	EXPECT_NE(index, cloned->get_lsh_index());
+	auto cloned_output = cloned->apply(features_test)->as<MulticlassLabels>();
+	env()->set_num_threads(1);
+
+	for ( index_t i = 0; i < labels_test->get_num_labels(); ++i )
+	{
+		EXPECT_EQ(output->get_label(i), labels_test->get_label(i));
+		EXPECT_EQ(output->get_label(i), cloned_output->get_label(i));
+	}
+}
+
+TEST_F(KNNTest, lsh_solver_add_training_data)
+{
+	auto knn = std::make_shared<KNN>(k, distance, labels, KNN_LSH);
+	knn->train(features);
+	auto index = knn->get_lsh_index();
+	ASSERT_TRUE(index);
+	index->set_rebuild_fraction(1.0);
+
+	auto num_train = features->get_num_vectors();
+	auto num_added = features_test->get_num_vectors();
+	knn->add_training_data(features_test, labels_test);
+	EXPECT_EQ(index, knn->get_lsh_index());
+	EXPECT_EQ(num_train, index->get_num_hashed());
+	EXPECT_EQ(num_train + num_added, index->get_num_vectors());
+
+	// added vectors are found although they are not hashed
+	auto NN = index->query(distance, 1);
+	for ( index_t i = 0; i < num_added; ++i )
+		EXPECT_EQ(0.0, distance->distance(NN(0, num_train + i), num_train + i));
+
+	auto output = knn->apply(features_test)->as<MulticlassLabels>();
+	for ( index_t i = 0; i < labels_test->get_num_labels(); ++i )
+		EXPECT_EQ(output->get_label(i), labels_test->get_label(i));
+
+	index->set_rebuild_fraction(0);
+	knn->add_training_data(features_test, labels_test);
+	EXPECT_EQ(num_train + 2 * num_added, index->get_num_hashed());
+}
+
+TEST_F(KNNTest, hnsw_solver)
+{
+	auto knn = std::make_shared<KNN>(k, distance, labels, KNN_HNSW);
+	knn->set_hnsw_parameters(4, 20, 10);
+	knn->train(features);
+	auto output = knn->apply(features_test)->as<MulticlassLabels>();
+
+	for ( index_t i = 0; i < labels_test->get_num_labels(); ++i )
+		EXPECT_EQ(output->get_label(i), labels_test->get_label(i));
+}
+
+TEST_F(KNNTest, hnsw_solver_threads_recall)
+{
+	env()->set_num_threads(4);
+	auto knn = std::make_shared<KNN>(k, distance, labels, KNN_HNSW);
+	knn->set_hnsw_parameters(4, 20, 20);
+	knn->train(features);
+
+	auto index = knn->get_hnsw_index();
+	ASSERT_TRUE(index);
+	EXPECT_EQ(features->get_num_vectors(), index->get_num_vectors());
+
+	distance->init(features, features_test);
+	auto approximate = index->query(distance, k, 20);
+	auto exact = std::make_shared<KNN>(k, distance, labels, KNN_BRUTE)
+	                 ->nearest_neighbors();
+	env()->set_num_threads(1);
+
+	index_t found = 0;
+	for (index_t i = 0; i < exact.num_cols; ++i)
+	{
+		for (index_t j = 0; j < k; ++j)
+		{
+			for (index_t l = 0; l < k; ++l)
+				found += approximate(l, i) == exact(j, i);
+		}
+	}
+	EXPECT_GE(found, 0.95 * k * exact.num_cols);
+}
+
+TEST_F(KNNTest, hnsw_solver_clone_reuses_index)
+{
+	auto knn = std::make_shared<KNN>(k, distance, labels, KNN_HNSW);
+	knn->train(features);
+	auto output = knn->apply(features_test)->as<MulticlassLabels>();
+
+	auto cloned = knn->clone()->as<KNN>();
+	auto index = cloned->get_hnsw_index();
+	ASSERT_TRUE(index);
+	EXPECT_NE(knn->get_hnsw_index(), index);
+	EXPECT_TRUE(knn->get_hnsw_index()->equals(index));
+
+	auto cloned_output = cloned->apply(features_test)->as<MulticlassLabels>();
+	EXPECT_EQ(index, cloned->get_hnsw_index());
+	for ( index_t i = 0; i < labels_test->get_num_labels(); ++i )
+		EXPECT_EQ(output->get_label(i), cloned_output->get_label(i));
+}
+
 TEST(KNN, classify_multiple_brute)
 {
 	std::mt19937_64 prng(17);
@@ -226,3 +345,25 @@ TEST(KNN, classify_multiple_kdtree)
 
 
 }
+
+TEST_F(KNNTest, hnsw_solver_distinct_neighbors)
+{
+	auto knn = std::make_shared<KNN>(k, distance, labels, KNN_HNSW);
+	knn->set_hnsw_parameters(2, 4, 4);
+	knn->train(features);
+
+	auto index = knn->get_hnsw_index();
+	ASSERT_TRUE(index);
+	auto num_vectors = index->get_num_vectors();
+
+	distance->init(features, features_test);
+	auto neighbors = index->query(distance, num_vectors, 4);
+	ASSERT_EQ(num_vectors, neighbors.num_rows);
+	for (index_t i = 0; i < neighbors.num_cols; ++i)
+	{
+		std::set<index_t> distinct;
+		for (index_t j = 0; j < num_vectors; ++j)
+			distinct.insert(neighbors(j, i));
+		EXPECT_EQ(num_vectors, distinct.size());
+	}
+}
@@ -0,0 +1,128 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+#include <gtest/gtest.h>
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/classifier/svm/LibSVM.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/kernel/CustomKernel.h>
+#include <shogun/kernel/GaussianKernel.h>
+#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/machine/KernelMulticlassMachine.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/multiclass/MulticlassOneVsOneStrategy.h>
+#include <shogun/multiclass/MulticlassOneVsRestStrategy.h>
+
+using namespace shogun;
+
+class KernelMulticlassMachineTest : public ::testing::Test
+{
+public:
+	void SetUp()
+	{
+		index_t num_vec = 60;
+		index_t num_class = 4;
+		float64_t distance = 5;
+
+		SGMatrix<float64_t> matrix(num_class, num_vec);
+		labels = std::make_shared<MulticlassLabels>(num_vec);
+		std::mt19937_64 prng(57);
+		NormalDistribution<float64_t> normal_dist;
+		for (index_t i = 0; i < num_vec; ++i)
+		{
+			index_t label = i % num_class;
+			for (index_t j = 0; j < num_class; ++j)
+				matrix(j, i) = normal_dist(prng);
+
+			matrix(label, i) += distance;
+			labels->set_label(i, label);
+		}
+		features = std::make_shared<DenseFeatures<float64_t>>(matrix);
+	}
+
+	void TearDown()
+	{
+		env()->set_num_threads(1);
+	}
+
+	/* trains with the given number of threads and returns the outputs of
+	 * all sub-machines on the training vectors */
+	SGMatrix<float64_t> train_with_threads(
+	    std::shared_ptr<MulticlassStrategy> strategy,
+	    std::shared_ptr<Kernel> kernel, int32_t num_threads)
+	{
+		env()->set_num_threads(num_threads);
+
+		auto svm = std::make_shared<LibSVM>();
+		auto machine = std::make_shared<KernelMulticlassMachine>(
+		    strategy, kernel, svm, labels);
+		machine->train();
+
+		auto pred = machine->apply_multiclass();
+		for (index_t i = 0; i < labels->get_num_labels(); ++i)
+			EXPECT_EQ(labels->get_label(i), pred->get_label(i));
+
+		auto num_machines = strategy->get_num_machines();
+		auto num_vec = labels->get_num_labels();
+		SGMatrix<float64_t> outputs(num_vec, num_machines);
+		for (index_t m = 0; m < num_machines; ++m)
+		{
+			auto sub = machine->get_machine(m)->as<KernelMachine>();
+			sub->set_kernel(kernel);
+			for (index_t i = 0; i < num_vec; ++i)
+				outputs(i, m) = sub->apply_one(i);
+		}
+
+		return outputs;
+	}
+
+	std::shared_ptr<DenseFeatures<float64_t>> features;
+	std::shared_ptr<MulticlassLabels> labels;
+};
+
+TEST_F(KernelMulticlassMachineTest, one_vs_rest_concurrent_train)
+{
+	auto kernel = std::make_shared<GaussianKernel>(features, features, 2.0);
+	auto single = train_with_threads(
+	    std::make_shared<MulticlassOneVsRestStrategy>(), kernel, 1);
+	auto multi = train_with_threads(
+	    std::make_shared<MulticlassOneVsRestStrategy>(), kernel, 4);
+
+	ASSERT_EQ(single.num_cols, multi.num_cols);
+	for (index_t i = 0; i < single.num_rows * single.num_cols; ++i)
+		EXPECT_NEAR(single[i], multi[i], 1e-10);
+}
+
+TEST_F(KernelMulticlassMachineTest, one_vs_one_concurrent_train)
+{
+	auto kernel = std::make_shared<GaussianKernel>(features, features, 2.0);
+	auto single = train_with_threads(
+	    std::make_shared<MulticlassOneVsOneStrategy>(), kernel, 1);
+	auto multi = train_with_threads(
+	    std::make_shared<MulticlassOneVsOneStrategy>(), kernel, 4);
+
+	ASSERT_EQ(single.num_cols, multi.num_cols);
+	for (index_t i = 0; i < single.num_rows * single.num_cols; ++i)
+		EXPECT_NEAR(single[i], multi[i], 1e-10);
+}
+
+TEST_F(KernelMulticlassMachineTest, one_vs_one_precomputed_kernel)
+{
+	auto gaussian = std::make_shared<GaussianKernel>(features, features, 2.0);
+	auto expected = train_with_threads(
+	    std::make_shared<MulticlassOneVsOneStrategy>(), gaussian, 1);
+
+	auto kernel = std::make_shared<CustomKernel>(gaussian);
+	auto single = train_with_threads(
+	    std::make_shared<MulticlassOneVsOneStrategy>(), kernel, 1);
+	auto multi = train_with_threads(
+	    std::make_shared<MulticlassOneVsOneStrategy>(), kernel, 4);
+
+	ASSERT_EQ(expected.num_cols, multi.num_cols);
+	for (index_t i = 0; i < expected.num_rows * expected.num_cols; ++i)
+	{
+		EXPECT_NEAR(expected[i], single[i], 1e-6);
+		EXPECT_NEAR(single[i], multi[i], 1e-10);
+	}
+}
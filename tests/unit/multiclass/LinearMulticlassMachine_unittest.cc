@@ -0,0 +1,105 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+#include <gtest/gtest.h>
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/classifier/svm/LibLinear.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/labels/MulticlassLabels.h>
+#include <shogun/machine/LinearMulticlassMachine.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/multiclass/MulticlassOneVsOneStrategy.h>
+#include <shogun/multiclass/MulticlassOneVsRestStrategy.h>
+
+using namespace shogun;
+
+class LinearMulticlassMachineTest : public ::testing::Test
+{
+public:
+	void SetUp()
+	{
+		index_t num_vec = 60;
+		index_t num_class = 4;
+		float64_t distance = 5;
+
+		SGMatrix<float64_t> matrix(num_class, num_vec);
+		labels = std::make_shared<MulticlassLabels>(num_vec);
+		std::mt19937_64 prng(57);
+		NormalDistribution<float64_t> normal_dist;
+		for (index_t i = 0; i < num_vec; ++i)
+		{
+			index_t label = i % num_class;
+			for (index_t j = 0; j < num_class; ++j)
+				matrix(j, i) = normal_dist(prng);
+
+			matrix(label, i) += distance;
+			labels->set_label(i, label);
+		}
+		features = std::make_shared<DenseFeatures<float64_t>>(matrix);
+	}
+
+	void TearDown()
+	{
+		env()->set_num_threads(1);
+	}
+
+	/* trains with the given number of threads and returns the sub-machines
+	 * weights concatenated */
+	SGVector<float64_t> train_with_threads(
+	    std::shared_ptr<MulticlassStrategy> strategy, int32_t num_threads)
+	{
+		env()->set_num_threads(num_threads);
+
+		auto svm = std::make_shared<LibLinear>(L2R_L2LOSS_SVC);
+		svm->put("C1", 1.0);
+		svm->put("C2", 1.0);
+		auto machine = std::make_shared<LinearMulticlassMachine>(
+		    strategy, features, svm, labels);
+		machine->train();
+
+		auto pred = machine->apply_multiclass(features);
+		for (index_t i = 0; i < labels->get_num_labels(); ++i)
+			EXPECT_EQ(labels->get_label(i), pred->get_label(i));
+
+		auto num_machines = strategy->get_num_machines();
+		auto dim = features->get_num_features();
+		SGVector<float64_t> weights(num_machines * dim);
+		for (index_t m = 0; m < num_machines; ++m)
+		{
+			auto w = machine->get_machine(m)->as<LinearMachine>()->get_w();
+			EXPECT_EQ(dim, w.vlen);
+			for (index_t j = 0; j < dim; ++j)
+				weights[m * dim + j] = w[j];
+		}
+
+		return weights;
+	}
+
+	std::shared_ptr<DenseFeatures<float64_t>> features;
+	std::shared_ptr<MulticlassLabels> labels;
+};
+
+TEST_F(LinearMulticlassMachineTest, one_vs_rest_concurrent_train)
+{
+	auto single = train_with_threads(
+	    std::make_shared<MulticlassOneVsRestStrategy>(), 1);
+	auto multi = train_with_threads(
+	    std::make_shared<MulticlassOneVsRestStrategy>(), 4);
+
+	ASSERT_EQ(single.vlen, multi.vlen);
+	for (index_t i = 0; i < single.vlen; ++i)
+		EXPECT_NEAR(single[i], multi[i], 1e-10);
+}
+
+TEST_F(LinearMulticlassMachineTest, one_vs_one_concurrent_train)
+{
+	auto single = train_with_threads(
+	    std::make_shared<MulticlassOneVsOneStrategy>(), 1);
+	auto multi = train_with_threads(
+	    std::make_shared<MulticlassOneVsOneStrategy>(), 4);
+
+	ASSERT_EQ(single.vlen, multi.vlen);
+	for (index_t i = 0; i < single.vlen; ++i)
+		EXPECT_NEAR(single[i], multi[i], 1e-10);
+}
@@ -0,0 +1,158 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/base/ShogunEnv.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/streaming/StreamingDenseFeatures.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/mathematics/RandomNamespace.h>
+#include <shogun/mathematics/linalg/LinalgNamespace.h>
+#include <shogun/preprocessor/IncrementalPCA.h>
+#include <shogun/preprocessor/PCA.h>
+
+#include <random>
+
+using namespace shogun;
+
+class IncrementalPCATest : public ::testing::Test
+{
+public:
+	void SetUp()
+	{
+		// data of rank target_dim, which truncation does not change
+		std::mt19937_64 prng(23);
+		NormalDistribution<float64_t> normal;
+		SGMatrix<float64_t> basis(num_features, target_dim);
+		SGMatrix<float64_t> coefficients(target_dim, num_vectors);
+		random::fill_array(basis, normal, prng);
+		random::fill_array(coefficients, normal, prng);
+		for (index_t i = 0; i < target_dim; ++i)
+			for (index_t j = 0; j < num_vectors; ++j)
+				coefficients(i, j) = coefficients(i, j) * (target_dim - i) + i;
+		data = linalg::matrix_prod(basis, coefficients);
+
+		features = std::make_shared<DenseFeatures<float64_t>>(data);
+		pca = std::make_shared<PCA>(SVD);
+		pca->set_target_dim(target_dim);
+		pca->fit(features);
+	}
+
+	void TearDown()
+	{
+		env()->set_num_threads(1);
+	}
+
+	void expect_pca(const std::shared_ptr<IncrementalPCA>& ipca)
+	{
+		EXPECT_EQ(ipca->get_num_vectors_seen(), num_vectors);
+
+		auto mean = ipca->get_mean();
+		auto expected_mean = pca->get_mean();
+		ASSERT_EQ(mean.vlen, num_features);
+		for (index_t i = 0; i < num_features; ++i)
+			EXPECT_NEAR(mean[i], expected_mean[i], 1e-10);
+
+		auto eigenvalues = ipca->get_eigenvalues();
+		auto expected_eigenvalues = pca->get_eigenvalues();
+		ASSERT_EQ(eigenvalues.vlen, target_dim);
+		for (index_t i = 0; i < target_dim; ++i)
+			EXPECT_NEAR(
+			    eigenvalues[i], expected_eigenvalues[i],
+			    1e-10 * expected_eigenvalues[0]);
+
+		auto transmat = ipca->get_transformation_matrix();
+		auto expected_transmat = pca->get_transformation_matrix();
+		ASSERT_EQ(transmat.num_rows, num_features);
+		ASSERT_EQ(transmat.num_cols, target_dim);
+		for (index_t i = 0; i < target_dim; ++i)
+			EXPECT_NEAR(
+			    std::abs(linalg::dot(
+			        transmat.get_column(i), expected_transmat.get_column(i))),
+			    1.0, 1e-10);
+	}
+
+	const index_t num_features = 10;
+	const index_t num_vectors = 500;
+	const index_t target_dim = 3;
+
+	SGMatrix<float64_t> data;
+	std::shared_ptr<DenseFeatures<float64_t>> features;
+	std::shared_ptr<PCA> pca;
+};
+
+TEST_F(IncrementalPCATest, fit_dense)
+{
+	auto ipca = std::make_shared<IncrementalPCA>(target_dim);
+	ipca->set_batch_size(37);
+	ipca->fit(features);
+	expect_pca(ipca);
+
+	auto embedding = ipca->transform(features)
+	                     ->as<DenseFeatures<float64_t>>()
+	                     ->get_feature_matrix();
+	auto expected = pca->transform(features)
+	                    ->as<DenseFeatures<float64_t>>()
+	                    ->get_feature_matrix();
+	ASSERT_EQ(embedding.num_rows, target_dim);
+	ASSERT_EQ(embedding.num_cols, num_vectors);
+	for (index_t i = 0; i < embedding.num_rows * embedding.num_cols; ++i)
+		EXPECT_NEAR(std::abs(embedding[i]), std::abs(expected[i]), 1e-8);
+}
+
+TEST_F(IncrementalPCATest, fit_dense_parallel)
+{
+	env()->set_num_threads(4);
+	auto ipca = std::make_shared<IncrementalPCA>(target_dim);
+	ipca->set_batch_size(50);
+	ipca->fit(features);
+	expect_pca(ipca);
+}
+
+TEST_F(IncrementalPCATest, fit_streaming)
+{
+	env()->set_num_threads(3);
+	auto stream = std::make_shared<StreamingDenseFeatures<float64_t>>(features);
+	auto ipca = std::make_shared<IncrementalPCA>(target_dim);
+	ipca->set_batch_size(64);
+	ipca->fit(stream);
+	expect_pca(ipca);
+}
+
+TEST_F(IncrementalPCATest, partial_fit_and_merge)
+{
+	auto first = std::make_shared<IncrementalPCA>(target_dim);
+	auto second = std::make_shared<IncrementalPCA>(target_dim);
+	for (index_t start = 0; start < num_vectors; start += 100)
+	{
+		SGMatrix<float64_t> batch(
+		    data.get_column_vector(start), num_features, 100, false);
+		if (start < 200)
+			first->partial_fit(batch);
+		else
+			second->partial_fit(batch);
+	}
+	EXPECT_EQ(first->get_num_vectors_seen(), 200);
+	first->merge(second);
+	expect_pca(first);
+}
+
+TEST_F(IncrementalPCATest, whitening)
+{
+	auto ipca = std::make_shared<IncrementalPCA>(target_dim, true);
+	ipca->fit(features);
+
+	auto embedding = ipca->transform(features)
+	                     ->as<DenseFeatures<float64_t>>()
+	                     ->get_feature_matrix();
+	// whitened components have unit norm over the vectors
+	for (index_t i = 0; i < target_dim; ++i)
+	{
+		float64_t norm = 0;
+		for (index_t j = 0; j < num_vectors; ++j)
+			norm += embedding(i, j) * embedding(i, j);
+		EXPECT_NEAR(norm, 1.0, 1e-10);
+	}
+}
@@ -7,6 +7,10 @@
 #include <shogun/preprocessor/KernelPCA.h>
 #include <shogun/kernel/GaussianKernel.h>
 #include <shogun/lib/SGMatrix.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/mathematics/RandomNamespace.h>
+
+#include <random>
 
 
 using ::testing::Test;
@@ -101,3 +105,86 @@ TEST(KernelPCA, apply_to_feature_vector)
 
 
 }
+
+TEST(KernelPCA, nystrom_all_landmarks)
+{
+	index_t num_test_vectors = 2;
+
+	SGMatrix<float64_t> train_matrix(num_features, num_vectors);
+	SGMatrix<float64_t> test_matrix(num_features, num_test_vectors);
+	load_data(train_matrix, test_matrix);
+
+	auto train_feats =
+	    std::make_shared<DenseFeatures<float64_t>>(train_matrix);
+	auto test_feats = std::make_shared<DenseFeatures<float64_t>>(test_matrix);
+
+	auto kernel = std::make_shared<GaussianKernel>();
+	kernel->set_width(1);
+
+	// the Nystroem approximation is exact with all vectors as landmarks
+	auto kpca = std::make_shared<KernelPCA>(kernel);
+	kpca->set_method(KPCA_NYSTROM);
+	kpca->set_num_landmarks(num_vectors);
+	kpca->set_target_dim(target_dim);
+	kpca->fit(train_feats);
+
+	SGMatrix<float64_t> embedding = kpca->transform(test_feats)
+	                                    ->as<DenseFeatures<float64_t>>()
+	                                    ->get_feature_matrix();
+
+	// allow embedding with opposite sign
+	for (index_t i = 0; i < num_test_vectors * target_dim; ++i)
+		EXPECT_NEAR(Math::abs(embedding[i]), Math::abs(resdata[i]), 1E-6);
+}
+
+TEST(KernelPCA, randomized_and_nystrom)
+{
+	const index_t num_train = 200;
+	const index_t num_test = 4;
+
+	std::mt19937_64 prng(5);
+	NormalDistribution<float64_t> normal;
+	SGMatrix<float64_t> train_matrix(num_features, num_train);
+	SGMatrix<float64_t> test_matrix(num_features, num_test);
+	random::fill_array(train_matrix, normal, prng);
+	random::fill_array(test_matrix, normal, prng);
+	auto train_feats =
+	    std::make_shared<DenseFeatures<float64_t>>(train_matrix);
+	auto test_feats = std::make_shared<DenseFeatures<float64_t>>(test_matrix);
+
+	auto kernel = std::make_shared<GaussianKernel>();
+	kernel->set_width(2);
+
+	auto kpca = std::make_shared<KernelPCA>(kernel);
+	kpca->set_target_dim(target_dim);
+	kpca->fit(train_feats);
+	auto expected = kpca->transform(test_feats)
+	                    ->as<DenseFeatures<float64_t>>()
+	                    ->get_feature_matrix();
+
+	auto randomized = std::make_shared<KernelPCA>(kernel);
+	randomized->put("seed", 11);
+	randomized->set_method(KPCA_RANDOMIZED);
+	randomized->set_oversampling(20);
+	randomized->set_target_dim(target_dim);
+	randomized->fit(train_feats);
+	auto embedding = randomized->transform(test_feats)
+	                     ->as<DenseFeatures<float64_t>>()
+	                     ->get_feature_matrix();
+	for (index_t i = 0; i < num_test * target_dim; ++i)
+		EXPECT_NEAR(Math::abs(embedding[i]), Math::abs(expected[i]), 1E-4);
+
+	// the landmarks only approximate the leading components
+	auto nystrom = std::make_shared<KernelPCA>(kernel);
+	nystrom->put("seed", 11);
+	nystrom->set_method(KPCA_NYSTROM);
+	nystrom->set_num_landmarks(100);
+	nystrom->set_target_dim(target_dim);
+	nystrom->fit(train_feats);
+	EXPECT_EQ(nystrom->get_transformation_matrix().num_rows, 100);
+	embedding = nystrom->transform(test_feats)
+	                ->as<DenseFeatures<float64_t>>()
+	                ->get_feature_matrix();
+	for (index_t i = 0; i < num_test * target_dim; ++i)
+		EXPECT_NEAR(Math::abs(embedding[i]), Math::abs(expected[i]), 5E-2);
+}
@@ -9,10 +9,14 @@
 #include <shogun/features/DenseFeatures.h>
 #include <shogun/lib/SGMatrix.h>
 #include <shogun/lib/SGVector.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/mathematics/RandomNamespace.h>
 #include <shogun/mathematics/linalg/LinalgNamespace.h>
 
 #include <shogun/preprocessor/PCA.h>
 
+#include <random>
+
 using namespace shogun;
 
 /** Check eigenvector equality
@@ -603,3 +607,57 @@ TEST(PCA, PCA_WHITEN_EVD)
 	EXPECT_NEAR(0.0,covariance_mat(2,1),epsilon);
 	EXPECT_NEAR(1.0,covariance_mat(2,2),epsilon);
 }
+
+TEST(PCA, PCA_RANDOMIZED)
+{
+	const index_t num_features = 20;
+	const index_t num_vectors = 200;
+	const index_t rank = 5;
+
+	// low rank data with small noise
+	std::mt19937_64 prng(17);
+	NormalDistribution<float64_t> normal;
+	SGMatrix<float64_t> basis(num_features, rank);
+	SGMatrix<float64_t> coefficients(rank, num_vectors);
+	random::fill_array(basis, normal, prng);
+	random::fill_array(coefficients, normal, prng);
+	for (index_t i = 0; i < rank; ++i)
+		for (index_t j = 0; j < num_vectors; ++j)
+			coefficients(i, j) *= rank - i;
+	auto data = linalg::matrix_prod(basis, coefficients);
+	for (index_t i = 0; i < data.num_rows * data.num_cols; ++i)
+		data[i] += 1e-3 * normal(prng);
+
+	auto features = std::make_shared<DenseFeatures<float64_t>>(data);
+	auto pca = std::make_shared<PCA>(SVD);
+	pca->set_target_dim(3);
+	pca->fit(features);
+
+	auto randomized = std::make_shared<PCA>(RANDOMIZED);
+	randomized->put("seed", 3);
+	randomized->set_target_dim(3);
+	randomized->set_oversampling(5);
+	randomized->fit(features);
+
+	auto eigenvalues = pca->get_eigenvalues();
+	auto randomized_eigenvalues = randomized->get_eigenvalues();
+	EXPECT_EQ(randomized_eigenvalues.vlen, 8);
+	for (index_t i = 0; i < 3; ++i)
+		EXPECT_NEAR(
+		    eigenvalues[i], randomized_eigenvalues[i], 1e-8 * eigenvalues[0]);
+
+	auto transmat = pca->get_transformation_matrix();
+	auto randomized_transmat = randomized->get_transformation_matrix();
+	ASSERT_EQ(randomized_transmat.num_rows, num_features);
+	ASSERT_EQ(randomized_transmat.num_cols, 3);
+	for (index_t i = 0; i < 3; ++i)
+		check_eigenvector_eq(
+		    transmat.get_column(i), randomized_transmat.get_column(i), 1e-8);
+
+	// vectors are reduced to the target dimension
+	auto embedding = randomized->transform(features)
+	                     ->as<DenseFeatures<float64_t>>()
+	                     ->get_feature_matrix();
+	EXPECT_EQ(embedding.num_rows, 3);
+	EXPECT_EQ(embedding.num_cols, num_vectors);
+}
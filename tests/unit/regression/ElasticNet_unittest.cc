@@ -0,0 +1,182 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ *
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/features/SparseFeatures.h>
+#include <shogun/labels/RegressionLabels.h>
+#include <shogun/mathematics/NormalDistribution.h>
+#include <shogun/mathematics/UniformRealDistribution.h>
+#include <shogun/regression/ElasticNet.h>
+
+#include <random>
+
+using namespace shogun;
+
+class ElasticNetTest : public ::testing::Test
+{
+public:
+	void SetUp()
+	{
+		std::mt19937_64 prng(7);
+		NormalDistribution<float64_t> normal;
+		UniformRealDistribution<float64_t> uniform(0.0, 1.0);
+
+		// more features than vectors, a third of the entries zero
+		m_data = SGMatrix<float64_t>(200, 60);
+		for (index_t i = 0; i < m_data.num_rows * m_data.num_cols; ++i)
+			m_data.matrix[i] = uniform(prng) < 0.3 ? 0 : normal(prng) + 0.5;
+
+		SGVector<float64_t> y(m_data.num_cols);
+		for (index_t i = 0; i < m_data.num_cols; ++i)
+		{
+			y[i] = 2.0 + 0.1 * normal(prng);
+			for (index_t j = 0; j < 10; ++j)
+				y[i] += (j % 2 ? 3.0 : -2.0) * m_data(j * 7, i);
+		}
+		m_labels = std::make_shared<RegressionLabels>(y);
+	}
+
+	/** Checks the optimality conditions of the objective at the weights
+	 * and bias of the machine.
+	 */
+	void check_optimality(
+	    const std::shared_ptr<ElasticNet>& machine, float64_t lambda,
+	    float64_t l1_ratio)
+	{
+		auto w = machine->get_w();
+		auto b = machine->get_bias();
+		auto y = m_labels->get_labels();
+		index_t n = m_data.num_cols;
+
+		SGVector<float64_t> r(n);
+		float64_t r_sum = 0;
+		for (index_t i = 0; i < n; ++i)
+		{
+			r[i] = y[i] - b;
+			for (index_t j = 0; j < m_data.num_rows; ++j)
+				r[i] -= w[j] * m_data(j, i);
+			r_sum += r[i];
+		}
+		EXPECT_NEAR(r_sum / n, 0, 1e-8);
+
+		for (index_t j = 0; j < m_data.num_rows; ++j)
+		{
+			float64_t g = 0;
+			for (index_t i = 0; i < n; ++i)
+				g += m_data(j, i) * r[i];
+			g = g / n - lambda * (1 - l1_ratio) * w[j];
+			if (w[j] == 0)
+				EXPECT_LE(std::abs(g), lambda * l1_ratio + 1e-4);
+			else
+				EXPECT_NEAR(
+				    g, lambda * l1_ratio * (w[j] > 0 ? 1 : -1), 1e-4);
+		}
+	}
+
+protected:
+	SGMatrix<float64_t> m_data;
+	std::shared_ptr<RegressionLabels> m_labels;
+};
+
+TEST_F(ElasticNetTest, lasso_optimality)
+{
+	auto features = std::make_shared<DenseFeatures<float64_t>>(m_data);
+	auto machine = std::make_shared<ElasticNet>(0.05, 1.0);
+	machine->put("epsilon", 1e-12);
+	machine->set_labels(m_labels);
+	machine->train(features);
+	check_optimality(machine, 0.05, 1.0);
+
+	// the relevant features are found
+	auto w = machine->get_w();
+	for (index_t j = 0; j < 10; ++j)
+		EXPECT_NE(w[j * 7], 0);
+}
+
+TEST_F(ElasticNetTest, elastic_net_optimality)
+{
+	auto features = std::make_shared<DenseFeatures<float64_t>>(m_data);
+	auto machine = std::make_shared<ElasticNet>(0.1, 0.4);
+	machine->set_num_lambdas(1);
+	machine->put("epsilon", 1e-12);
+	machine->set_labels(m_labels);
+	machine->train(features);
+	EXPECT_EQ(machine->get_path_size(), 1);
+	check_optimality(machine, 0.1, 0.4);
+}
+
+TEST_F(ElasticNetTest, sparse_equals_dense)
+{
+	auto dense = std::make_shared<DenseFeatures<float64_t>>(m_data);
+	auto sparse = std::make_shared<SparseFeatures<float64_t>>(dense);
+
+	auto dense_machine = std::make_shared<ElasticNet>(0.05, 0.7);
+	dense_machine->put("epsilon", 1e-12);
+	dense_machine->set_labels(m_labels);
+	dense_machine->train(dense);
+	auto sparse_machine = std::make_shared<ElasticNet>(0.05, 0.7);
+	sparse_machine->put("epsilon", 1e-12);
+	sparse_machine->set_labels(m_labels);
+	sparse_machine->train(sparse);
+
+	auto w_dense = dense_machine->get_w();
+	auto w_sparse = sparse_machine->get_w();
+	for (index_t j = 0; j < w_dense.vlen; ++j)
+		EXPECT_NEAR(w_dense[j], w_sparse[j], 1e-6);
+	EXPECT_NEAR(dense_machine->get_bias(), sparse_machine->get_bias(), 1e-6);
+}
+
+TEST_F(ElasticNetTest, path)
+{
+	auto features = std::make_shared<DenseFeatures<float64_t>>(m_data);
+	auto machine = std::make_shared<ElasticNet>(0.01, 1.0);
+	machine->set_num_lambdas(20);
+	machine->put("epsilon", 1e-12);
+	machine->set_labels(m_labels);
+	machine->train(features);
+	ASSERT_EQ(machine->get_path_size(), 20);
+
+	auto y = m_labels->get_labels();
+	float64_t y_mean = 0;
+	for (auto v : y)
+		y_mean += v / y.vlen;
+
+	// the path starts at the smallest lambda with all weights zero
+	for (auto v : machine->get_path_w(0))
+		EXPECT_EQ(v, 0);
+	EXPECT_NEAR(machine->get_path_lambda(19), 0.01, 1e-12);
+	for (index_t k = 1; k < 20; ++k)
+		EXPECT_LT(machine->get_path_lambda(k), machine->get_path_lambda(k - 1));
+
+	auto w = machine->get_w().clone();
+	machine->switch_w(0);
+	EXPECT_NEAR(machine->get_bias(), y_mean, 1e-10);
+	machine->switch_w(10);
+	check_optimality(machine, machine->get_path_lambda(10), 1.0);
+	machine->switch_w(19);
+	auto w_last = machine->get_w();
+	for (index_t j = 0; j < w.vlen; ++j)
+		EXPECT_EQ(w[j], w_last[j]);
+}
+
+TEST_F(ElasticNetTest, lambda_above_max)
+{
+	auto features = std::make_shared<DenseFeatures<float64_t>>(m_data);
+	auto machine = std::make_shared<ElasticNet>(1e6, 0.5);
+	machine->set_labels(m_labels);
+	machine->train(features);
+	EXPECT_EQ(machine->get_path_size(), 1);
+
+	for (auto v : machine->get_w())
+		EXPECT_EQ(v, 0);
+	auto outputs = machine->apply_regression(features)->get_labels();
+	auto y = m_labels->get_labels();
+	float64_t y_mean = 0;
+	for (auto v : y)
+		y_mean += v / y.vlen;
+	for (auto v : outputs)
+		EXPECT_NEAR(v, y_mean, 1e-10);
+}
@@ -168,3 +168,187 @@ TEST(BeliefPropagation, tree_max_product_multi_states)
 
 }
 
+TEST(BeliefPropagation, tree_max_product_reuse)
+{
+	SGVector<int32_t> assignment_expected;
+	float64_t min_energy_expected;
+
+	auto fg_test_data = std::make_shared<FactorGraphDataGenerator>();
+	auto fg = fg_test_data->random_chain_graph(assignment_expected, min_energy_expected);
+
+	MAPInference infer_met(fg, TREE_MAX_PROD);
+	infer_met.inference();
+	EXPECT_NEAR(min_energy_expected, infer_met.get_energy(), 1E-10);
+
+	// the compiled graph reads the energies again
+	SGVector<int32_t> y_truth(assignment_expected.size());
+	y_truth.zero();
+	fg->loss_augmentation(y_truth);
+	infer_met.inference();
+
+	MAPInference infer_new(fg, TREE_MAX_PROD);
+	infer_new.inference();
+
+	SGVector<int32_t> assignment = infer_met.get_structured_outputs()->get_data();
+	SGVector<int32_t> assignment_new = infer_new.get_structured_outputs()->get_data();
+	for (int32_t i = 0; i < assignment.size(); i++)
+		EXPECT_EQ(assignment[i], assignment_new[i]);
+
+	EXPECT_NEAR(infer_new.get_energy(), infer_met.get_energy(), 1E-10);
+	EXPECT_NEAR(fg->evaluate_energy(assignment), infer_met.get_energy(), 1E-10);
+}
+
+TEST(BeliefPropagation, loopy_max_product_random)
+{
+	SGVector<int32_t> assignment_expected;
+	float64_t min_energy_expected;
+
+	auto fg_test_data = std::make_shared<FactorGraphDataGenerator>();
+	auto fg = fg_test_data->random_chain_graph(assignment_expected, min_energy_expected);
+
+	// exact on trees
+	MAPInference infer_met(fg, LOOPY_MAX_PROD);
+	infer_met.inference();
+
+	SGVector<int32_t> assignment = infer_met.get_structured_outputs()->get_data();
+	for (int32_t i = 0; i < assignment.size(); i++)
+		EXPECT_EQ(assignment[i], assignment_expected[i]);
+
+	EXPECT_NEAR(min_energy_expected, infer_met.get_energy(), 1E-10);
+}
+
+TEST(BeliefPropagation, loopy_max_product_multi_states)
+{
+	auto fg_test_data = std::make_shared<FactorGraphDataGenerator>();
+	auto fg = fg_test_data->multi_state_tree_graph();
+
+	MAPInference infer_met(fg, LOOPY_MAX_PROD);
+	infer_met.inference();
+
+	SGVector<int32_t> assignment = infer_met.get_structured_outputs()->get_data();
+	EXPECT_EQ(assignment[0], 2);
+	EXPECT_EQ(assignment[1], 0);
+	EXPECT_EQ(assignment[2], 2);
+
+	EXPECT_NEAR(-3.8, infer_met.get_energy(), 1E-10);
+}
+
+TEST(BeliefPropagation, loopy_max_product_cycle)
+{
+	SGVector<int32_t> card(1);
+	card[0] = 2;
+	SGVector<float64_t> w_unary;
+	auto unary = std::make_shared<TableFactorType>(0, card, w_unary);
+
+	SGVector<int32_t> card2(2);
+	card2[0] = 2;
+	card2[1] = 2;
+	SGVector<float64_t> w_potts(4);
+	w_potts[0] = 0.0; // 0,0
+	w_potts[1] = 0.4; // 1,0
+	w_potts[2] = 0.4; // 0,1
+	w_potts[3] = 0.0; // 1,1
+	auto potts = std::make_shared<TableFactorType>(1, card2, w_potts);
+
+	// 2x2 grid, the variables connected in a cycle
+	SGVector<int32_t> vc(4);
+	SGVector<int32_t>::fill_vector(vc.vector, vc.vlen, 2);
+	auto fg = std::make_shared<FactorGraph>(vc);
+
+	float64_t unaries[4][2] = {{0.0, 1.0}, {0.8, 0.2}, {0.3, 0.6}, {0.9, 0.1}};
+	for (int32_t vi = 0; vi < 4; vi++)
+	{
+		SGVector<int32_t> var_index(1);
+		var_index[0] = vi;
+		SGVector<float64_t> data(2);
+		data[0] = unaries[vi][0];
+		data[1] = unaries[vi][1];
+		fg->add_factor(std::make_shared<Factor>(unary, var_index, data));
+	}
+
+	int32_t pairs[4][2] = {{0, 1}, {1, 3}, {3, 2}, {2, 0}};
+	SGVector<float64_t> data(1);
+	data[0] = 1.0;
+	for (int32_t pi = 0; pi < 4; pi++)
+	{
+		SGVector<int32_t> var_index(2);
+		var_index[0] = pairs[pi][0];
+		var_index[1] = pairs[pi][1];
+		fg->add_factor(std::make_shared<Factor>(potts, var_index, data));
+	}
+
+	fg->connect_components();
+	fg->compute_energies();
+	EXPECT_FALSE(fg->is_acyclic_graph());
+
+	MAPInference infer_met(fg, LOOPY_MAX_PROD);
+	infer_met.inference();
+	SGVector<int32_t> assignment = infer_met.get_structured_outputs()->get_data();
+
+	// exhaustive search
+	float64_t min_energy = std::numeric_limits<float64_t>::infinity();
+	SGVector<int32_t> assignment_expected;
+	SGVector<int32_t> y(4);
+	for (int32_t yi = 0; yi < 16; yi++)
+	{
+		for (int32_t vi = 0; vi < 4; vi++)
+			y[vi] = (yi >> vi) & 1;
+
+		float64_t energy = fg->evaluate_energy(y);
+		if (energy < min_energy)
+		{
+			min_energy = energy;
+			assignment_expected = y.clone();
+		}
+	}
+
+	for (int32_t i = 0; i < assignment.size(); i++)
+		EXPECT_EQ(assignment[i], assignment_expected[i]);
+
+	EXPECT_NEAR(min_energy, infer_met.get_energy(), 1E-10);
+	EXPECT_NEAR(1.4, infer_met.get_energy(), 1E-10);
+}
+
+TEST(BeliefPropagation, loopy_max_product_recompile)
+{
+	SGVector<int32_t> card2(2);
+	card2[0] = 2;
+	card2[1] = 2;
+	SGVector<float64_t> w_pair(4);
+	w_pair[0] = 0.0; // 0,0
+	w_pair[1] = 2.0; // 1,0
+	w_pair[2] = -1.0; // 0,1
+	w_pair[3] = 0.0; // 1,1
+	auto pairwise = std::make_shared<TableFactorType>(0, card2, w_pair);
+
+	SGVector<int32_t> vc(2);
+	SGVector<int32_t>::fill_vector(vc.vector, vc.vlen, 2);
+	auto fg = std::make_shared<FactorGraph>(vc);
+
+	SGVector<int32_t> var_index(2);
+	var_index[0] = 0;
+	var_index[1] = 1;
+	SGVector<float64_t> data(1);
+	data[0] = 1.0;
+	auto factor = std::make_shared<Factor>(pairwise, var_index, data);
+	fg->add_factor(factor);
+	fg->connect_components();
+	fg->compute_energies();
+
+	MAPInference infer_met(fg, LOOPY_MAX_PROD);
+	infer_met.inference();
+	SGVector<int32_t> assignment = infer_met.get_structured_outputs()->get_data();
+	EXPECT_EQ(assignment[0], 0);
+	EXPECT_EQ(assignment[1], 1);
+
+	// the same number of factors and edges, but other variables
+	SGVector<int32_t> swapped(2);
+	swapped[0] = 1;
+	swapped[1] = 0;
+	factor->set_variables(swapped);
+	infer_met.inference();
+	assignment = infer_met.get_structured_outputs()->get_data();
+	EXPECT_EQ(assignment[0], 1);
+	EXPECT_EQ(assignment[1], 0);
+	EXPECT_NEAR(-1.0, infer_met.get_energy(), 1E-10);
+}
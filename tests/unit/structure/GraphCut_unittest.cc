@@ -47,6 +47,61 @@ TEST(GraphCut, graph_cut_st_graph)
 
 }
 
+// Test max-flow algorithm on a changed s-t graph, starting from the
+// previous max flow
+TEST(GraphCut, graph_cut_st_graph_reuse)
+{
+	int32_t num_nodes = 5;
+	int32_t num_edges = 6;
+
+	float64_t caps[6] = {5, 2, 6, 9, 1, 3};
+	float64_t new_caps[6] = {1, 1, 6, 2, 4, 1};
+	int32_t heads[6][2] = {{0, 2}, {0, 3}, {1, 2}, {1, 4}, {2, 3}, {2, 4}};
+
+	auto g = std::make_shared<GraphCut>(num_nodes, num_edges);
+	auto g_new = std::make_shared<GraphCut>(num_nodes, num_edges);
+
+	for (auto graph : {g, g_new})
+	{
+		graph->add_tweights(0, 4, 0);
+		graph->add_tweights(1, 2, 0);
+		graph->add_tweights(2, 8, 0);
+		graph->add_tweights(2, 0, 4);
+		graph->add_tweights(3, 0, 7);
+		graph->add_tweights(4, 0, 5);
+	}
+
+	for (int32_t e = 0; e < num_edges; e++)
+	{
+		EXPECT_EQ(g->add_edge(heads[e][0], heads[e][1], caps[e], 0), e);
+		g_new->add_edge(heads[e][0], heads[e][1], new_caps[e], 0);
+	}
+
+	g->init_maxflow();
+	EXPECT_EQ(g->compute_maxflow(), 12);
+
+	// the flow along the edges 0->3 and 2->4 exceeds their new capacities
+	for (int32_t e = 0; e < num_edges; e++)
+		g->set_edge_capacity(e, new_caps[e], 0);
+
+	for (auto graph : {g, g_new})
+	{
+		graph->add_tweights(1, 0, 3);
+		graph->add_tweights(3, 6, 0);
+	}
+
+	g->init_maxflow(true);
+	float64_t flow = g->compute_maxflow();
+	g_new->init_maxflow();
+	EXPECT_EQ(flow, g_new->compute_maxflow());
+	EXPECT_EQ(flow, 14);
+
+	for (int32_t i = 0; i < num_nodes; i++)
+	{
+		EXPECT_EQ(g->get_assignment(i), g_new->get_assignment(i));
+	}
+}
+
 // Test graph-cuts inference for a simple two nodes chain structure graph
 TEST(GraphCut, graph_cut_chain)
 {
@@ -99,6 +154,35 @@ TEST(GraphCut, graph_cut_random)
 
 }
 
+// Test graph-cuts inference after the energies changed, starting from
+// the previous max flow
+TEST(GraphCut, graph_cut_reuse)
+{
+	SGVector<int32_t> assignment_expected;
+	float64_t min_energy_expected;
+
+	auto fg_test_data = std::make_shared<FactorGraphDataGenerator>();
+	fg_test_data->put("seed", 10);
+
+	auto fg = fg_test_data->random_chain_graph(assignment_expected, min_energy_expected);
+
+	MAPInference infer_met(fg, GRAPH_CUT);
+	infer_met.inference();
+	EXPECT_NEAR(min_energy_expected, infer_met.get_energy(), 1E-10);
+
+	SGVector<int32_t> y_truth(assignment_expected.size());
+	y_truth.zero();
+	fg->loss_augmentation(y_truth);
+	infer_met.inference();
+
+	MAPInference infer_new(fg, GRAPH_CUT);
+	infer_new.inference();
+
+	SGVector<int32_t> assignment = infer_met.get_structured_outputs()->get_data();
+	EXPECT_NEAR(infer_new.get_energy(), infer_met.get_energy(), 1E-10);
+	EXPECT_NEAR(fg->evaluate_energy(assignment), infer_met.get_energy(), 1E-10);
+}
+
 // Test graph-cuts with SOSVM framework
 // using randomly generated synthetic data
 TEST(GraphCut, graph_cut_sosvm)
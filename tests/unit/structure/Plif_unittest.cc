@@ -0,0 +1,112 @@
+/*
+ * This software is distributed under BSD 3-clause license (see LICENSE file).
+ */
+
+#include <gtest/gtest.h>
+#include <shogun/structure/Plif.h>
+#include <shogun/structure/PlifArray.h>
+
+#include <cmath>
+
+using namespace shogun;
+
+namespace
+{
+	std::shared_ptr<Plif> create_plif(
+	    float64_t min_value, float64_t max_value, int32_t use_svm,
+	    float64_t lo, float64_t hi)
+	{
+		const int32_t len = 5;
+		auto plif = std::make_shared<Plif>(len);
+		SGVector<float64_t> limits(len);
+		SGVector<float64_t> penalties(len);
+		for (index_t i = 0; i < len; i++)
+		{
+			limits[i] = lo + (hi - lo) * i / (len - 1);
+			penalties[i] = std::sin(i + use_svm + min_value);
+		}
+		plif->set_plif_limits(limits);
+		plif->set_plif_penalty(penalties);
+		plif->set_min_value(min_value);
+		plif->set_max_value(max_value);
+		plif->set_use_svm(use_svm);
+		return plif;
+	}
+
+	void check_penalty_parts(
+	    const std::shared_ptr<PlifBase>& plif, int32_t p_value,
+	    float64_t* svm_values)
+	{
+		float64_t expected = plif->lookup_penalty(p_value, svm_values);
+		float64_t actual = plif->lookup_penalty_value_part(p_value) +
+		                   plif->lookup_penalty_svm_part(p_value, svm_values);
+		if (std::isinf(expected))
+			EXPECT_EQ(expected, actual) << "p_value " << p_value;
+		else
+			EXPECT_NEAR(expected, actual, 1e-12) << "p_value " << p_value;
+	}
+}
+
+TEST(Plif, lookup_penalty_parts)
+{
+	float64_t svm_values[] = {0.3, -0.7};
+	auto plif = create_plif(10, 200, 0, 10, 200);
+
+	for (int32_t p = -20; p <= 250; p++)
+		check_penalty_parts(plif, p, svm_values);
+	EXPECT_EQ(-Math::INFTY, plif->lookup_penalty_value_part(5));
+	EXPECT_EQ(-Math::INFTY, plif->lookup_penalty_value_part(201));
+	EXPECT_EQ(0, plif->lookup_penalty_svm_part(50, svm_values));
+
+	plif->set_transform_type("log(+1)");
+	for (int32_t p = -20; p <= 250; p++)
+		check_penalty_parts(plif, p, svm_values);
+
+	plif->set_use_cache(true);
+	plif->init_penalty_struct_cache();
+	for (int32_t p = -20; p <= 250; p++)
+		check_penalty_parts(plif, p, svm_values);
+}
+
+TEST(Plif, lookup_penalty_parts_use_svm)
+{
+	float64_t svm_values[] = {0.3, -0.7};
+	auto plif = create_plif(-1e6, 1e6, 2, -1, 1);
+
+	for (int32_t p = -20; p <= 250; p++)
+		check_penalty_parts(plif, p, svm_values);
+	EXPECT_EQ(0, plif->lookup_penalty_value_part(50));
+	EXPECT_EQ(
+	    plif->lookup_penalty_svm(50, svm_values),
+	    plif->lookup_penalty_svm_part(50, svm_values));
+
+	/* SVM values outside of the limits */
+	svm_values[1] = 5.0;
+	check_penalty_parts(plif, 50, svm_values);
+	svm_values[1] = -5.0;
+	check_penalty_parts(plif, 50, svm_values);
+}
+
+TEST(PlifArray, lookup_penalty_parts)
+{
+	float64_t svm_values[] = {0.3, -0.7};
+	auto plif_array = std::make_shared<PlifArray>();
+	plif_array->add_plif(create_plif(10, 200, 0, 10, 200));
+	plif_array->add_plif(create_plif(-1e6, 1e6, 1, -1, 1));
+	plif_array->add_plif(create_plif(20, 150, 0, 20, 150));
+	plif_array->add_plif(create_plif(-1e6, 1e6, 2, -1, 1));
+
+	/* the range is the intersection of the PLiFs not using SVM values */
+	EXPECT_EQ(20, plif_array->get_min_value());
+	EXPECT_EQ(150, plif_array->get_max_value());
+
+	for (int32_t p = -20; p <= 250; p++)
+		check_penalty_parts(plif_array, p, svm_values);
+	EXPECT_EQ(-Math::INFTY, plif_array->lookup_penalty_value_part(15));
+	EXPECT_EQ(-Math::INFTY, plif_array->lookup_penalty_value_part(151));
+
+	svm_values[0] = 5.0;
+	svm_values[1] = -5.0;
+	for (int32_t p = -20; p <= 250; p++)
+		check_penalty_parts(plif_array, p, svm_values);
+}
@@ -9,8 +9,15 @@
 #include <shogun/structure/StochasticSOSVM.h>
 #include <shogun/structure/FWSOSVM.h>
 #include <shogun/structure/SOSVMHelper.h>
+#include <shogun/structure/MulticlassModel.h>
+#include <shogun/structure/MulticlassSOLabels.h>
+#include <shogun/features/DenseFeatures.h>
+#include <shogun/mathematics/NormalDistribution.h>
 #include <gtest/gtest.h>
 
+#include <cmath>
+#include <random>
+
 using namespace shogun;
 
 TEST(SOSVM, sgd_check_w_helper)
@@ -176,4 +183,106 @@ TEST(SOSVM, fw_check_w_helper)
 
 
 
+}
+
+/** three classes around directions 120 degrees apart */
+static std::shared_ptr<MulticlassModel> create_multiclass_model(int32_t num_samples)
+{
+	std::mt19937_64 prng(23);
+	NormalDistribution<float64_t> normal;
+
+	SGMatrix<float64_t> data(2, num_samples);
+	SGVector<float64_t> labs(num_samples);
+	for (int32_t i = 0; i < num_samples; ++i)
+	{
+		labs[i] = i % 3;
+		float64_t angle = 2 * M_PI * labs[i] / 3;
+		data(0, i) = 5 * std::cos(angle) + 0.5 * normal(prng);
+		data(1, i) = 5 * std::sin(angle) + 0.5 * normal(prng);
+	}
+	auto features = std::make_shared<DenseFeatures<float64_t>>(data);
+	auto labels = std::make_shared<MulticlassSOLabels>(labs);
+
+	return std::make_shared<MulticlassModel>(features, labels);
+}
+
+TEST(SOSVM, argmax_batch)
+{
+	auto model = create_multiclass_model(30);
+	model->init_training();
+
+	SGVector<float64_t> w(model->get_dim());
+	for (int32_t i = 0; i < w.vlen; ++i)
+		w[i] = std::sin(i + 1.0);
+
+	// with repeated examples
+	SGVector<int32_t> examples(45);
+	for (int32_t i = 0; i < examples.vlen; ++i)
+		examples[i] = (i * 7) % 30;
+
+	for (bool training : {true, false})
+	{
+		auto results = model->argmax_batch(w, examples, training);
+		ASSERT_EQ(results.size(), examples.vlen);
+		for (int32_t i = 0; i < examples.vlen; ++i)
+		{
+			auto expected = model->argmax(w, examples[i], training);
+			EXPECT_EQ(
+			    results[i]->argmax->as<RealNumber>()->value,
+			    expected->argmax->as<RealNumber>()->value);
+			EXPECT_EQ(results[i]->score, expected->score);
+			EXPECT_EQ(results[i]->delta, expected->delta);
+			for (int32_t j = 0; j < w.vlen; ++j)
+				EXPECT_EQ(results[i]->psi_pred[j], expected->psi_pred[j]);
+		}
+	}
+}
+
+TEST(SOSVM, sgd_mini_batch)
+{
+	int32_t num_samples = 90;
+	auto model = create_multiclass_model(num_samples);
+	auto labels = model->get_labels();
+
+	auto sgd = std::make_shared<StochasticSOSVM>(model, labels, true, false);
+	sgd->set_batch_size(8);
+	sgd->set_num_iter(30);
+	sgd->put("seed", 5);
+	sgd->train();
+
+	auto out = sgd->apply()->as<StructuredLabels>();
+	int32_t num_correct = 0;
+	for (int32_t i = 0; i < num_samples; ++i)
+	{
+		float64_t truth = labels->get_label(i)->as<RealNumber>()->value;
+		float64_t pred = out->get_label(i)->as<RealNumber>()->value;
+		num_correct += truth == pred;
+	}
+	EXPECT_GE(num_correct, 0.95 * num_samples);
+}
+
+TEST(SOSVM, sgd_mini_batch_debug_info)
+{
+	int32_t num_samples = 90;
+	int32_t num_iter = 10;
+	auto model = create_multiclass_model(num_samples);
+	auto labels = model->get_labels();
+
+	auto sgd = std::make_shared<StochasticSOSVM>(model, labels, true, true);
+	sgd->set_batch_size(8);
+	sgd->set_num_iter(num_iter);
+	sgd->put("seed", 5);
+	sgd->train();
+
+	/* about once per pass, not on every step */
+	auto eff_passes = sgd->get_helper()->get_eff_passes();
+	EXPECT_GE(eff_passes.vlen, num_iter - 1);
+	EXPECT_LE(eff_passes.vlen, num_iter + 1);
+	for (int32_t i = 1; i < eff_passes.vlen; ++i)
+		EXPECT_GT(eff_passes[i], eff_passes[i - 1]);
+
+	/* a multiplier below 100 does not grow the schedule */
+	sgd->set_debug_multiplier(50);
+	sgd->train();
+	EXPECT_EQ(1, sgd->get_helper()->get_eff_passes().vlen);
 }